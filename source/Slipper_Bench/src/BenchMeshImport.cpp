@@ -0,0 +1,93 @@
+#include "BenchMeshImport.h"
+
+#include "Model/ObjImporter.h"
+#include "ThreadPool.h"
+
+namespace Slipper::Bench
+{
+    MeshImportResult BenchMeshImport::Run(const MeshImportSettings &Settings)
+    {
+        ASSERT(Settings.runs > 0, "The mesh import bench needs at least one run")
+
+        const std::filesystem::path source = Settings.source.empty() ? GenerateGrid(Settings.triangles) :
+                                                                       Settings.source;
+        const std::string source_path = std::filesystem::absolute(source).string();
+
+        MeshImportResult result;
+        result.source = source.generic_string();
+        result.sourceBytes = std::filesystem::file_size(source);
+        result.threads = ThreadPool::GetConcurrency();
+
+        const auto time_import = [&](MeshData (*Import)(const std::string &), MeshData &Mesh)
+        {
+            double best = std::numeric_limits<double>::max();
+            for (uint32_t run = 0; run < Settings.runs; ++run)
+            {
+                // The previous result is freed before the clock starts
+                Mesh = {};
+                const auto begin = std::chrono::steady_clock::now();
+                Mesh = Import(source_path);
+                const std::chrono::duration<double, std::milli> time = std::chrono::steady_clock::now() - begin;
+                best = std::min(best, time.count());
+            }
+            return best;
+        };
+
+        MeshData reference;
+        result.referenceMs = time_import(&ImportObjTinyObj, reference);
+        MeshData parallel;
+        result.parallelMs = time_import(&ImportObj, parallel);
+
+        result.triangles = parallel.indices.size() / 3;
+        result.vertices = parallel.vertices.size();
+        result.identical = reference.vertices == parallel.vertices && reference.indices == parallel.indices;
+        return result;
+    }
+
+    std::filesystem::path BenchMeshImport::GenerateGrid(const uint32_t Triangles)
+    {
+        const auto size = std::max(
+            static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(Triangles) / 2.0))), 1u);
+        const std::filesystem::path path =
+            std::filesystem::temp_directory_path() / std::format("slipper_bench_grid_{}.obj", size);
+        if (std::filesystem::exists(path))
+            return path;
+
+        // An interrupted run must not leave a truncated grid behind for the next one
+        File::write_file_atomic(path.string(), [&](std::ofstream &Stream) {
+            // Written a row at a time, the file of a 10 million triangle grid is several hundred megabytes
+            std::string row;
+            for (uint32_t y = 0; y <= size; ++y)
+            {
+                row.clear();
+                for (uint32_t x = 0; x <= size; ++x)
+                {
+                    const float u = static_cast<float>(x) / static_cast<float>(size);
+                    const float v = static_cast<float>(y) / static_cast<float>(size);
+                    std::format_to(std::back_inserter(row), "v {} {} {}\nvt {} {}\n", u * 10.0f, 0.0f, v * 10.0f, u, v);
+                }
+                Stream << row;
+            }
+
+            for (uint32_t y = 0; y < size; ++y)
+            {
+                row.clear();
+                if (y % 64 == 0)
+                {
+                    std::format_to(std::back_inserter(row), "g rows_{}\n", y);
+                }
+                for (uint32_t x = 0; x < size; ++x)
+                {
+                    const uint32_t a = y * (size + 1) + x + 1;
+                    const uint32_t b = a + 1;
+                    const uint32_t c = a + size + 2;
+                    const uint32_t d = a + size + 1;
+                    std::format_to(
+                        std::back_inserter(row), "f {0}/{0} {1}/{1} {2}/{2}\nf {0}/{0} {2}/{2} {3}/{3}\n", a, b, c, d);
+                }
+                Stream << row;
+            }
+        });
+        return path;
+    }
+}  // namespace Slipper::Bench
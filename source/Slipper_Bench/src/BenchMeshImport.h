@@ -0,0 +1,44 @@
+#pragma once
+
+namespace Slipper::Bench
+{
+    struct MeshImportSettings
+    {
+        // OBJ to import, a grid of about this many triangles is generated into the temp directory if empty
+        std::filesystem::path source;
+        uint32_t triangles = 0;
+        // Both importers read the file this often, the fastest run of each is reported
+        uint32_t runs = 3;
+
+        [[nodiscard]] bool IsEnabled() const
+        {
+            return !source.empty() || triangles > 0;
+        }
+    };
+
+    struct MeshImportResult
+    {
+        std::string source;
+        uint64_t sourceBytes = 0;
+        uint64_t triangles = 0;
+        uint64_t vertices = 0;
+        uint32_t threads = 0;
+        // Single threaded tinyobjloader import the Model constructor used before the parallel importer
+        double referenceMs = 0.0;
+        double parallelMs = 0.0;
+        // Both importers produced the same vertices and indices in the same order
+        bool identical = false;
+    };
+
+    /* Times the OBJ import that cooking a model starts with, the rest of loading a model is the same for both
+     * importers. Runs on the main thread with the engines thread pool available to the parallel importer. */
+    class BenchMeshImport
+    {
+     public:
+        static MeshImportResult Run(const MeshImportSettings &Settings);
+
+     private:
+        // Square grid of about Triangles triangles with texture coordinates, split into a group every 64 rows
+        static std::filesystem::path GenerateGrid(uint32_t Triangles);
+    };
+}  // namespace Slipper::Bench
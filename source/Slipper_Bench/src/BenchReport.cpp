@@ -0,0 +1,151 @@
+#include "BenchReport.h"
+
+#ifdef WINDOWS
+#    include <windows.h>
+#    include <psapi.h>
+#else
+#    include <sys/resource.h>
+#endif
+
+namespace Slipper::Bench
+{
+    FrameTimeStats FrameTimeStats::Compute(std::vector<double> FrameTimesMs)
+    {
+        FrameTimeStats stats;
+        if (FrameTimesMs.empty())
+            return stats;
+
+        std::ranges::sort(FrameTimesMs);
+        const auto percentile = [&](const double Percentile)
+        {
+            const auto rank = static_cast<size_t>(std::ceil(Percentile / 100.0 * FrameTimesMs.size()));
+            return FrameTimesMs[std::clamp<size_t>(rank, 1, FrameTimesMs.size()) - 1];
+        };
+
+        stats.samples = FrameTimesMs.size();
+        stats.min = FrameTimesMs.front();
+        stats.max = FrameTimesMs.back();
+        stats.mean = std::accumulate(FrameTimesMs.begin(), FrameTimesMs.end(), 0.0) / FrameTimesMs.size();
+        stats.p50 = percentile(50.0);
+        stats.p90 = percentile(90.0);
+        stats.p95 = percentile(95.0);
+        stats.p99 = percentile(99.0);
+        return stats;
+    }
+
+    static std::string frame_time_stats_to_json(const FrameTimeStats &Stats)
+    {
+        return std::format(
+            R"({{"samples": {}, "min": {:.4f}, "mean": {:.4f}, "p50": {:.4f}, "p90": {:.4f}, "p95": {:.4f}, "p99": {:.4f}, "max": {:.4f}}})",
+            Stats.samples,
+            Stats.min,
+            Stats.mean,
+            Stats.p50,
+            Stats.p90,
+            Stats.p95,
+            Stats.p99,
+            Stats.max);
+    }
+
+    std::string BenchReport::ToJson() const
+    {
+        std::stringstream json;
+        json << "{\n";
+        json << std::format(R"(  "device": "{}",)", deviceName) << '\n';
+        json << std::format(R"(  "scene": {{"entities": {}, "models": {}, "materials": {}, "seed": {}, "lights": {}, "lit": {}, "vertices": {}, "indices": {}}},)",
+                            scene.entities,
+                            scene.models,
+                            scene.materials,
+                            scene.seed,
+                            scene.lights,
+                            scene.lit,
+                            sceneInfo.vertices,
+                            sceneInfo.indices)
+             << '\n';
+        json << std::format(R"(  "warmupFrames": {},)", warmupFrames) << '\n';
+        json << std::format(R"(  "frames": {},)", frames) << '\n';
+        json << R"(  "cpuFrameMs": )" << frame_time_stats_to_json(cpuFrameTimes) << ",\n";
+        json << R"(  "gpuFrameMs": )" << frame_time_stats_to_json(gpuFrameTimes) << ",\n";
+        json << R"(  "lightCullingMs": )" << frame_time_stats_to_json(lightCullingTimes) << ",\n";
+        json << std::format(R"(  "commands": {{"draws": {}, "pipelineBinds": {}, "descriptorSetBinds": {}, "elidedBinds": {}}},)",
+                            draws,
+                            pipelineBinds,
+                            descriptorSetBinds,
+                            elidedBinds)
+             << '\n';
+        json << std::format(
+            R"(  "descriptorSets": {{"allocated": {}, "cacheHits": {}, "cacheMisses": {}, "hitRate": {:.4f}, "pools": {}}},)",
+            descriptorSets.setsAllocated,
+            descriptorSets.cacheHits,
+            descriptorSets.cacheMisses,
+            descriptorSets.HitRate(),
+            descriptorPools)
+             << '\n';
+        json << std::format(R"(  "memory": {{"peakProcessBytes": {}, "deviceLocalUsageBytes": {}}},)",
+                            peakProcessMemory,
+                            deviceLocalMemoryUsage)
+             << '\n';
+        json << std::format(R"(  "startup": {{"initMs": {:.4f}, "firstFrameMs": {}, "tasks": [)",
+                            startup.initMs,
+                            startup.firstFrameMs ? std::format("{:.4f}", *startup.firstFrameMs) : "null");
+        for (size_t i = 0; i < startup.tasks.size(); ++i)
+        {
+            const auto &task = startup.tasks[i];
+            json << (i ? ",\n" : "\n");
+            json << std::format(R"(    {{"name": "{}", "thread": "{}", "startMs": {:.4f}, "durationMs": {:.4f}}})",
+                                task.name,
+                                magic_enum::enum_name(task.thread),
+                                task.startMs,
+                                task.durationMs);
+        }
+        json << (startup.tasks.empty() ? "]},\n" : "\n  ]},\n");
+        if (meshImport)
+        {
+            json << std::format(
+                R"(  "meshImport": {{"source": "{}", "sourceBytes": {}, "triangles": {}, "vertices": {}, "threads": {}, "referenceMs": {:.4f}, "parallelMs": {:.4f}, "identical": {}}},)",
+                meshImport->source,
+                meshImport->sourceBytes,
+                meshImport->triangles,
+                meshImport->vertices,
+                meshImport->threads,
+                meshImport->referenceMs,
+                meshImport->parallelMs,
+                meshImport->identical)
+                 << '\n';
+        }
+        json << R"(  "lightSweep": [)";
+        for (size_t i = 0; i < lightSweep.size(); ++i)
+        {
+            const auto &step = lightSweep[i];
+            json << (i ? ",\n" : "\n");
+            json << std::format(R"(    {{"lights": {}, "cpuFrameMs": {}, "gpuFrameMs": {}, "lightCullingMs": {}}})",
+                                step.lights,
+                                frame_time_stats_to_json(step.cpuFrameTimes),
+                                frame_time_stats_to_json(step.gpuFrameTimes),
+                                frame_time_stats_to_json(step.lightCullingTimes));
+        }
+        json << (lightSweep.empty() ? "]\n" : "\n  ]\n");
+        json << "}\n";
+        return json.str();
+    }
+
+    uint64_t get_peak_process_memory()
+    {
+#ifdef WINDOWS
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        {
+            return counters.PeakWorkingSetSize;
+        }
+        return 0;
+#else
+        rusage usage{};
+        if (getrusage(RUSAGE_SELF, &usage) == 0)
+        {
+            // Reported in kilobytes on linux
+            return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+        }
+        return 0;
+#endif
+    }
+}  // namespace Slipper::Bench
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "BenchMeshImport.h"
+#include "BenchScene.h"
+#include "Core/Application.h"
+#include "Vulkan/vk_DescriptorAllocator.h"
+
+namespace Slipper::Bench
+{
+    struct FrameTimeStats
+    {
+        uint64_t samples = 0;
+        double min = 0.0;
+        double mean = 0.0;
+        double p50 = 0.0;
+        double p90 = 0.0;
+        double p95 = 0.0;
+        double p99 = 0.0;
+        double max = 0.0;
+
+        // Nearest rank percentiles of the given frame times in milliseconds
+        static FrameTimeStats Compute(std::vector<double> FrameTimesMs);
+    };
+
+    // Measured with exactly this many lights in the scene, see BenchSettings::lightSweep
+    struct LightSweepStep
+    {
+        uint32_t lights = 0;
+        FrameTimeStats cpuFrameTimes;
+        FrameTimeStats gpuFrameTimes;
+        // Gpu time of the clustered light culling dispatch, empty for unlit scenes
+        FrameTimeStats lightCullingTimes;
+    };
+
+    struct BenchReport
+    {
+        BenchSceneSettings scene;
+        BenchSceneInfo sceneInfo;
+        uint32_t warmupFrames = 0;
+        uint32_t frames = 0;
+
+        std::string deviceName;
+
+        FrameTimeStats cpuFrameTimes;
+        // Empty if the device does not support timestamp queries
+        FrameTimeStats gpuFrameTimes;
+        // Gpu time of the clustered light culling dispatch, empty for unlit scenes
+        FrameTimeStats lightCullingTimes;
+
+        // Per frame, taken from the command context of the rendered stage
+        uint64_t draws = 0;
+        uint64_t pipelineBinds = 0;
+        uint64_t descriptorSetBinds = 0;
+        uint64_t elidedBinds = 0;
+
+        // Summed over all measured frames
+        GPU::Vulkan::DescriptorAllocatorStats descriptorSets;
+        size_t descriptorPools = 0;
+
+        uint64_t peakProcessMemory = 0;
+        uint64_t deviceLocalMemoryUsage = 0;
+
+        std::vector<LightSweepStep> lightSweep;
+        std::optional<MeshImportResult> meshImport;
+        // Init graph tasks and time to first frame of the bench run itself
+        StartupStats startup;
+
+        [[nodiscard]] std::string ToJson() const;
+    };
+
+    // Peak resident set size of the process in bytes
+    uint64_t get_peak_process_memory();
+}  // namespace Slipper::Bench
@@ -0,0 +1,162 @@
+#include "BenchScene.h"
+
+#include "Camera.h"
+#include "CameraComponent.h"
+#include "GraphicsEngine.h"
+#include "LightComponent.h"
+#include "MaterialManager.h"
+#include "Model/Model.h"
+#include "ModelManager.h"
+#include "RendererComponent.h"
+#include "SceneObject.h"
+#include "ShaderManager.h"
+#include "TextureManager.h"
+#include "TransformComponent.h"
+#include "Vulkan/vk_Mesh.h"
+
+namespace Slipper::Bench
+{
+    BenchSceneInfo BenchScene::Generate(const BenchSceneSettings &Settings, NonOwningPtr<GPU::RenderingStage> Stage)
+    {
+        ASSERT(Settings.models > 0 && Settings.materials > 0, "The bench scene needs at least one model and material")
+
+        std::mt19937 random(Settings.seed);
+        BenchSceneInfo info;
+
+        std::vector<AssetHandle<Model>> models;
+        models.reserve(Settings.models);
+        std::vector<GPU::Vulkan::Vertex> vertices;
+        std::vector<VertexIndex> indices;
+        for (uint32_t i = 0; i < Settings.models; ++i)
+        {
+            std::uniform_int_distribution<uint32_t> tesselation(6, 48);
+            GenerateSphere(random, tesselation(random), tesselation(random), vertices, indices);
+            info.vertices += vertices.size();
+            info.indices += indices.size();
+            models.push_back(ModelManager::Create(std::format("Bench Model {}", i), vertices, indices));
+        }
+
+        const std::string_view shader_name = Settings.lit ? "Lit" : "Basic";
+        const auto shader = ShaderManager::TryGetGraphicsShader(shader_name);
+        ASSERT(shader, "The bench scene requires the engines '{}' shader", shader_name)
+        shader->RegisterRenderPass(GPU::GraphicsEngine::Get().viewportRenderPass);
+
+        const auto texture = TextureManager::Get2D("viking_room");
+        std::vector<NonOwningPtr<GPU::Material>> materials;
+        materials.reserve(Settings.materials);
+        for (uint32_t i = 0; i < Settings.materials; ++i)
+        {
+            const auto material = MaterialManager::AddMaterial(std::format("Bench Material {}", i), shader);
+            if (Settings.lit)
+                material->SetTexture(0, *texture);
+            else
+                material->SetUniform("texSampler", *texture);
+            materials.push_back(material);
+        }
+
+        // Entities sit on a jittered grid so the amount of overlap scales evenly with their count
+        constexpr float spacing = 3.0f;
+        const auto grid_size = static_cast<uint32_t>(std::ceil(std::cbrt(static_cast<double>(Settings.entities))));
+        info.extent = static_cast<float>(grid_size) * spacing;
+        const glm::vec3 grid_origin = glm::vec3(info.extent * -0.5f);
+
+        std::uniform_real_distribution<float> jitter(-0.5f, 0.5f);
+        std::uniform_real_distribution<float> angle(0.0f, 360.0f);
+        std::uniform_real_distribution<float> scale(0.5f, 1.25f);
+        std::uniform_int_distribution<uint32_t> model_index(0, Settings.models - 1);
+        std::uniform_int_distribution<uint32_t> material_index(0, Settings.materials - 1);
+        for (uint32_t i = 0; i < Settings.entities; ++i)
+        {
+            const glm::vec3 cell(i % grid_size, (i / grid_size) % grid_size, i / (grid_size * grid_size));
+            const glm::vec3 location = grid_origin + (cell + glm::vec3(0.5f) + glm::vec3(jitter(random))) * spacing;
+
+            Entity entity = SceneObject::Create(std::format("Bench Entity {}", i),
+                                                location,
+                                                glm::vec3(scale(random)),
+                                                glm::vec3(angle(random), angle(random), angle(random)));
+            entity.AddComponent<Renderer>(
+                Stage, models[model_index(random)], materials[material_index(random)]);
+        }
+
+        // Look at the whole volume from the same corner the default camera uses
+        Entity camera = GPU::GraphicsEngine::GetDefaultCamera();
+        camera.GetComponent<Transform>().SetLocation(glm::vec3(info.extent));
+        camera.GetComponent<Camera>().farPlane = info.extent * 4.0f;
+
+        return info;
+    }
+
+    std::vector<Entity> BenchScene::GenerateLights(const uint32_t Count, const uint32_t Seed, const float Extent)
+    {
+        // Seeded separately from the scene so sweeping the light count leaves the renderers untouched
+        std::mt19937 random(Seed ^ 0x9e3779b9u);
+        std::uniform_real_distribution<float> position(Extent * -0.5f, Extent * 0.5f);
+        std::uniform_real_distribution<float> channel(0.2f, 1.0f);
+        std::uniform_real_distribution<float> range(2.0f, 8.0f);
+
+        std::vector<Entity> lights;
+        lights.reserve(Count);
+        for (uint32_t i = 0; i < Count; ++i)
+        {
+            Entity entity = SceneObject::Create(
+                std::format("Bench Light {}", i), glm::vec3(position(random), position(random), position(random)));
+            entity.AddComponent<Light>(glm::vec3(channel(random), channel(random), channel(random)), 4.0f, range(random));
+            lights.push_back(entity);
+        }
+        return lights;
+    }
+
+    void BenchScene::GenerateSphere(std::mt19937 &Random,
+                                    const uint32_t Rings,
+                                    const uint32_t Segments,
+                                    std::vector<GPU::Vulkan::Vertex> &Vertices,
+                                    std::vector<VertexIndex> &Indices)
+    {
+        ASSERT((Rings + 1) * (Segments + 1) <= std::numeric_limits<VertexIndex>::max(),
+               "Sphere with {} rings and {} segments exceeds the index range",
+               Rings,
+               Segments)
+
+        Vertices.clear();
+        Indices.clear();
+
+        std::uniform_real_distribution<float> noise(0.85f, 1.15f);
+        std::uniform_real_distribution<float> channel(0.2f, 1.0f);
+        const glm::vec3 color(channel(Random), channel(Random), channel(Random));
+
+        for (uint32_t ring = 0; ring <= Rings; ++ring)
+        {
+            const float v = static_cast<float>(ring) / static_cast<float>(Rings);
+            const float theta = v * glm::pi<float>();
+            const bool pole = ring == 0 || ring == Rings;
+            float seam_radius = 1.0f;
+            for (uint32_t segment = 0; segment <= Segments; ++segment)
+            {
+                const float u = static_cast<float>(segment) / static_cast<float>(Segments);
+                const float phi = u * glm::two_pi<float>();
+                // Poles and the seam reuse their radius so the surface stays closed
+                float radius = pole ? 1.0f : noise(Random);
+                if (segment == 0)
+                    seam_radius = radius;
+                else if (segment == Segments)
+                    radius = seam_radius;
+
+                const glm::vec3 position(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi));
+                Vertices.push_back({position * radius, color, {u, v}});
+            }
+        }
+
+        for (uint32_t ring = 0; ring < Rings; ++ring)
+        {
+            for (uint32_t segment = 0; segment < Segments; ++segment)
+            {
+                const auto current = static_cast<VertexIndex>(ring * (Segments + 1) + segment);
+                const auto next = static_cast<VertexIndex>(current + Segments + 1);
+
+                Indices.insert(Indices.end(), {current, next, static_cast<VertexIndex>(current + 1)});
+                Indices.insert(Indices.end(),
+                               {static_cast<VertexIndex>(current + 1), next, static_cast<VertexIndex>(next + 1)});
+            }
+        }
+    }
+}  // namespace Slipper::Bench
@@ -0,0 +1,47 @@
+#pragma once
+
+namespace Slipper::GPU
+{
+    class RenderingStage;
+}
+
+namespace Slipper::Bench
+{
+    struct BenchSceneSettings
+    {
+        uint32_t entities = 1000;
+        uint32_t models = 16;
+        uint32_t materials = 8;
+        uint32_t seed = 1337;
+        // Point lights placed inside the scene volume, any lights switch the materials to the "Lit" shader
+        uint32_t lights = 0;
+        bool lit = false;
+    };
+
+    struct BenchSceneInfo
+    {
+        uint64_t vertices = 0;
+        uint64_t indices = 0;
+        // Edge length of the cube the entities are placed in
+        float extent = 0.0f;
+    };
+
+    /* Procedurally fills the registry with renderers so that runs with equal settings always produce the same
+     * scene. Models are distorted spheres of different tesselation, all materials share the "Basic" shader or the
+     * clustered "Lit" shader if the scene is lit. */
+    class BenchScene
+    {
+     public:
+        static BenchSceneInfo Generate(const BenchSceneSettings &Settings, NonOwningPtr<GPU::RenderingStage> Stage);
+
+        // Scatters lights over the volume of a generated scene, destroy the returned entities to remove them again
+        static std::vector<Entity> GenerateLights(uint32_t Count, uint32_t Seed, float Extent);
+
+     private:
+        static void GenerateSphere(std::mt19937 &Random,
+                                   uint32_t Rings,
+                                   uint32_t Segments,
+                                   std::vector<GPU::Vulkan::Vertex> &Vertices,
+                                   std::vector<VertexIndex> &Indices);
+    };
+}  // namespace Slipper::Bench
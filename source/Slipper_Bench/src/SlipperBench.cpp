@@ -0,0 +1,244 @@
+#include "SlipperBench.h"
+
+#include "GraphicsEngine.h"
+#include "Vulkan/vk_DescriptorAllocator.h"
+#include "Vulkan/vk_Device.h"
+#include "Vulkan/vk_GpuProfiler.h"
+#include "Vulkan/vk_RenderingStage.h"
+
+int main(int argc, char *argv[])
+{
+    /* The engine logs to std::cout, which is redirected to stderr for the whole process so that stdout only ever
+     * receives the report. That includes logs of destructors that run after the report was written. */
+    std::ostream report_stream(std::cout.rdbuf(std::cerr.rdbuf()));
+    try
+    {
+        auto settings = Slipper::Bench::BenchSettings::Parse(argc, argv);
+        Slipper::ApplicationInfo app_info{"Slipper Bench"};
+        app_info.Headless = true;
+        const OwningPtr<Slipper::Bench::SlipperBench> app = new Slipper::Bench::SlipperBench(settings);
+        app->Init(app_info);
+        app->Run();
+        app->Shutdown();
+
+        const std::string json = app->GetReport().ToJson();
+        if (settings.output.empty())
+        {
+            report_stream << json << std::flush;
+        }
+        else
+        {
+            std::ofstream file(settings.output);
+            if (!file.is_open())
+            {
+                std::cerr << "Failed to open '" << settings.output.string() << "' for the bench report\n";
+                return EXIT_FAILURE;
+            }
+            file << json;
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+namespace Slipper::Bench
+{
+    BenchSettings BenchSettings::Parse(const int Argc, char *Argv[])
+    {
+        BenchSettings settings;
+        for (int i = 1; i < Argc; ++i)
+        {
+            const std::string_view argument = Argv[i];
+            if (i + 1 >= Argc)
+            {
+                throw std::invalid_argument(std::format("Missing value for bench argument '{}'", argument));
+            }
+
+            const std::string_view value = Argv[++i];
+            const auto to_uint = [&]
+            {
+                uint32_t result = 0;
+                if (const auto [ptr, error] = std::from_chars(value.data(), value.data() + value.size(), result);
+                    error != std::errc() || ptr != value.data() + value.size())
+                {
+                    throw std::invalid_argument(std::format("Invalid value '{}' for bench argument '{}'", value, argument));
+                }
+                return result;
+            };
+
+            if (argument == "--entities")
+                settings.scene.entities = to_uint();
+            else if (argument == "--models")
+                settings.scene.models = to_uint();
+            else if (argument == "--materials")
+                settings.scene.materials = to_uint();
+            else if (argument == "--seed")
+                settings.scene.seed = to_uint();
+            else if (argument == "--lights")
+                settings.scene.lights = to_uint();
+            else if (argument == "--light-sweep")
+            {
+                // Comma separated light counts, e.g. "1,10,100,1000,10000"
+                settings.lightSweep.clear();
+                for (const auto count : std::views::split(value, ','))
+                {
+                    const std::string_view count_value(count.begin(), count.end());
+                    uint32_t lights = 0;
+                    if (const auto [ptr, error] =
+                            std::from_chars(count_value.data(), count_value.data() + count_value.size(), lights);
+                        error != std::errc() || ptr != count_value.data() + count_value.size())
+                    {
+                        throw std::invalid_argument(
+                            std::format("Invalid light count '{}' for bench argument '{}'", count_value, argument));
+                    }
+                    settings.lightSweep.push_back(lights);
+                }
+            }
+            else if (argument == "--import-obj")
+                settings.meshImport.source = value;
+            else if (argument == "--import-triangles")
+                settings.meshImport.triangles = to_uint();
+            else if (argument == "--import-runs")
+                settings.meshImport.runs = to_uint();
+            else if (argument == "--warmup")
+                settings.warmupFrames = to_uint();
+            else if (argument == "--frames")
+                settings.frames = to_uint();
+            else if (argument == "--output")
+                settings.output = value;
+            else
+                throw std::invalid_argument(std::format("Unknown bench argument '{}'", argument));
+        }
+        settings.scene.lit = settings.scene.lights > 0 || !settings.lightSweep.empty();
+        return settings;
+    }
+
+    void SlipperBench::Init(ApplicationInfo &ApplicationInfo)
+    {
+        Application::Init(ApplicationInfo);
+
+        if (m_settings.meshImport.IsEnabled())
+        {
+            m_report.meshImport = BenchMeshImport::Run(m_settings.meshImport);
+        }
+
+        m_report.scene = m_settings.scene;
+        m_report.sceneInfo = BenchScene::Generate(m_settings.scene, GPU::GraphicsEngine::Get().viewportRenderingStage);
+        m_lights = BenchScene::GenerateLights(m_settings.scene.lights, m_settings.scene.seed, m_report.sceneInfo.extent);
+        m_report.warmupFrames = m_settings.warmupFrames;
+        m_report.frames = m_settings.frames;
+        m_report.deviceName = GPU::Vulkan::VKDevice::Get().deviceProperties.deviceName.data();
+    }
+
+    void SlipperBench::Run()
+    {
+        const auto viewport_stage =
+            GPU::GraphicsEngine::Get().viewportRenderingStage.TryCast<GPU::Vulkan::VKRenderingStage>();
+
+        RunFrames(m_settings.warmupFrames, m_settings.frames);
+
+        m_report.cpuFrameTimes = FrameTimeStats::Compute(m_cpuFrameTimes);
+        m_report.gpuFrameTimes = FrameTimeStats::Compute(m_gpuFrameTimes);
+        m_report.lightCullingTimes = FrameTimeStats::Compute(m_lightCullingTimes);
+
+        // The scene is static so every frame records the same commands
+        const auto &command_stats = viewport_stage->GetCommandStats();
+        m_report.draws = command_stats.draws;
+        m_report.pipelineBinds = command_stats.pipelineBinds.issued;
+        m_report.descriptorSetBinds = command_stats.descriptorSetBinds.issued;
+        m_report.elidedBinds = command_stats.Total().elided;
+        m_report.descriptorSets = GPU::Vulkan::DescriptorAllocator::Get().GetStats();
+        m_report.descriptorPools = GPU::Vulkan::DescriptorAllocator::Get().GetPoolCount();
+
+        m_report.startup = GetStartupStats();
+        m_report.peakProcessMemory = get_peak_process_memory();
+        for (const auto &heap : GPU::Vulkan::VKDevice::Get().GetMemoryHeapUsage())
+        {
+            if (heap.deviceLocal)
+            {
+                m_report.deviceLocalMemoryUsage += heap.usage;
+            }
+        }
+
+        // Only the lights change between the steps, so the difference in gpu time is the cost of the lights
+        for (const uint32_t light_count : m_settings.lightSweep)
+        {
+            for (auto &light : m_lights)
+            {
+                light.Destroy();
+            }
+            m_lights = BenchScene::GenerateLights(light_count, m_settings.scene.seed, m_report.sceneInfo.extent);
+
+            RunFrames(m_settings.warmupFrames, m_settings.frames);
+            m_report.lightSweep.push_back({light_count,
+                                           FrameTimeStats::Compute(m_cpuFrameTimes),
+                                           FrameTimeStats::Compute(m_gpuFrameTimes),
+                                           FrameTimeStats::Compute(m_lightCullingTimes)});
+        }
+    }
+
+    void SlipperBench::RunFrames(const uint32_t WarmupFrames, const uint32_t Frames)
+    {
+        m_cpuFrameTimes.clear();
+        m_gpuFrameTimes.clear();
+        m_lightCullingTimes.clear();
+        m_cpuFrameTimes.reserve(Frames);
+        m_gpuFrameTimes.reserve(Frames);
+        m_firstMeasuredFrame = Engine::FRAME_COUNT + WarmupFrames;
+
+        for (uint32_t frame = 0; frame < WarmupFrames + Frames && running; ++frame)
+        {
+            if (frame == WarmupFrames)
+            {
+                GPU::Vulkan::DescriptorAllocator::Get().ResetStats();
+            }
+
+            const auto frame_begin = std::chrono::steady_clock::now();
+            RunFrame();
+            const std::chrono::duration<double, std::milli> frame_time = std::chrono::steady_clock::now() - frame_begin;
+
+            if (frame >= WarmupFrames)
+            {
+                m_cpuFrameTimes.push_back(frame_time.count());
+            }
+            CollectGpuTimings();
+        }
+
+        // Results of the frames still in flight can only be read back once they are finished
+        vkDeviceWaitIdle(GPU::Vulkan::VKDevice::Get());
+        if (GPU::Vulkan::GpuProfiler::IsAvailable())
+        {
+            GPU::Vulkan::GpuProfiler::Get().CollectInFlight();
+            CollectGpuTimings();
+        }
+    }
+
+    void SlipperBench::CollectGpuTimings()
+    {
+        if (!GPU::Vulkan::GpuProfiler::IsAvailable())
+            return;
+
+        // Results arrive MAX_FRAMES_IN_FLIGHT frames late and several at once after CollectInFlight, only take each
+        // frame once
+        for (const auto &timings : GPU::Vulkan::GpuProfiler::Get().GetHistory())
+        {
+            if (timings.frame < m_firstMeasuredFrame || timings.frame <= m_lastGpuFrame)
+                continue;
+
+            m_lastGpuFrame = timings.frame;
+            m_gpuFrameTimes.push_back(timings.DurationMs());
+
+            if (const auto culling =
+                    std::ranges::find(timings.scopes, "Light Culling", &GPU::Vulkan::GpuTimingScope::name);
+                culling != timings.scopes.end())
+            {
+                m_lightCullingTimes.push_back(culling->DurationMs());
+            }
+        }
+    }
+}  // namespace Slipper::Bench
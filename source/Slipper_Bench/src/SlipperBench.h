@@ -0,0 +1,55 @@
+#pragma once
+#include "BenchMeshImport.h"
+#include "BenchReport.h"
+#include "Core/Application.h"
+
+namespace Slipper::Bench
+{
+    struct BenchSettings
+    {
+        BenchSceneSettings scene;
+        uint32_t warmupFrames = 60;
+        uint32_t frames = 600;
+        // Light counts measured one after another once the main run is done, each with its own warmup
+        std::vector<uint32_t> lightSweep;
+        // Measured once during init if a source or triangle count is given
+        MeshImportSettings meshImport;
+        // Report is written to stdout if empty
+        std::filesystem::path output;
+
+        static BenchSettings Parse(int Argc, char *Argv[]);
+    };
+
+    /* Renders a generated scene into the offscreen viewport stage for a fixed number of frames and collects
+     * timings and command counts of every frame after the warmup. */
+    class SlipperBench : public Application
+    {
+     public:
+        explicit SlipperBench(BenchSettings Settings) : m_settings(std::move(Settings))
+        {
+        }
+
+        void Init(ApplicationInfo &ApplicationInfo) override;
+        void Run() override;
+
+        [[nodiscard]] const BenchReport &GetReport() const
+        {
+            return m_report;
+        }
+
+     private:
+        void RunFrames(uint32_t WarmupFrames, uint32_t Frames);
+        void CollectGpuTimings();
+
+     private:
+        BenchSettings m_settings;
+        BenchReport m_report;
+
+        std::vector<double> m_cpuFrameTimes;
+        std::vector<double> m_gpuFrameTimes;
+        std::vector<double> m_lightCullingTimes;
+        std::vector<Entity> m_lights;
+        uint64_t m_firstMeasuredFrame = 0;
+        uint64_t m_lastGpuFrame = 0;
+    };
+}  // namespace Slipper::Bench
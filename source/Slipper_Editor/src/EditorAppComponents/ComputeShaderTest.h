@@ -1,4 +1,5 @@
 #pragma once
+#include "AssetCache.h"
 #include "EditorAppComponent.h"
 #include "Vulkan/vk_DeviceDependentObject.h"
 
@@ -38,6 +39,6 @@ namespace Slipper::Editor
         uint32_t m_particleCount = 1024;
         VkDeviceSize m_bufferSize;
         std::vector<OwningPtr<Buffer>> m_storageBuffers;
-        NonOwningPtr<ComputeShader> m_computeShader;
+        AssetHandle<ComputeShader> m_computeShader;
     };
 }  // namespace Slipper::Editor
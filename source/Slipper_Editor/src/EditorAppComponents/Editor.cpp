@@ -1,10 +1,13 @@
 #include "Editor.h"
 
+#include "AssetCacheWindow.h"
 #include "CameraComponent.h"
 #include "Core/AppComponents/Gui.h"
 #include "Core/Application.h"
+#include "CpuProfilerWindow.h"
 #include "EditorCameraSystem.h"
 #include "EntityOutliner.h"
+#include "GpuProfilerWindow.h"
 #include "Input.h"
 #include "SceneOutliner.h"
 #include "TransformComponent.h"
@@ -56,6 +59,10 @@ namespace Slipper::Editor
         {
             EntityOutliner::DrawEntity(SceneOutliner::GetSelectedEntity());
         }
+
+        CpuProfilerWindow::Draw();
+        GpuProfilerWindow::Draw();
+        AssetCacheWindow::Draw();
     }
 
     void Editor::OnViewportResize(NonOwningPtr<GPU::RenderingStage> Stage, uint32_t Width, uint32_t Height)
@@ -0,0 +1,70 @@
+#include "AssetCacheWindow.h"
+
+#include "AssetCache.h"
+
+namespace Slipper::Editor
+{
+constexpr double MIB = 1024.0 * 1024.0;
+
+void AssetCacheWindow::Draw()
+{
+    static bool open = true;
+    ImGui::Begin("Asset Cache", &open);
+
+    auto &settings = AssetCache::settings;
+    auto budget_mib = static_cast<int>(settings.budgetBytes >> 20);
+    if (ImGui::DragInt("Budget MiB", &budget_mib, 1.0f, 1, 65536)) {
+        settings.budgetBytes = static_cast<uint64_t>(budget_mib) << 20;
+    }
+
+    // Resident memory above the budget with nothing unreferenced left means the assets in use alone exceed it
+    const AssetCacheStats stats = AssetCache::GetStats();
+    ImGui::Text("%u referenced, %u unreferenced (%.1f MiB)",
+                stats.referencedAssets,
+                stats.unreferencedAssets,
+                static_cast<double>(stats.unreferencedBytes) / MIB);
+    ImGui::Text("%.1f of %.1f MiB resident, %.1f MiB cpu, %.1f MiB gpu",
+                static_cast<double>(stats.resident.Total()) / MIB,
+                static_cast<double>(settings.budgetBytes) / MIB,
+                static_cast<double>(stats.resident.cpuBytes) / MIB,
+                static_cast<double>(stats.resident.gpuBytes) / MIB);
+    ImGui::Text("%llu evicted (%.2f MiB), %llu reused before eviction",
+                static_cast<unsigned long long>(stats.evictions),
+                static_cast<double>(stats.evictedBytes) / MIB,
+                static_cast<unsigned long long>(stats.reuses));
+
+    DrawUnreferencedAssets();
+    ImGui::End();
+}
+
+void AssetCacheWindow::DrawUnreferencedAssets()
+{
+    if (!ImGui::CollapsingHeader("Unreferenced Assets")) {
+        return;
+    }
+
+    // Listed in eviction order, the first row goes next
+    const auto assets = AssetCache::GetUnreferencedAssets();
+    if (!ImGui::BeginTable("UnreferencedAssets", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV)) {
+        return;
+    }
+    ImGui::TableSetupColumn("Asset");
+    ImGui::TableSetupColumn("Type", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+    ImGui::TableSetupColumn("MiB", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+    ImGui::TableSetupColumn("Released", ImGuiTableColumnFlags_WidthFixed, 80.0f);
+    ImGui::TableHeadersRow();
+
+    for (const auto &asset : assets) {
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::TextUnformatted(asset.name.c_str());
+        ImGui::TableNextColumn();
+        ImGui::TextUnformatted(magic_enum::enum_name(asset.type).data());
+        ImGui::TableNextColumn();
+        ImGui::Text("%.2f", static_cast<double>(asset.memory.Total()) / MIB);
+        ImGui::TableNextColumn();
+        ImGui::Text("%llu", static_cast<unsigned long long>(asset.releaseFrame));
+    }
+    ImGui::EndTable();
+}
+}  // namespace Slipper::Editor
@@ -0,0 +1,13 @@
+#pragma once
+
+namespace Slipper::Editor
+{
+class AssetCacheWindow
+{
+ public:
+    static void Draw();
+
+ private:
+    static void DrawUnreferencedAssets();
+};
+}  // namespace Slipper::Editor
@@ -0,0 +1,104 @@
+#include "CpuProfilerWindow.h"
+
+namespace Slipper::Editor
+{
+void CpuProfilerWindow::Draw()
+{
+    static bool open = true;
+    ImGui::Begin("CPU Profiler", &open);
+
+#ifdef SLIPPER_PROFILING_ENABLED
+    DrawFrames();
+#else
+    ImGui::TextUnformatted("Profiling zones are compiled out of shipping builds.");
+#endif
+
+    ImGui::End();
+}
+
+void CpuProfilerWindow::DrawFrames()
+{
+    ImGui::Checkbox("Pause", &Profiler::paused);
+    ImGui::SameLine();
+    if (ImGui::Button("Export Chrome Trace")) {
+        Profiler::ExportChromeTrace("cpu_profile.json");
+    }
+
+    const ProfileFrame *latest = Profiler::GetLatestFrame();
+    if (!latest) {
+        ImGui::TextUnformatted("Waiting for the first frame...");
+        return;
+    }
+
+    const auto &frames = Profiler::GetFrames();
+    std::vector<float> frame_times;
+    frame_times.reserve(frames.size());
+    for (const auto &frame : frames) {
+        frame_times.push_back(static_cast<float>(frame.DurationMs()));
+    }
+    ImGui::Text("Frame %llu: %.3f ms, %zu zones",
+                static_cast<unsigned long long>(latest->frame),
+                latest->DurationMs(),
+                latest->zones.size());
+    ImGui::PlotLines("##CpuFrameTimes",
+                     frame_times.data(),
+                     static_cast<int>(frame_times.size()),
+                     0,
+                     "CPU ms",
+                     0.0f,
+                     FLT_MAX,
+                     ImVec2(ImGui::GetContentRegionAvail().x, 60.0f));
+
+    DrawFlameGraph(*latest);
+}
+
+void CpuProfilerWindow::DrawFlameGraph(const ProfileFrame &Frame)
+{
+    if (Frame.endNs <= Frame.beginNs) {
+        return;
+    }
+
+    constexpr float row_height = 20.0f;
+    const float width = ImGui::GetContentRegionAvail().x;
+    const auto thread_names = Profiler::GetThreadNames();
+    const auto ns_to_x = [&](const ImVec2 Origin, const uint64_t Ns) {
+        return Origin.x + static_cast<float>(static_cast<double>(Ns - Frame.beginNs) /
+                                             static_cast<double>(Frame.endNs - Frame.beginNs)) *
+                              width;
+    };
+
+    // Zones are ordered by thread, every thread gets its own block of rows with one row per depth
+    size_t zone_index = 0;
+    while (zone_index < Frame.zones.size()) {
+        const uint32_t thread = Frame.zones[zone_index].thread;
+        ImGui::TextUnformatted(thread < thread_names.size() ? thread_names[thread].c_str() : "Unknown");
+
+        const ImVec2 origin = ImGui::GetCursorScreenPos();
+        ImDrawList *draw_list = ImGui::GetWindowDrawList();
+        uint32_t max_depth = 0;
+        for (; zone_index < Frame.zones.size() && Frame.zones[zone_index].thread == thread; ++zone_index) {
+            const ProfileZone &zone = Frame.zones[zone_index];
+            max_depth = std::max(max_depth, zone.depth);
+
+            const ImVec2 min(ns_to_x(origin, zone.beginNs), origin.y + zone.depth * row_height);
+            const ImVec2 max(std::max(ns_to_x(origin, std::min(zone.endNs, Frame.endNs)), min.x + 1.0f),
+                             min.y + row_height - 2.0f);
+
+            const ImU32 color = ImColor::HSV(
+                static_cast<float>(std::hash<std::string_view>{}(zone.name) % 360) / 360.0f, 0.5f, 0.7f);
+            draw_list->AddRectFilled(min, max, color, 2.0f);
+            draw_list->PushClipRect(min, max, true);
+            draw_list->AddText(ImVec2(min.x + 3.0f, min.y + 2.0f),
+                               IM_COL32_WHITE,
+                               std::format("{} {:.3f}ms", zone.name, zone.DurationMs()).c_str());
+            draw_list->PopClipRect();
+
+            if (ImGui::IsMouseHoveringRect(min, max)) {
+                ImGui::SetTooltip("%s\n%.3f ms", zone.name, zone.DurationMs());
+            }
+        }
+
+        ImGui::Dummy(ImVec2(width, static_cast<float>(max_depth + 1) * row_height));
+    }
+}
+}  // namespace Slipper::Editor
@@ -0,0 +1,14 @@
+#pragma once
+
+namespace Slipper::Editor
+{
+class CpuProfilerWindow
+{
+ public:
+    static void Draw();
+
+ private:
+    static void DrawFrames();
+    static void DrawFlameGraph(const ProfileFrame &Frame);
+};
+}  // namespace Slipper::Editor
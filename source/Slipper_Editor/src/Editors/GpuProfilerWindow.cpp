@@ -0,0 +1,298 @@
+#include "GpuProfilerWindow.h"
+
+#include "DynamicResolution.h"
+#include "GraphicsEngine.h"
+#include "Vulkan/vk_ClusteredLighting.h"
+#include "Vulkan/vk_GpuProfiler.h"
+#include "Vulkan/vk_RenderingStage.h"
+#include "Vulkan/vk_ShadowAtlas.h"
+#include "Vulkan/vk_TextureStreamer.h"
+
+namespace Slipper::Editor
+{
+using GPU::Vulkan::GpuFrameTimings;
+using GPU::Vulkan::GpuProfiler;
+using GPU::Vulkan::GpuTimingScope;
+using GPU::Vulkan::INVALID_GPU_SCOPE;
+
+void GpuProfilerWindow::Draw()
+{
+    static bool open = true;
+    ImGui::Begin("GPU Profiler", &open);
+
+    if (!GpuProfiler::IsAvailable()) {
+        ImGui::TextUnformatted("Timestamp queries are not supported on this device.");
+        ImGui::End();
+        return;
+    }
+
+    auto &profiler = GpuProfiler::Get();
+    ImGui::Checkbox("Pause", &profiler.paused);
+    ImGui::SameLine();
+    if (ImGui::Button("Export Chrome Trace")) {
+        profiler.ExportChromeTrace("gpu_profile.json");
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Export CSV")) {
+        profiler.ExportCsv("gpu_profile.csv");
+    }
+
+    const GpuFrameTimings *latest = profiler.GetLatestTimings();
+    if (!latest) {
+        ImGui::TextUnformatted("Waiting for results...");
+        ImGui::End();
+        return;
+    }
+
+    const auto &history = profiler.GetHistory();
+    std::vector<float> frame_times;
+    frame_times.reserve(history.size());
+    for (const auto &frame : history) {
+        frame_times.push_back(static_cast<float>(frame.DurationMs()));
+    }
+    ImGui::Text("Frame %llu: %.3f ms", static_cast<unsigned long long>(latest->frame), latest->DurationMs());
+    ImGui::PlotLines("##GpuFrameTimes",
+                     frame_times.data(),
+                     static_cast<int>(frame_times.size()),
+                     0,
+                     "GPU ms",
+                     0.0f,
+                     FLT_MAX,
+                     ImVec2(ImGui::GetContentRegionAvail().x, 60.0f));
+
+    DrawDynamicResolution();
+    DrawDepthPrePass();
+    DrawClusteredLighting();
+    DrawShadowAtlas();
+    DrawTextureStreaming();
+    DrawTimeline();
+    DrawScopeTree();
+
+    ImGui::End();
+}
+
+void GpuProfilerWindow::DrawDynamicResolution()
+{
+    if (!GPU::DynamicResolution::IsAvailable() || !ImGui::CollapsingHeader("Dynamic Resolution")) {
+        return;
+    }
+
+    auto &dynamic_resolution = GPU::DynamicResolution::Get();
+    auto &settings = dynamic_resolution.settings;
+    ImGui::Checkbox("Enabled", &settings.enabled);
+
+    auto target_ms = static_cast<float>(settings.targetFrameMs);
+    if (ImGui::DragFloat("Target ms", &target_ms, 0.1f, 1.0f, 100.0f, "%.2f")) {
+        settings.targetFrameMs = target_ms;
+    }
+    ImGui::DragFloatRange2("Scale Range", &settings.minScale, &settings.maxScale, 0.01f, 0.1f, 1.0f, "%.2f");
+    ImGui::Checkbox("Adjust MSAA", &settings.adjustSampleCount);
+
+    ImGui::Text("Scale %.2f, MSAA %ux (max %ux), smoothed %.3f ms",
+                dynamic_resolution.GetScale(),
+                static_cast<uint32_t>(dynamic_resolution.GetSampleCount()),
+                static_cast<uint32_t>(dynamic_resolution.GetMaxSampleCount()),
+                dynamic_resolution.GetSmoothedFrameMs());
+}
+
+void GpuProfilerWindow::DrawDepthPrePass()
+{
+    if (!ImGui::CollapsingHeader("Depth Pre-Pass")) {
+        return;
+    }
+
+    const auto stage = GPU::GraphicsEngine::Get().viewportRenderingStage.TryCast<GPU::Vulkan::VKRenderingStage>();
+    bool enabled = stage->IsDepthPrePassEnabled();
+    if (ImGui::Checkbox("Viewport Depth Pre-Pass", &enabled)) {
+        stage->SetDepthPrePass(enabled);
+    }
+
+    // Compare against the "Depth Pre-Pass" scope below to see whether the saved shading pays for the extra pass
+    const auto &overdraw = stage->GetOverdrawStats();
+    if (overdraw.pixels == 0) {
+        ImGui::TextUnformatted("No overdraw statistics, they need pipeline statistics queries.");
+        return;
+    }
+    ImGui::Text("Overdraw %.2fx (%llu fragments for %llu pixels)",
+                overdraw.Overdraw(),
+                static_cast<unsigned long long>(overdraw.fragmentInvocations),
+                static_cast<unsigned long long>(overdraw.pixels));
+}
+
+void GpuProfilerWindow::DrawClusteredLighting()
+{
+    if (!GPU::Vulkan::ClusteredLighting::IsAvailable() || !ImGui::CollapsingHeader("Clustered Lighting")) {
+        return;
+    }
+
+    // The cull dispatch itself shows up as the "Light Culling" scope below
+    const auto &stats = GPU::Vulkan::ClusteredLighting::Get().GetStats();
+    ImGui::Text("%u lights submitted, %u uploaded, %u views",
+                stats.submittedLights,
+                stats.uploadedLights,
+                stats.views);
+    ImGui::Text("%ux%ux%u clusters, at most %u lights each",
+                GPU::Vulkan::CLUSTER_GRID_X,
+                GPU::Vulkan::CLUSTER_GRID_Y,
+                GPU::Vulkan::CLUSTER_GRID_Z,
+                GPU::Vulkan::MAX_LIGHTS_PER_CLUSTER);
+}
+
+void GpuProfilerWindow::DrawShadowAtlas()
+{
+    if (!GPU::Vulkan::ShadowAtlas::IsAvailable() || !ImGui::CollapsingHeader("Shadow Atlas")) {
+        return;
+    }
+
+    // Static faces should stay at 0 while nothing static moves, the work shows up as the "Shadow Atlas" scope
+    const auto &stats = GPU::Vulkan::ShadowAtlas::Get().GetStats();
+    constexpr auto atlas_texels = static_cast<double>(GPU::Vulkan::SHADOW_ATLAS_SIZE) *
+        GPU::Vulkan::SHADOW_ATLAS_SIZE;
+    ImGui::Text("%u shadowed lights, %u dropped, %.1f%% of the atlas used",
+                stats.shadowedLights,
+                stats.droppedLights,
+                static_cast<double>(stats.usedTexels) / atlas_texels * 100.0);
+    ImGui::Text("%u static and %u dynamic casters", stats.staticCasters, stats.dynamicCasters);
+    ImGui::Text("Faces: %u static rendered, %u copied, %u dynamic rendered",
+                stats.staticFaces,
+                stats.copiedFaces,
+                stats.dynamicFaces);
+}
+
+void GpuProfilerWindow::DrawTextureStreaming()
+{
+    if (!GPU::Vulkan::TextureStreamer::IsAvailable() || !ImGui::CollapsingHeader("Texture Streaming")) {
+        return;
+    }
+
+    auto &streamer = GPU::Vulkan::TextureStreamer::Get();
+    auto &settings = streamer.settings;
+    constexpr double mib = 1024.0 * 1024.0;
+
+    auto budget_mib = static_cast<int>(settings.budgetBytes >> 20);
+    if (ImGui::DragInt("Budget MiB", &budget_mib, 1.0f, 1, 8192)) {
+        settings.budgetBytes = static_cast<uint64_t>(budget_mib) << 20;
+    }
+    ImGui::DragFloat("Mip Bias", &settings.mipBias, 0.05f, -2.0f, 4.0f, "%.2f");
+
+    // Denied mips that stay above 0 mean the budget is too small for the current view
+    const auto &stats = streamer.GetStats();
+    ImGui::Text("%u textures, %.1f of %.1f MiB resident",
+                stats.streamedTextures,
+                static_cast<double>(stats.residentBytes) / mib,
+                static_cast<double>(settings.budgetBytes) / mib);
+    ImGui::Text("Mips: %u uploaded (%.2f MiB), %u evicted, %u pending, %u denied",
+                stats.uploadedMips,
+                static_cast<double>(stats.uploadedBytes) / mib,
+                stats.evictedMips,
+                stats.pendingMips,
+                stats.deniedMips);
+}
+
+void GpuProfilerWindow::DrawTimeline()
+{
+    const GpuFrameTimings &timings = *GpuProfiler::Get().GetLatestTimings();
+    if (timings.DurationMs() <= 0.0) {
+        return;
+    }
+
+    // Scopes go into the first row below their parent that is free at their start, so graphics and
+    // compute work that overlaps in time gets its own rows
+    std::vector<uint32_t> rows(timings.scopes.size(), 0);
+    std::vector<double> row_ends;
+    for (uint32_t i = 0; i < timings.scopes.size(); ++i) {
+        const GpuTimingScope &scope = timings.scopes[i];
+        uint32_t row = scope.parent == INVALID_GPU_SCOPE ? 0 : rows[scope.parent] + 1;
+        while (row < row_ends.size() && row_ends[row] > scope.beginMs) {
+            ++row;
+        }
+        if (row >= row_ends.size()) {
+            row_ends.resize(row + 1, 0.0);
+        }
+        row_ends[row] = scope.endMs;
+        rows[i] = row;
+    }
+
+    constexpr float row_height = 20.0f;
+    const ImVec2 origin = ImGui::GetCursorScreenPos();
+    const float width = ImGui::GetContentRegionAvail().x;
+    const auto ms_to_x = [&](const double Ms) {
+        return origin.x + static_cast<float>(Ms / timings.DurationMs()) * width;
+    };
+
+    ImDrawList *draw_list = ImGui::GetWindowDrawList();
+    for (uint32_t i = 0; i < timings.scopes.size(); ++i) {
+        const GpuTimingScope &scope = timings.scopes[i];
+        const ImVec2 min(ms_to_x(scope.beginMs), origin.y + rows[i] * row_height);
+        const ImVec2 max(std::max(ms_to_x(scope.endMs), min.x + 1.0f), min.y + row_height - 2.0f);
+
+        const ImU32 color = ImColor::HSV(static_cast<float>(std::hash<std::string>{}(scope.name) % 360) / 360.0f,
+                                         0.5f,
+                                         0.7f);
+        draw_list->AddRectFilled(min, max, color, 2.0f);
+        draw_list->PushClipRect(min, max, true);
+        draw_list->AddText(ImVec2(min.x + 3.0f, min.y + 2.0f),
+                           IM_COL32_WHITE,
+                           std::format("{} {:.3f}ms", scope.name, scope.DurationMs()).c_str());
+        draw_list->PopClipRect();
+
+        if (ImGui::IsMouseHoveringRect(min, max)) {
+            ImGui::SetTooltip("%s\n%.3f ms (%.3f - %.3f)",
+                              scope.name.c_str(),
+                              scope.DurationMs(),
+                              scope.beginMs,
+                              scope.endMs);
+        }
+    }
+
+    ImGui::Dummy(ImVec2(width, static_cast<float>(row_ends.size()) * row_height));
+}
+
+void GpuProfilerWindow::DrawScopeTree()
+{
+    const GpuFrameTimings &timings = *GpuProfiler::Get().GetLatestTimings();
+
+    std::vector<std::vector<uint32_t>> children(timings.scopes.size());
+    std::vector<uint32_t> roots;
+    for (uint32_t i = 0; i < timings.scopes.size(); ++i) {
+        const uint32_t parent = timings.scopes[i].parent;
+        (parent == INVALID_GPU_SCOPE ? roots : children[parent]).push_back(i);
+    }
+
+    if (!ImGui::BeginTable("GpuScopes", 2, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV)) {
+        return;
+    }
+    ImGui::TableSetupColumn("Scope");
+    ImGui::TableSetupColumn("ms", ImGuiTableColumnFlags_WidthFixed, 80.0f);
+    ImGui::TableHeadersRow();
+
+    std::function<void(uint32_t)> draw_scope = [&](const uint32_t Index) {
+        const GpuTimingScope &scope = timings.scopes[Index];
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+
+        ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_DefaultOpen | ImGuiTreeNodeFlags_SpanFullWidth;
+        if (children[Index].empty()) {
+            flags |= ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_NoTreePushOnOpen;
+        }
+        const bool open = ImGui::TreeNodeEx(reinterpret_cast<void *>(static_cast<uintptr_t>(Index)),
+                                            flags,
+                                            "%s",
+                                            scope.name.c_str());
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", scope.DurationMs());
+
+        if (open && !children[Index].empty()) {
+            for (const uint32_t child : children[Index]) {
+                draw_scope(child);
+            }
+            ImGui::TreePop();
+        }
+    };
+
+    for (const uint32_t root : roots) {
+        draw_scope(root);
+    }
+    ImGui::EndTable();
+}
+}  // namespace Slipper::Editor
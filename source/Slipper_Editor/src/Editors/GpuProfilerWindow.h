@@ -0,0 +1,19 @@
+#pragma once
+
+namespace Slipper::Editor
+{
+class GpuProfilerWindow
+{
+ public:
+    static void Draw();
+
+ private:
+    static void DrawDynamicResolution();
+    static void DrawDepthPrePass();
+    static void DrawClusteredLighting();
+    static void DrawShadowAtlas();
+    static void DrawTextureStreaming();
+    static void DrawTimeline();
+    static void DrawScopeTree();
+};
+}  // namespace Slipper::Editor
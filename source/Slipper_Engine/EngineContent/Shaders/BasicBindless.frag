@@ -0,0 +1,14 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+
+#include "Include/Bindless.glsl"
+#include "Include/DrawPushConstants.glsl"
+
+layout(location = 0) in vec3 fragColor;
+layout(location = 1) in vec2 fragTexCoord;
+
+layout(location = 0) out vec4 outColor;
+
+void main() {
+    outColor = SampleBindless(draw.textureIndex, fragTexCoord);
+}
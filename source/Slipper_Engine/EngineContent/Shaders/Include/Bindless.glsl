@@ -0,0 +1,16 @@
+// Global bindless descriptor heap, see GPU/Vulkan/vk_BindlessHeap.h
+// Must match BINDLESS_DESCRIPTOR_SET, BINDLESS_TEXTURE_BINDING and BINDLESS_BUFFER_BINDING
+#extension GL_EXT_nonuniform_qualifier : require
+
+#define BINDLESS_SET 2
+
+layout(set = BINDLESS_SET, binding = 0) uniform sampler2D bindlessTextures[];
+
+layout(set = BINDLESS_SET, binding = 1) readonly buffer BindlessBuffer {
+    uint data[];
+} bindlessBuffers[];
+
+vec4 SampleBindless(uint TextureIndex, vec2 TexCoord)
+{
+    return texture(bindlessTextures[nonuniformEXT(TextureIndex)], TexCoord);
+}
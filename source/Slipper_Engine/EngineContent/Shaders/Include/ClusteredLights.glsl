@@ -0,0 +1,72 @@
+// Lights binned into a froxel grid per view, see GPU/Vulkan/vk_ClusteredLighting.h
+// Requires Bindless.glsl, DrawPushConstants.glsl and Shadows.glsl to be included first
+// Must match the header layout and LIGHT_HEADER_WORDS in vk_ClusteredLighting.h
+#define LIGHT_HEADER_WORDS 20
+#define LIGHT_WORDS 8
+#define INVALID_LIGHT_BUFFER 0xFFFFFFFFu
+
+uint LightHeaderUint(uint Offset)
+{
+    return bindlessBuffers[nonuniformEXT(draw.lightBuffer)].data[Offset];
+}
+
+float LightHeaderFloat(uint Offset)
+{
+    return uintBitsToFloat(LightHeaderUint(Offset));
+}
+
+vec4 LightVec4(uint Light, uint Offset)
+{
+    const uint base = LIGHT_HEADER_WORDS + Light * LIGHT_WORDS + Offset;
+    return uintBitsToFloat(uvec4(LightHeaderUint(base),
+                                 LightHeaderUint(base + 1),
+                                 LightHeaderUint(base + 2),
+                                 LightHeaderUint(base + 3)));
+}
+
+// Smoothly reaches zero at the lights range so clipping it to the clusters does not show
+float LightFalloff(float Distance, float Range)
+{
+    const float ratio = Distance / Range;
+    const float window = clamp(1.0 - ratio * ratio * ratio * ratio, 0.0, 1.0);
+    return window * window / (Distance * Distance + 1.0);
+}
+
+// Sums the diffuse light of all lights of the fragments cluster, positions and normals are in view space.
+// The world space position is only needed to look up the shadows of the lights.
+vec3 ClusteredDiffuseLight(vec3 ViewPosition, vec3 ViewNormal, vec3 WorldPosition)
+{
+    const uint cluster_buffer = LightHeaderUint(0);
+    const uvec3 grid = uvec3(LightHeaderUint(2), LightHeaderUint(3), LightHeaderUint(4));
+    const vec2 tile_size = vec2(LightHeaderFloat(5), LightHeaderFloat(6));
+    const float slice_scale = LightHeaderFloat(9);
+    const float slice_bias = LightHeaderFloat(10);
+    const uint cluster_stride = LightHeaderUint(13) + 1;
+    const uint shadow_buffer = LightHeaderUint(16);
+
+    const uvec2 tile = min(uvec2(gl_FragCoord.xy / tile_size), grid.xy - 1);
+    const float depth = max(-ViewPosition.z, 1e-4);
+    const uint slice = uint(clamp(log(depth) * slice_scale - slice_bias, 0.0, float(grid.z - 1)));
+    const uint cluster = tile.x + tile.y * grid.x + slice * grid.x * grid.y;
+
+    const uint cluster_offset = cluster * cluster_stride;
+    const uint light_count = bindlessBuffers[nonuniformEXT(cluster_buffer)].data[cluster_offset];
+
+    vec3 diffuse = vec3(0.0);
+    for (uint i = 0; i < light_count; ++i)
+    {
+        const uint light = bindlessBuffers[nonuniformEXT(cluster_buffer)].data[cluster_offset + 1 + i];
+        const vec4 position_range = LightVec4(light, 0);
+        const vec4 color = LightVec4(light, 4);
+
+        const vec3 to_light = position_range.xyz - ViewPosition;
+        const float distance = length(to_light);
+        const float n_dot_l = max(dot(ViewNormal, to_light / max(distance, 1e-4)), 0.0);
+        if (n_dot_l == 0.0)
+            continue;
+
+        const float shadow = PointShadow(shadow_buffer, floatBitsToUint(color.w), WorldPosition);
+        diffuse += color.rgb * n_dot_l * LightFalloff(distance, position_range.w) * shadow;
+    }
+    return diffuse;
+}
@@ -0,0 +1,8 @@
+// Per draw data pushed by the renderer, must match DrawPushConstants in GPU/Vulkan/vk_Shader.h
+layout(push_constant) uniform DrawPushConstants {
+    mat4 model;
+    uint textureIndex;
+    uint materialBuffer;
+    uint materialBlock;
+    uint lightBuffer;
+} draw;
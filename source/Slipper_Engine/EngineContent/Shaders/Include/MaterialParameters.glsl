@@ -0,0 +1,23 @@
+// Access to the constants of the drawn material, see GPU/Vulkan/vk_MaterialParameterBuffer.h
+// Requires Bindless.glsl and DrawPushConstants.glsl to be included first
+// Must match MATERIAL_PARAMETER_BLOCK_SIZE
+#define MATERIAL_PARAMETER_BLOCK_WORDS 64
+
+// Offset is measured in 4 byte words from the start of the materials block
+uint MaterialParameterUint(uint Offset)
+{
+    return bindlessBuffers[nonuniformEXT(draw.materialBuffer)].data[draw.materialBlock * MATERIAL_PARAMETER_BLOCK_WORDS + Offset];
+}
+
+float MaterialParameterFloat(uint Offset)
+{
+    return uintBitsToFloat(MaterialParameterUint(Offset));
+}
+
+vec4 MaterialParameterVec4(uint Offset)
+{
+    return vec4(MaterialParameterFloat(Offset),
+                MaterialParameterFloat(Offset + 1),
+                MaterialParameterFloat(Offset + 2),
+                MaterialParameterFloat(Offset + 3));
+}
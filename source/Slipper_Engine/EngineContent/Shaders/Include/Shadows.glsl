@@ -0,0 +1,74 @@
+// Point light shadows from the shadow atlas, see GPU/Vulkan/vk_ShadowAtlas.h
+// Requires Bindless.glsl to be included first
+// Must match SHADOW_HEADER_WORDS and the GpuShadow layout in vk_ShadowAtlas.h
+#define SHADOW_HEADER_WORDS 4
+#define SHADOW_FACE_WORDS 20
+#define SHADOW_WORDS (4 + 6 * SHADOW_FACE_WORDS)
+#define INVALID_SHADOW 0xFFFFFFFFu
+#define INVALID_SHADOW_BUFFER 0xFFFFFFFFu
+// Fraction of the distance to the light the receiver is moved towards it, the 16 bit depth needs a generous one
+#define SHADOW_BIAS 0.02
+
+uint ShadowUint(uint ShadowBuffer, uint Offset)
+{
+    return bindlessBuffers[nonuniformEXT(ShadowBuffer)].data[Offset];
+}
+
+vec4 ShadowVec4(uint ShadowBuffer, uint Offset)
+{
+    return uintBitsToFloat(uvec4(ShadowUint(ShadowBuffer, Offset),
+                                 ShadowUint(ShadowBuffer, Offset + 1),
+                                 ShadowUint(ShadowBuffer, Offset + 2),
+                                 ShadowUint(ShadowBuffer, Offset + 3)));
+}
+
+// 1 where the light reaches the world space position, filtered over the 4 closest texels
+float PointShadow(uint ShadowBuffer, uint Shadow, vec3 WorldPosition)
+{
+    if (ShadowBuffer == INVALID_SHADOW_BUFFER || Shadow == INVALID_SHADOW)
+        return 1.0;
+
+    const uint base = SHADOW_HEADER_WORDS + Shadow * SHADOW_WORDS;
+    const vec4 position_range = ShadowVec4(ShadowBuffer, base);
+    if (position_range.w == 0.0)
+        return 1.0;
+
+    // Every cube face covers the directions whose major axis it faces
+    const vec3 direction = WorldPosition - position_range.xyz;
+    const vec3 axis = abs(direction);
+    uint face;
+    if (axis.x >= axis.y && axis.x >= axis.z)
+        face = direction.x > 0.0 ? 0 : 1;
+    else if (axis.y >= axis.z)
+        face = direction.y > 0.0 ? 2 : 3;
+    else
+        face = direction.z > 0.0 ? 4 : 5;
+
+    const uint face_base = base + 4 + face * SHADOW_FACE_WORDS;
+    const mat4 view_projection = mat4(ShadowVec4(ShadowBuffer, face_base),
+                                      ShadowVec4(ShadowBuffer, face_base + 4),
+                                      ShadowVec4(ShadowBuffer, face_base + 8),
+                                      ShadowVec4(ShadowBuffer, face_base + 12));
+    const vec4 uv_rect = ShadowVec4(ShadowBuffer, face_base + 16);
+
+    const vec4 clip = view_projection * vec4(WorldPosition - direction * SHADOW_BIAS, 1.0);
+    const vec3 ndc = clip.xyz / clip.w;
+
+    const uint atlas = ShadowUint(ShadowBuffer, 0);
+    const float atlas_size = 1.0 / uintBitsToFloat(ShadowUint(ShadowBuffer, 1));
+    const vec2 tile_min = uv_rect.xy * atlas_size;
+    const vec2 tile_max = tile_min + uv_rect.zw * atlas_size - 1.0;
+
+    // The depth is compared per texel, filtering the stored depths would blur the edges they form
+    const vec2 texel = tile_min + (ndc.xy * 0.5 + 0.5) * uv_rect.zw * atlas_size - 0.5;
+    const vec2 base_texel = floor(texel);
+    const vec2 weight = texel - base_texel;
+    vec4 lit;
+    for (int i = 0; i < 4; ++i)
+    {
+        const vec2 coord = clamp(base_texel + vec2(i & 1, i >> 1), tile_min, tile_max);
+        const float depth = texelFetch(bindlessTextures[nonuniformEXT(atlas)], ivec2(coord), 0).r;
+        lit[i] = ndc.z <= depth ? 1.0 : 0.0;
+    }
+    return mix(mix(lit.x, lit.y, weight.x), mix(lit.z, lit.w, weight.x), weight.y);
+}
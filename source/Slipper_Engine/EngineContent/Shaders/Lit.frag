@@ -0,0 +1,30 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+
+#include "Include/Bindless.glsl"
+#include "Include/DrawPushConstants.glsl"
+#include "Include/Shadows.glsl"
+#include "Include/ClusteredLights.glsl"
+
+layout(location = 0) in vec3 fragColor;
+layout(location = 1) in vec2 fragTexCoord;
+layout(location = 2) in vec3 fragViewPosition;
+layout(location = 3) in vec3 fragWorldPosition;
+
+layout(location = 0) out vec4 outColor;
+
+const vec3 AMBIENT_LIGHT = vec3(0.05);
+
+void main() {
+    const vec4 albedo = SampleBindless(draw.textureIndex, fragTexCoord);
+    if (draw.lightBuffer == INVALID_LIGHT_BUFFER)
+    {
+        outColor = albedo;
+        return;
+    }
+
+    // The vertex format has no normals, so the faces are shaded flat
+    const vec3 normal = normalize(cross(dFdy(fragViewPosition), dFdx(fragViewPosition)));
+    const vec3 light = AMBIENT_LIGHT + ClusteredDiffuseLight(fragViewPosition, normal, fragWorldPosition);
+    outColor = vec4(albedo.rgb * light, albedo.a);
+}
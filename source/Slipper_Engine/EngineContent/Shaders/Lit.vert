@@ -0,0 +1,28 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+
+#include "Include/DrawPushConstants.glsl"
+
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec3 inColor;
+layout(location = 2) in vec2 inTexCoord;
+
+layout(set = 0, binding = 0) uniform VP {
+    mat4 view;
+    mat4 proj;
+} vp;
+
+layout(location = 0) out vec3 fragColor;
+layout(location = 1) out vec2 fragTexCoord;
+layout(location = 2) out vec3 fragViewPosition;
+layout(location = 3) out vec3 fragWorldPosition;
+
+void main() {
+    const vec4 world_position = draw.model * vec4(inPosition, 1.0);
+    const vec4 view_position = vp.view * world_position;
+    gl_Position = vp.proj * view_position;
+    fragColor = inColor;
+    fragTexCoord = inTexCoord;
+    fragViewPosition = view_position.xyz;
+    fragWorldPosition = world_position.xyz;
+}
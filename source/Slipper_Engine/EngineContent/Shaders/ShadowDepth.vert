@@ -0,0 +1,15 @@
+#version 450
+
+// Renders casters into a cube face tile of the shadow atlas, see GPU/Vulkan/vk_ShadowAtlas.h
+
+layout(location = 0) in vec3 inPosition;
+
+// Must match ShadowPushConstants in GPU/Vulkan/internal/vk_ShadowAtlas.cpp
+layout(push_constant) uniform ShadowPushConstants {
+    mat4 model;
+    mat4 lightViewProjection;
+} shadow;
+
+void main() {
+    gl_Position = shadow.lightViewProjection * shadow.model * vec4(inPosition, 1.0);
+}
@@ -10,6 +10,8 @@ concept IsAppComponent = std::is_base_of_v<AppComponent, T>;
 
 class AppComponent
 {
+    friend class Application;
+
  public:
     AppComponent(std::string_view Name);
     virtual ~AppComponent() = default;
@@ -24,7 +26,16 @@ class AppComponent
         return m_name;
     };
 
+    // Interned when the component is added to the Application, so its update zones take no lock every frame
+    const char *GetZoneName() const
+    {
+        return m_zoneName;
+    }
+
  protected:
     std::string m_name;
+
+ private:
+    const char *m_zoneName = "AppComponent";
 };
 }  // namespace Slipper
\ No newline at end of file
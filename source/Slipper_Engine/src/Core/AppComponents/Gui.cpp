@@ -1,7 +1,6 @@
 #include "Gui.h"
 
 #include "GraphicsEngine.h"
-#include "GraphicsSettings.h"
 #include "Core/Application.h"
 #include "Window.h"
 #include "Vulkan/vk_CommandPool.h"
@@ -72,7 +71,7 @@ namespace Slipper
         info.DescriptorPool = m_resources->imGuiDescriptorPool;
         info.MinImageCount = GPU::Vulkan::MAX_FRAMES_IN_FLIGHT;
         info.ImageCount = GPU::Vulkan::MAX_FRAMES_IN_FLIGHT;
-        info.MSAASamples = static_cast<VkSampleCountFlagBits>(GPU::GraphicsSettings::MSAA_SAMPLES);
+        info.MSAASamples = static_cast<VkSampleCountFlagBits>(m_renderPass->sampleCount);
 
         ImGui_ImplVulkan_Init(&info, m_renderPass->vkRenderPass);
 
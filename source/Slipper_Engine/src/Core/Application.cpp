@@ -3,11 +3,17 @@
 #include "AppComponent.h"
 #include "AppComponents/Ecs.h"
 #include "AppEvents.h"
+#include "AssetTask.h"
 #include "Event.h"
 #include "GraphicsSettings.h"
+#include "InitGraph.h"
 #include "Input.h"
 #include "MaterialManager.h"
+#include "PackFile.h"
+#include "Path.h"
+#include "ThreadPool.h"
 #include "Time/Time.h"
+#include "VirtualFileSystem.h"
 #include "Window.h"
 #include "Vulkan/vk_Instance.h"
 
@@ -20,45 +26,109 @@ Application::Application()
 
 void Application::Init(ApplicationInfo &ApplicationInfo)
 {
+    initStart = std::chrono::steady_clock::now();
     name = ApplicationInfo.Name;
+    headless = ApplicationInfo.Headless;
 
-    glfwInit();
-    vulkanInstance = new GPU::Vulkan::VulkanInstance();
+    // Builds that packed their content read it from the pack, loose files next to it still win during development
+    const std::string content_pack = std::format("./EngineContent{}", PACK_FILE_EXTENSION);
+    if (std::filesystem::exists(Path::make_engine_relative_path_absolute(content_pack))) {
+        VirtualFileSystem::Mount(content_pack, "./EngineContent");
+    }
+
+    // The init graph runs its worker tasks on the pool
+    ThreadPool::Init();
+    AssetScheduler::Init();
+
+    /* Creating the instance loads the drivers and layers, one of the slowest steps of the startup. It needs nothing
+     * but glfw, so it runs on a worker while the window is created. */
+    InitGraph graph(initStart);
+    VkExtent2D viewport_resolution{ApplicationInfo.Width, ApplicationInfo.Height};
+    InitTaskId device;
+    if (headless) {
+        const InitTaskId instance = graph.Add("VulkanInstance", InitThread::Worker, [this] {
+            vulkanInstance = new GPU::Vulkan::VulkanInstance(true);
+        });
+        device = graph.Add("Device", InitThread::Main, [] {
+            GPU::Vulkan::VKDevice::PickPhysicalDevice(nullptr, true);
+        }, {instance});
+    }
+    else {
+        const InitTaskId glfw = graph.Add("Glfw", InitThread::Main, [] {
+            glfwInit();
+            // Loads the vulkan loader of glfw here, so the instance task only reads the extensions it needs
+            glfwVulkanSupported();
+        });
+        const InitTaskId instance = graph.Add("VulkanInstance", InitThread::Worker, [this] {
+            vulkanInstance = new GPU::Vulkan::VulkanInstance();
+        }, {glfw});
 
-    WindowInfo window_create_info;
-    window_create_info.width = 1280;
-    window_create_info.height = 720;
-    window_create_info.name = name;
-    window_create_info.resizable = true;
-    window = new Window(window_create_info);
-    window->SetEventCallback(std::bind(&Application::OnEvent, this, std::placeholders::_1));
+        const auto create_window = [this, &ApplicationInfo, &viewport_resolution] {
+            WindowInfo window_create_info;
+            window_create_info.width = ApplicationInfo.Width;
+            window_create_info.height = ApplicationInfo.Height;
+            window_create_info.name = name;
+            window_create_info.resizable = true;
+            window_create_info.visible = ApplicationInfo.ShowWindow;
+            window = new Window(window_create_info);
+            window->SetEventCallback(std::bind(&Application::OnEvent, this, std::placeholders::_1));
+            viewport_resolution = window->GetSize();
+        };
+        const InitTaskId window_task = graph.Add("Window", InitThread::Main, create_window, {glfw});
 
-    GPU::Vulkan::VKDevice::PickPhysicalDevice(&window->GetContext(), true);
-    GPU::GraphicsSettings::MSAA_SAMPLES = static_cast<GPU::SampleCount>(GPU::Vulkan::VKDevice::Get().GetMaxUsableFramebufferSampleCount());
+        device = graph.Add("Device", InitThread::Main, [this] {
+            GPU::Vulkan::VKDevice::PickPhysicalDevice(&window->GetContext(), true);
+        }, {instance, window_task});
+    }
 
     // Setup Application Components
-    ecsComponent = AddComponent(new Ecs());
-    AddComponentBefore(new InputManager(), ecsComponent);
-    materialManager = AddComponent(new MaterialManager());
+    const InitTaskId components = graph.Add("AppComponents", InitThread::Main, [this] {
+        GPU::GraphicsSettings::MSAA_SAMPLES = static_cast<GPU::SampleCount>(
+            GPU::Vulkan::VKDevice::Get().GetMaxUsableFramebufferSampleCount());
 
-    GraphicsEngine::Init();
-    GraphicsEngine::Get().AddWindow(*window);
+        ecsComponent = AddComponent(new Ecs());
+        AddComponentBefore(new InputManager(), ecsComponent);
+        materialManager = AddComponent(new MaterialManager());
+    }, {device});
+
+    const InitTaskId graphics_engine = GraphicsEngine::Init(graph, components, viewport_resolution);
+    if (!headless) {
+        graph.Add("WindowSwapChain", InitThread::Main, [this] {
+            GraphicsEngine::Get().AddWindow(*window);
+        }, {graphics_engine});
+    }
+
+    graph.Run();
+    startupStats.tasks = graph.GetTimings();
 
     AddAdditionalRenderStageUpdate(GraphicsEngine::Get().viewportRenderingStage,
                                    [&](NonOwningPtr<RenderingStage> RS) {
-                                       for (const auto &app_component : appComponentsOrdered) {
-                                           app_component->OnGuiRender();
+                                       {
+                                           PROFILE_ZONE("AppComponent::OnGuiRender");
+                                           for (const auto &app_component : appComponentsOrdered) {
+                                               PROFILE_ZONE(app_component->GetZoneName());
+                                               app_component->OnGuiRender();
+                                           }
                                        }
 
+                                       PROFILE_ZONE("AppComponent::OnUpdate");
                                        for (const auto &app_component : appComponentsOrdered) {
+                                           PROFILE_ZONE(app_component->GetZoneName());
                                            app_component->OnUpdate();
                                        }
                                    });
+
+    startupStats.initMs = GetMillisecondsSinceInit();
+    LOG_FORMAT("Application::Init took {:.2f} ms", startupStats.initMs)
 }
 
 void Application::Shutdown()
 {
+    // Loads that are still running need the workers and may upload, so they finish first
+    AssetScheduler::Shutdown();
     vkDeviceWaitIdle(VKDevice::Get());
+    // Workers may still hand decoded assets to the managers, so they stop before anything is torn down
+    ThreadPool::Shutdown();
 
     for (const auto &app_component : appComponents) {
         app_component->Shutdown();
@@ -69,7 +139,10 @@ void Application::Shutdown()
     GraphicsEngine::Shutdown();
     window.reset();
     VKDevice::Destroy();
-    glfwTerminate();
+    if (!headless) {
+        glfwTerminate();
+    }
+    VirtualFileSystem::UnmountAll();
 }
 
 void Application::Close()
@@ -86,54 +159,96 @@ void Application::CloseWindow(const Window *Window)
 
 void Application::Run()
 {
+    Profiler::SetThreadName("Main");
     while (running) {
-        Input::UpdateInputs();
-        window->OnUpdate();
-        if (!running)
-            return;
+        RunFrame();
+    }
+}
+
+void Application::Run(const uint64_t FrameCount)
+{
+    Run([FrameCount](const uint64_t Frame) { return Frame < FrameCount; });
+}
+
+void Application::Run(const std::function<bool(uint64_t)> &Tick)
+{
+    Profiler::SetThreadName("Main");
+    for (uint64_t frame = 0; running && Tick(frame); ++frame) {
+        RunFrame();
+    }
+}
 
-        if (windowResize.resized) {
-            // Do whatever you have to do
+void Application::RunFrame()
+{
+    PROFILE_FRAME(Engine::FRAME_COUNT);
+    PROFILE_ZONE("Application::Run");
+
+    {
+        PROFILE_ZONE("Poll Events");
+        Input::UpdateInputs();
+        if (window) {
+            window->OnUpdate();
         }
-        for (auto &[Stage, Info] : viewportsResize) {
-            if (Info.resized) {
-                ViewportResize(Stage);
-            }
+    }
+    if (!running)
+        return;
+
+    if (windowResize.resized) {
+        // Do whatever you have to do
+    }
+    for (auto &[Stage, Info] : viewportsResize) {
+        if (Info.resized) {
+            ViewportResize(Stage);
         }
+    }
 
-        if (!minimized) {
-            Time::Tick(Engine::FRAME_COUNT);
-            if (!(Engine::FRAME_COUNT % DELTA_SMOOTH_FRAMES)) {
-                std::stringstream ss;
-                ss << name << " " << std::setw(10) << 1.0f / Time::DeltaTimeSmooth() << "fps  "
-                   << std::setw(2) << Time::DeltaTimeSmooth() * 1000 << ' ' << std::setw(2) << "ms"
-                   << std::flush;
-                window->SetTitle(ss.str());
-            }
+    if (minimized)
+        return;
 
-            // Render loop
-            GraphicsEngine::Get().NewFrame();
-
-            // All render stages will be rendered here
-            //  That includes the viewport and the window render stage
-            //  The Update events are executed via the function added to the viewport stage in
-            //  Init()
-            for (auto &rendering_stage :
-                 GraphicsEngine::Get().renderingStages | std::ranges::views::values) {
-                GraphicsEngine::Get().BeginRenderingStage(rendering_stage->name);
-                for (auto &stage_update : renderingStagesUpdates[rendering_stage]) {
-                    stage_update(rendering_stage.get());
-                }
-                GraphicsEngine::Get().EndRenderingStage();
-            }
+    Time::Tick(Engine::FRAME_COUNT);
+    if (window && !(Engine::FRAME_COUNT % DELTA_SMOOTH_FRAMES)) {
+        std::stringstream ss;
+        ss << name << " " << std::setw(10) << 1.0f / Time::DeltaTimeSmooth() << "fps  "
+           << std::setw(2) << Time::DeltaTimeSmooth() * 1000 << ' ' << std::setw(2) << "ms"
+           << std::flush;
+        window->SetTitle(ss.str());
+    }
 
-            GraphicsEngine::Get().EndFrame();
+    // Render loop
+    {
+        PROFILE_ZONE("GraphicsEngine::NewFrame");
+        GraphicsEngine::Get().NewFrame();
+    }
 
-            Engine::FRAME_COUNT += 1;
+    // All render stages will be rendered here
+    //  That includes the viewport and the window render stage
+    //  The Update events are executed via the function added to the viewport stage in
+    //  Init()
+    for (auto &rendering_stage :
+         GraphicsEngine::Get().renderingStages | std::ranges::views::values) {
+        PROFILE_ZONE_DYNAMIC(rendering_stage->name);
+        GraphicsEngine::Get().BeginRenderingStage(rendering_stage->name);
+        for (auto &stage_update : renderingStagesUpdates[rendering_stage]) {
+            stage_update(rendering_stage.get());
         }
+        GraphicsEngine::Get().EndRenderingStage();
+    }
+
+    GraphicsEngine::Get().EndFrame();
+
+    Engine::FRAME_COUNT += 1;
+    if (!startupStats.firstFrameMs) {
+        startupStats.firstFrameMs = GetMillisecondsSinceInit();
+        LOG_FORMAT("First frame was recorded {:.2f} ms after the start of Application::Init",
+                   startupStats.firstFrameMs.value())
     }
 }
 
+double Application::GetMillisecondsSinceInit() const
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - initStart).count();
+}
+
 void Application::OnEvent(Event &Event)
 {
     // std::cout << Event.ToString() << '\n';
@@ -1,5 +1,6 @@
 #pragma once
 #include "AppComponent.h"
+#include "InitGraph.h"
 
 int main(int argc, char *argv[]);
 
@@ -23,6 +24,25 @@ namespace Slipper
     struct ApplicationInfo
     {
         std::string Name = "Slipper Engine";
+        // Hidden windows still get a swap chain, useful for automated runs that only read back offscreen stages
+        bool ShowWindow = true;
+        // Runs without glfw, a window or a surface. Only offscreen rendering stages exist and the frame loop has
+        // to be driven through Run(FrameCount) or Run(Tick).
+        bool Headless = false;
+        // Size of the window, or of the viewport when headless
+        uint32_t Width = 1280;
+        uint32_t Height = 720;
+    };
+
+    // Where the startup time went, SlipperBench reports it to catch regressions
+    struct StartupStats
+    {
+        // Tasks of the init graph in the order they finished, timed from the start of Application::Init
+        std::vector<InitTaskTiming> tasks;
+        // Application::Init without the setup derived applications do after it
+        double initMs = 0.0;
+        // From the start of Application::Init to the end of the first frame, empty until that frame was rendered
+        std::optional<double> firstFrameMs;
     };
 
     struct ResizeInfo
@@ -46,6 +66,7 @@ namespace Slipper
             requires IsAppComponent<T>
         NonOwningPtr<T> AddComponent(NonOwningPtr<T> ProgramComponent)
         {
+            ProgramComponent->m_zoneName = Profiler::InternName(ProgramComponent->GetName());
             ProgramComponent->Init();
             appComponentsOrdered.emplace_back(ProgramComponent);
             return static_cast<T *>(appComponents.emplace_back(ProgramComponent).get());
@@ -55,6 +76,7 @@ namespace Slipper
             requires IsAppComponent<T>
         NonOwningPtr<T> AddComponent(T *ProgramComponent)
         {
+            ProgramComponent->m_zoneName = Profiler::InternName(ProgramComponent->GetName());
             ProgramComponent->Init();
             appComponentsOrdered.emplace_back(ProgramComponent);
             return static_cast<T *>(appComponents.emplace_back(ProgramComponent).get());
@@ -71,6 +93,7 @@ namespace Slipper
                 appComponentsOrdered.emplace(execute_before_itr, ProgramComponent);
             }
 
+            ProgramComponent->m_zoneName = Profiler::InternName(ProgramComponent->GetName());
             ProgramComponent->Init();
             return static_cast<T *>(appComponents.emplace_back(ProgramComponent).get());
         }
@@ -86,6 +109,7 @@ namespace Slipper
                 appComponentsOrdered.emplace(execute_after_itr, ProgramComponent);
             }
 
+            ProgramComponent->m_zoneName = Profiler::InternName(ProgramComponent->GetName());
             ProgramComponent->Init();
             return static_cast<T *>(appComponents.emplace_back(ProgramComponent).get());
         }
@@ -105,6 +129,22 @@ namespace Slipper
         }
 
         virtual void Run();
+        // Renders FrameCount frames or until the application is closed
+        void Run(uint64_t FrameCount);
+        // Renders frames as long as Tick returns true, it is called with the index of the frame about to be rendered
+        void Run(const std::function<bool(uint64_t)> &Tick);
+        // Polls events and renders a single frame, Run calls this until the application is closed
+        void RunFrame();
+
+        [[nodiscard]] bool IsHeadless() const
+        {
+            return headless;
+        }
+
+        [[nodiscard]] const StartupStats &GetStartupStats() const
+        {
+            return startupStats;
+        }
         virtual void OnEvent(Event &Event);
         virtual void OnWindowResize(Window *Window, int Width, int Height);
         virtual void OnViewportResize(NonOwningPtr<GPU::RenderingStage> Stage, uint32_t Width, uint32_t Height);
@@ -116,6 +156,7 @@ namespace Slipper
 
      private:
         void ViewportResize(NonOwningPtr<GPU::RenderingStage> Stage);
+        [[nodiscard]] double GetMillisecondsSinceInit() const;
 
      public:
         OwningPtr<Window> window;
@@ -126,6 +167,10 @@ namespace Slipper
         std::string name;
         bool running = true;
         bool minimized = false;
+        bool headless = false;
+
+        std::chrono::steady_clock::time_point initStart;
+        StartupStats startupStats;
 
         ResizeInfo windowResize;
         std::unordered_map<NonOwningPtr<GPU::RenderingStage>, ResizeInfo> viewportsResize;
@@ -4,6 +4,7 @@ namespace Slipper
 {
 void EcsInterface::RunSystems()
 {
+    PROFILE_FUNCTION();
     auto &registry = m_registry;
     for (const auto &ecs_system : m_ecsSystems) {
         if (ecs_system.executeFunction) {
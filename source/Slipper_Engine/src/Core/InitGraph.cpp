@@ -0,0 +1,127 @@
+#include "InitGraph.h"
+
+#include "ThreadPool.h"
+
+namespace Slipper
+{
+InitTaskId InitGraph::Add(std::string Name,
+                          const InitThread Thread,
+                          std::function<void()> Work,
+                          const std::initializer_list<InitTaskId> Dependencies)
+{
+    const auto id = static_cast<InitTaskId>(m_tasks.size());
+    for (const InitTaskId dependency : Dependencies) {
+        ASSERT(dependency < id, "Init task '{}' depends on task {} which was not added before it!", Name, dependency)
+        m_tasks[dependency].dependents.push_back(id);
+    }
+
+    Task &task = m_tasks.emplace_back();
+    task.name = std::move(Name);
+    task.thread = Thread;
+    task.work = std::move(Work);
+    task.remainingDependencies = static_cast<uint32_t>(Dependencies.size());
+    return id;
+}
+
+void InitGraph::Run()
+{
+    PROFILE_ZONE("InitGraph::Run");
+
+    // Ordered so the main thread starts its ready tasks in the order they were added
+    std::set<InitTaskId> ready_on_main;
+    uint32_t running_on_workers = 0;
+    std::exception_ptr error;
+
+    const auto start = [&](const InitTaskId Id) {
+        if (m_tasks[Id].thread == InitThread::Worker && ThreadPool::IsAvailable()) {
+            ++running_on_workers;
+            ThreadPool::Get().Submit([this, Id] { OnWorkerFinished(Id, Execute(m_tasks[Id])); });
+        }
+        else {
+            ready_on_main.insert(Id);
+        }
+    };
+    const auto finish = [&](const InitTaskId Id) {
+        m_timings.push_back(m_tasks[Id].timing);
+        for (const InitTaskId dependent : m_tasks[Id].dependents) {
+            if (--m_tasks[dependent].remainingDependencies == 0 && !error) {
+                start(dependent);
+            }
+        }
+    };
+
+    for (InitTaskId id = 0; id < m_tasks.size(); ++id) {
+        if (m_tasks[id].remainingDependencies == 0) {
+            start(id);
+        }
+    }
+
+    while ((!ready_on_main.empty() && !error) || running_on_workers > 0) {
+        if (!ready_on_main.empty() && !error) {
+            const InitTaskId id = *ready_on_main.begin();
+            ready_on_main.erase(ready_on_main.begin());
+            error = Execute(m_tasks[id]);
+            finish(id);
+        }
+
+        // Only blocks if the main thread has nothing to do until a worker task finishes
+        std::vector<InitTaskId> finished;
+        {
+            std::unique_lock lock(m_mutex);
+            if (running_on_workers > 0 && (ready_on_main.empty() || error)) {
+                m_condition.wait(lock, [this] { return !m_finishedOnWorkers.empty(); });
+            }
+            finished.swap(m_finishedOnWorkers);
+            if (m_workerError && !error) {
+                error = m_workerError;
+            }
+        }
+        for (const InitTaskId id : finished) {
+            --running_on_workers;
+            finish(id);
+        }
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    ASSERT(m_timings.size() == m_tasks.size(), "Init graph finished with tasks that never ran!")
+}
+
+std::exception_ptr InitGraph::Execute(Task &Task) const
+{
+    PROFILE_ZONE_DYNAMIC(Task.name);
+
+    const auto start = std::chrono::steady_clock::now();
+    std::exception_ptr error;
+    try {
+        Task.work();
+    }
+    catch (...) {
+        error = std::current_exception();
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    Task.timing.name = Task.name;
+    Task.timing.thread = Task.thread;
+    Task.timing.startMs = GetMilliseconds(start);
+    Task.timing.durationMs = std::chrono::duration<double, std::milli>(end - start).count();
+    return error;
+}
+
+void InitGraph::OnWorkerFinished(const InitTaskId Id, std::exception_ptr Error)
+{
+    // Notified under the lock, the graph may be gone as soon as Run sees the last task finish
+    std::scoped_lock lock(m_mutex);
+    m_finishedOnWorkers.push_back(Id);
+    if (Error && !m_workerError) {
+        m_workerError = std::move(Error);
+    }
+    m_condition.notify_one();
+}
+
+double InitGraph::GetMilliseconds(const std::chrono::steady_clock::time_point Time) const
+{
+    return std::chrono::duration<double, std::milli>(Time - m_epoch).count();
+}
+}  // namespace Slipper
@@ -0,0 +1,78 @@
+#pragma once
+
+namespace Slipper
+{
+using InitTaskId = uint32_t;
+
+enum class InitThread : uint8_t
+{
+    // Creates vulkan objects, touches glfw or state owned by the main thread
+    Main,
+    // Runs on the ThreadPool, the same rules as for any other task of the pool apply
+    Worker,
+};
+
+struct InitTaskTiming
+{
+    std::string name;
+    InitThread thread;
+    // Milliseconds since the epoch of the graph
+    double startMs = 0.0;
+    double durationMs = 0.0;
+};
+
+/* Startup work split into tasks that only wait for the tasks they depend on. Worker tasks run on the ThreadPool
+ * while the main thread works through its own tasks, which start in the order they were added once their
+ * dependencies are done. A graph that only has main thread tasks therefore runs exactly in that order. */
+class InitGraph
+{
+ public:
+    explicit InitGraph(std::chrono::steady_clock::time_point Epoch = std::chrono::steady_clock::now())
+        : m_epoch(Epoch)
+    {
+    }
+
+    // Dependencies have to be added before the task that depends on them, which keeps the graph free of cycles
+    InitTaskId Add(std::string Name,
+                   InitThread Thread,
+                   std::function<void()> Work,
+                   std::initializer_list<InitTaskId> Dependencies = {});
+
+    /* Runs every task once and returns when all of them are done. Has to be called from the main thread. After a
+     * task throws no further tasks are started, the exception is rethrown once the running worker tasks are done. */
+    void Run();
+
+    // In the order the tasks finished, complete once Run returned
+    [[nodiscard]] const std::vector<InitTaskTiming> &GetTimings() const
+    {
+        return m_timings;
+    }
+
+ private:
+    struct Task
+    {
+        std::string name;
+        InitThread thread;
+        std::function<void()> work;
+        std::vector<InitTaskId> dependents;
+        uint32_t remainingDependencies = 0;
+        InitTaskTiming timing;
+    };
+
+    // Runs the work of the task on the current thread, returns the exception it threw if any
+    std::exception_ptr Execute(Task &Task) const;
+    void OnWorkerFinished(InitTaskId Id, std::exception_ptr Error);
+    [[nodiscard]] double GetMilliseconds(std::chrono::steady_clock::time_point Time) const;
+
+ private:
+    std::chrono::steady_clock::time_point m_epoch;
+    std::vector<Task> m_tasks;
+    std::vector<InitTaskTiming> m_timings;
+
+    // Worker tasks hand their completion to the main thread, which alone updates the dependency counts
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::vector<InitTaskId> m_finishedOnWorkers;
+    std::exception_ptr m_workerError;
+};
+}  // namespace Slipper
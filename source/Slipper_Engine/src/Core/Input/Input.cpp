@@ -29,9 +29,12 @@ void Input::CaptureMouse(bool Capture)
     if (Capture == captureMouseCursor)
         return;
 
-    glfwSetInputMode(Application::Get().window->glfwWindow,
-                     GLFW_CURSOR,
-                     Capture ? GLFW_CURSOR_DISABLED : GLFW_CURSOR_NORMAL);
+    // Headless applications have no cursor to capture but still track the state
+    if (const auto &window = Application::Get().window) {
+        glfwSetInputMode(window->glfwWindow,
+                         GLFW_CURSOR,
+                         Capture ? GLFW_CURSOR_DISABLED : GLFW_CURSOR_NORMAL);
+    }
 
     if (Capture) {
         mouseInput.preCapturePosition = mouseInput.position;
@@ -0,0 +1,165 @@
+#include "Profiler.h"
+
+namespace Slipper
+{
+uint32_t Profiler::BeginZone()
+{
+    return GetThreadBuffer().depth++;
+}
+
+void Profiler::EndZone(const char *Name, const uint64_t BeginNs, const uint32_t Depth)
+{
+    const uint64_t end_ns = NowNs();
+    auto &buffer = GetThreadBuffer();
+    buffer.depth = Depth;
+
+    // Only the owning thread writes. The slot sequence is cleared before and set after the payload, so readers
+    // can tell whether the payload they copied belongs to a single complete zone
+    const uint64_t written = buffer.written.load(std::memory_order_relaxed);
+    ZoneSlot &slot = buffer.zones[written % ThreadBuffer::CAPACITY];
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(Name, std::memory_order_relaxed);
+    slot.beginNs.store(BeginNs, std::memory_order_relaxed);
+    slot.endNs.store(end_ns, std::memory_order_relaxed);
+    slot.depth.store(Depth, std::memory_order_relaxed);
+    slot.sequence.store(written + 1, std::memory_order_release);
+    buffer.written.store(written + 1, std::memory_order_release);
+}
+
+void Profiler::MarkFrame(const uint64_t Frame)
+{
+    const uint64_t now = NowNs();
+    if (!paused && m_frameBeginNs != 0) {
+        ProfileFrame &frame = m_frames.emplace_back();
+        frame.frame = m_currentFrame;
+        frame.beginNs = m_frameBeginNs;
+        frame.endNs = now;
+        CollectZones(frame);
+
+        if (m_frames.size() > FRAME_HISTORY_SIZE) {
+            m_frames.pop_front();
+        }
+    }
+
+    m_currentFrame = Frame;
+    m_frameBeginNs = now;
+}
+
+void Profiler::SetThreadName(const std::string_view Name)
+{
+    // Registering the buffer takes the lock itself on first use
+    auto &buffer = GetThreadBuffer();
+    std::scoped_lock lock(m_threadsMutex);
+    buffer.name = Name;
+}
+
+const char *Profiler::InternName(const std::string_view Name)
+{
+    std::scoped_lock lock(m_namesMutex);
+    return m_names.emplace(Name).first->c_str();
+}
+
+std::vector<std::string> Profiler::GetThreadNames()
+{
+    std::scoped_lock lock(m_threadsMutex);
+    std::vector<std::string> names;
+    names.reserve(m_threads.size());
+    for (const auto &thread : m_threads) {
+        names.push_back(thread->name);
+    }
+    return names;
+}
+
+bool Profiler::ExportChromeTrace(const std::filesystem::path &FilePath)
+{
+    std::ofstream file(FilePath);
+    if (!file.is_open()) {
+        LOG_FORMAT("Failed to open '{}' for the cpu profile export.", FilePath.string())
+        return false;
+    }
+
+    file << "{\"traceEvents\":[";
+    bool first_event = true;
+    const auto thread_names = GetThreadNames();
+    for (uint32_t thread = 0; thread < thread_names.size(); ++thread) {
+        file << (first_event ? "" : ",") << '\n'
+             << std::format(R"({{"name":"thread_name","ph":"M","pid":0,"tid":{},"args":{{"name":"{}"}}}})",
+                            thread,
+                            String::escape_json(thread_names[thread]));
+        first_event = false;
+    }
+
+    for (const auto &frame : m_frames) {
+        for (const auto &zone : frame.zones) {
+            file << (first_event ? "" : ",") << '\n'
+                 << std::format(R"({{"name":"{}","cat":"cpu","ph":"X","pid":0,"tid":{},"ts":{:.3f},"dur":{:.3f},)"
+                                R"("args":{{"frame":{}}}}})",
+                                String::escape_json(zone.name),
+                                zone.thread,
+                                static_cast<double>(zone.beginNs) / 1000.0,
+                                static_cast<double>(zone.endNs - zone.beginNs) / 1000.0,
+                                frame.frame);
+            first_event = false;
+        }
+    }
+    file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    LOG_FORMAT("Exported {} frames of cpu timings to '{}'", m_frames.size(), FilePath.string())
+    return true;
+}
+
+Profiler::ThreadBuffer &Profiler::GetThreadBuffer()
+{
+    thread_local ThreadBuffer *buffer = nullptr;
+    if (!buffer) {
+        // Buffers are never freed so zones of finished threads can still be exported
+        auto new_buffer = std::make_unique<ThreadBuffer>();
+        std::scoped_lock lock(m_threadsMutex);
+        new_buffer->index = static_cast<uint32_t>(m_threads.size());
+        new_buffer->name = new_buffer->index == 0 ? "Main" : std::format("Thread {}", new_buffer->index);
+        buffer = m_threads.emplace_back(std::move(new_buffer)).get();
+    }
+    return *buffer;
+}
+
+void Profiler::CollectZones(ProfileFrame &Frame)
+{
+    std::scoped_lock lock(m_threadsMutex);
+    for (const auto &thread : m_threads) {
+        const size_t thread_begin = Frame.zones.size();
+
+        // Zones are written in the order they end, so walking backwards can stop at the first zone that
+        // ended before the frame started
+        const uint64_t written = thread->written.load(std::memory_order_acquire);
+        const uint64_t oldest = written > ThreadBuffer::CAPACITY ? written - ThreadBuffer::CAPACITY : 0;
+        for (uint64_t i = written; i > oldest; --i) {
+            const ZoneSlot &slot = thread->zones[(i - 1) % ThreadBuffer::CAPACITY];
+            const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+            const ProfileZone zone{slot.name.load(std::memory_order_relaxed),
+                                   slot.beginNs.load(std::memory_order_relaxed),
+                                   slot.endNs.load(std::memory_order_relaxed),
+                                   slot.depth.load(std::memory_order_relaxed),
+                                   thread->index};
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            // The owning thread wrapped around and is reusing this slot, every older one is gone as well
+            if (sequence != i || slot.sequence.load(std::memory_order_relaxed) != i) {
+                break;
+            }
+            if (zone.endNs < Frame.beginNs) {
+                break;
+            }
+            if (zone.beginNs >= Frame.beginNs && zone.beginNs < Frame.endNs) {
+                Frame.zones.push_back(zone);
+            }
+        }
+
+        std::sort(Frame.zones.begin() + static_cast<ptrdiff_t>(thread_begin),
+                  Frame.zones.end(),
+                  [](const ProfileZone &A, const ProfileZone &B) {
+                      return A.beginNs != B.beginNs ? A.beginNs < B.beginNs : A.depth < B.depth;
+                  });
+    }
+}
+}  // namespace Slipper
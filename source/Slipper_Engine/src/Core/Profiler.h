@@ -0,0 +1,160 @@
+#pragma once
+
+// Zones are compiled out of shipping builds, the Profiler itself stays available and simply records nothing
+#ifndef SLIPPER_SHIPPING
+#    define SLIPPER_PROFILING_ENABLED
+#endif
+
+namespace Slipper
+{
+struct ProfileZone
+{
+    // Has to outlive the profiler, use Profiler::InternName for names that are built at runtime
+    const char *name;
+    uint64_t beginNs;
+    uint64_t endNs;
+    uint32_t depth;
+    uint32_t thread;
+
+    [[nodiscard]] double DurationMs() const
+    {
+        return static_cast<double>(endNs - beginNs) / 1'000'000.0;
+    }
+};
+
+struct ProfileFrame
+{
+    uint64_t frame = 0;
+    uint64_t beginNs = 0;
+    uint64_t endNs = 0;
+    // Zones of all threads that started inside the frame, ordered by thread and begin time
+    std::vector<ProfileZone> zones;
+
+    [[nodiscard]] double DurationMs() const
+    {
+        return static_cast<double>(endNs - beginNs) / 1'000'000.0;
+    }
+};
+
+/* Cpu side instrumentation. Every thread writes finished zones into its own fixed size ring buffer without any
+ * locking, the main thread gathers the zones of the last frame in MarkFrame. Timestamps are nanoseconds
+ * since the profiler was first used. */
+class Profiler
+{
+    // Ring entry guarded by a sequence number so the collecting thread can detect entries the owning thread
+    // overwrote while they were being copied
+    struct ZoneSlot
+    {
+        // Number of zones written when this slot was filled, 0 while the owning thread is writing it
+        std::atomic<uint64_t> sequence = 0;
+        std::atomic<const char *> name = nullptr;
+        std::atomic<uint64_t> beginNs = 0;
+        std::atomic<uint64_t> endNs = 0;
+        std::atomic<uint32_t> depth = 0;
+    };
+
+    struct ThreadBuffer
+    {
+        static constexpr uint64_t CAPACITY = 1 << 14;
+
+        std::array<ZoneSlot, CAPACITY> zones;
+        // Total number of zones written, the ring index is written % CAPACITY
+        std::atomic<uint64_t> written = 0;
+        uint32_t depth = 0;
+        uint32_t index = 0;
+        std::string name;
+    };
+
+ public:
+    static constexpr size_t FRAME_HISTORY_SIZE = 240;
+
+    [[nodiscard]] static uint64_t NowNs()
+    {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_epoch).count());
+    }
+
+    // Returns the depth the zone has to be recorded with
+    static uint32_t BeginZone();
+    static void EndZone(const char *Name, uint64_t BeginNs, uint32_t Depth);
+
+    // Closes the current frame and starts the next one, has to be called from the main thread
+    static void MarkFrame(uint64_t Frame);
+
+    static void SetThreadName(std::string_view Name);
+
+    // Returns a pointer that stays valid for the lifetime of the program, equal names return equal pointers
+    [[nodiscard]] static const char *InternName(std::string_view Name);
+
+    [[nodiscard]] static const ProfileFrame *GetLatestFrame()
+    {
+        return m_frames.empty() ? nullptr : &m_frames.back();
+    }
+
+    [[nodiscard]] static const std::deque<ProfileFrame> &GetFrames()
+    {
+        return m_frames;
+    }
+
+    [[nodiscard]] static std::vector<std::string> GetThreadNames();
+
+    // Chrome trace event format of all frames in the history, can be opened in chrome://tracing or Perfetto
+    static bool ExportChromeTrace(const std::filesystem::path &FilePath);
+
+ private:
+    static ThreadBuffer &GetThreadBuffer();
+    static void CollectZones(ProfileFrame &Frame);
+
+ public:
+    // Frames are neither collected nor replaced while paused
+    static inline bool paused = false;
+
+ private:
+    static inline const std::chrono::steady_clock::time_point m_epoch = std::chrono::steady_clock::now();
+
+    static inline std::mutex m_threadsMutex;
+    static inline std::vector<std::unique_ptr<ThreadBuffer>> m_threads;
+
+    static inline std::mutex m_namesMutex;
+    static inline std::unordered_set<std::string> m_names;
+
+    static inline uint64_t m_frameBeginNs = 0;
+    static inline uint64_t m_currentFrame = 0;
+    static inline std::deque<ProfileFrame> m_frames;
+};
+
+class ProfileZoneScope
+{
+ public:
+    explicit ProfileZoneScope(const char *Name) : m_name(Name), m_depth(Profiler::BeginZone()), m_beginNs(Profiler::NowNs())
+    {
+    }
+
+    ~ProfileZoneScope()
+    {
+        Profiler::EndZone(m_name, m_beginNs, m_depth);
+    }
+
+    ProfileZoneScope(const ProfileZoneScope &) = delete;
+    ProfileZoneScope &operator=(const ProfileZoneScope &) = delete;
+
+ private:
+    const char *m_name;
+    uint32_t m_depth;
+    uint64_t m_beginNs;
+};
+}  // namespace Slipper
+
+#ifdef SLIPPER_PROFILING_ENABLED
+#    define PROFILE_ZONE(Name) const ::Slipper::ProfileZoneScope CONCAT(profile_zone_, __LINE__)(Name)
+// For names that are only known at runtime, interning costs a lock so keep these out of tight loops
+#    define PROFILE_ZONE_DYNAMIC(Name) \
+        const ::Slipper::ProfileZoneScope CONCAT(profile_zone_, __LINE__)(::Slipper::Profiler::InternName(Name))
+#    define PROFILE_FUNCTION() PROFILE_ZONE(__FUNCTION__)
+#    define PROFILE_FRAME(Frame) ::Slipper::Profiler::MarkFrame(Frame)
+#else
+#    define PROFILE_ZONE(Name)
+#    define PROFILE_ZONE_DYNAMIC(Name)
+#    define PROFILE_FUNCTION()
+#    define PROFILE_FRAME(Frame)
+#endif
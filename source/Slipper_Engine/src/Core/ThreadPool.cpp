@@ -0,0 +1,69 @@
+#include "ThreadPool.h"
+
+namespace Slipper
+{
+void ThreadPool::Init(const uint32_t ThreadCount)
+{
+    ASSERT(!m_instance, "Thread pool already created!")
+
+    const uint32_t thread_count = ThreadCount > 0 ? ThreadCount :
+                                                    std::max(std::thread::hardware_concurrency(), 2u) - 1;
+    m_instance = new ThreadPool(thread_count);
+}
+
+void ThreadPool::Shutdown()
+{
+    delete m_instance;
+    m_instance = nullptr;
+}
+
+ThreadPool::ThreadPool(const uint32_t ThreadCount)
+{
+    m_workers.reserve(ThreadCount);
+    for (uint32_t index = 0; index < ThreadCount; ++index) {
+        m_workers.emplace_back(&ThreadPool::Work, this, index);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::scoped_lock lock(m_mutex);
+        m_stopping = true;
+        m_tasks.clear();
+    }
+    m_condition.notify_all();
+
+    for (auto &worker : m_workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::Enqueue(std::function<void()> Task)
+{
+    {
+        std::scoped_lock lock(m_mutex);
+        m_tasks.push_back(std::move(Task));
+    }
+    m_condition.notify_one();
+}
+
+void ThreadPool::Work(const uint32_t Index)
+{
+    Profiler::SetThreadName(std::format("Worker {}", Index));
+
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock lock(m_mutex);
+            m_condition.wait(lock, [this] { return m_stopping || !m_tasks.empty(); });
+            if (m_stopping) {
+                return;
+            }
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+        task();
+    }
+}
+}  // namespace Slipper
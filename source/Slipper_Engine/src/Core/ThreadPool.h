@@ -0,0 +1,109 @@
+#pragma once
+
+namespace Slipper
+{
+/* Fixed set of worker threads that run submitted tasks in submission order. Tasks must not record or submit gpu
+ * work or touch other state owned by the main thread, whoever submits them hands the results back. */
+class ThreadPool
+{
+ public:
+    static ThreadPool &Get()
+    {
+        return *m_instance;
+    }
+
+    static bool IsAvailable()
+    {
+        return m_instance != nullptr;
+    }
+
+    // A thread count of 0 uses all hardware threads but one, which is left to the main thread
+    static void Init(uint32_t ThreadCount = 0);
+    // Tasks that did not start yet are dropped, running ones are waited for
+    static void Shutdown();
+
+    // Workers plus the calling thread
+    static uint32_t GetConcurrency()
+    {
+        return IsAvailable() ? Get().GetThreadCount() + 1 : 1;
+    }
+
+    /* Runs Body(Chunk) for every chunk on the workers and the calling thread and returns once all of them are done.
+     * The first exception of a chunk is rethrown after that. Chunks go to whichever thread asks for the next one
+     * first, so the caller never waits for a chunk that is still queued and may be a task itself, e.g. a load. */
+    template<typename F> static void ParallelFor(const uint32_t ChunkCount, F &&Body)
+    {
+        struct Progress
+        {
+            std::atomic<uint32_t> next = 0;
+            std::atomic<uint32_t> finished = 0;
+            std::mutex mutex;
+            std::condition_variable condition;
+            std::exception_ptr error;
+        };
+        const auto progress = std::make_shared<Progress>();
+
+        // Helpers that only start once every chunk was taken return without touching Body, which is gone by then
+        const auto run_chunks = [progress, &Body, ChunkCount] {
+            for (uint32_t chunk = progress->next++; chunk < ChunkCount; chunk = progress->next++) {
+                try {
+                    Body(chunk);
+                }
+                catch (...) {
+                    std::scoped_lock lock(progress->mutex);
+                    if (!progress->error) {
+                        progress->error = std::current_exception();
+                    }
+                }
+                if (++progress->finished == ChunkCount) {
+                    std::scoped_lock lock(progress->mutex);
+                    progress->condition.notify_all();
+                }
+            }
+        };
+        if (IsAvailable() && ChunkCount > 1) {
+            const uint32_t helpers = std::min(ChunkCount - 1, Get().GetThreadCount());
+            for (uint32_t helper = 0; helper < helpers; ++helper) {
+                Get().Enqueue(run_chunks);
+            }
+        }
+        run_chunks();
+
+        std::unique_lock lock(progress->mutex);
+        progress->condition.wait(lock, [&] { return progress->finished == ChunkCount; });
+        if (progress->error) {
+            std::rethrow_exception(progress->error);
+        }
+    }
+
+    template<typename F> std::future<std::invoke_result_t<F>> Submit(F &&Task)
+    {
+        using Result = std::invoke_result_t<F>;
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(Task));
+        std::future<Result> future = task->get_future();
+        Enqueue([task] { (*task)(); });
+        return future;
+    }
+
+    [[nodiscard]] uint32_t GetThreadCount() const
+    {
+        return static_cast<uint32_t>(m_workers.size());
+    }
+
+ private:
+    explicit ThreadPool(uint32_t ThreadCount);
+    ~ThreadPool();
+
+    void Enqueue(std::function<void()> Task);
+    void Work(uint32_t Index);
+
+ private:
+    static inline ThreadPool *m_instance = nullptr;
+
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<std::function<void()>> m_tasks;
+    bool m_stopping = false;
+};
+}  // namespace Slipper
@@ -0,0 +1,27 @@
+#pragma once
+#include "IEcsComponent.h"
+
+namespace Slipper
+{
+// Point light placed at the location of the entities Transform
+struct Light : public IEcsComponent<Light>
+{
+    Light(glm::vec3 Color = glm::vec3(1),
+          float Intensity = 1.0f,
+          float Range = 10.0f,
+          bool CastShadows = false)
+    {
+        color = Color;
+        intensity = Intensity;
+        range = Range;
+        castShadows = CastShadows;
+    }
+
+    glm::vec3 color;
+    float intensity;
+    // Distance at which the light has faded out completely, lights are only binned into clusters within it
+    float range;
+    // Gets tiles in the ShadowAtlas, only entities with a ShadowCaster are rendered into them
+    bool castShadows;
+};
+}  // namespace Slipper
@@ -1,4 +1,5 @@
 #pragma once
+#include "AssetCache.h"
 #include "IEcsComponent.h"
 
 namespace Slipper
@@ -12,7 +13,7 @@ namespace Slipper
 
     struct Renderer : public IEcsComponent<Renderer>
     {
-        Renderer(NonOwningPtr<GPU::RenderingStage> Stage, NonOwningPtr<GPU::Model> Model, NonOwningPtr<GPU::Material> Shader)
+        Renderer(NonOwningPtr<GPU::RenderingStage> Stage, AssetHandle<GPU::Model> Model, NonOwningPtr<GPU::Material> Shader)
         {
             stage = Stage;
             model = Model;
@@ -20,7 +21,8 @@ namespace Slipper
         }
 
         NonOwningPtr<GPU::RenderingStage> stage;
-        NonOwningPtr<GPU::Model> model;
+        // Keeps the model loaded while the entity renders it
+        AssetHandle<GPU::Model> model;
         NonOwningPtr<GPU::Material> material;
     };
 }  // namespace Slipper
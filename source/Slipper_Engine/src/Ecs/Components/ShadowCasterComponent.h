@@ -0,0 +1,24 @@
+#pragma once
+#include "IEcsComponent.h"
+
+namespace Slipper
+{
+// Renders the model of the entities Renderer into the shadows of all lights that reach it
+struct ShadowCaster : public IEcsComponent<ShadowCaster>
+{
+    ShadowCaster(bool Static = true, float BoundingRadius = 1.0f)
+    {
+        isStatic = Static;
+        boundingRadius = BoundingRadius;
+    }
+
+    // Static casters are cached by the ShadowAtlas and only rendered again once their Transform changes
+    bool isStatic;
+    // Radius around the location before scaling, used to find the lights the caster is rendered for
+    float boundingRadius;
+
+    // Transform version and world bounds the cached shadows were rendered with
+    uint64_t seenVersion = std::numeric_limits<uint64_t>::max();
+    glm::vec4 seenBounds = {};
+};
+}  // namespace Slipper
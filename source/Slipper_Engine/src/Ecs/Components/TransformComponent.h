@@ -19,6 +19,7 @@ struct Transform : public IEcsComponent<Transform>
     void SetLocation(glm::vec3 Location)
     {
         m_location = Location;
+        ++m_version;
     }
 
     glm::vec3 GetLocation()
@@ -29,36 +30,43 @@ struct Transform : public IEcsComponent<Transform>
     void Translate(glm::vec3 Translation)
     {
         m_location += Translation;
+        ++m_version;
     }
 
     void LocalTranslate(glm::vec3 Translation)
     {
         m_location += glm::inverse(m_rotation) * Translation;
+        ++m_version;
     }
 
     void Rotate(glm::vec3 Rotation)
     {
         m_rotation = glm::quat(glm::radians(Rotation)) * m_rotation;
+        ++m_version;
     }
 
     void Rotate(float Angle, glm::vec3 Axis)
     {
         m_rotation = glm::rotate(glm::quat({0, 0, 0}), glm::radians(Angle), Axis) * m_rotation;
+        ++m_version;
     }
 
     void RotateLocal(float Angle, glm::vec3 Axis)
     {
         m_rotation = glm::rotate(m_rotation, glm::radians(Angle), glm::inverse(m_rotation) * Axis);
+        ++m_version;
     }
 
     void LocalRotate(glm::vec3 Rotation)
     {
         m_rotation *= glm::quat(glm::radians(Rotation)) * m_rotation;
+        ++m_version;
     }
 
     void SetRotation(glm::vec3 Rotation)
     {
         m_rotation = glm::quat(glm::radians(Rotation));
+        ++m_version;
     }
 
     glm::vec3 GetRotation() const
@@ -69,6 +77,7 @@ struct Transform : public IEcsComponent<Transform>
     template<typename T> void SetScale(T Scale)
     {
         m_scale = Scale;
+        ++m_version;
     }
 
     glm::vec3 GetScale() const
@@ -86,6 +95,7 @@ struct Transform : public IEcsComponent<Transform>
     {
         const auto dir = glm::normalize(Center - GetLocation());
         m_rotation = glm::degrees(glm::eulerAngles(glm::quatLookAt(dir, Up)));
+        ++m_version;
     }
 
     glm::vec3 Forward() const
@@ -103,9 +113,16 @@ struct Transform : public IEcsComponent<Transform>
         return m_rotation * glm::vec3(0, 0, 1);
     }
 
+    // Incremented by every change, systems compare it against the version they last saw to find moved entities
+    uint64_t GetVersion() const
+    {
+        return m_version;
+    }
+
  private:
     glm::vec3 m_location = {0.0f, 0.0f, 0.0f};
     glm::quat m_rotation = glm::quat({0, 0, 0});
     glm::vec3 m_scale = {1.0f, 1.0f, 1.0f};
+    uint64_t m_version = 0;
 };
 }  // namespace Slipper
\ No newline at end of file
@@ -0,0 +1,38 @@
+#include "LightUpdateSystem.h"
+
+#include "CameraComponent.h"
+#include "GraphicsEngine.h"
+#include "LightComponent.h"
+#include "TransformComponent.h"
+#include "Vulkan/vk_ClusteredLighting.h"
+#include "Vulkan/vk_ShadowAtlas.h"
+
+namespace Slipper
+{
+void LightUpdateSystem::Execute(entt::registry &Registry)
+{
+    if (!GPU::Vulkan::ClusteredLighting::IsAvailable())
+        return;
+
+    auto &clustered_lighting = GPU::Vulkan::ClusteredLighting::Get();
+    const bool shadows = GPU::Vulkan::ShadowAtlas::IsAvailable();
+
+    // Resolved before iterating, the default camera is created on demand and must not be added during the view
+    GPU::Vulkan::ShadowViewer viewer;
+    if (shadows) {
+        const auto camera = GPU::GraphicsEngine::GetDefaultCamera();
+        viewer.location = camera.GetComponent<Transform>().GetLocation();
+        viewer.fov = camera.GetComponent<Camera>().fov;
+    }
+
+    Registry.view<Transform, Light>().each(
+        [&](const entt::entity Entity, Transform &Transform, const Light &Light) {
+            uint32_t shadow = GPU::Vulkan::INVALID_SHADOW;
+            if (shadows && Light.castShadows) {
+                shadow = GPU::Vulkan::ShadowAtlas::Get().SubmitLight(
+                    Entity, Transform.GetLocation(), Light.range, Transform.GetVersion(), viewer);
+            }
+            clustered_lighting.SubmitLight(Transform.GetLocation(), Light, shadow);
+        });
+}
+}  // namespace Slipper
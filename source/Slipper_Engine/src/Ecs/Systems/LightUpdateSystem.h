@@ -0,0 +1,10 @@
+#pragma once
+#include "IEcsSystem.h"
+
+namespace Slipper
+{
+struct LightUpdateSystem : public IEcsSystem<LightUpdateSystem>
+{
+    void Execute(entt::registry &Registry) override;
+};
+}  // namespace Slipper
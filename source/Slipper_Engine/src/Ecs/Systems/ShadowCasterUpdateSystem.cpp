@@ -0,0 +1,34 @@
+#include "ShadowCasterUpdateSystem.h"
+
+#include "RendererComponent.h"
+#include "ShadowCasterComponent.h"
+#include "TransformComponent.h"
+#include "Vulkan/vk_ShadowAtlas.h"
+
+namespace Slipper
+{
+void ShadowCasterUpdateSystem::Execute(entt::registry &Registry)
+{
+    if (!GPU::Vulkan::ShadowAtlas::IsAvailable())
+        return;
+
+    auto &shadow_atlas = GPU::Vulkan::ShadowAtlas::Get();
+    Registry.view<Transform, Renderer, ShadowCaster>().each(
+        [&](Transform &Transform, const Renderer &Renderer, ShadowCaster &Caster) {
+            const glm::vec3 scale = Transform.GetScale();
+            const glm::vec4 bounds(Transform.GetLocation(),
+                                   Caster.boundingRadius * std::max({scale.x, scale.y, scale.z}));
+
+            // The cached shadows have to be rendered again where the caster was and where it is now
+            if (Caster.isStatic && Caster.seenVersion != Transform.GetVersion()) {
+                if (Caster.seenVersion != std::numeric_limits<uint64_t>::max())
+                    shadow_atlas.InvalidateStatic(Caster.seenBounds);
+                shadow_atlas.InvalidateStatic(bounds);
+                Caster.seenVersion = Transform.GetVersion();
+                Caster.seenBounds = bounds;
+            }
+
+            shadow_atlas.SubmitCaster(Renderer.model, Transform.GetModelMatrix(), bounds, Caster.isStatic);
+        });
+}
+}  // namespace Slipper
@@ -0,0 +1,10 @@
+#pragma once
+#include "IEcsSystem.h"
+
+namespace Slipper
+{
+struct ShadowCasterUpdateSystem : public IEcsSystem<ShadowCasterUpdateSystem>
+{
+    void Execute(entt::registry &Registry) override;
+};
+}  // namespace Slipper
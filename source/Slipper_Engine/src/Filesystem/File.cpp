@@ -1,6 +1,6 @@
 #include "File.h"
 
-#include "Path.h"
+#include "VirtualFileSystem.h"
 
 namespace Slipper
 {
@@ -9,21 +9,37 @@ namespace File
 // Mark relative path with "./"
 std::vector<char> read_binary_file(const std::string_view Filepath)
 {
-    std::string final_path(Filepath);
-    if (*Filepath.begin() == '.') {
-        final_path = Path::make_engine_relative_path_absolute(Filepath);
-    }
-    std::ifstream file(final_path.data(), std::ios::ate | std::ios::binary);
-
-    ASSERT(file.is_open(), "Failed to open file in path {}!", Filepath)
+    const VirtualFile file = VirtualFileSystem::Open(Filepath);
+    const std::span<const char> data = file.GetChars();
+    return {data.begin(), data.end()};
+}
 
-    const size_t file_size = (size_t)file.tellg();
-    std::vector<char> buffer(file_size);
-    file.seekg(0);
-    file.read(buffer.data(), file_size);
-    file.close();
+void write_file_atomic(const std::string_view Filepath, const std::function<void(std::ofstream &)> &Write)
+{
+    const std::string temporary_path = std::format(
+        "{}.{}.tmp", Filepath, std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    try {
+        {
+            std::ofstream stream(temporary_path, std::ios::binary | std::ios::trunc);
+            ASSERT(stream.is_open(), "Failed to open '{}' for writing!", temporary_path)
+            Write(stream);
+            stream.close();
+            ASSERT(stream.good(), "Failed to write '{}'!", temporary_path)
+        }
+        std::filesystem::rename(temporary_path, Filepath);
+    }
+    catch (...) {
+        std::error_code error;
+        std::filesystem::remove(temporary_path, error);
+        throw;
+    }
+}
 
-    return buffer;
+void write_file_atomic(const std::string_view Filepath, const std::span<const char> Data)
+{
+    write_file_atomic(Filepath, [&](std::ofstream &Stream) {
+        Stream.write(Data.data(), static_cast<std::streamsize>(Data.size()));
+    });
 }
 
 /* Needs further refinement! */
@@ -4,6 +4,20 @@ namespace Slipper
 {
 namespace File
 {
+// Blobs inside cooked files start at this alignment so views into a mapping are aligned for every type stored in them
+constexpr uint64_t BLOB_ALIGNMENT = 16;
+
+constexpr uint64_t align_blob_offset(const uint64_t Offset)
+{
+    return (Offset + BLOB_ALIGNMENT - 1) & ~(BLOB_ALIGNMENT - 1);
+}
+
+/* Writes under a temporary name and renames it over the file once complete, so an interrupted write never leaves a
+ * truncated file behind. The temporary name is unique per thread since workers may write the same file at once. */
+extern void write_file_atomic(std::string_view Filepath, const std::function<void(std::ofstream &)> &Write);
+extern void write_file_atomic(std::string_view Filepath, std::span<const char> Data);
+
+// Copies the file, VirtualFileSystem::Open gives a view of it instead
 extern std::vector<char> read_binary_file(std::string_view Filepath);
 extern std::string get_file_name_from_path(std::string_view Filepath);
 extern std::string remove_file_type_from_name(std::string_view FileName);
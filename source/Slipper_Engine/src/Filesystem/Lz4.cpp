@@ -0,0 +1,152 @@
+#include "Lz4.h"
+
+namespace Slipper
+{
+namespace Lz4
+{
+namespace
+{
+constexpr size_t MIN_MATCH = 4;
+// The last bytes of a block are always literals and the last match has to start this far from the end
+constexpr size_t LAST_LITERALS = 5;
+constexpr size_t MATCH_FIND_LIMIT = 12;
+constexpr size_t MAX_OFFSET = 65535;
+constexpr uint32_t HASH_BITS = 16;
+
+uint32_t read_u32(const std::byte *Data)
+{
+    uint32_t value;
+    std::memcpy(&value, Data, sizeof(value));
+    return value;
+}
+
+uint32_t hash_sequence(const uint32_t Sequence)
+{
+    return (Sequence * 2654435761u) >> (32 - HASH_BITS);
+}
+
+// Lengths that do not fit the nibble of the token continue in bytes of 255 until one is smaller
+void write_length(std::vector<std::byte> &Block, size_t Length)
+{
+    for (; Length >= 255; Length -= 255) {
+        Block.push_back(std::byte{255});
+    }
+    Block.push_back(static_cast<std::byte>(Length));
+}
+
+void write_sequence(std::vector<std::byte> &Block,
+                    const std::span<const std::byte> Literals,
+                    const size_t Offset,
+                    const size_t MatchLength)
+{
+    const size_t match_code = MatchLength ? MatchLength - MIN_MATCH : 0;
+    Block.push_back(static_cast<std::byte>(std::min<size_t>(Literals.size(), 15) << 4 |
+                                           std::min<size_t>(match_code, 15)));
+    if (Literals.size() >= 15) {
+        write_length(Block, Literals.size() - 15);
+    }
+    Block.insert(Block.end(), Literals.begin(), Literals.end());
+
+    // The last sequence only has literals
+    if (!MatchLength) {
+        return;
+    }
+    Block.push_back(static_cast<std::byte>(Offset & 0xFF));
+    Block.push_back(static_cast<std::byte>(Offset >> 8));
+    if (match_code >= 15) {
+        write_length(Block, match_code - 15);
+    }
+}
+
+size_t read_length(const std::span<const std::byte> Source, size_t &Position, size_t Length)
+{
+    if (Length != 15) {
+        return Length;
+    }
+
+    uint8_t byte;
+    do {
+        ASSERT(Position < Source.size(), "LZ4 block ends inside of a length!")
+        byte = static_cast<uint8_t>(Source[Position++]);
+        Length += byte;
+    } while (byte == 255);
+    return Length;
+}
+}  // namespace
+
+std::vector<std::byte> compress(const std::span<const std::byte> Source)
+{
+    PROFILE_ZONE("Lz4::compress");
+
+    std::vector<std::byte> block;
+    block.reserve(get_compress_bound(Source.size()));
+
+    // Greedy matching against the last position each hashed sequence was seen at, positions are stored plus one
+    std::vector<uint32_t> table(size_t{1} << HASH_BITS, 0);
+    size_t anchor = 0;
+    size_t position = 0;
+    while (Source.size() >= MATCH_FIND_LIMIT && position <= Source.size() - MATCH_FIND_LIMIT) {
+        const uint32_t sequence = read_u32(Source.data() + position);
+        uint32_t &entry = table[hash_sequence(sequence)];
+        const size_t candidate = entry;
+        entry = static_cast<uint32_t>(position + 1);
+
+        if (!candidate || position - (candidate - 1) > MAX_OFFSET ||
+            read_u32(Source.data() + candidate - 1) != sequence) {
+            ++position;
+            continue;
+        }
+
+        const size_t match = candidate - 1;
+        const size_t match_end = Source.size() - LAST_LITERALS;
+        size_t length = MIN_MATCH;
+        while (position + length < match_end && Source[match + length] == Source[position + length]) {
+            ++length;
+        }
+
+        write_sequence(block, Source.subspan(anchor, position - anchor), position - match, length);
+        position += length;
+        anchor = position;
+    }
+    write_sequence(block, Source.subspan(anchor), 0, 0);
+    return block;
+}
+
+void decompress(const std::span<const std::byte> Source, const std::span<std::byte> Destination)
+{
+    PROFILE_ZONE("Lz4::decompress");
+
+    size_t in = 0;
+    size_t out = 0;
+    while (in < Source.size()) {
+        const auto token = static_cast<uint8_t>(Source[in++]);
+
+        const size_t literals = read_length(Source, in, token >> 4);
+        ASSERT(literals <= Source.size() - in && literals <= Destination.size() - out,
+               "LZ4 block has more literals than fit!")
+        std::copy_n(Source.data() + in, literals, Destination.data() + out);
+        in += literals;
+        out += literals;
+
+        if (in == Source.size()) {
+            break;
+        }
+
+        ASSERT(Source.size() - in >= 2, "LZ4 block ends inside of an offset!")
+        const size_t offset = static_cast<size_t>(Source[in]) | static_cast<size_t>(Source[in + 1]) << 8;
+        in += 2;
+        ASSERT(offset != 0 && offset <= out, "LZ4 block refers to data before its start!")
+
+        const size_t length = read_length(Source, in, token & 0x0F) + MIN_MATCH;
+        ASSERT(length <= Destination.size() - out, "LZ4 block decompresses to more than fits!")
+        // Matches may overlap the bytes they produce, which repeats them, so they are copied byte by byte
+        const std::byte *match = Destination.data() + out - offset;
+        for (size_t i = 0; i < length; ++i) {
+            Destination[out + i] = match[i];
+        }
+        out += length;
+    }
+    ASSERT(out == Destination.size(), "LZ4 block decompresses to {} instead of {} bytes!", out, Destination.size())
+}
+}  // namespace Lz4
+}  // namespace Slipper
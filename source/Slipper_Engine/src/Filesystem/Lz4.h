@@ -0,0 +1,19 @@
+#pragma once
+
+namespace Slipper
+{
+/* Raw LZ4 blocks as described by the LZ4 block format, without the frame around them. Sizes are not stored in the
+ * block, whoever stores one has to keep the decompressed size next to it. */
+namespace Lz4
+{
+// Size a compressed block of Size bytes can grow to in the worst case
+[[nodiscard]] constexpr size_t get_compress_bound(const size_t Size)
+{
+    return Size + Size / 255 + 16;
+}
+
+extern std::vector<std::byte> compress(std::span<const std::byte> Source);
+// Throws if the block is malformed or does not decompress to exactly the size of Destination
+extern void decompress(std::span<const std::byte> Source, std::span<std::byte> Destination);
+}  // namespace Lz4
+}  // namespace Slipper
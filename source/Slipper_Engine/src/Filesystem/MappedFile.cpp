@@ -0,0 +1,94 @@
+#include "MappedFile.h"
+
+#ifdef WINDOWS
+#    define NOMINMAX
+#    include "windows.h"
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+namespace Slipper
+{
+#ifdef WINDOWS
+MappedFile::MappedFile(const std::string_view Filepath, const MappedFileAccess Access)
+{
+    const std::string path(Filepath);
+    const DWORD access_flag =
+        Access == MappedFileAccess::Sequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_FLAG_RANDOM_ACCESS;
+    m_file = CreateFileA(path.c_str(),
+                         GENERIC_READ,
+                         FILE_SHARE_READ,
+                         nullptr,
+                         OPEN_EXISTING,
+                         FILE_ATTRIBUTE_NORMAL | access_flag,
+                         nullptr);
+    ASSERT(m_file != INVALID_HANDLE_VALUE, "Failed to open file in path {}!", Filepath)
+
+    LARGE_INTEGER size;
+    GetFileSizeEx(m_file, &size);
+    m_size = static_cast<size_t>(size.QuadPart);
+    if (m_size == 0) {
+        return;
+    }
+
+    m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_mapping) {
+        m_data = static_cast<const std::byte *>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+    }
+    if (!m_data) {
+        // The destructor does not run for a constructor that throws
+        if (m_mapping) {
+            CloseHandle(m_mapping);
+        }
+        CloseHandle(m_file);
+        ASSERT(false, "Failed to map file in path {}!", Filepath)
+    }
+}
+
+MappedFile::~MappedFile()
+{
+    if (m_data) {
+        UnmapViewOfFile(m_data);
+    }
+    if (m_mapping) {
+        CloseHandle(m_mapping);
+    }
+    if (m_file && m_file != INVALID_HANDLE_VALUE) {
+        CloseHandle(m_file);
+    }
+}
+#else
+MappedFile::MappedFile(const std::string_view Filepath, const MappedFileAccess Access)
+{
+    const std::string path(Filepath);
+    const int file = open(path.c_str(), O_RDONLY);
+    ASSERT(file >= 0, "Failed to open file in path {}!", Filepath)
+
+    struct stat info = {};
+    fstat(file, &info);
+    m_size = static_cast<size_t>(info.st_size);
+    if (m_size == 0) {
+        close(file);
+        return;
+    }
+
+    // The mapping keeps its own reference to the file
+    void *data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    ASSERT(data != MAP_FAILED, "Failed to map file in path {}!", Filepath)
+
+    madvise(data, m_size, Access == MappedFileAccess::Sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+    m_data = static_cast<const std::byte *>(data);
+}
+
+MappedFile::~MappedFile()
+{
+    if (m_data) {
+        munmap(const_cast<std::byte *>(m_data), m_size);
+    }
+}
+#endif
+}  // namespace Slipper
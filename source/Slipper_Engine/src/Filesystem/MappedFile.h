@@ -0,0 +1,37 @@
+#pragma once
+
+namespace Slipper
+{
+enum class MappedFileAccess
+{
+    // Read front to back once, lets the system read ahead further
+    Sequential,
+    // Looked up all over the place, e.g. packs
+    Random,
+};
+
+/* Read only memory mapping of a whole file. Pages are read from the page cache when they are first touched, so
+ * copying from the mapping is the only copy the data goes through. */
+class MappedFile
+{
+ public:
+    explicit MappedFile(std::string_view Filepath, MappedFileAccess Access = MappedFileAccess::Sequential);
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    [[nodiscard]] std::span<const std::byte> GetData() const
+    {
+        return {m_data, m_size};
+    }
+
+ private:
+    const std::byte *m_data = nullptr;
+    size_t m_size = 0;
+#ifdef WINDOWS
+    void *m_file = nullptr;
+    void *m_mapping = nullptr;
+#endif
+};
+}  // namespace Slipper
@@ -0,0 +1,161 @@
+#include "PackFile.h"
+
+#include "Lz4.h"
+#include "Util/StringUtil.h"
+
+namespace Slipper
+{
+namespace
+{
+struct PackSource
+{
+    std::string path;
+    std::vector<std::byte> blob;
+    uint64_t size;
+    bool compressed;
+};
+
+PackSource ReadPackSource(const std::filesystem::path &Filepath,
+                          const std::filesystem::path &Directory,
+                          const PackWriteSettings &Settings)
+{
+    PackSource source;
+    source.path = Filepath.lexically_relative(Directory).generic_string();
+
+    const MappedFile file(Filepath.string());
+    const std::span<const std::byte> data = file.GetData();
+    source.size = data.size();
+    source.compressed = false;
+    if (Settings.compress && !data.empty()) {
+        std::vector<std::byte> compressed = Lz4::compress(data);
+        const auto kept_bytes = static_cast<float>(data.size()) * (1.0f - Settings.minimumSavings);
+        if (static_cast<float>(compressed.size()) <= kept_bytes) {
+            source.blob = std::move(compressed);
+            source.compressed = true;
+            return source;
+        }
+    }
+    source.blob.assign(data.begin(), data.end());
+    return source;
+}
+}  // namespace
+
+void WritePackFile(const std::string_view Directory, const std::string_view Filepath, const PackWriteSettings &Settings)
+{
+    PROFILE_ZONE("WritePackFile");
+
+    const std::filesystem::path directory(Directory);
+    const std::filesystem::path pack_path = std::filesystem::absolute(Filepath);
+    std::vector<std::filesystem::path> files;
+    for (const auto &entry : std::filesystem::recursive_directory_iterator(directory)) {
+        const std::string name = entry.path().filename().string();
+        // A pack written into the directory it packs must not end up in the next one
+        if (entry.is_regular_file() && std::filesystem::absolute(entry.path()) != pack_path &&
+            std::ranges::find(Settings.excludedNames, name) == Settings.excludedNames.end()) {
+            files.push_back(entry.path());
+        }
+    }
+
+    std::vector<PackSource> sources;
+    sources.reserve(files.size());
+    for (const auto &file : files) {
+        sources.push_back(ReadPackSource(file, directory, Settings));
+    }
+    std::ranges::sort(sources, [](const PackSource &A, const PackSource &B) {
+        return std::pair(String::hash_name(A.path), std::string_view(A.path)) <
+            std::pair(String::hash_name(B.path), std::string_view(B.path));
+    });
+
+    PackFileHeader header = {};
+    header.magic = PACK_FILE_MAGIC;
+    header.version = PACK_FILE_VERSION;
+    header.entryCount = static_cast<uint32_t>(sources.size());
+    header.entryOffset = File::align_blob_offset(sizeof(PackFileHeader));
+    header.pathOffset = header.entryOffset + sources.size() * sizeof(PackEntry);
+
+    std::vector<PackEntry> entries(sources.size());
+    std::string paths;
+    for (size_t i = 0; i < sources.size(); ++i) {
+        entries[i].pathHash = String::hash_name(sources[i].path);
+        entries[i].pathOffset = static_cast<uint32_t>(paths.size());
+        entries[i].pathSize = static_cast<uint32_t>(sources[i].path.size());
+        paths += sources[i].path;
+    }
+    header.pathBytes = static_cast<uint32_t>(paths.size());
+
+    uint64_t offset = header.pathOffset + paths.size();
+    for (size_t i = 0; i < sources.size(); ++i) {
+        offset = File::align_blob_offset(offset);
+        entries[i].offset = offset;
+        entries[i].storedSize = sources[i].blob.size();
+        entries[i].size = sources[i].size;
+        entries[i].flags = sources[i].compressed ? PackEntryFlags::Lz4 : PackEntryFlags::None;
+        offset += sources[i].blob.size();
+    }
+
+    std::vector<char> file(offset, 0);
+    std::memcpy(file.data(), &header, sizeof(header));
+    std::memcpy(file.data() + header.entryOffset, entries.data(), entries.size() * sizeof(PackEntry));
+    std::memcpy(file.data() + header.pathOffset, paths.data(), paths.size());
+    for (size_t i = 0; i < sources.size(); ++i) {
+        std::ranges::copy(sources[i].blob, reinterpret_cast<std::byte *>(file.data() + entries[i].offset));
+    }
+
+    File::write_file_atomic(Filepath, file);
+
+    LOG_FORMAT("Packed {} files from '{}' into {} ({} bytes)", sources.size(), Directory, Filepath, file.size())
+}
+
+PackFile::PackFile(const std::string_view Filepath)
+    : m_filepath(Filepath), m_file(Filepath, MappedFileAccess::Random)
+{
+    const std::span<const std::byte> data = m_file.GetData();
+    ASSERT(data.size() >= sizeof(PackFileHeader), "'{}' is not a pack!", Filepath)
+
+    PackFileHeader header;
+    std::memcpy(&header, data.data(), sizeof(header));
+    ASSERT(header.magic == PACK_FILE_MAGIC && header.version == PACK_FILE_VERSION,
+           "'{}' is not a pack of version {}!",
+           Filepath,
+           PACK_FILE_VERSION)
+    ASSERT(header.entryOffset % alignof(PackEntry) == 0 && header.entryOffset <= data.size() &&
+               uint64_t{header.entryCount} * sizeof(PackEntry) <= data.size() - header.entryOffset &&
+               header.pathOffset <= data.size() && header.pathBytes <= data.size() - header.pathOffset,
+           "'{}' is truncated!",
+           Filepath)
+
+    m_entries = {reinterpret_cast<const PackEntry *>(data.data() + header.entryOffset), header.entryCount};
+    m_paths = {reinterpret_cast<const char *>(data.data() + header.pathOffset), header.pathBytes};
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        const PackEntry &entry = m_entries[i];
+        ASSERT(entry.pathOffset <= m_paths.size() && entry.pathSize <= m_paths.size() - entry.pathOffset &&
+                   entry.offset <= data.size() && entry.storedSize <= data.size() - entry.offset,
+               "'{}' is truncated!",
+               Filepath)
+        // Find does a binary search over the hashes
+        ASSERT(i == 0 || m_entries[i - 1].pathHash <= entry.pathHash, "Entries of '{}' are not sorted!", Filepath)
+    }
+}
+
+const PackEntry *PackFile::Find(const std::string_view RelativePath) const
+{
+    const uint64_t hash = String::hash_name(RelativePath);
+    const auto candidates = std::ranges::equal_range(m_entries, hash, {}, &PackEntry::pathHash);
+    for (const PackEntry &entry : candidates) {
+        if (GetPath(entry) == RelativePath) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+std::string_view PackFile::GetPath(const PackEntry &Entry) const
+{
+    return m_paths.substr(Entry.pathOffset, Entry.pathSize);
+}
+
+std::span<const std::byte> PackFile::GetStoredData(const PackEntry &Entry) const
+{
+    return m_file.GetData().subspan(Entry.offset, Entry.storedSize);
+}
+}  // namespace Slipper
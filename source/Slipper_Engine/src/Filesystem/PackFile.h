@@ -0,0 +1,90 @@
+#pragma once
+
+#include "MappedFile.h"
+
+namespace Slipper
+{
+constexpr std::array<char, 4> PACK_FILE_MAGIC = {'S', 'P', 'A', 'K'};
+// Has to be bumped whenever the layout of the header, the entries or the blobs changes
+constexpr uint32_t PACK_FILE_VERSION = 1;
+inline constexpr std::string_view PACK_FILE_EXTENSION = ".spak";
+
+/* Packs start with this header, followed by the entry table sorted by path hash, the path strings and the blobs.
+ * Blobs start aligned, so uncompressed ones can be handed out as views into the mapping. */
+struct PackFileHeader
+{
+    std::array<char, 4> magic;
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t pathBytes;
+    uint64_t entryOffset;
+    uint64_t pathOffset;
+};
+
+enum class PackEntryFlags : uint32_t
+{
+    None = 0,
+    // The blob is a raw LZ4 block, see Lz4::decompress
+    Lz4 = 1 << 0,
+};
+
+struct PackEntry
+{
+    // String::hash_name of the path, which is relative to the packed directory and uses '/' separators
+    uint64_t pathHash;
+    uint32_t pathOffset;
+    uint32_t pathSize;
+    uint64_t offset;
+    uint64_t storedSize;
+    uint64_t size;
+    PackEntryFlags flags;
+    uint32_t reserved;
+
+    [[nodiscard]] bool IsCompressed() const
+    {
+        return static_cast<uint32_t>(flags) & static_cast<uint32_t>(PackEntryFlags::Lz4);
+    }
+};
+
+struct PackWriteSettings
+{
+    bool compress = true;
+    // Blobs are only stored compressed if that saves at least this fraction of their size
+    float minimumSavings = 0.1f;
+    // File names that are left out, e.g. build scripts that live next to the content
+    std::vector<std::string> excludedNames;
+};
+
+// Packs every file below Directory
+void WritePackFile(std::string_view Directory, std::string_view Filepath, const PackWriteSettings &Settings = {});
+
+/* Table of contents of a pack over a mapping of the whole file. Looking up an entry reads the entry table in the
+ * mapping, nothing is copied when the pack is opened. */
+class PackFile
+{
+ public:
+    explicit PackFile(std::string_view Filepath);
+
+    // Null if there is no file at the path relative to the packed directory
+    [[nodiscard]] const PackEntry *Find(std::string_view RelativePath) const;
+    [[nodiscard]] std::string_view GetPath(const PackEntry &Entry) const;
+    // The blob as it is stored, which is an LZ4 block for compressed entries
+    [[nodiscard]] std::span<const std::byte> GetStoredData(const PackEntry &Entry) const;
+
+    [[nodiscard]] std::span<const PackEntry> GetEntries() const
+    {
+        return m_entries;
+    }
+
+    [[nodiscard]] const std::string &GetFilepath() const
+    {
+        return m_filepath;
+    }
+
+ private:
+    std::string m_filepath;
+    MappedFile m_file;
+    std::span<const PackEntry> m_entries;
+    std::string_view m_paths;
+};
+}  // namespace Slipper
@@ -0,0 +1,114 @@
+#include "VirtualFileSystem.h"
+
+#include "Lz4.h"
+#include "PackFile.h"
+#include "Path.h"
+
+namespace Slipper
+{
+void VirtualFileSystem::Mount(const std::string_view PackPath, const std::string_view MountPoint)
+{
+    PROFILE_ZONE("VirtualFileSystem::Mount");
+
+    auto pack = std::make_shared<const PackFile>(Normalize(PackPath));
+    std::string root = Normalize(MountPoint);
+    if (!root.ends_with('/')) {
+        root += '/';
+    }
+    LOG_FORMAT("Mounted '{}' with {} files over '{}'", pack->GetFilepath(), pack->GetEntries().size(), root)
+
+    std::scoped_lock lock(m_mutex);
+    std::erase_if(m_mounts, [&root](const MountedPack &Mounted) { return Mounted.root == root; });
+    m_mounts.push_back({std::move(root), std::move(pack)});
+}
+
+void VirtualFileSystem::Unmount(const std::string_view MountPoint)
+{
+    std::string root = Normalize(MountPoint);
+    if (!root.ends_with('/')) {
+        root += '/';
+    }
+
+    std::scoped_lock lock(m_mutex);
+    std::erase_if(m_mounts, [&root](const MountedPack &Mounted) { return Mounted.root == root; });
+}
+
+void VirtualFileSystem::UnmountAll()
+{
+    std::scoped_lock lock(m_mutex);
+    m_mounts.clear();
+}
+
+VirtualFile VirtualFileSystem::Open(const std::string_view Filepath)
+{
+    PROFILE_ZONE("VirtualFileSystem::Open");
+
+    const std::string path = Normalize(Filepath);
+    PackLookup lookup = Find(path);
+
+    VirtualFile file;
+    if (UsesLooseFile(path, lookup)) {
+        file.m_loose = std::make_unique<MappedFile>(path);
+        file.m_data = file.m_loose->GetData();
+        return file;
+    }
+    ASSERT(lookup.entry, "Failed to open file in path {}, it is not in the pack mounted over it!", Filepath)
+
+    const std::span<const std::byte> stored = lookup.pack->GetStoredData(*lookup.entry);
+    if (lookup.entry->IsCompressed()) {
+        file.m_decompressed.resize(lookup.entry->size);
+        Lz4::decompress(stored, file.m_decompressed);
+        file.m_data = file.m_decompressed;
+    }
+    else {
+        file.m_data = stored;
+    }
+    file.m_pack = std::move(lookup.pack);
+    return file;
+}
+
+bool VirtualFileSystem::Exists(const std::string_view Filepath)
+{
+    const std::string path = Normalize(Filepath);
+    const PackLookup lookup = Find(path);
+    return lookup.entry || ((!lookup.belowMount || looseOverride) && std::filesystem::is_regular_file(path));
+}
+
+std::string VirtualFileSystem::Normalize(const std::string_view Filepath)
+{
+    std::string path(Filepath);
+    if (path.starts_with('.')) {
+        path = Path::make_engine_relative_path_absolute(path);
+    }
+    return std::filesystem::path(path).lexically_normal().generic_string();
+}
+
+bool VirtualFileSystem::UsesLooseFile(const std::string &Filepath, const PackLookup &Lookup)
+{
+    if (!Lookup.belowMount) {
+        return true;
+    }
+    return looseOverride && std::filesystem::is_regular_file(Filepath);
+}
+
+VirtualFileSystem::PackLookup VirtualFileSystem::Find(const std::string &Filepath)
+{
+    PackLookup lookup;
+    std::scoped_lock lock(m_mutex);
+    // Packs mounted later are looked at first, so they can shadow files of packs mounted over parent directories
+    for (auto mounted = m_mounts.rbegin(); mounted != m_mounts.rend(); ++mounted) {
+        if (!Filepath.starts_with(mounted->root)) {
+            continue;
+        }
+
+        lookup.belowMount = true;
+        const std::string_view relative_path = std::string_view(Filepath).substr(mounted->root.size());
+        if (const PackEntry *entry = mounted->pack->Find(relative_path)) {
+            lookup.pack = mounted->pack;
+            lookup.entry = entry;
+            break;
+        }
+    }
+    return lookup;
+}
+}  // namespace Slipper
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "MappedFile.h"
+
+namespace Slipper
+{
+class PackFile;
+struct PackEntry;
+
+/* Contents of a file opened through the VirtualFileSystem. Uncompressed files of a pack and loose files are views
+ * into a mapping, only compressed files of a pack are decompressed into memory the file owns. The data stays valid
+ * as long as the file does, even if its pack is unmounted in the meantime. */
+class VirtualFile
+{
+    friend class VirtualFileSystem;
+
+ public:
+    [[nodiscard]] std::span<const std::byte> GetData() const
+    {
+        return m_data;
+    }
+
+    [[nodiscard]] std::span<const char> GetChars() const
+    {
+        return {reinterpret_cast<const char *>(m_data.data()), m_data.size()};
+    }
+
+    [[nodiscard]] size_t GetSize() const
+    {
+        return m_data.size();
+    }
+
+    // Whether the file was read from disk rather than from a pack
+    [[nodiscard]] bool IsLoose() const
+    {
+        return m_loose != nullptr;
+    }
+
+ private:
+    std::span<const std::byte> m_data;
+    std::shared_ptr<const PackFile> m_pack;
+    std::unique_ptr<MappedFile> m_loose;
+    std::vector<std::byte> m_decompressed;
+};
+
+/* Serves files from packs that are mounted over directories, see WritePackFile. Paths are the ones the loose files
+ * would have, engine relative ones start with "./". Files that are not below a mount point are read from disk. In
+ * development builds loose files below a mount point take precedence over the pack, so content can be edited
+ * without repacking. Opening files is thread safe. */
+class VirtualFileSystem
+{
+ public:
+    // Files below MountPoint are looked up in the pack, mounting over the same directory again replaces the pack
+    static void Mount(std::string_view PackPath, std::string_view MountPoint);
+    static void Unmount(std::string_view MountPoint);
+    static void UnmountAll();
+
+    // Throws if the file is neither in a pack nor on disk
+    [[nodiscard]] static VirtualFile Open(std::string_view Filepath);
+    [[nodiscard]] static bool Exists(std::string_view Filepath);
+
+ private:
+    struct MountedPack
+    {
+        // Absolute and normalized with a trailing '/'
+        std::string root;
+        std::shared_ptr<const PackFile> pack;
+    };
+
+    struct PackLookup
+    {
+        std::shared_ptr<const PackFile> pack;
+        const PackEntry *entry = nullptr;
+        bool belowMount = false;
+    };
+
+    static std::string Normalize(std::string_view Filepath);
+    static bool UsesLooseFile(const std::string &Filepath, const PackLookup &Lookup);
+    static PackLookup Find(const std::string &Filepath);
+
+ public:
+    // Off in shipping builds, where only the packs are read below mount points
+#ifdef SLIPPER_SHIPPING
+    static inline bool looseOverride = false;
+#else
+    static inline bool looseOverride = true;
+#endif
+
+ private:
+    static inline std::mutex m_mutex;
+    static inline std::vector<MountedPack> m_mounts;
+};
+}  // namespace Slipper
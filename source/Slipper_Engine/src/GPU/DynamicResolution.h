@@ -0,0 +1,96 @@
+#pragma once
+
+namespace Slipper::GPU
+{
+    namespace Vulkan
+    {
+        class RenderPass;
+        class SwapChain;
+    }
+
+    struct DynamicResolutionSettings
+    {
+        bool enabled = false;
+        // Gpu time of a whole frame the controller aims for
+        double targetFrameMs = 1000.0 / 60.0;
+        float minScale = 0.5f;
+        float maxScale = 1.0f;
+        // Frame times between this fraction of the target and the target leave the scale alone
+        float headroom = 0.85f;
+        // Largest change of the render scale per adjustment
+        float maxStep = 0.05f;
+        // Weight of the newest gpu frame time in the smoothed one
+        float smoothing = 0.1f;
+
+        bool adjustSampleCount = true;
+        // Consecutive frames at the scale limits before the sample count changes
+        uint32_t sampleCountFrames = 120;
+        // Raising the sample count costs a lot more than one scale step, so it needs more headroom
+        float sampleCountHeadroom = 0.6f;
+    };
+
+    /* Scales the render area of the viewport so the gpu frame time measured by the GpuProfiler stays on target.
+     * The swap chain renders into the top left part of its full size images and the presentation copy upscales it,
+     * so changing the scale never recreates anything. Once the scale is at its minimum and the frame is still over
+     * budget the viewport sample count is lowered. That rebuilds the render pass and its pipelines, so it is only
+     * done after the frame time has been off for a while. */
+    class DynamicResolution
+    {
+     public:
+        static DynamicResolution &Get()
+        {
+            return *m_instance;
+        }
+
+        static bool IsAvailable()
+        {
+            return m_instance != nullptr;
+        }
+
+        static void Init(NonOwningPtr<Vulkan::SwapChain> SwapChain, NonOwningPtr<Vulkan::RenderPass> RenderPass);
+        static void Shutdown();
+
+        // Called once per frame after the gpu profiler has collected the timings of the frame slot
+        void Update();
+
+        [[nodiscard]] float GetScale() const;
+        [[nodiscard]] vk::SampleCountFlagBits GetSampleCount() const;
+
+        [[nodiscard]] vk::SampleCountFlagBits GetMaxSampleCount() const
+        {
+            return m_maxSampleCount;
+        }
+
+        [[nodiscard]] double GetSmoothedFrameMs() const
+        {
+            return m_smoothedFrameMs;
+        }
+
+     private:
+        DynamicResolution(NonOwningPtr<Vulkan::SwapChain> SwapChain, NonOwningPtr<Vulkan::RenderPass> RenderPass);
+
+        // Returns true if the scale was changed
+        bool UpdateScale();
+        void UpdateSampleCount();
+        void Reset(bool RestoreQuality);
+
+     public:
+        DynamicResolutionSettings settings;
+
+     private:
+        static inline DynamicResolution *m_instance = nullptr;
+
+        NonOwningPtr<Vulkan::SwapChain> m_swapChain;
+        NonOwningPtr<Vulkan::RenderPass> m_renderPass;
+        // The sample count the viewport was created with, never exceeded when raising it again
+        vk::SampleCountFlagBits m_maxSampleCount;
+
+        double m_smoothedFrameMs = 0.0;
+        uint64_t m_lastTimedFrame = 0;
+        // Timings of frames recorded before this one do not reflect the last change yet
+        uint64_t m_settledFrame = 0;
+        uint32_t m_overBudgetFrames = 0;
+        uint32_t m_underBudgetFrames = 0;
+        bool m_wasEnabled = false;
+    };
+}  // namespace Slipper::GPU
@@ -1,9 +1,13 @@
 #pragma once
+#include "AssetCache.h"
+#include "AssetTask.h"
+#include "InitGraph.h"
 #include "Vulkan/vk_DeviceDependentObject.h"
 #include "Vulkan/vk_RenderingStage.h"
 
 namespace Slipper
 {
+    class Model;
     class Window;
 }
 
@@ -11,6 +15,7 @@ namespace Slipper::GPU
 {
     class Context;
     class CommandPool;
+    class Material;
 
     namespace Vulkan
     {
@@ -19,6 +24,7 @@ namespace Slipper::GPU
         class SwapChain;
         class RenderPass;
         class Surface;
+        class GraphicsShader;
     }
 
     class GraphicsEngine : Vulkan::DeviceDependentObject
@@ -29,20 +35,26 @@ namespace Slipper::GPU
             return *m_graphicsInstance;
         }
 
-        static void Init();
+        /* Adds the tasks that set up the engine and its debug resources to the graph. They start once Dependency is
+         * done, which has to have created the device and the material manager. The resolution is read when the tasks
+         * run, so an earlier task may still fill it in. Returns the task the engine is ready after. */
+        static InitTaskId Init(InitGraph &Graph, InitTaskId Dependency, const VkExtent2D &ViewportResolution);
 
         static void Shutdown();
 
-        static void SetupDebugResources();
         void SetupDebugRender(Context &Context) const;
         void SetupSimpleDraw() const;
 
         Vulkan::RenderPass *CreateRenderPass(const std::string &Name,
                                              vk::Format RenderingFormat,
                                              vk::Format DepthFormat,
-                                             bool ForPresentation);
+                                             bool ForPresentation,
+                                             bool DepthPrePass = false);
         void DestroyRenderPass(Vulkan::RenderPass *RenderPass);
 
+        // Rebuilds the viewport render pass, its pipelines and attachments, waits for the device to be idle
+        void SetViewportSampleCount(vk::SampleCountFlagBits SampleCount) const;
+
         void AddWindow(Window &Window);
         NonOwningPtr<RenderingStage> AddRenderingStage(std::string Name,
                                                                  NonOwningPtr<Vulkan::SwapChain> SwapChain,
@@ -94,10 +106,26 @@ namespace Slipper::GPU
         // Memory Transfer Commands
         std::unique_ptr<CommandPool> memoryCommandPool;
 
+     private:
+        struct DebugResourceLoads
+        {
+            AssetTask<AssetHandle<Model>> model;
+            AssetTask<NonOwningPtr<Material>> material;
+            // Only loaded if there is a bindless heap
+            AssetTask<AssetHandle<Vulkan::GraphicsShader>> litShader;
+        };
+
+        // Starts the loads without waiting for them, so reading and decoding overlaps the rest of the startup
+        static DebugResourceLoads StartDebugResourceLoads();
+        static void FinishDebugResourceLoads(const DebugResourceLoads &Loads);
+        static AssetTask<NonOwningPtr<Material>> LoadBasicMaterial();
+
      private:
         NonOwningPtr<Vulkan::Surface> surface = nullptr;
 
         static GraphicsEngine *m_graphicsInstance;
+        // No material uses it until a scene asks for lit rendering, so it would be unloaded otherwise
+        static inline AssetHandle<Vulkan::GraphicsShader> m_litShader;
 
         std::vector<vk::Fence> m_computeInFlightFences;
         std::vector<vk::Fence> m_renderingInFlightFences;
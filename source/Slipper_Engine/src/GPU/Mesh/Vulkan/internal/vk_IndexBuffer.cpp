@@ -5,7 +5,8 @@ namespace Slipper
 IndexBuffer::IndexBuffer(const VertexIndex *Indices,
                          const size_t NumIndices)
     : Buffer(sizeof(Indices[0]) * NumIndices,
-             VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+             VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT |
+                 VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
              VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT),
       numIndex(NumIndices)
 {
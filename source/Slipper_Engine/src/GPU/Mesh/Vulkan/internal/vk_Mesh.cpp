@@ -1,5 +1,8 @@
 #include "Mesh.h"
 
+#include "Vulkan/vk_BindlessHeap.h"
+#include "Vulkan/vk_CommandContext.h"
+
 namespace Slipper
 {
 Mesh::Mesh(std::string_view Name,
@@ -7,8 +10,73 @@ Mesh::Mesh(std::string_view Name,
            const size_t NumVertices,
            const VertexIndex *Indices,
            const size_t NumIndices)
-    : m_name(Name), m_vertexBuffer(Vertices, NumVertices), m_indexBuffer(Indices, NumIndices)
+    : Mesh(Name,
+           {Vertices, NumVertices},
+           {Indices, NumIndices},
+           ComputeBounds({Vertices, NumVertices}, {Indices, NumIndices}),
+           {})
+{
+}
+
+Mesh::Mesh(const std::string_view Name,
+           const std::span<const Vertex> Vertices,
+           const std::span<const VertexIndex> Indices,
+           const MeshBounds &Bounds,
+           const std::span<const Submesh> Submeshes)
+    : m_name(Name),
+      m_vertexBuffer(Vertices.data(), Vertices.size()),
+      m_indexBuffer(Indices.data(), Indices.size()),
+      m_vertexBufferIndex(GPU::Vulkan::INVALID_BINDLESS_INDEX),
+      m_indexBufferIndex(GPU::Vulkan::INVALID_BINDLESS_INDEX),
+      m_bounds(Bounds),
+      m_submeshes(Submeshes.begin(), Submeshes.end())
 {
+    if (GPU::Vulkan::BindlessHeap::IsAvailable()) {
+        m_vertexBufferIndex = GPU::Vulkan::BindlessHeap::Get().RegisterBuffer(m_vertexBuffer);
+        m_indexBufferIndex = GPU::Vulkan::BindlessHeap::Get().RegisterBuffer(m_indexBuffer);
+    }
+
+    if (m_submeshes.empty()) {
+        m_submeshes.push_back({0, static_cast<uint32_t>(Indices.size())});
+    }
+}
+
+MeshBounds Mesh::ComputeBounds(const std::span<const Vertex> Vertices, const std::span<const VertexIndex> Indices)
+{
+    MeshBounds bounds;
+    if (!Vertices.empty()) {
+        bounds.min = bounds.max = Vertices.front().pos;
+    }
+    for (const Vertex &vertex : Vertices) {
+        bounds.min = glm::min(bounds.min, vertex.pos);
+        bounds.max = glm::max(bounds.max, vertex.pos);
+        bounds.radius = std::max(bounds.radius, glm::length(vertex.pos));
+    }
+
+    // The ratio of the summed areas, the halves of the cross products cancel out
+    float world_area = 0.0f;
+    float uv_area = 0.0f;
+    for (size_t i = 0; i + 2 < Indices.size(); i += 3) {
+        const Vertex &a = Vertices[Indices[i]];
+        const Vertex &b = Vertices[Indices[i + 1]];
+        const Vertex &c = Vertices[Indices[i + 2]];
+        world_area += glm::length(glm::cross(b.pos - a.pos, c.pos - a.pos));
+        const glm::vec2 uv_ab = b.texCoord - a.texCoord;
+        const glm::vec2 uv_ac = c.texCoord - a.texCoord;
+        uv_area += std::abs(uv_ab.x * uv_ac.y - uv_ab.y * uv_ac.x);
+    }
+    if (uv_area > 0.0f) {
+        bounds.uvDensity = std::sqrt(world_area / uv_area);
+    }
+    return bounds;
+}
+
+Mesh::~Mesh()
+{
+    if (GPU::Vulkan::BindlessHeap::IsAvailable()) {
+        GPU::Vulkan::BindlessHeap::Get().ReleaseBuffer(m_vertexBufferIndex);
+        GPU::Vulkan::BindlessHeap::Get().ReleaseBuffer(m_indexBufferIndex);
+    }
 }
 
 void Mesh::Bind(const VkCommandBuffer &CommandBuffer) const
@@ -17,6 +85,12 @@ void Mesh::Bind(const VkCommandBuffer &CommandBuffer) const
     constexpr VkDeviceSize offsets[1] = {0};
 
     vkCmdBindVertexBuffers(CommandBuffer, 0, 1, vertex_buffers, offsets);
-    vkCmdBindIndexBuffer(CommandBuffer, m_indexBuffer, 0, VK_INDEX_TYPE_UINT16);
+    vkCmdBindIndexBuffer(CommandBuffer, m_indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+}
+
+void Mesh::Bind(GPU::Vulkan::CommandContext &Context) const
+{
+    Context.BindVertexBuffer(0, static_cast<VkBuffer>(m_vertexBuffer));
+    Context.BindIndexBuffer(static_cast<VkBuffer>(m_indexBuffer), 0, vk::IndexType::eUint32);
 }
 }  // namespace Slipper
\ No newline at end of file
@@ -6,7 +6,8 @@ namespace Slipper
 {
 VertexBuffer::VertexBuffer(const Vertex *Vertices, const size_t NumVertices)
     : Buffer(sizeof(Vertices[0]) * NumVertices,
-             VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+             VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT |
+                 VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
              VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT),
       numVertex(NumVertices)
 {
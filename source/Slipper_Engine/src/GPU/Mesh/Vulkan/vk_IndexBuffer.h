@@ -5,7 +5,8 @@
 
 namespace Slipper
 {
-typedef uint16_t VertexIndex;
+// 32 bit, scanned and sculpted assets easily have more than 65536 unique vertices
+typedef uint32_t VertexIndex;
 
 class IndexBuffer : public Buffer
 {
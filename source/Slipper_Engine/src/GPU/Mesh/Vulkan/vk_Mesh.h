@@ -3,14 +3,13 @@
 #include <array>
 #include <vector>
 
-#define GLM_ENABLE_EXPERIMENTAL
-#include <glm/gtx/hash.hpp>
-
 #include "vk_IndexBuffer.h"
 #include "vk_VertexBuffer.h"
 
 namespace Slipper::GPU::Vulkan
 {
+    class CommandContext;
+
     const std::string DEMO_MODEL_PATH = "./EngineContent/Models/VikingRoom/viking_room.obj";
     const std::string DEMO_TEXTURE_PATH = "./EngineContent/Models/VikingRoom/viking_room.png";
 
@@ -57,6 +56,38 @@ namespace Slipper::GPU::Vulkan
             return &attribute_descriptions;
         }
     };
+
+    /* 64 bit hash of all components of the vertex. Pairs of components are mixed in with a multiply and xorshift
+     * step and the result goes through the splitmix64 finalizer, so vertices that only differ in a low mantissa bit
+     * still land far apart. */
+    [[nodiscard]] inline uint64_t HashVertex(const Vertex &Vertex)
+    {
+        // Adding zero turns -0 into 0, the two compare equal so they have to hash equal as well
+        const std::array<float, 8> components = {Vertex.pos.x + 0.0f,
+                                                 Vertex.pos.y + 0.0f,
+                                                 Vertex.pos.z + 0.0f,
+                                                 Vertex.color.r + 0.0f,
+                                                 Vertex.color.g + 0.0f,
+                                                 Vertex.color.b + 0.0f,
+                                                 Vertex.texCoord.x + 0.0f,
+                                                 Vertex.texCoord.y + 0.0f};
+
+        uint64_t hash = 0x9E3779B97F4A7C15ull;
+        for (size_t i = 0; i < components.size(); i += 2)
+        {
+            const uint64_t word = std::bit_cast<uint32_t>(components[i]) |
+                static_cast<uint64_t>(std::bit_cast<uint32_t>(components[i + 1])) << 32;
+            hash = (hash ^ word) * 0xBF58476D1CE4E5B9ull;
+            hash ^= hash >> 31;
+        }
+
+        hash ^= hash >> 30;
+        hash *= 0xBF58476D1CE4E5B9ull;
+        hash ^= hash >> 27;
+        hash *= 0x94D049BB133111EBull;
+        hash ^= hash >> 31;
+        return hash;
+    }
 }  // namespace Slipper::GPU::Vulkan
 
 namespace std
@@ -66,8 +97,7 @@ namespace std
     {
         size_t operator()(Slipper::GPU::Vulkan::Vertex const &Vertex) const noexcept
         {
-            return ((hash<glm::vec3>()(Vertex.pos) ^ (hash<glm::vec3>()(Vertex.color) << 1)) >> 1) ^
-                (hash<glm::vec2>()(Vertex.texCoord) << 1);
+            return static_cast<size_t>(Slipper::GPU::Vulkan::HashVertex(Vertex));
         }
     };
 }  // namespace std
@@ -85,6 +115,24 @@ namespace Slipper
 
     const std::vector<VertexIndex> DEBUG_TRIANGLE_INDICES = {0, 1, 2, 2, 3, 0, 4, 5, 6, 6, 7, 4};
 
+    // Properties derived from the vertices, cooked meshes store them so loading does not have to visit every vertex
+    struct MeshBounds
+    {
+        glm::vec3 min = glm::vec3(0.0f);
+        glm::vec3 max = glm::vec3(0.0f);
+        // Distance of the farthest vertex from the origin of the mesh
+        float radius = 0.0f;
+        // Average world space size of one uv unit, 0 if the mesh has no uvs
+        float uvDensity = 0.0f;
+    };
+
+    // Range of the index buffer that belongs to one part of the source file, e.g. an OBJ shape
+    struct Submesh
+    {
+        uint32_t firstIndex = 0;
+        uint32_t indexCount = 0;
+    };
+
     class Mesh
     {
      public:
@@ -93,8 +141,30 @@ namespace Slipper
              size_t NumVertices,
              const VertexIndex *Indices,
              size_t NumIndices);
+        // Takes bounds and submeshes that were computed before, no submeshes means a single one spanning all indices
+        Mesh(std::string_view Name,
+             std::span<const GPU::Vulkan::Vertex> Vertices,
+             std::span<const VertexIndex> Indices,
+             const MeshBounds &Bounds,
+             std::span<const Submesh> Submeshes);
+        ~Mesh();
+
+        [[nodiscard]] static MeshBounds ComputeBounds(std::span<const GPU::Vulkan::Vertex> Vertices,
+                                                      std::span<const VertexIndex> Indices);
 
         void Bind(const VkCommandBuffer &CommandBuffer) const;
+        void Bind(GPU::Vulkan::CommandContext &Context) const;
+
+        // Indices of the vertex and index buffer inside the BindlessHeap (INVALID_BINDLESS_INDEX if unavailable)
+        uint32_t GetVertexBufferIndex() const
+        {
+            return m_vertexBufferIndex;
+        }
+
+        uint32_t GetIndexBufferIndex() const
+        {
+            return m_indexBufferIndex;
+        }
 
         size_t NumVertex() const
         {
@@ -111,9 +181,35 @@ namespace Slipper
             return m_name;
         }
 
+        const MeshBounds &GetBounds() const
+        {
+            return m_bounds;
+        }
+
+        // Distance of the farthest vertex from the origin of the mesh
+        float GetBoundingRadius() const
+        {
+            return m_bounds.radius;
+        }
+
+        // Average world space size of one uv unit, 0 if the mesh has no uvs. Used to estimate texel density.
+        float GetUvDensity() const
+        {
+            return m_bounds.uvDensity;
+        }
+
+        const std::vector<Submesh> &GetSubmeshes() const
+        {
+            return m_submeshes;
+        }
+
      private:
         const std::string m_name;
         GPU::Vulkan::VertexBuffer m_vertexBuffer;
         IndexBuffer m_indexBuffer;
+        uint32_t m_vertexBufferIndex;
+        uint32_t m_indexBufferIndex;
+        MeshBounds m_bounds;
+        std::vector<Submesh> m_submeshes;
     };
 }  // namespace Slipper
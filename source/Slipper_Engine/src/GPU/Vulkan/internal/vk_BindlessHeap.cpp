@@ -0,0 +1,164 @@
+#include "../vk_BindlessHeap.h"
+
+#include "Vulkan/vk_Buffer.h"
+#include "Vulkan/vk_Device.h"
+#include "Vulkan/vk_Texture.h"
+
+namespace Slipper::GPU::Vulkan
+{
+    uint32_t BindlessHeap::SlotAllocator::Acquire()
+    {
+        if (!freeSlots.empty())
+        {
+            const uint32_t slot = freeSlots.back();
+            freeSlots.pop_back();
+            return slot;
+        }
+
+        ASSERT(next < capacity, "Bindless heap is full! Capacity: {}", capacity)
+        return next++;
+    }
+
+    void BindlessHeap::SlotAllocator::Release(const uint32_t Slot)
+    {
+        freeSlots.push_back(Slot);
+    }
+
+    BindlessHeap::BindlessHeap(const uint32_t TextureCapacity, const uint32_t BufferCapacity)
+    {
+        m_textureSlots.capacity = TextureCapacity;
+        m_bufferSlots.capacity = BufferCapacity;
+
+        const std::array layout_bindings = {
+            vk::DescriptorSetLayoutBinding(BINDLESS_TEXTURE_BINDING,
+                                           vk::DescriptorType::eCombinedImageSampler,
+                                           TextureCapacity,
+                                           vk::ShaderStageFlagBits::eAll),
+            vk::DescriptorSetLayoutBinding(BINDLESS_BUFFER_BINDING,
+                                           vk::DescriptorType::eStorageBuffer,
+                                           BufferCapacity,
+                                           vk::ShaderStageFlagBits::eAll)};
+
+        constexpr vk::DescriptorBindingFlags binding_flags = vk::DescriptorBindingFlagBits::ePartiallyBound |
+            vk::DescriptorBindingFlagBits::eUpdateAfterBind | vk::DescriptorBindingFlagBits::eUpdateUnusedWhilePending;
+        const std::array layout_binding_flags = {binding_flags, binding_flags};
+
+        vk::DescriptorSetLayoutBindingFlagsCreateInfo binding_flags_info(layout_binding_flags);
+        const vk::DescriptorSetLayoutCreateInfo layout_info(
+            vk::DescriptorSetLayoutCreateFlagBits::eUpdateAfterBindPool, layout_bindings, &binding_flags_info);
+        m_layout = device.logicalDevice.createDescriptorSetLayout(layout_info);
+
+        const std::array pool_sizes = {vk::DescriptorPoolSize(vk::DescriptorType::eCombinedImageSampler, TextureCapacity),
+                                       vk::DescriptorPoolSize(vk::DescriptorType::eStorageBuffer, BufferCapacity)};
+        const vk::DescriptorPoolCreateInfo pool_info(vk::DescriptorPoolCreateFlagBits::eUpdateAfterBind, 1, pool_sizes);
+        VK_HPP_ASSERT(device.logicalDevice.createDescriptorPool(&pool_info, nullptr, &m_pool),
+                      "Failed to create bindless descriptor pool!")
+
+        const vk::DescriptorSetAllocateInfo allocate_info(m_pool, 1, &m_layout);
+        VK_HPP_ASSERT(device.logicalDevice.allocateDescriptorSets(&allocate_info, &m_set),
+                      "Failed to allocate bindless descriptor set!")
+    }
+
+    BindlessHeap::~BindlessHeap()
+    {
+        device.logicalDevice.destroyDescriptorPool(m_pool);
+        device.logicalDevice.destroyDescriptorSetLayout(m_layout);
+    }
+
+    void BindlessHeap::Init()
+    {
+        ASSERT(!m_instance, "Bindless heap already created!")
+
+        const auto &device = VKDevice::Get();
+        if (!device.SupportsBindless())
+        {
+            LOG("Device does not support descriptor indexing. Bindless heap is disabled.")
+            return;
+        }
+
+        // Combined image samplers count against both the sampled image and the sampler limits
+        const auto &limits = device.descriptorIndexingProperties;
+        const uint32_t texture_capacity = std::min(
+            {MAX_BINDLESS_TEXTURES,
+             limits.maxDescriptorSetUpdateAfterBindSampledImages,
+             limits.maxPerStageDescriptorUpdateAfterBindSampledImages,
+             limits.maxDescriptorSetUpdateAfterBindSamplers,
+             limits.maxPerStageDescriptorUpdateAfterBindSamplers});
+        const uint32_t buffer_capacity = std::min(
+            {MAX_BINDLESS_BUFFERS,
+             limits.maxDescriptorSetUpdateAfterBindStorageBuffers,
+             limits.maxPerStageDescriptorUpdateAfterBindStorageBuffers});
+
+        m_instance = new BindlessHeap(texture_capacity, buffer_capacity);
+    }
+
+    void BindlessHeap::Shutdown()
+    {
+        delete m_instance;
+        m_instance = nullptr;
+    }
+
+    uint32_t BindlessHeap::RegisterTexture(const Texture &Texture)
+    {
+        const uint32_t index = m_textureSlots.Acquire();
+        UpdateTexture(index, Texture);
+        return index;
+    }
+
+    void BindlessHeap::UpdateTexture(const uint32_t Index, const Texture &Texture) const
+    {
+        const auto image_info = Texture.GetDescriptorImageInfo().value();
+        const vk::WriteDescriptorSet write(
+            m_set, BINDLESS_TEXTURE_BINDING, Index, vk::DescriptorType::eCombinedImageSampler, image_info);
+        device.logicalDevice.updateDescriptorSets(write, {});
+    }
+
+    void BindlessHeap::ReleaseTexture(const uint32_t Index)
+    {
+        if (Index == INVALID_BINDLESS_INDEX)
+            return;
+
+        m_pendingReleases.push_back({m_frame + MAX_FRAMES_IN_FLIGHT, Index, true});
+    }
+
+    uint32_t BindlessHeap::RegisterBuffer(const Buffer &Buffer)
+    {
+        const uint32_t index = m_bufferSlots.Acquire();
+        UpdateBuffer(index, Buffer);
+        return index;
+    }
+
+    void BindlessHeap::UpdateBuffer(const uint32_t Index, const Buffer &Buffer) const
+    {
+        const auto buffer_info = Buffer.GetDescriptorBufferInfo().value();
+        const vk::WriteDescriptorSet write(
+            m_set, BINDLESS_BUFFER_BINDING, Index, vk::DescriptorType::eStorageBuffer, {}, buffer_info);
+        device.logicalDevice.updateDescriptorSets(write, {});
+    }
+
+    void BindlessHeap::ReleaseBuffer(const uint32_t Index)
+    {
+        if (Index == INVALID_BINDLESS_INDEX)
+            return;
+
+        m_pendingReleases.push_back({m_frame + MAX_FRAMES_IN_FLIGHT, Index, false});
+    }
+
+    void BindlessHeap::BeginFrame()
+    {
+        ++m_frame;
+        while (!m_pendingReleases.empty() && m_pendingReleases.front().releaseFrame <= m_frame)
+        {
+            const auto &[release_frame, slot, is_texture] = m_pendingReleases.front();
+            (is_texture ? m_textureSlots : m_bufferSlots).Release(slot);
+            m_pendingReleases.pop_front();
+        }
+    }
+
+    void BindlessHeap::Bind(const vk::CommandBuffer CommandBuffer,
+                            const vk::PipelineBindPoint BindPoint,
+                            const vk::PipelineLayout PipelineLayout) const
+    {
+        CommandBuffer.bindDescriptorSets(BindPoint, PipelineLayout, BINDLESS_DESCRIPTOR_SET, m_set, {});
+    }
+}  // namespace Slipper::GPU::Vulkan
@@ -0,0 +1,563 @@
+#include "../vk_BlockCompression.h"
+
+namespace Slipper::GPU::Vulkan
+{
+    namespace
+    {
+        // Pixels of a single decoded block in row major order
+        using DecodedBlock = std::array<std::array<uint8_t, 4>, 16>;
+
+        // Bit i is the subset of pixel i in the BC7 partitions with two subsets
+        constexpr uint16_t BC7_PARTITIONS_2[64] = {
+            0xCCCC, 0x8888, 0xEEEE, 0xECC8, 0xC880, 0xFEEC, 0xFEC8, 0xEC80, 0xC800, 0xFFEC, 0xFE80, 0xE800, 0xFFE8,
+            0xFF00, 0xFFF0, 0xF000, 0xF710, 0x008E, 0x7100, 0x08CE, 0x008C, 0x7310, 0x3100, 0x8CCE, 0x088C, 0x3110,
+            0x6666, 0x366C, 0x17E8, 0x0FF0, 0x718E, 0x399C, 0xAAAA, 0xF0F0, 0x5A5A, 0x33CC, 0x3C3C, 0x55AA, 0x9696,
+            0xA55A, 0x73CE, 0x13C8, 0x324C, 0x3BDC, 0x6996, 0xC33C, 0x9966, 0x0660, 0x0272, 0x04E4, 0x4E40, 0x2720,
+            0xC936, 0x936C, 0x39C6, 0x639C, 0x9336, 0x9CC6, 0x817E, 0xE718, 0xCCF0, 0x0FCC, 0x7744, 0xEE22};
+
+        constexpr uint8_t BC7_PARTITIONS_3[64][16] = {
+            {0, 0, 1, 1, 0, 0, 1, 1, 0, 2, 2, 1, 2, 2, 2, 2}, {0, 0, 0, 1, 0, 0, 1, 1, 2, 2, 1, 1, 2, 2, 2, 1},
+            {0, 0, 0, 0, 2, 0, 0, 1, 2, 2, 1, 1, 2, 2, 1, 1}, {0, 2, 2, 2, 0, 0, 2, 2, 0, 0, 1, 1, 0, 1, 1, 1},
+            {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 2, 2, 1, 1, 2, 2}, {0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 2, 2, 0, 0, 2, 2},
+            {0, 0, 2, 2, 0, 0, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1}, {0, 0, 1, 1, 0, 0, 1, 1, 2, 2, 1, 1, 2, 2, 1, 1},
+            {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2}, {0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2},
+            {0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2}, {0, 0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 2},
+            {0, 1, 1, 2, 0, 1, 1, 2, 0, 1, 1, 2, 0, 1, 1, 2}, {0, 1, 2, 2, 0, 1, 2, 2, 0, 1, 2, 2, 0, 1, 2, 2},
+            {0, 0, 1, 1, 0, 1, 1, 2, 1, 1, 2, 2, 1, 2, 2, 2}, {0, 0, 1, 1, 2, 0, 0, 1, 2, 2, 0, 0, 2, 2, 2, 0},
+            {0, 0, 0, 1, 0, 0, 1, 1, 0, 1, 1, 2, 1, 1, 2, 2}, {0, 1, 1, 1, 0, 0, 1, 1, 2, 0, 0, 1, 2, 2, 0, 0},
+            {0, 0, 0, 0, 1, 1, 2, 2, 1, 1, 2, 2, 1, 1, 2, 2}, {0, 0, 2, 2, 0, 0, 2, 2, 0, 0, 2, 2, 1, 1, 1, 1},
+            {0, 1, 1, 1, 0, 1, 1, 1, 0, 2, 2, 2, 0, 2, 2, 2}, {0, 0, 0, 1, 0, 0, 0, 1, 2, 2, 2, 1, 2, 2, 2, 1},
+            {0, 0, 0, 0, 0, 0, 1, 1, 0, 1, 2, 2, 0, 1, 2, 2}, {0, 0, 0, 0, 1, 1, 0, 0, 2, 2, 1, 0, 2, 2, 1, 0},
+            {0, 1, 2, 2, 0, 1, 2, 2, 0, 0, 1, 1, 0, 0, 0, 0}, {0, 0, 1, 2, 0, 0, 1, 2, 1, 1, 2, 2, 2, 2, 2, 2},
+            {0, 1, 1, 0, 1, 2, 2, 1, 1, 2, 2, 1, 0, 1, 1, 0}, {0, 0, 0, 0, 0, 1, 1, 0, 1, 2, 2, 1, 1, 2, 2, 1},
+            {0, 0, 2, 2, 1, 1, 0, 2, 1, 1, 0, 2, 0, 0, 2, 2}, {0, 1, 1, 0, 0, 1, 1, 0, 2, 0, 0, 2, 2, 2, 2, 2},
+            {0, 0, 1, 1, 0, 1, 2, 2, 0, 1, 2, 2, 0, 0, 1, 1}, {0, 0, 0, 0, 2, 0, 0, 0, 2, 2, 1, 1, 2, 2, 2, 1},
+            {0, 0, 0, 0, 0, 0, 0, 2, 1, 1, 2, 2, 1, 2, 2, 2}, {0, 2, 2, 2, 0, 0, 2, 2, 0, 0, 1, 2, 0, 0, 1, 1},
+            {0, 0, 1, 1, 0, 0, 1, 2, 0, 0, 2, 2, 0, 2, 2, 2}, {0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 2, 0},
+            {0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 0, 0, 0, 0}, {0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0},
+            {0, 1, 2, 0, 2, 0, 1, 2, 1, 2, 0, 1, 0, 1, 2, 0}, {0, 0, 1, 1, 2, 2, 0, 0, 1, 1, 2, 2, 0, 0, 1, 1},
+            {0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 0, 0, 0, 0, 1, 1}, {0, 1, 0, 1, 0, 1, 0, 1, 2, 2, 2, 2, 2, 2, 2, 2},
+            {0, 0, 0, 0, 0, 0, 0, 0, 2, 1, 2, 1, 2, 1, 2, 1}, {0, 0, 2, 2, 1, 1, 2, 2, 0, 0, 2, 2, 1, 1, 2, 2},
+            {0, 0, 2, 2, 0, 0, 1, 1, 0, 0, 2, 2, 0, 0, 1, 1}, {0, 2, 2, 0, 1, 2, 2, 1, 0, 2, 2, 0, 1, 2, 2, 1},
+            {0, 1, 0, 1, 2, 2, 2, 2, 2, 2, 2, 2, 0, 1, 0, 1}, {0, 0, 0, 0, 2, 1, 2, 1, 2, 1, 2, 1, 2, 1, 2, 1},
+            {0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 2, 2, 2, 2}, {0, 2, 2, 2, 0, 1, 1, 1, 0, 2, 2, 2, 0, 1, 1, 1},
+            {0, 0, 0, 2, 1, 1, 1, 2, 0, 0, 0, 2, 1, 1, 1, 2}, {0, 0, 0, 0, 2, 1, 1, 2, 2, 1, 1, 2, 2, 1, 1, 2},
+            {0, 2, 2, 2, 0, 1, 1, 1, 0, 1, 1, 1, 0, 2, 2, 2}, {0, 0, 0, 2, 1, 1, 1, 2, 1, 1, 1, 2, 0, 0, 0, 2},
+            {0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 2, 2, 2, 2}, {0, 0, 0, 0, 0, 0, 0, 0, 2, 1, 1, 2, 2, 1, 1, 2},
+            {0, 1, 1, 0, 0, 1, 1, 0, 2, 2, 2, 2, 2, 2, 2, 2}, {0, 0, 2, 2, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 2, 2},
+            {0, 0, 2, 2, 1, 1, 2, 2, 1, 1, 2, 2, 0, 0, 2, 2}, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 1, 1, 2},
+            {0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1}, {0, 2, 2, 2, 1, 2, 2, 2, 0, 2, 2, 2, 1, 2, 2, 2},
+            {0, 1, 0, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2}, {0, 1, 1, 1, 2, 0, 1, 1, 2, 2, 0, 1, 2, 2, 2, 0}};
+
+        // Pixels whose index is stored with one bit less, the first subset always has its anchor at pixel 0
+        constexpr uint8_t BC7_ANCHORS_2[64] = {15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+                                               15, 2,  8,  2,  2,  8,  8,  15, 2,  8,  2,  2,  8,  8,  2,  2,
+                                               15, 15, 6,  8,  2,  8,  15, 15, 2,  8,  2,  2,  2,  15, 15, 6,
+                                               6,  2,  6,  8,  15, 15, 2,  2,  15, 15, 15, 15, 15, 2,  2,  15};
+        constexpr uint8_t BC7_ANCHORS_3_SECOND[64] = {3,  3,  15, 15, 8,  3,  15, 15, 8,  8,  6,  6,  6,  5,  3,  3,
+                                                      3,  3,  8,  15, 3,  3,  6,  10, 5,  8,  8,  6,  8,  5,  15, 15,
+                                                      8,  15, 3,  5,  6,  10, 8,  15, 15, 3,  15, 5,  15, 15, 15, 15,
+                                                      3,  15, 5,  5,  5,  8,  5,  10, 5,  10, 8,  13, 15, 12, 3,  3};
+        constexpr uint8_t BC7_ANCHORS_3_THIRD[64] = {15, 8,  8,  3,  15, 15, 3,  8,  15, 15, 15, 15, 15, 15, 15, 8,
+                                                     15, 8,  15, 3,  15, 8,  15, 8,  3,  15, 6,  10, 15, 15, 10, 8,
+                                                     15, 3,  15, 10, 10, 8,  9,  10, 6,  15, 8,  15, 3,  6,  6,  8,
+                                                     15, 3,  15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 3,  15, 15, 8};
+
+        constexpr uint8_t BC7_WEIGHTS_2[4] = {0, 21, 43, 64};
+        constexpr uint8_t BC7_WEIGHTS_3[8] = {0, 9, 18, 27, 37, 46, 55, 64};
+        constexpr uint8_t BC7_WEIGHTS_4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+        struct Bc7Mode
+        {
+            uint32_t subsets;
+            uint32_t partitionBits;
+            uint32_t rotationBits;
+            uint32_t indexSelectionBits;
+            uint32_t colorBits;
+            uint32_t alphaBits;
+            // Either every endpoint or every subset has a p-bit, which is the shared lowest bit of its channels
+            uint32_t endpointPBits;
+            uint32_t sharedPBits;
+            uint32_t indexBits;
+            uint32_t secondaryIndexBits;
+        };
+
+        constexpr Bc7Mode BC7_MODES[8] = {{3, 4, 0, 0, 4, 0, 1, 0, 3, 0},
+                                          {2, 6, 0, 0, 6, 0, 0, 1, 3, 0},
+                                          {3, 6, 0, 0, 5, 0, 0, 0, 2, 0},
+                                          {2, 6, 0, 0, 7, 0, 1, 0, 2, 0},
+                                          {1, 0, 2, 1, 5, 6, 0, 0, 2, 3},
+                                          {1, 0, 2, 0, 7, 8, 0, 0, 2, 2},
+                                          {1, 0, 0, 0, 7, 7, 1, 0, 4, 0},
+                                          {2, 6, 0, 0, 5, 5, 1, 0, 2, 0}};
+
+        // Reads the bits of a block from the lowest bit of its first byte on
+        struct BlockBitReader
+        {
+            const uint8_t *block;
+            uint32_t position = 0;
+
+            uint32_t Read(const uint32_t Count)
+            {
+                uint32_t value = 0;
+                for (uint32_t bit = 0; bit < Count; ++bit, ++position)
+                {
+                    value |= ((block[position >> 3] >> (position & 7)) & 1u) << bit;
+                }
+                return value;
+            }
+        };
+
+        std::array<uint8_t, 4> UnpackRgb565(const uint16_t Color)
+        {
+            const uint32_t r = (Color >> 11) & 0x1F;
+            const uint32_t g = (Color >> 5) & 0x3F;
+            const uint32_t b = Color & 0x1F;
+            return {static_cast<uint8_t>(r << 3 | r >> 2),
+                    static_cast<uint8_t>(g << 2 | g >> 4),
+                    static_cast<uint8_t>(b << 3 | b >> 2),
+                    255};
+        }
+
+        // Rounds half away from zero, the signed BC4 and BC5 values may be negative
+        int32_t RoundedDivide(const int32_t Value, const int32_t Divisor)
+        {
+            return (Value >= 0 ? Value + Divisor / 2 : Value - Divisor / 2) / Divisor;
+        }
+
+        /* Colors of BC1, BC2 and BC3 blocks. Blocks with c0 <= c1 only have three colors and black, which is
+         * transparent if the format has punch through alpha. BC3 blocks always have four colors. */
+        void DecodeBc1(const uint8_t *Block, DecodedBlock &Pixels, const bool FourColors, const bool PunchThroughAlpha)
+        {
+            const auto c0 = static_cast<uint16_t>(Block[0] | Block[1] << 8);
+            const auto c1 = static_cast<uint16_t>(Block[2] | Block[3] << 8);
+
+            std::array<std::array<uint8_t, 4>, 4> palette = {UnpackRgb565(c0), UnpackRgb565(c1)};
+            for (uint32_t channel = 0; channel < 3; ++channel)
+            {
+                const uint32_t a = palette[0][channel];
+                const uint32_t b = palette[1][channel];
+                if (FourColors || c0 > c1)
+                {
+                    palette[2][channel] = static_cast<uint8_t>((2 * a + b + 1) / 3);
+                    palette[3][channel] = static_cast<uint8_t>((a + 2 * b + 1) / 3);
+                }
+                else
+                {
+                    palette[2][channel] = static_cast<uint8_t>((a + b + 1) / 2);
+                    palette[3][channel] = 0;
+                }
+            }
+            palette[2][3] = 255;
+            palette[3][3] = FourColors || c0 > c1 || !PunchThroughAlpha ? 255 : 0;
+
+            const uint32_t indices = Block[4] | Block[5] << 8 | Block[6] << 16 | static_cast<uint32_t>(Block[7]) << 24;
+            for (uint32_t pixel = 0; pixel < 16; ++pixel)
+            {
+                const auto &color = palette[(indices >> (pixel * 2)) & 3];
+                std::copy_n(color.begin(), 3, Pixels[pixel].begin());
+                Pixels[pixel][3] = color[3];
+            }
+        }
+
+        // Single channel block of BC3 alpha, BC4 and BC5, signed values are stored as their two's complement
+        void DecodeBc4(const uint8_t *Block, DecodedBlock &Pixels, const uint32_t Channel, const bool Signed)
+        {
+            // -128 is not used by snorm formats, it decodes to -1 as well
+            const int32_t e0 = Signed ? std::max<int32_t>(static_cast<int8_t>(Block[0]), -127) : Block[0];
+            const int32_t e1 = Signed ? std::max<int32_t>(static_cast<int8_t>(Block[1]), -127) : Block[1];
+
+            std::array<int32_t, 8> values = {e0, e1};
+            if (e0 > e1)
+            {
+                for (int32_t i = 1; i < 7; ++i)
+                {
+                    values[i + 1] = RoundedDivide((7 - i) * e0 + i * e1, 7);
+                }
+            }
+            else
+            {
+                for (int32_t i = 1; i < 5; ++i)
+                {
+                    values[i + 1] = RoundedDivide((5 - i) * e0 + i * e1, 5);
+                }
+                values[6] = Signed ? -127 : 0;
+                values[7] = Signed ? 127 : 255;
+            }
+
+            uint64_t indices = 0;
+            for (uint32_t byte = 0; byte < 6; ++byte)
+            {
+                indices |= static_cast<uint64_t>(Block[2 + byte]) << (byte * 8);
+            }
+            for (uint32_t pixel = 0; pixel < 16; ++pixel)
+            {
+                Pixels[pixel][Channel] = static_cast<uint8_t>(values[(indices >> (pixel * 3)) & 7]);
+            }
+        }
+
+        const uint8_t *GetBc7Weights(const uint32_t IndexBits)
+        {
+            switch (IndexBits)
+            {
+                case 2:
+                    return BC7_WEIGHTS_2;
+                case 3:
+                    return BC7_WEIGHTS_3;
+                default:
+                    return BC7_WEIGHTS_4;
+            }
+        }
+
+        void DecodeBc7(const uint8_t *Block, DecodedBlock &Pixels)
+        {
+            uint32_t mode = 0;
+            while (mode < 8 && !(Block[0] & (1u << mode)))
+            {
+                ++mode;
+            }
+
+            // Reserved mode, decoders have to return transparent black
+            if (mode == 8)
+            {
+                Pixels = {};
+                return;
+            }
+
+            const Bc7Mode &info = BC7_MODES[mode];
+            BlockBitReader reader{Block};
+            reader.Read(mode + 1);
+            const uint32_t partition = reader.Read(info.partitionBits);
+            const uint32_t rotation = reader.Read(info.rotationBits);
+            const uint32_t index_selection = reader.Read(info.indexSelectionBits);
+
+            // Every channel stores the endpoints of all subsets before the next channel starts
+            const uint32_t endpoint_count = info.subsets * 2;
+            std::array<std::array<uint32_t, 4>, 6> endpoints = {};
+            for (uint32_t channel = 0; channel < 3; ++channel)
+            {
+                for (uint32_t endpoint = 0; endpoint < endpoint_count; ++endpoint)
+                {
+                    endpoints[endpoint][channel] = reader.Read(info.colorBits);
+                }
+            }
+            for (uint32_t endpoint = 0; endpoint < endpoint_count; ++endpoint)
+            {
+                endpoints[endpoint][3] = reader.Read(info.alphaBits);
+            }
+
+            std::array<uint32_t, 6> p_bits = {};
+            for (uint32_t endpoint = 0; info.endpointPBits && endpoint < endpoint_count; ++endpoint)
+            {
+                p_bits[endpoint] = reader.Read(1);
+            }
+            for (uint32_t subset = 0; info.sharedPBits && subset < info.subsets; ++subset)
+            {
+                p_bits[subset * 2] = p_bits[subset * 2 + 1] = reader.Read(1);
+            }
+
+            // Endpoints are extended to 8 bits by repeating their highest bits
+            const bool has_p_bits = info.endpointPBits || info.sharedPBits;
+            for (uint32_t endpoint = 0; endpoint < endpoint_count; ++endpoint)
+            {
+                for (uint32_t channel = 0; channel < 4; ++channel)
+                {
+                    uint32_t bits = channel < 3 ? info.colorBits : info.alphaBits;
+                    if (bits == 0)
+                    {
+                        endpoints[endpoint][channel] = 255;
+                        continue;
+                    }
+
+                    uint32_t value = endpoints[endpoint][channel];
+                    if (has_p_bits)
+                    {
+                        value = value << 1 | p_bits[endpoint];
+                        ++bits;
+                    }
+                    value <<= 8 - bits;
+                    endpoints[endpoint][channel] = value | value >> bits;
+                }
+            }
+
+            std::array<uint32_t, 16> subsets = {};
+            for (uint32_t pixel = 0; pixel < 16; ++pixel)
+            {
+                if (info.subsets == 2)
+                    subsets[pixel] = (BC7_PARTITIONS_2[partition] >> pixel) & 1;
+                else if (info.subsets == 3)
+                    subsets[pixel] = BC7_PARTITIONS_3[partition][pixel];
+            }
+
+            const auto is_anchor = [&](const uint32_t Pixel) {
+                if (Pixel == 0)
+                    return true;
+                if (info.subsets == 2)
+                    return Pixel == BC7_ANCHORS_2[partition];
+                if (info.subsets == 3)
+                    return Pixel == BC7_ANCHORS_3_SECOND[partition] || Pixel == BC7_ANCHORS_3_THIRD[partition];
+                return false;
+            };
+
+            std::array<uint32_t, 16> indices = {};
+            for (uint32_t pixel = 0; pixel < 16; ++pixel)
+            {
+                indices[pixel] = reader.Read(info.indexBits - (is_anchor(pixel) ? 1 : 0));
+            }
+            std::array<uint32_t, 16> secondary_indices = {};
+            for (uint32_t pixel = 0; info.secondaryIndexBits && pixel < 16; ++pixel)
+            {
+                secondary_indices[pixel] = reader.Read(info.secondaryIndexBits - (pixel == 0 ? 1 : 0));
+            }
+
+            // Modes with two index sets use the primary one for the colors unless the index selection bit swaps them
+            const bool swap_indices = info.secondaryIndexBits && index_selection;
+            const auto &color_indices = swap_indices ? secondary_indices : indices;
+            const auto &alpha_indices = info.secondaryIndexBits && !swap_indices ? secondary_indices : indices;
+            const uint8_t *color_weights = GetBc7Weights(swap_indices ? info.secondaryIndexBits : info.indexBits);
+            const uint8_t *alpha_weights = GetBc7Weights(
+                info.secondaryIndexBits && !swap_indices ? info.secondaryIndexBits : info.indexBits);
+
+            for (uint32_t pixel = 0; pixel < 16; ++pixel)
+            {
+                const auto &e0 = endpoints[subsets[pixel] * 2];
+                const auto &e1 = endpoints[subsets[pixel] * 2 + 1];
+                for (uint32_t channel = 0; channel < 4; ++channel)
+                {
+                    const uint32_t weight = channel < 3 ? color_weights[color_indices[pixel]] :
+                                                          alpha_weights[alpha_indices[pixel]];
+                    Pixels[pixel][channel] = static_cast<uint8_t>(((64 - weight) * e0[channel] + weight * e1[channel] +
+                                                                   32) >>
+                                                                  6);
+                }
+
+                // Alpha is swapped with the rotated channel after decoding
+                if (rotation != 0)
+                {
+                    std::swap(Pixels[pixel][3], Pixels[pixel][rotation - 1]);
+                }
+            }
+        }
+    }  // namespace
+
+    std::optional<FormatBlockInfo> GetFormatBlockInfo(const vk::Format Format)
+    {
+        switch (Format)
+        {
+            case vk::Format::eR8G8B8A8Unorm:
+            case vk::Format::eR8G8B8A8Srgb:
+            case vk::Format::eR8G8B8A8Snorm:
+            case vk::Format::eB8G8R8A8Unorm:
+            case vk::Format::eB8G8R8A8Srgb:
+                return FormatBlockInfo{1, 1, 4};
+            case vk::Format::eBc1RgbUnormBlock:
+            case vk::Format::eBc1RgbSrgbBlock:
+            case vk::Format::eBc1RgbaUnormBlock:
+            case vk::Format::eBc1RgbaSrgbBlock:
+            case vk::Format::eBc4UnormBlock:
+            case vk::Format::eBc4SnormBlock:
+                return FormatBlockInfo{4, 4, 8};
+            case vk::Format::eBc3UnormBlock:
+            case vk::Format::eBc3SrgbBlock:
+            case vk::Format::eBc5UnormBlock:
+            case vk::Format::eBc5SnormBlock:
+            case vk::Format::eBc7UnormBlock:
+            case vk::Format::eBc7SrgbBlock:
+                return FormatBlockInfo{4, 4, 16};
+            case vk::Format::eAstc4x4UnormBlock:
+            case vk::Format::eAstc4x4SrgbBlock:
+                return FormatBlockInfo{4, 4, 16};
+            case vk::Format::eAstc5x4UnormBlock:
+            case vk::Format::eAstc5x4SrgbBlock:
+                return FormatBlockInfo{5, 4, 16};
+            case vk::Format::eAstc5x5UnormBlock:
+            case vk::Format::eAstc5x5SrgbBlock:
+                return FormatBlockInfo{5, 5, 16};
+            case vk::Format::eAstc6x5UnormBlock:
+            case vk::Format::eAstc6x5SrgbBlock:
+                return FormatBlockInfo{6, 5, 16};
+            case vk::Format::eAstc6x6UnormBlock:
+            case vk::Format::eAstc6x6SrgbBlock:
+                return FormatBlockInfo{6, 6, 16};
+            case vk::Format::eAstc8x5UnormBlock:
+            case vk::Format::eAstc8x5SrgbBlock:
+                return FormatBlockInfo{8, 5, 16};
+            case vk::Format::eAstc8x6UnormBlock:
+            case vk::Format::eAstc8x6SrgbBlock:
+                return FormatBlockInfo{8, 6, 16};
+            case vk::Format::eAstc8x8UnormBlock:
+            case vk::Format::eAstc8x8SrgbBlock:
+                return FormatBlockInfo{8, 8, 16};
+            case vk::Format::eAstc10x5UnormBlock:
+            case vk::Format::eAstc10x5SrgbBlock:
+                return FormatBlockInfo{10, 5, 16};
+            case vk::Format::eAstc10x6UnormBlock:
+            case vk::Format::eAstc10x6SrgbBlock:
+                return FormatBlockInfo{10, 6, 16};
+            case vk::Format::eAstc10x8UnormBlock:
+            case vk::Format::eAstc10x8SrgbBlock:
+                return FormatBlockInfo{10, 8, 16};
+            case vk::Format::eAstc10x10UnormBlock:
+            case vk::Format::eAstc10x10SrgbBlock:
+                return FormatBlockInfo{10, 10, 16};
+            case vk::Format::eAstc12x10UnormBlock:
+            case vk::Format::eAstc12x10SrgbBlock:
+                return FormatBlockInfo{12, 10, 16};
+            case vk::Format::eAstc12x12UnormBlock:
+            case vk::Format::eAstc12x12SrgbBlock:
+                return FormatBlockInfo{12, 12, 16};
+            default:
+                return {};
+        }
+    }
+
+    bool IsBlockCompressed(const vk::Format Format)
+    {
+        const auto info = GetFormatBlockInfo(Format);
+        return info && (info->width > 1 || info->height > 1);
+    }
+
+    bool IsSrgbFormat(const vk::Format Format)
+    {
+        switch (Format)
+        {
+            case vk::Format::eR8G8B8A8Srgb:
+            case vk::Format::eB8G8R8A8Srgb:
+            case vk::Format::eBc1RgbSrgbBlock:
+            case vk::Format::eBc1RgbaSrgbBlock:
+            case vk::Format::eBc3SrgbBlock:
+            case vk::Format::eBc7SrgbBlock:
+            case vk::Format::eAstc4x4SrgbBlock:
+            case vk::Format::eAstc5x4SrgbBlock:
+            case vk::Format::eAstc5x5SrgbBlock:
+            case vk::Format::eAstc6x5SrgbBlock:
+            case vk::Format::eAstc6x6SrgbBlock:
+            case vk::Format::eAstc8x5SrgbBlock:
+            case vk::Format::eAstc8x6SrgbBlock:
+            case vk::Format::eAstc8x8SrgbBlock:
+            case vk::Format::eAstc10x5SrgbBlock:
+            case vk::Format::eAstc10x6SrgbBlock:
+            case vk::Format::eAstc10x8SrgbBlock:
+            case vk::Format::eAstc10x10SrgbBlock:
+            case vk::Format::eAstc12x10SrgbBlock:
+            case vk::Format::eAstc12x12SrgbBlock:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    uint64_t GetLevelBytes(const vk::Format Format, const vk::Extent3D Extent)
+    {
+        const auto info = GetFormatBlockInfo(Format);
+        ASSERT(info, "Format {} is not supported for textures!", vk::to_string(Format))
+
+        const uint64_t blocks_x = (Extent.width + info->width - 1) / info->width;
+        const uint64_t blocks_y = (Extent.height + info->height - 1) / info->height;
+        return blocks_x * blocks_y * std::max(Extent.depth, 1u) * info->bytes;
+    }
+
+    std::optional<vk::Format> GetDecodedFormat(const vk::Format Format)
+    {
+        switch (Format)
+        {
+            case vk::Format::eBc1RgbUnormBlock:
+            case vk::Format::eBc1RgbaUnormBlock:
+            case vk::Format::eBc3UnormBlock:
+            case vk::Format::eBc4UnormBlock:
+            case vk::Format::eBc5UnormBlock:
+            case vk::Format::eBc7UnormBlock:
+                return vk::Format::eR8G8B8A8Unorm;
+            case vk::Format::eBc1RgbSrgbBlock:
+            case vk::Format::eBc1RgbaSrgbBlock:
+            case vk::Format::eBc3SrgbBlock:
+            case vk::Format::eBc7SrgbBlock:
+                return vk::Format::eR8G8B8A8Srgb;
+            case vk::Format::eBc4SnormBlock:
+            case vk::Format::eBc5SnormBlock:
+                return vk::Format::eR8G8B8A8Snorm;
+            default:
+                return {};
+        }
+    }
+
+    std::vector<uint8_t> DecodeBlocks(const vk::Format Format,
+                                      const vk::Extent3D Extent,
+                                      const std::span<const uint8_t> Blocks)
+    {
+        PROFILE_ZONE("DecodeBlocks");
+
+        ASSERT(GetDecodedFormat(Format), "There is no cpu decoder for format {}!", vk::to_string(Format))
+        ASSERT(Blocks.size() >= GetLevelBytes(Format, Extent),
+               "Level of format {} is smaller than its extent!",
+               vk::to_string(Format))
+
+        const uint32_t block_bytes = GetFormatBlockInfo(Format)->bytes;
+        const uint32_t blocks_x = (Extent.width + 3) / 4;
+        const uint32_t blocks_y = (Extent.height + 3) / 4;
+
+        std::vector<uint8_t> pixels(static_cast<size_t>(Extent.width) * Extent.height * 4);
+        DecodedBlock decoded;
+        for (uint32_t block_y = 0; block_y < blocks_y; ++block_y)
+        {
+            for (uint32_t block_x = 0; block_x < blocks_x; ++block_x)
+            {
+                const uint8_t *block = Blocks.data() +
+                    (static_cast<size_t>(block_y) * blocks_x + block_x) * block_bytes;
+
+                // Channels the format does not have read as 0 and alpha as 1
+                switch (Format)
+                {
+                    case vk::Format::eBc1RgbUnormBlock:
+                    case vk::Format::eBc1RgbSrgbBlock:
+                        DecodeBc1(block, decoded, false, false);
+                        break;
+                    case vk::Format::eBc1RgbaUnormBlock:
+                    case vk::Format::eBc1RgbaSrgbBlock:
+                        DecodeBc1(block, decoded, false, true);
+                        break;
+                    case vk::Format::eBc3UnormBlock:
+                    case vk::Format::eBc3SrgbBlock:
+                        DecodeBc1(block + 8, decoded, true, false);
+                        DecodeBc4(block, decoded, 3, false);
+                        break;
+                    case vk::Format::eBc4UnormBlock:
+                        decoded.fill({0, 0, 0, 255});
+                        DecodeBc4(block, decoded, 0, false);
+                        break;
+                    case vk::Format::eBc4SnormBlock:
+                        decoded.fill({0, 0, 0, 127});
+                        DecodeBc4(block, decoded, 0, true);
+                        break;
+                    case vk::Format::eBc5UnormBlock:
+                        decoded.fill({0, 0, 0, 255});
+                        DecodeBc4(block, decoded, 0, false);
+                        DecodeBc4(block + 8, decoded, 1, false);
+                        break;
+                    case vk::Format::eBc5SnormBlock:
+                        decoded.fill({0, 0, 0, 127});
+                        DecodeBc4(block, decoded, 0, true);
+                        DecodeBc4(block + 8, decoded, 1, true);
+                        break;
+                    default:
+                        DecodeBc7(block, decoded);
+                        break;
+                }
+
+                // Blocks at the right and bottom edge may reach past the level
+                const uint32_t width = std::min(4u, Extent.width - block_x * 4);
+                const uint32_t height = std::min(4u, Extent.height - block_y * 4);
+                for (uint32_t y = 0; y < height; ++y)
+                {
+                    for (uint32_t x = 0; x < width; ++x)
+                    {
+                        const size_t pixel = (static_cast<size_t>(block_y * 4 + y) * Extent.width + block_x * 4 + x) *
+                            4;
+                        std::copy_n(decoded[y * 4 + x].begin(), 4, pixels.begin() + pixel);
+                    }
+                }
+            }
+        }
+        return pixels;
+    }
+}  // namespace Slipper::GPU::Vulkan
@@ -0,0 +1,183 @@
+#include "../vk_ClusteredLighting.h"
+
+#include "CameraComponent.h"
+#include "GraphicsEngine.h"
+#include "LightComponent.h"
+#include "ShaderManager.h"
+#include "Vulkan/vk_BindlessHeap.h"
+#include "Vulkan/vk_Buffer.h"
+#include "Vulkan/vk_ComputeShader.h"
+#include "Vulkan/vk_GpuProfiler.h"
+#include "Vulkan/vk_RenderingStage.h"
+#include "Vulkan/vk_ShadowAtlas.h"
+
+namespace Slipper::GPU::Vulkan
+{
+    // Must match the push constant block of Shaders/ClusterCull.comp
+    struct LightCullPushConstants
+    {
+        uint32_t lightBuffer;
+    };
+
+    // Must match local_size_x of Shaders/ClusterCull.comp
+    constexpr uint32_t CLUSTER_CULL_GROUP_SIZE = 64;
+
+    ClusteredLighting::ClusteredLighting(AssetHandle<ComputeShader> CullShader) : m_cullShader(std::move(CullShader))
+    {
+        m_lights.reserve(MAX_CLUSTERED_LIGHTS);
+    }
+
+    ClusteredLighting::~ClusteredLighting()
+    {
+        for (auto &view : m_views | std::views::values)
+        {
+            for (uint32_t frame = 0; frame < MAX_FRAMES_IN_FLIGHT; ++frame)
+            {
+                BindlessHeap::Get().ReleaseBuffer(view.lightBufferIndices[frame]);
+                BindlessHeap::Get().ReleaseBuffer(view.clusterBufferIndices[frame]);
+                vkUnmapMemory(device, static_cast<VkDeviceMemory>(*view.lightBuffers[frame]));
+            }
+        }
+        m_views.clear();
+    }
+
+    void ClusteredLighting::Init()
+    {
+        ASSERT(!m_instance, "Clustered lighting already created!")
+
+        // Shaders can only find the light and cluster buffers through the heap
+        if (!BindlessHeap::IsAvailable())
+        {
+            LOG("Clustered lighting needs the bindless heap, lit shaders will render unlit.")
+            return;
+        }
+
+        m_instance = new ClusteredLighting(
+            ShaderManager::LoadComputeShader("./EngineContent/Shaders/Spir-V/ClusterCull.comp.spv"));
+    }
+
+    void ClusteredLighting::Shutdown()
+    {
+        delete m_instance;
+        m_instance = nullptr;
+    }
+
+    void ClusteredLighting::BeginFrame()
+    {
+        m_stats.submittedLights = static_cast<uint32_t>(m_lights.size());
+        m_stats.views = m_recordedViews;
+        m_recordedViews = 0;
+        m_lights.clear();
+    }
+
+    void ClusteredLighting::SubmitLight(const glm::vec3 Location, const Light &Light, const uint32_t Shadow)
+    {
+        m_lights.push_back(
+            {glm::vec4(Location, Light.range), glm::vec4(Light.color * Light.intensity, std::bit_cast<float>(Shadow))});
+    }
+
+    void ClusteredLighting::Record(VKRenderingStage &Stage,
+                                   const vk::CommandBuffer ComputeCommandBuffer,
+                                   const uint32_t Frame)
+    {
+        PROFILE_ZONE("ClusteredLighting::Record");
+
+        auto &view = GetView(Stage);
+
+        const vk::Extent2D resolution = Stage.GetSwapChain()->GetRenderResolution();
+        const auto &camera = GraphicsEngine::GetDefaultCamera().GetComponent<Camera>();
+        const glm::mat4 view_matrix = camera.GetView();
+        const glm::mat4 projection = camera.GetProjection(static_cast<float>(resolution.width) / resolution.height);
+        const float log_depth_range = std::log(camera.farPlane / camera.nearPlane);
+
+        auto *header = static_cast<LightBufferHeader *>(view.mappedLightBuffers[Frame]);
+        auto *lights = reinterpret_cast<GpuLight *>(header + 1);
+
+        // Lights that can not reach the depth range of the grid would never be binned anyways
+        uint32_t light_count = 0;
+        for (const auto &light : m_lights)
+        {
+            if (light_count == MAX_CLUSTERED_LIGHTS)
+                break;
+
+            const glm::vec3 position = view_matrix * glm::vec4(glm::vec3(light.positionRange), 1.0f);
+            const float range = light.positionRange.w;
+            if (position.z - range > -camera.nearPlane || position.z + range < -camera.farPlane)
+                continue;
+
+            lights[light_count++] = {glm::vec4(position, range), light.color};
+        }
+
+        *header = {
+            .clusterBuffer = view.clusterBufferIndices[Frame],
+            .lightCount = light_count,
+            .gridSize = {CLUSTER_GRID_X, CLUSTER_GRID_Y, CLUSTER_GRID_Z},
+            .tileSize = {static_cast<float>(resolution.width) / CLUSTER_GRID_X,
+                         static_cast<float>(resolution.height) / CLUSTER_GRID_Y},
+            .nearPlane = camera.nearPlane,
+            .farPlane = camera.farPlane,
+            .sliceScale = CLUSTER_GRID_Z / log_depth_range,
+            .sliceBias = CLUSTER_GRID_Z * std::log(camera.nearPlane) / log_depth_range,
+            .p00 = projection[0][0],
+            .p11 = projection[1][1],
+            .maxLightsPerCluster = MAX_LIGHTS_PER_CLUSTER,
+            .resolution = {static_cast<float>(resolution.width), static_cast<float>(resolution.height)},
+            .shadowBuffer = ShadowAtlas::IsAvailable() ? ShadowAtlas::Get().GetShadowBuffer(Frame) :
+                                                         INVALID_BINDLESS_INDEX,
+            .reserved = {}};
+
+        view.recordedFrames[Frame] = FRAME_COUNT;
+        m_stats.uploadedLights = light_count;
+        ++m_recordedViews;
+
+        // The clusters are rebuilt even without lights, stale counts of an earlier frame would be read otherwise
+        GPU_PROFILE_SCOPE(ComputeCommandBuffer, "Light Culling");
+        m_cullShader->Push(ComputeCommandBuffer, LightCullPushConstants{view.lightBufferIndices[Frame]});
+        m_cullShader->Dispatch(
+            ComputeCommandBuffer, (CLUSTER_COUNT + CLUSTER_CULL_GROUP_SIZE - 1) / CLUSTER_CULL_GROUP_SIZE, 1, 1);
+    }
+
+    uint32_t ClusteredLighting::GetLightBuffer(const VKRenderingStage &Stage, const uint32_t Frame) const
+    {
+        const auto view = m_views.find(&Stage);
+        if (view == m_views.end() || view->second.recordedFrames[Frame] != FRAME_COUNT)
+            return INVALID_BINDLESS_INDEX;
+
+        return view->second.lightBufferIndices[Frame];
+    }
+
+    ClusteredLighting::View &ClusteredLighting::GetView(const VKRenderingStage &Stage)
+    {
+        if (const auto view = m_views.find(&Stage); view != m_views.end())
+            return view->second;
+
+        constexpr VkDeviceSize light_buffer_size = sizeof(LightBufferHeader) +
+            sizeof(GpuLight) * MAX_CLUSTERED_LIGHTS;
+        constexpr VkDeviceSize cluster_buffer_size = sizeof(uint32_t) * CLUSTER_COUNT * (MAX_LIGHTS_PER_CLUSTER + 1);
+
+        auto &view = m_views[&Stage];
+        view.recordedFrames.fill(std::numeric_limits<uint64_t>::max());
+        for (uint32_t frame = 0; frame < MAX_FRAMES_IN_FLIGHT; ++frame)
+        {
+            // Rewritten every frame from the cpu, so it stays mapped and is read straight from host memory
+            view.lightBuffers[frame] = new Buffer(light_buffer_size,
+                                                  VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                                                  VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                                                      VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+            VK_ASSERT(vkMapMemory(device,
+                                  static_cast<VkDeviceMemory>(*view.lightBuffers[frame]),
+                                  0,
+                                  light_buffer_size,
+                                  0,
+                                  &view.mappedLightBuffers[frame]),
+                      "Failed to map light buffer!")
+            view.lightBufferIndices[frame] = BindlessHeap::Get().RegisterBuffer(*view.lightBuffers[frame]);
+
+            // Only ever written by the cull shader
+            view.clusterBuffers[frame] = new Buffer(
+                cluster_buffer_size, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+            view.clusterBufferIndices[frame] = BindlessHeap::Get().RegisterBuffer(*view.clusterBuffers[frame]);
+        }
+        return view;
+    }
+}  // namespace Slipper::GPU::Vulkan
@@ -0,0 +1,202 @@
+#include "../vk_CommandContext.h"
+
+namespace Slipper::GPU::Vulkan
+{
+    void CommandContextStats::Add(const CommandContextStats &Other)
+    {
+        pipelineBinds.Add(Other.pipelineBinds);
+        descriptorSetBinds.Add(Other.descriptorSetBinds);
+        vertexBufferBinds.Add(Other.vertexBufferBinds);
+        indexBufferBinds.Add(Other.indexBufferBinds);
+        viewports.Add(Other.viewports);
+        scissors.Add(Other.scissors);
+        pushConstants += Other.pushConstants;
+        draws += Other.draws;
+    }
+
+    CommandCounter CommandContextStats::Total() const
+    {
+        CommandCounter total;
+        total.Add(pipelineBinds);
+        total.Add(descriptorSetBinds);
+        total.Add(vertexBufferBinds);
+        total.Add(indexBufferBinds);
+        total.Add(viewports);
+        total.Add(scissors);
+        return total;
+    }
+
+    CommandContext::CommandContext(const vk::CommandBuffer CommandBuffer)
+    {
+        Reset(CommandBuffer);
+    }
+
+    void CommandContext::Reset(const vk::CommandBuffer CommandBuffer)
+    {
+        m_commandBuffer = CommandBuffer;
+        Invalidate();
+    }
+
+    void CommandContext::Invalidate()
+    {
+        m_graphicsState = {};
+        m_computeState = {};
+        m_vertexBuffers = {};
+        m_indexBuffer = VK_NULL_HANDLE;
+        m_indexBufferOffset = 0;
+        m_viewport.reset();
+        m_scissor.reset();
+    }
+
+    void CommandContext::BindPipeline(const vk::PipelineBindPoint BindPoint, const vk::Pipeline Pipeline)
+    {
+        auto &state = GetBindPointState(BindPoint);
+        if (state.pipeline == Pipeline)
+        {
+            m_stats.pipelineBinds.elided++;
+            return;
+        }
+
+        m_commandBuffer.bindPipeline(BindPoint, Pipeline);
+        state.pipeline = Pipeline;
+        m_stats.pipelineBinds.issued++;
+    }
+
+    void CommandContext::BindDescriptorSets(const vk::PipelineBindPoint BindPoint,
+                                            const vk::PipelineLayout Layout,
+                                            const uint32_t FirstSet,
+                                            const std::span<const vk::DescriptorSet> DescriptorSets)
+    {
+        if (DescriptorSets.empty())
+            return;
+
+        auto &state = GetBindPointState(BindPoint);
+
+        // Sets bound with another layout are not tracked since they might have been disturbed
+        if (state.layout != Layout)
+        {
+            state.layout = Layout;
+            state.descriptorSets.clear();
+        }
+
+        if (state.descriptorSets.size() < FirstSet + DescriptorSets.size())
+        {
+            state.descriptorSets.resize(FirstSet + DescriptorSets.size());
+        }
+
+        // Only rebind the range of sets that actually changed
+        std::optional<uint32_t> first_changed;
+        uint32_t last_changed = 0;
+        for (uint32_t i = 0; i < DescriptorSets.size(); ++i)
+        {
+            if (state.descriptorSets[FirstSet + i] != DescriptorSets[i])
+            {
+                if (!first_changed.has_value())
+                    first_changed = i;
+                last_changed = i;
+            }
+        }
+
+        if (!first_changed.has_value())
+        {
+            m_stats.descriptorSetBinds.elided++;
+            return;
+        }
+
+        const auto changed_sets = DescriptorSets.subspan(first_changed.value(),
+                                                         last_changed - first_changed.value() + 1);
+        m_commandBuffer.bindDescriptorSets(BindPoint,
+                                           Layout,
+                                           FirstSet + first_changed.value(),
+                                           static_cast<uint32_t>(changed_sets.size()),
+                                           changed_sets.data(),
+                                           0,
+                                           nullptr);
+        std::ranges::copy(changed_sets, state.descriptorSets.begin() + FirstSet + first_changed.value());
+        m_stats.descriptorSetBinds.issued++;
+    }
+
+    void CommandContext::BindVertexBuffer(const uint32_t Binding, const vk::Buffer Buffer, const vk::DeviceSize Offset)
+    {
+        ASSERT(Binding < MAX_VERTEX_BINDINGS, "Vertex binding {} is not tracked by the command context.", Binding)
+
+        auto &bound_buffer = m_vertexBuffers[Binding];
+        if (bound_buffer.first == Buffer && bound_buffer.second == Offset)
+        {
+            m_stats.vertexBufferBinds.elided++;
+            return;
+        }
+
+        m_commandBuffer.bindVertexBuffers(Binding, 1, &Buffer, &Offset);
+        bound_buffer = {Buffer, Offset};
+        m_stats.vertexBufferBinds.issued++;
+    }
+
+    void CommandContext::BindIndexBuffer(const vk::Buffer Buffer,
+                                         const vk::DeviceSize Offset,
+                                         const vk::IndexType IndexType)
+    {
+        if (m_indexBuffer == Buffer && m_indexBufferOffset == Offset && m_indexType == IndexType)
+        {
+            m_stats.indexBufferBinds.elided++;
+            return;
+        }
+
+        m_commandBuffer.bindIndexBuffer(Buffer, Offset, IndexType);
+        m_indexBuffer = Buffer;
+        m_indexBufferOffset = Offset;
+        m_indexType = IndexType;
+        m_stats.indexBufferBinds.issued++;
+    }
+
+    void CommandContext::SetViewport(const vk::Viewport &Viewport)
+    {
+        if (m_viewport.has_value() && m_viewport.value() == Viewport)
+        {
+            m_stats.viewports.elided++;
+            return;
+        }
+
+        m_commandBuffer.setViewport(0, Viewport);
+        m_viewport = Viewport;
+        m_stats.viewports.issued++;
+    }
+
+    void CommandContext::SetScissor(const vk::Rect2D &Scissor)
+    {
+        if (m_scissor.has_value() && m_scissor.value() == Scissor)
+        {
+            m_stats.scissors.elided++;
+            return;
+        }
+
+        m_commandBuffer.setScissor(0, Scissor);
+        m_scissor = Scissor;
+        m_stats.scissors.issued++;
+    }
+
+    void CommandContext::PushConstants(const vk::PipelineLayout Layout,
+                                       const vk::ShaderStageFlags StageFlags,
+                                       const uint32_t Offset,
+                                       const uint32_t Size,
+                                       const void *Data)
+    {
+        m_commandBuffer.pushConstants(Layout, StageFlags, Offset, Size, Data);
+        m_stats.pushConstants++;
+    }
+
+    void CommandContext::DrawIndexed(const uint32_t IndexCount,
+                                     const uint32_t InstanceCount,
+                                     const uint32_t FirstIndex,
+                                     const int32_t VertexOffset,
+                                     const uint32_t FirstInstance)
+    {
+        m_commandBuffer.drawIndexed(IndexCount, InstanceCount, FirstIndex, VertexOffset, FirstInstance);
+        m_stats.draws++;
+    }
+
+    CommandContext::BindPointState &CommandContext::GetBindPointState(const vk::PipelineBindPoint BindPoint)
+    {
+        return BindPoint == vk::PipelineBindPoint::eCompute ? m_computeState : m_graphicsState;
+    }
+}  // namespace Slipper::GPU::Vulkan
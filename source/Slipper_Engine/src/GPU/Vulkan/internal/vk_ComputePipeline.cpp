@@ -5,9 +5,11 @@
 namespace Slipper::GPU::Vulkan
 {
     ComputePipeline::ComputePipeline(const vk::PipelineShaderStageCreateInfo &ComputeShader,
-                                     vk::DescriptorSetLayout &Layout)
+                                     const std::vector<vk::DescriptorSetLayout> &DescriptorSetLayouts,
+                                     const std::vector<vk::PushConstantRange> &PushConstantRanges)
     {
-        vk::PipelineLayoutCreateInfo layout_create_info(vk::PipelineLayoutCreateFlags{}, Layout);
+        vk::PipelineLayoutCreateInfo layout_create_info(
+            vk::PipelineLayoutCreateFlags{}, DescriptorSetLayouts, PushConstantRanges);
         VK_HPP_ASSERT(device.logicalDevice.createPipelineLayout(&layout_create_info, nullptr, &vkPipelineLayout),
                       "Compute Pipeline Layout Creation Failed");
 
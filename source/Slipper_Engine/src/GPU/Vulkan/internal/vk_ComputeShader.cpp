@@ -4,15 +4,21 @@
 
 namespace Slipper::GPU::Vulkan
 {
-    ComputeShader::ComputeShader(std::string_view ComputeShaderPath) : Shader()
+    ComputeShader::ComputeShader(std::string_view ComputeShaderPath)
+        : ComputeShader(ReadCode(std::array{std::tuple(ComputeShaderPath, ShaderType::COMPUTE)}))
     {
-        LoadShader(ComputeShaderPath);
+    }
+
+    ComputeShader::ComputeShader(ShaderCode &&Code) : Shader()
+    {
+        LoadShader(std::move(Code));
 
-        CreateDescriptorPool();
         CreateDescriptorSetLayouts();
         AllocateDescriptorSets();
 
         CreateUniformBuffers();
+
+        CreateComputePipeline();
     }
 
     ComputeShader::~ComputeShader()
@@ -26,6 +32,8 @@ namespace Slipper::GPU::Vulkan
                                  uint32_t GroupCountY,
                                  uint32_t GroupCountZ) const
     {
+        ASSERT(m_computePipeline, "Compute shader '{}' has no pipeline!", name)
+
         CommandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, *m_computePipeline);
         CommandBuffer.bindDescriptorSets(
             vk::PipelineBindPoint::eCompute, m_computePipeline->vkPipelineLayout, 0, GetDescriptorSets(), {});
@@ -33,22 +41,41 @@ namespace Slipper::GPU::Vulkan
         CommandBuffer.dispatch(GroupCountX, GroupCountY, GroupCountZ);
     }
 
-    void ComputeShader::LoadShader(const std::string_view ShaderPath)
+    vk::PipelineLayout ComputeShader::GetPipelineLayout() const
     {
+        ASSERT(m_computePipeline, "Compute shader '{}' has no pipeline!", name)
+
+        return m_computePipeline->vkPipelineLayout;
+    }
+
+    void ComputeShader::LoadShader(ShaderCode &&Code)
+    {
+        ASSERT(Code.stages.size() == 1 && Code.stages.front().type == ShaderType::COMPUTE,
+               "Compute shaders consist of a single compute stage!")
+
+        const ShaderStageCode &stage = Code.stages.front();
         ShaderStage new_shader_stage;
-        name = File::get_file_name_from_path(ShaderPath);
-        std::vector<char> shader_code = File::read_binary_file(ShaderPath);
-        new_shader_stage.shaderModule = CreateShaderModule(shader_code);
+        name = File::get_file_name_from_path(stage.filepath);
+        new_shader_stage.shaderModule = CreateShaderModule(stage.code);
         new_shader_stage.pipelineStageCrateInfo = CreateShaderStage(ShaderType::COMPUTE, new_shader_stage.shaderModule);
         m_shaderStage = new_shader_stage;
 
-        shaderLayout = new ShaderLayout({shader_code});
+        shaderLayout = Code.layout.release();
+        ASSERT(shaderLayout, "Compute shader '{}' has no reflected layout!", name)
     }
 
     ComputePipeline &ComputeShader::CreateComputePipeline()
     {
-        m_computePipeline = new ComputePipeline((m_shaderStage).pipelineStageCrateInfo,
-                                                m_vkDescriptorSetLayouts.begin()->second);
+        // Every set has to be part of the layout, Dispatch binds all of them starting at set 0
+        std::vector<vk::DescriptorSetLayout> layouts;
+        layouts.reserve(m_vkDescriptorSetLayouts.size());
+        for (const auto descriptor_set_layout : m_vkDescriptorSetLayouts | std::views::values)
+        {
+            layouts.push_back(descriptor_set_layout);
+        }
+
+        m_computePipeline = new ComputePipeline(
+            m_shaderStage.pipelineStageCrateInfo, layouts, shaderLayout->GetVkPushConstantRanges());
         return *m_computePipeline;
     }
 }  // namespace Slipper::GPU::Vulkan
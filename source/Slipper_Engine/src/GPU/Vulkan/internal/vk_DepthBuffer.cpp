@@ -1,17 +1,17 @@
 #include "../vk_DepthBuffer.h"
 
-#include "GraphicsSettings.h"
-
 
 namespace Slipper::GPU::Vulkan
 {
-    DepthBuffer::DepthBuffer(const VkExtent2D Extent, const vk::Format Format)
+    DepthBuffer::DepthBuffer(const VkExtent2D Extent,
+                             const vk::Format Format,
+                             const vk::SampleCountFlagBits NumSamples)
         : Texture(vk::ImageType::e2D,
                   VkExtent3D(Extent.width, Extent.height, 1),
                   Format,
                   {},
                   false,
-                  static_cast<vk::SampleCountFlagBits>(GraphicsSettings::MSAA_SAMPLES),
+                  NumSamples,
                   vk::ImageTiling::eOptimal,
                   vk::ImageUsageFlagBits::eDepthStencilAttachment,
                   vk::ImageAspectFlagBits::eDepth,
@@ -0,0 +1,288 @@
+#include "../vk_DescriptorAllocator.h"
+
+#include "Vulkan/vk_Device.h"
+#include "Vulkan/vk_IShaderBindableData.h"
+
+namespace Slipper::GPU::Vulkan
+{
+    namespace
+    {
+        // Amount of descriptors of each type reserved per set in a pool
+        struct PoolSizeRatio
+        {
+            vk::DescriptorType type;
+            float ratio;
+        };
+
+        constexpr std::array POOL_SIZE_RATIOS = {
+            PoolSizeRatio{vk::DescriptorType::eUniformBuffer, 2.0f},
+            PoolSizeRatio{vk::DescriptorType::eCombinedImageSampler, 2.0f},
+            PoolSizeRatio{vk::DescriptorType::eStorageBuffer, 1.0f},
+            PoolSizeRatio{vk::DescriptorType::eStorageImage, 0.5f},
+            PoolSizeRatio{vk::DescriptorType::eSampledImage, 0.5f},
+            PoolSizeRatio{vk::DescriptorType::eSampler, 0.5f},
+            PoolSizeRatio{vk::DescriptorType::eUniformBufferDynamic, 0.5f},
+            PoolSizeRatio{vk::DescriptorType::eStorageBufferDynamic, 0.5f},
+        };
+
+        constexpr uint32_t PERSISTENT_SETS_PER_POOL = 64;
+        constexpr uint32_t FRAME_SETS_PER_POOL = 256;
+    }  // namespace
+
+    DescriptorResource DescriptorResource::FromBindable(const uint32_t Binding, const IShaderBindableData &Data)
+    {
+        return DescriptorResource{
+            Binding, Data.GetDescriptorType(), Data.GetDescriptorBufferInfo(), Data.GetDescriptorImageInfo()};
+    }
+
+    DescriptorPoolChain::DescriptorPoolChain(const vk::DescriptorPoolCreateFlags Flags,
+                                             const uint32_t InitialSetsPerPool)
+        : m_flags(Flags), m_setsPerPool(InitialSetsPerPool)
+    {
+    }
+
+    DescriptorPoolChain::~DescriptorPoolChain()
+    {
+        for (const auto pool : m_readyPools)
+        {
+            device.logicalDevice.destroyDescriptorPool(pool);
+        }
+        for (const auto pool : m_fullPools)
+        {
+            device.logicalDevice.destroyDescriptorPool(pool);
+        }
+    }
+
+    vk::DescriptorSet DescriptorPoolChain::Allocate(const vk::DescriptorSetLayout Layout,
+                                                    DescriptorAllocatorStats &Stats,
+                                                    vk::DescriptorPool *OutPool)
+    {
+        vk::DescriptorPool pool = GrabPool(Stats);
+
+        vk::DescriptorSetAllocateInfo allocate_info(pool, 1, &Layout);
+        vk::DescriptorSet set;
+        vk::Result result = device.logicalDevice.allocateDescriptorSets(&allocate_info, &set);
+
+        if (result == vk::Result::eErrorOutOfPoolMemory || result == vk::Result::eErrorFragmentedPool)
+        {
+            // Current pool is exhausted, retire it and retry once with a fresh pool
+            m_readyPools.pop_back();
+            m_fullPools.push_back(pool);
+
+            pool = GrabPool(Stats);
+            allocate_info.descriptorPool = pool;
+            result = device.logicalDevice.allocateDescriptorSets(&allocate_info, &set);
+        }
+
+        VK_HPP_ASSERT(result, "Failed to allocate descriptor set!")
+
+        Stats.setsAllocated++;
+        if (OutPool)
+        {
+            *OutPool = pool;
+        }
+        return set;
+    }
+
+    void DescriptorPoolChain::Free(const vk::DescriptorPool Pool, const vk::DescriptorSet Set)
+    {
+        ASSERT(m_flags & vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet,
+               "Descriptor pool chain does not support freeing individual sets.")
+
+        device.logicalDevice.freeDescriptorSets(Pool, Set);
+
+        // The pool has space again so it can be handed out for new allocations
+        if (const auto full_it = std::ranges::find(m_fullPools, Pool); full_it != m_fullPools.end())
+        {
+            m_fullPools.erase(full_it);
+            m_readyPools.insert(m_readyPools.begin(), Pool);
+        }
+    }
+
+    void DescriptorPoolChain::Reset(DescriptorAllocatorStats &Stats)
+    {
+        for (const auto pool : m_readyPools)
+        {
+            device.logicalDevice.resetDescriptorPool(pool);
+        }
+        for (const auto pool : m_fullPools)
+        {
+            device.logicalDevice.resetDescriptorPool(pool);
+            m_readyPools.push_back(pool);
+        }
+        m_fullPools.clear();
+        Stats.poolResets++;
+    }
+
+    vk::DescriptorPool DescriptorPoolChain::GrabPool(DescriptorAllocatorStats &Stats)
+    {
+        if (!m_readyPools.empty())
+        {
+            return m_readyPools.back();
+        }
+
+        const vk::DescriptorPool new_pool = CreatePool(m_setsPerPool);
+        m_setsPerPool = std::min(m_setsPerPool + m_setsPerPool / 2, MAX_SETS_PER_POOL);
+        m_readyPools.push_back(new_pool);
+        Stats.poolsCreated++;
+        return new_pool;
+    }
+
+    vk::DescriptorPool DescriptorPoolChain::CreatePool(const uint32_t SetCount) const
+    {
+        std::vector<vk::DescriptorPoolSize> pool_sizes;
+        pool_sizes.reserve(POOL_SIZE_RATIOS.size());
+        for (const auto &[type, ratio] : POOL_SIZE_RATIOS)
+        {
+            pool_sizes.emplace_back(type, std::max(1u, static_cast<uint32_t>(ratio * static_cast<float>(SetCount))));
+        }
+
+        const vk::DescriptorPoolCreateInfo pool_info(m_flags, SetCount, pool_sizes);
+
+        vk::DescriptorPool pool;
+        VK_HPP_ASSERT(device.logicalDevice.createDescriptorPool(&pool_info, nullptr, &pool),
+                      "Failed to create descriptor pool!")
+        return pool;
+    }
+
+    DescriptorAllocator::DescriptorAllocator()
+    {
+        m_persistentPools = new DescriptorPoolChain(vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet,
+                                                    PERSISTENT_SETS_PER_POOL);
+        for (auto &frame_pool : m_framePools)
+        {
+            frame_pool = new DescriptorPoolChain({}, FRAME_SETS_PER_POOL);
+        }
+    }
+
+    DescriptorAllocator::~DescriptorAllocator()
+    {
+        m_frameSetCaches = {};
+        for (auto &frame_pool : m_framePools)
+        {
+            frame_pool.reset();
+        }
+
+        m_persistentSetPools.clear();
+        m_persistentPools.reset();
+    }
+
+    void DescriptorAllocator::Init()
+    {
+        ASSERT(!m_instance, "Descriptor allocator already created!")
+        m_instance = new DescriptorAllocator();
+    }
+
+    void DescriptorAllocator::Shutdown()
+    {
+        delete m_instance;
+        m_instance = nullptr;
+    }
+
+    vk::DescriptorSet DescriptorAllocator::AllocatePersistent(const vk::DescriptorSetLayout Layout)
+    {
+        vk::DescriptorPool pool;
+        const vk::DescriptorSet set = m_persistentPools->Allocate(Layout, m_stats, &pool);
+        m_persistentSetPools.emplace(set, pool);
+        return set;
+    }
+
+    void DescriptorAllocator::FreePersistent(const vk::DescriptorSet Set)
+    {
+        const auto pool_it = m_persistentSetPools.find(Set);
+        ASSERT(pool_it != m_persistentSetPools.end(), "Descriptor set was not allocated as a persistent set.")
+
+        m_persistentPools->Free(pool_it->second, Set);
+        m_persistentSetPools.erase(pool_it);
+        m_stats.setsFreed++;
+    }
+
+    vk::DescriptorSet DescriptorAllocator::AllocateFrame(const vk::DescriptorSetLayout Layout)
+    {
+        return m_framePools[m_currentFrame]->Allocate(Layout, m_stats);
+    }
+
+    vk::DescriptorSet DescriptorAllocator::GetOrCreateFrameSet(const vk::DescriptorSetLayout Layout,
+                                                               const std::span<const DescriptorResource> Resources)
+    {
+        auto &cache = m_frameSetCaches[m_currentFrame];
+        if (const auto cached = cache.find(DescriptorSetKeyView(Layout, Resources)); cached != cache.end())
+        {
+            m_stats.cacheHits++;
+            return cached->second;
+        }
+        m_stats.cacheMisses++;
+
+        const vk::DescriptorSet set = AllocateFrame(Layout);
+
+        std::vector<vk::WriteDescriptorSet> descriptor_writes;
+        descriptor_writes.reserve(Resources.size());
+        for (const auto &resource : Resources)
+        {
+            vk::WriteDescriptorSet &write = descriptor_writes.emplace_back(
+                set, resource.binding, 0, 1, resource.descriptorType);
+            if (resource.bufferInfo.has_value())
+            {
+                write.setPBufferInfo(&resource.bufferInfo.value());
+            }
+            if (resource.imageInfo.has_value())
+            {
+                write.setPImageInfo(&resource.imageInfo.value());
+            }
+        }
+        device.logicalDevice.updateDescriptorSets(descriptor_writes, {});
+
+        cache.emplace(DescriptorSetKey{Layout, {Resources.begin(), Resources.end()}}, set);
+        return set;
+    }
+
+    void DescriptorAllocator::BeginFrame(const uint32_t Frame)
+    {
+        m_currentFrame = Frame;
+        m_frameSetCaches[Frame].clear();
+        m_framePools[Frame]->Reset(m_stats);
+    }
+
+    size_t DescriptorAllocator::GetPoolCount() const
+    {
+        size_t count = m_persistentPools->GetPoolCount();
+        for (const auto &frame_pool : m_framePools)
+        {
+            count += frame_pool->GetPoolCount();
+        }
+        return count;
+    }
+
+    size_t DescriptorAllocator::HashResources(const vk::DescriptorSetLayout Layout,
+                                              const std::span<const DescriptorResource> Resources)
+    {
+        size_t hash = 0;
+        hash_combine(hash, reinterpret_cast<uintptr_t>(static_cast<VkDescriptorSetLayout>(Layout)));
+        for (const auto &resource : Resources)
+        {
+            hash_combine(hash, resource.binding, static_cast<uint32_t>(resource.descriptorType));
+            if (resource.bufferInfo.has_value())
+            {
+                const auto &buffer_info = resource.bufferInfo.value();
+                hash_combine(hash,
+                             reinterpret_cast<uintptr_t>(static_cast<VkBuffer>(buffer_info.buffer)),
+                             buffer_info.offset,
+                             buffer_info.range);
+            }
+            if (resource.imageInfo.has_value())
+            {
+                const auto &image_info = resource.imageInfo.value();
+                hash_combine(hash,
+                             reinterpret_cast<uintptr_t>(static_cast<VkImageView>(image_info.imageView)),
+                             reinterpret_cast<uintptr_t>(static_cast<VkSampler>(image_info.sampler)),
+                             static_cast<uint32_t>(image_info.imageLayout));
+            }
+        }
+        return hash;
+    }
+
+    size_t DescriptorSetKeyHash::operator()(const DescriptorSetKeyView Key) const
+    {
+        return DescriptorAllocator::HashResources(Key.layout, Key.resources);
+    }
+}  // namespace Slipper::GPU::Vulkan
@@ -13,6 +13,27 @@ namespace Slipper::GPU::Vulkan
     {
         deviceProperties = physicalDevice.getProperties();
         deviceFeatures = physicalDevice.getFeatures();
+
+        const auto features = physicalDevice.getFeatures2<vk::PhysicalDeviceFeatures2,
+                                                          vk::PhysicalDeviceDescriptorIndexingFeatures,
+                                                          vk::PhysicalDeviceHostQueryResetFeatures>();
+        descriptorIndexingFeatures = features.get<vk::PhysicalDeviceDescriptorIndexingFeatures>();
+        descriptorIndexingFeatures.pNext = nullptr;
+        hostQueryResetFeatures = features.get<vk::PhysicalDeviceHostQueryResetFeatures>();
+        hostQueryResetFeatures.pNext = nullptr;
+
+        const auto properties = physicalDevice.getProperties2<vk::PhysicalDeviceProperties2,
+                                                              vk::PhysicalDeviceDescriptorIndexingProperties>();
+        descriptorIndexingProperties = properties.get<vk::PhysicalDeviceDescriptorIndexingProperties>();
+        descriptorIndexingProperties.pNext = nullptr;
+
+        for (const auto &extension : physicalDevice.enumerateDeviceExtensionProperties())
+        {
+            if (strcmp(extension.extensionName, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME) == 0)
+            {
+                memoryBudgetSupported = true;
+            }
+        }
     }
 
     VKDevice::~VKDevice()
@@ -38,15 +59,39 @@ namespace Slipper::GPU::Vulkan
         // All features are checked for support during device selection
         vk::PhysicalDeviceFeatures device_features;
         device_features.setSamplerAnisotropy(VK_TRUE);
+        // Optional, only used for the overdraw statistics of the depth pre-pass
+        device_features.setPipelineStatisticsQuery(deviceFeatures.pipelineStatisticsQuery);
+        // Optional, KTX2 textures in formats the device can not sample are decoded on the cpu
+        device_features.setTextureCompressionBC(deviceFeatures.textureCompressionBC);
+        device_features.setTextureCompressionASTC_LDR(deviceFeatures.textureCompressionASTC_LDR);
+
+        // Only enable what the BindlessHeap actually needs, it will stay disabled on devices without support
+        vk::PhysicalDeviceDescriptorIndexingFeatures descriptor_indexing_features;
+        if (SupportsBindless())
+        {
+            descriptor_indexing_features.setShaderSampledImageArrayNonUniformIndexing(VK_TRUE);
+            descriptor_indexing_features.setShaderStorageBufferArrayNonUniformIndexing(VK_TRUE);
+            descriptor_indexing_features.setDescriptorBindingSampledImageUpdateAfterBind(VK_TRUE);
+            descriptor_indexing_features.setDescriptorBindingStorageBufferUpdateAfterBind(VK_TRUE);
+            descriptor_indexing_features.setDescriptorBindingUpdateUnusedWhilePending(VK_TRUE);
+            descriptor_indexing_features.setDescriptorBindingPartiallyBound(VK_TRUE);
+            descriptor_indexing_features.setRuntimeDescriptorArray(VK_TRUE);
+        }
+
+        // Lets the GpuProfiler recycle its queries from the cpu once a frame slot is done
+        vk::PhysicalDeviceHostQueryResetFeatures host_query_reset_features;
+        host_query_reset_features.setHostQueryReset(hostQueryResetFeatures.hostQueryReset);
+        descriptor_indexing_features.setPNext(&host_query_reset_features);
 
         vk::PhysicalDeviceSynchronization2Features synchronization2_features;
         synchronization2_features.setSynchronization2(VK_TRUE);
+        synchronization2_features.setPNext(&descriptor_indexing_features);
 
         std::vector<const char *> enabled_layers;
         if (EnableValidationLayers)
             enabled_layers = VALIDATION_LAYERS;
 
-        auto extensions = GetRequiredExtensions();
+        auto extensions = GetRequiredExtensions(headless);
         std::cout << "\nRequested Device Extensions:\n";
         for (const char *extension_name : extensions)
         {
@@ -70,7 +115,10 @@ namespace Slipper::GPU::Vulkan
         std::map<uint32_t, std::vector<float>> unique_queue_family_priorities;
 
         unique_queue_family_priorities[queueFamilyIndices.graphicsFamily.value()].push_back(1.0f);
-        unique_queue_family_priorities[queueFamilyIndices.presentFamily.value()].push_back(1.0f);
+        if (!headless)
+        {
+            unique_queue_family_priorities[queueFamilyIndices.presentFamily.value()].push_back(1.0f);
+        }
         unique_queue_family_priorities[queueFamilyIndices.transferFamily.value()].push_back(1.0f);
         unique_queue_family_priorities[queueFamilyIndices.computeFamily.value()].push_back(1.0f);
 
@@ -89,7 +137,10 @@ namespace Slipper::GPU::Vulkan
 
         computeQueue = GetQueue(queueFamilyIndices.computeFamily.value());
         graphicsQueue = GetQueue(queueFamilyIndices.graphicsFamily.value());
-        presentQueue = GetQueue(queueFamilyIndices.presentFamily.value());
+        if (!headless)
+        {
+            presentQueue = GetQueue(queueFamilyIndices.presentFamily.value());
+        }
         transferQueue = GetQueue(queueFamilyIndices.transferFamily.value());
     }
 
@@ -103,11 +154,17 @@ namespace Slipper::GPU::Vulkan
                  VulkanInstance::GetVk().enumeratePhysicalDevices();
              const auto &physical_device : physical_devices)
         {
-            if (auto device = new VKDevice(physical_device); device->IsDeviceSuitable(Surface))
+            auto device = new VKDevice(physical_device);
+            device->headless = Surface == nullptr;
+            if (device->IsDeviceSuitable(Surface))
             {
                 LOG(device->DeviceInfoToString());
                 devices.insert(std::make_pair(device->RateDeviceSuitability(), device));
             }
+            else
+            {
+                delete device;
+            }
         }
 
         ASSERT(!devices.empty(), "Failed to find suitable GPU!");
@@ -151,13 +208,20 @@ namespace Slipper::GPU::Vulkan
         return info;
     }
 
-    std::vector<const char *> VKDevice::GetRequiredExtensions()
+    std::vector<const char *> VKDevice::GetRequiredExtensions(const bool Headless)
     {
         std::unordered_set<const char *> extensions(DEVICE_EXTENSIONS.begin(), DEVICE_EXTENSIONS.end());
 
-        uint32_t glfw_extension_count = 0;
-        const char **glfw_extensions = glfwGetRequiredInstanceExtensions(&glfw_extension_count);
-        extensions.insert(glfw_extensions, glfw_extensions + glfw_extension_count);
+        if (Headless)
+        {
+            extensions.erase(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+        }
+        else
+        {
+            uint32_t glfw_extension_count = 0;
+            const char **glfw_extensions = glfwGetRequiredInstanceExtensions(&glfw_extension_count);
+            extensions.insert(glfw_extensions, glfw_extensions + glfw_extension_count);
+        }
 
         // This removes all the instance extensions that might have found their way into this (looking
         // at you glfw)
@@ -260,22 +324,89 @@ namespace Slipper::GPU::Vulkan
         throw std::runtime_error("Failed to find suitable memory type!");
     }
 
+    bool VKDevice::SupportsGpuTimestamps() const
+    {
+        return deviceProperties.limits.timestampComputeAndGraphics && deviceProperties.limits.timestampPeriod > 0.0f &&
+            hostQueryResetFeatures.hostQueryReset;
+    }
+
+    bool VKDevice::SupportsPipelineStatistics() const
+    {
+        return deviceFeatures.pipelineStatisticsQuery;
+    }
+
+    bool VKDevice::SupportsSampledFormat(const vk::Format Format) const
+    {
+        constexpr vk::FormatFeatureFlags required = vk::FormatFeatureFlagBits::eSampledImage |
+            vk::FormatFeatureFlagBits::eSampledImageFilterLinear | vk::FormatFeatureFlagBits::eTransferDst;
+        return (physicalDevice.getFormatProperties(Format).optimalTilingFeatures & required) == required;
+    }
+
+    std::vector<MemoryHeapUsage> VKDevice::GetMemoryHeapUsage() const
+    {
+        vk::PhysicalDeviceMemoryProperties memory_properties;
+        vk::PhysicalDeviceMemoryBudgetPropertiesEXT budget_properties;
+        if (memoryBudgetSupported)
+        {
+            const auto properties = physicalDevice.getMemoryProperties2<vk::PhysicalDeviceMemoryProperties2,
+                                                                        vk::PhysicalDeviceMemoryBudgetPropertiesEXT>();
+            memory_properties = properties.get<vk::PhysicalDeviceMemoryProperties2>().memoryProperties;
+            budget_properties = properties.get<vk::PhysicalDeviceMemoryBudgetPropertiesEXT>();
+        }
+        else
+        {
+            memory_properties = physicalDevice.getMemoryProperties();
+        }
+
+        std::vector<MemoryHeapUsage> heaps(memory_properties.memoryHeapCount);
+        for (uint32_t i = 0; i < memory_properties.memoryHeapCount; ++i)
+        {
+            heaps[i].size = memory_properties.memoryHeaps[i].size;
+            heaps[i].deviceLocal = static_cast<bool>(memory_properties.memoryHeaps[i].flags &
+                                                     vk::MemoryHeapFlagBits::eDeviceLocal);
+            if (memoryBudgetSupported)
+            {
+                heaps[i].budget = budget_properties.heapBudget[i];
+                heaps[i].usage = budget_properties.heapUsage[i];
+            }
+        }
+        return heaps;
+    }
+
+    bool VKDevice::SupportsBindless() const
+    {
+        return descriptorIndexingFeatures.shaderSampledImageArrayNonUniformIndexing &&
+            descriptorIndexingFeatures.shaderStorageBufferArrayNonUniformIndexing &&
+            descriptorIndexingFeatures.descriptorBindingSampledImageUpdateAfterBind &&
+            descriptorIndexingFeatures.descriptorBindingStorageBufferUpdateAfterBind &&
+            descriptorIndexingFeatures.descriptorBindingUpdateUnusedWhilePending &&
+            descriptorIndexingFeatures.descriptorBindingPartiallyBound &&
+            descriptorIndexingFeatures.runtimeDescriptorArray;
+    }
+
     bool VKDevice::IsDeviceSuitable(const Surface *Surface)
     {
-        const auto [capabilities, formats, presentModes] = QuerySwapChainSupport(Surface);
-        /* Populate the queue family indices. */
-        if (const bool device_type_suitable = deviceProperties.deviceType == vk::PhysicalDeviceType::eDiscreteGpu ||
-                deviceProperties.deviceType == vk::PhysicalDeviceType::eIntegratedGpu;
-            !device_type_suitable)
+        // Render servers and CI machines often only have software rasterizers like lavapipe
+        const bool device_type_suitable = deviceProperties.deviceType == vk::PhysicalDeviceType::eDiscreteGpu ||
+            deviceProperties.deviceType == vk::PhysicalDeviceType::eIntegratedGpu ||
+            (headless &&
+             (deviceProperties.deviceType == vk::PhysicalDeviceType::eVirtualGpu ||
+              deviceProperties.deviceType == vk::PhysicalDeviceType::eCpu));
+        if (!device_type_suitable)
             return false;
 
+        /* Populate the queue family indices. */
         QueryQueueFamilyIndices(Surface);
-        if (!queueFamilyIndices.IsComplete())
+        if (!queueFamilyIndices.IsComplete(!headless))
             return false;
 
         if (!CheckExtensionSupport() || !CheckFeatureSupport())
             return false;
 
+        if (headless)
+            return true;
+
+        const auto [capabilities, formats, presentModes] = QuerySwapChainSupport(Surface);
         return !formats.empty() && !presentModes.empty();
     }
 
@@ -305,9 +436,8 @@ namespace Slipper::GPU::Vulkan
     {
         std::vector<vk::ExtensionProperties> available_extensions = physicalDevice.enumerateDeviceExtensionProperties();
 
-        std::set<std::string> extensions(DEVICE_EXTENSIONS.begin(), DEVICE_EXTENSIONS.end());
-        auto required_extensions = GetRequiredExtensions();
-        extensions.insert(required_extensions.begin(), required_extensions.end());
+        auto required_extensions = GetRequiredExtensions(headless);
+        std::set<std::string> extensions(required_extensions.begin(), required_extensions.end());
 
         for (const auto &[extension_name, spec_version] : available_extensions)
         {
@@ -375,7 +505,7 @@ namespace Slipper::GPU::Vulkan
 
     const QueueFamilyIndices *VKDevice::QueryQueueFamilyIndices(const Surface *Surface)
     {
-        if (queueFamilyIndices.IsComplete())
+        if (queueFamilyIndices.IsComplete(Surface != nullptr))
             return &queueFamilyIndices;
 
         QueueFamilyIndices indices;
@@ -417,7 +547,8 @@ namespace Slipper::GPU::Vulkan
         taken_families.insert(indices.transferFamily.value());
 
         // Get the queue family with surface support
-        for (uint32_t family_index = 0; family_index < static_cast<uint32_t>(queue_families.size()); ++family_index)
+        for (uint32_t family_index = 0; Surface && family_index < static_cast<uint32_t>(queue_families.size());
+             ++family_index)
         {
             if (physicalDevice.getSurfaceSupportKHR(family_index, *Surface))
                 indices.presentFamily = family_index;
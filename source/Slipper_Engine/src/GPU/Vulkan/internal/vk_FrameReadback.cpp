@@ -0,0 +1,284 @@
+#include "../vk_FrameReadback.h"
+
+#include "Vulkan/vk_Buffer.h"
+#include "Vulkan/vk_Device.h"
+#include "Vulkan/vk_GpuProfiler.h"
+#include "Vulkan/vk_OffscreenSwapChain.h"
+#include "Vulkan/vk_RenderingStage.h"
+
+namespace Slipper::GPU::Vulkan
+{
+    namespace
+    {
+        // The cpu conversions only reorder the channels of 8 bit formats
+        bool IsConvertibleReadbackFormat(const vk::Format Format)
+        {
+            return Format == vk::Format::eR8G8B8A8Unorm || Format == vk::Format::eR8G8B8A8Srgb ||
+                Format == vk::Format::eB8G8R8A8Unorm || Format == vk::Format::eB8G8R8A8Srgb;
+        }
+    }  // namespace
+
+    FrameReadback::FrameReadback()
+    {
+        const auto memory_properties = device.physicalDevice.getMemoryProperties();
+        constexpr auto cached_properties = vk::MemoryPropertyFlagBits::eHostVisible |
+            vk::MemoryPropertyFlagBits::eHostCached;
+
+        m_memoryProperties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+        for (uint32_t i = 0; i < memory_properties.memoryTypeCount; ++i)
+        {
+            if ((memory_properties.memoryTypes[i].propertyFlags & cached_properties) == cached_properties)
+            {
+                m_memoryProperties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+                break;
+            }
+        }
+    }
+
+    FrameReadback::~FrameReadback()
+    {
+        for (auto &capture : m_captures | std::views::values)
+        {
+            for (auto &slot : capture.slots)
+            {
+                if (slot.buffer)
+                {
+                    vkUnmapMemory(device, static_cast<VkDeviceMemory>(*slot.buffer));
+                }
+            }
+        }
+        m_captures.clear();
+    }
+
+    void FrameReadback::Init()
+    {
+        ASSERT(!m_instance, "Frame readback already created!")
+        m_instance = new FrameReadback();
+    }
+
+    void FrameReadback::Shutdown()
+    {
+        delete m_instance;
+        m_instance = nullptr;
+    }
+
+    uint32_t FrameReadback::AddCapture(NonOwningPtr<VKRenderingStage> Stage,
+                                       ReadbackCallback Callback,
+                                       const ReadbackFormat Format,
+                                       const bool Continuous)
+    {
+        ASSERT(Stage && Stage->IsSwapChain<OffscreenSwapChain>(),
+               "Only rendering stages with an offscreen swap chain can be read back!")
+        ASSERT(Format == ReadbackFormat::Native || IsConvertibleReadbackFormat(Stage->GetSwapChain()->GetImageFormat()),
+               "Converting '{}' on the cpu is not supported!",
+               vk::to_string(Stage->GetSwapChain()->GetImageFormat()))
+
+        const uint32_t id = m_nextCapture++;
+        auto &capture = m_captures[id];
+        capture.stage = Stage;
+        capture.callback = std::move(Callback);
+        capture.format = Format;
+        capture.continuous = Continuous;
+        return id;
+    }
+
+    void FrameReadback::RemoveCapture(const uint32_t Capture)
+    {
+        if (const auto capture = m_captures.find(Capture); capture != m_captures.end())
+        {
+            capture->second.active = false;
+        }
+    }
+
+    void FrameReadback::BeginFrame(const uint32_t Frame)
+    {
+        // Callbacks are allowed to add new captures, which would invalidate iterators into the map
+        std::vector<uint32_t> capture_ids;
+        capture_ids.reserve(m_captures.size());
+        for (const auto id : m_captures | std::views::keys)
+        {
+            capture_ids.push_back(id);
+        }
+
+        for (const auto id : capture_ids)
+        {
+            auto &capture = m_captures.at(id);
+            if (auto &slot = capture.slots[Frame]; slot.pending)
+            {
+                Deliver(capture, slot);
+            }
+
+            // Inactive captures are dropped once none of their slots are in flight anymore
+            if (!capture.active && std::ranges::none_of(capture.slots, [](const Slot &S) { return S.pending; }))
+            {
+                for (auto &slot : capture.slots)
+                {
+                    if (slot.buffer)
+                    {
+                        vkUnmapMemory(device, static_cast<VkDeviceMemory>(*slot.buffer));
+                    }
+                }
+                m_captures.erase(id);
+            }
+        }
+    }
+
+    void FrameReadback::Record(VKRenderingStage &Stage, const vk::CommandBuffer CommandBuffer, const uint32_t Frame)
+    {
+        if (!HasCaptures(Stage))
+            return;
+
+        GPU_PROFILE_SCOPE(CommandBuffer, "Readback");
+
+        const auto swap_chain = Stage.GetSwapChain();
+        // Only the dynamic resolution render area holds the current frame, the buffers are sized for the full
+        // resolution so changing the render scale does not reallocate them
+        const vk::Extent2D extent = swap_chain->GetRenderResolution();
+        const vk::Format format = swap_chain->GetImageFormat();
+        const vk::DeviceSize size = static_cast<vk::DeviceSize>(swap_chain->GetResolution().width) *
+            swap_chain->GetResolution().height * GetBytesPerPixel(format);
+
+        // The resolve attachment of offscreen render passes ends up in transfer src layout, see RenderPass
+        const vk::MemoryBarrier color_barrier(vk::AccessFlagBits::eColorAttachmentWrite,
+                                              vk::AccessFlagBits::eTransferRead);
+        CommandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eColorAttachmentOutput,
+                                      vk::PipelineStageFlagBits::eTransfer,
+                                      {},
+                                      color_barrier,
+                                      nullptr,
+                                      nullptr);
+
+        const vk::BufferImageCopy region(0,
+                                         0,
+                                         0,
+                                         vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, 0, 0, 1),
+                                         vk::Offset3D(0, 0, 0),
+                                         vk::Extent3D(extent, 1));
+
+        for (auto &capture : m_captures | std::views::values)
+        {
+            if (!capture.active || capture.stage.get() != &Stage)
+                continue;
+
+            auto &slot = capture.slots[Frame];
+            ASSERT(!slot.pending, "Readback slot {} is still in flight!", Frame)
+            EnsureSlotSize(slot, size);
+
+            CommandBuffer.copyImageToBuffer(swap_chain->GetCurrentSwapChainImage(),
+                                            vk::ImageLayout::eTransferSrcOptimal,
+                                            static_cast<vk::Buffer>(*slot.buffer),
+                                            region);
+
+            slot.pending = true;
+            slot.frame = FRAME_COUNT;
+            slot.extent = extent;
+            slot.format = format;
+
+            if (!capture.continuous)
+            {
+                capture.active = false;
+            }
+        }
+
+        // Makes the copies visible to the host once the frames fence has been waited on
+        const vk::MemoryBarrier host_barrier(vk::AccessFlagBits::eTransferWrite, vk::AccessFlagBits::eHostRead);
+        CommandBuffer.pipelineBarrier(
+            vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eHost, {}, host_barrier, nullptr, nullptr);
+    }
+
+    bool FrameReadback::HasCaptures(const VKRenderingStage &Stage) const
+    {
+        return std::ranges::any_of(m_captures | std::views::values,
+                                   [&](const Capture &C) { return C.active && C.stage.get() == &Stage; });
+    }
+
+    uint32_t FrameReadback::GetBytesPerPixel(const vk::Format Format)
+    {
+        switch (Format)
+        {
+            case vk::Format::eR8G8B8A8Unorm:
+            case vk::Format::eR8G8B8A8Srgb:
+            case vk::Format::eB8G8R8A8Unorm:
+            case vk::Format::eB8G8R8A8Srgb:
+            case vk::Format::eA2B10G10R10UnormPack32:
+            case vk::Format::eB10G11R11UfloatPack32:
+                return 4;
+            case vk::Format::eR16G16B16A16Sfloat:
+                return 8;
+            case vk::Format::eR32G32B32A32Sfloat:
+                return 16;
+            default:
+                ASSERT(false, "Unsupported readback format '{}'!", vk::to_string(Format))
+                return 0;
+        }
+    }
+
+    void FrameReadback::Deliver(Capture &Capture, Slot &Slot)
+    {
+        Slot.pending = false;
+
+        // Cached memory is not necessarily coherent
+        const vk::MappedMemoryRange range(static_cast<VkDeviceMemory>(*Slot.buffer), 0, VK_WHOLE_SIZE);
+        VK_HPP_ASSERT(device.logicalDevice.invalidateMappedMemoryRanges(1, &range),
+                      "Failed to invalidate readback memory!")
+
+        const uint32_t source_bpp = GetBytesPerPixel(Slot.format);
+        const size_t pixel_count = static_cast<size_t>(Slot.extent.width) * Slot.extent.height;
+        const auto *source = static_cast<const std::byte *>(Slot.mapped);
+
+        ReadbackImage image;
+        image.frame = Slot.frame;
+        image.width = Slot.extent.width;
+        image.height = Slot.extent.height;
+        image.sourceFormat = Slot.format;
+        image.format = Capture.format;
+
+        if (Capture.format == ReadbackFormat::Native)
+        {
+            image.bytesPerPixel = source_bpp;
+            image.pixels = {source, pixel_count * source_bpp};
+        }
+        else
+        {
+            const bool swizzle = Slot.format == vk::Format::eB8G8R8A8Unorm || Slot.format == vk::Format::eB8G8R8A8Srgb;
+            const uint32_t red = swizzle ? 2 : 0;
+            const uint32_t blue = swizzle ? 0 : 2;
+
+            image.bytesPerPixel = Capture.format == ReadbackFormat::Rgba8 ? 4 : 3;
+            m_conversionBuffer.resize(pixel_count * image.bytesPerPixel);
+
+            std::byte *target = m_conversionBuffer.data();
+            for (size_t pixel = 0; pixel < pixel_count; ++pixel, source += 4, target += image.bytesPerPixel)
+            {
+                target[0] = source[red];
+                target[1] = source[1];
+                target[2] = source[blue];
+                if (image.bytesPerPixel == 4)
+                {
+                    target[3] = source[3];
+                }
+            }
+            image.pixels = m_conversionBuffer;
+        }
+        image.rowPitch = image.width * image.bytesPerPixel;
+
+        Capture.callback(image);
+    }
+
+    void FrameReadback::EnsureSlotSize(Slot &Slot, const vk::DeviceSize Size) const
+    {
+        if (Slot.buffer && Slot.size == Size)
+            return;
+
+        if (Slot.buffer)
+        {
+            vkUnmapMemory(device, static_cast<VkDeviceMemory>(*Slot.buffer));
+        }
+
+        // The slot is not in flight when it gets recorded into, so it can be replaced right away
+        Slot.buffer = new Buffer(Size, VK_BUFFER_USAGE_TRANSFER_DST_BIT, m_memoryProperties);
+        Slot.size = Size;
+        VK_ASSERT(vkMapMemory(device, static_cast<VkDeviceMemory>(*Slot.buffer), 0, Size, 0, &Slot.mapped),
+                  "Failed to map readback buffer!")
+    }
+}  // namespace Slipper::GPU::Vulkan
@@ -0,0 +1,280 @@
+#include "../vk_GpuProfiler.h"
+
+#include "Vulkan/vk_Device.h"
+
+namespace Slipper::GPU::Vulkan
+{
+    GpuProfiler::GpuProfiler()
+    {
+        m_timestampPeriodNs = device.deviceProperties.limits.timestampPeriod;
+
+        // Timestamps wrap around after the valid bits of the queues they were written on
+        const auto queue_families = device.physicalDevice.getQueueFamilyProperties();
+        const uint32_t valid_bits = std::min(
+            queue_families[device.queueFamilyIndices.graphicsFamily.value()].timestampValidBits,
+            queue_families[device.queueFamilyIndices.computeFamily.value()].timestampValidBits);
+        if (valid_bits < 64)
+        {
+            m_timestampMask = (uint64_t{1} << valid_bits) - 1;
+        }
+
+        const vk::QueryPoolCreateInfo pool_info({}, vk::QueryType::eTimestamp, MAX_QUERIES_PER_FRAME);
+        for (auto &frame_queries : m_frames)
+        {
+            VK_HPP_ASSERT(device.logicalDevice.createQueryPool(&pool_info, nullptr, &frame_queries.pool),
+                          "Failed to create timestamp query pool!")
+            // Queries have to be reset before their first use
+            device.logicalDevice.resetQueryPool(frame_queries.pool, 0, MAX_QUERIES_PER_FRAME);
+        }
+    }
+
+    GpuProfiler::~GpuProfiler()
+    {
+        for (const auto &frame_queries : m_frames)
+        {
+            device.logicalDevice.destroyQueryPool(frame_queries.pool);
+        }
+    }
+
+    void GpuProfiler::Init()
+    {
+        ASSERT(!m_instance, "Gpu profiler already created!")
+
+        if (!VKDevice::Get().SupportsGpuTimestamps())
+        {
+            LOG("Device does not support timestamp queries with host reset. Gpu profiler is disabled.")
+            return;
+        }
+
+        m_instance = new GpuProfiler();
+    }
+
+    void GpuProfiler::Shutdown()
+    {
+        delete m_instance;
+        m_instance = nullptr;
+    }
+
+    void GpuProfiler::BeginFrame(const uint32_t Frame)
+    {
+        auto &frame_queries = m_frames[Frame];
+        Recycle(frame_queries);
+        frame_queries.frame = FRAME_COUNT;
+
+        m_currentFrame = Frame;
+        m_openScopes.clear();
+    }
+
+    void GpuProfiler::CollectInFlight()
+    {
+        std::array<FrameQueries *, MAX_FRAMES_IN_FLIGHT> slots;
+        std::ranges::transform(m_frames, slots.begin(), [](FrameQueries &Queries) { return &Queries; });
+        std::ranges::sort(slots, {}, &FrameQueries::frame);
+
+        for (FrameQueries *frame_queries : slots)
+        {
+            Recycle(*frame_queries);
+        }
+    }
+
+    void GpuProfiler::Recycle(FrameQueries &Queries)
+    {
+        if (Queries.usedQueries)
+        {
+            CollectResults(Queries);
+            device.logicalDevice.resetQueryPool(Queries.pool, 0, Queries.usedQueries);
+        }
+
+        Queries.usedQueries = 0;
+        Queries.scopes.clear();
+    }
+
+    uint32_t GpuProfiler::BeginScope(const vk::CommandBuffer CommandBuffer,
+                                     const std::string_view Name,
+                                     const vk::PipelineStageFlagBits Stage)
+    {
+        auto &frame_queries = m_frames[m_currentFrame];
+        if (paused || frame_queries.usedQueries + 2 > MAX_QUERIES_PER_FRAME)
+            return INVALID_GPU_SCOPE;
+
+        auto &open_scopes = m_openScopes[CommandBuffer];
+        const uint32_t parent = open_scopes.empty() ? INVALID_GPU_SCOPE : open_scopes.back();
+        const uint32_t depth = parent == INVALID_GPU_SCOPE ? 0 : frame_queries.scopes[parent].depth + 1;
+
+        const auto scope = static_cast<uint32_t>(frame_queries.scopes.size());
+        const uint32_t begin_query = frame_queries.usedQueries;
+        // The end query is reserved right away so both always stay valid or invalid together
+        frame_queries.scopes.push_back({std::string(Name), depth, parent, begin_query, begin_query + 1});
+        frame_queries.usedQueries += 2;
+
+        CommandBuffer.writeTimestamp(Stage, frame_queries.pool, begin_query);
+        open_scopes.push_back(scope);
+        return scope;
+    }
+
+    void GpuProfiler::EndScope(const vk::CommandBuffer CommandBuffer,
+                               const uint32_t Scope,
+                               const vk::PipelineStageFlagBits Stage)
+    {
+        if (Scope == INVALID_GPU_SCOPE)
+            return;
+
+        auto &frame_queries = m_frames[m_currentFrame];
+        auto &open_scopes = m_openScopes[CommandBuffer];
+        ASSERT(!open_scopes.empty() && open_scopes.back() == Scope,
+               "Gpu scope '{}' has to be ended on the command buffer it was started on and after its children.",
+               frame_queries.scopes[Scope].name)
+        open_scopes.pop_back();
+
+        CommandBuffer.writeTimestamp(Stage, frame_queries.pool, frame_queries.scopes[Scope].endQuery);
+    }
+
+    void GpuProfiler::CollectResults(FrameQueries &Queries)
+    {
+        // Value followed by its availability for every query
+        std::vector<uint64_t> results(static_cast<size_t>(Queries.usedQueries) * 2);
+        const vk::Result result = device.logicalDevice.getQueryPoolResults(
+            Queries.pool,
+            0,
+            Queries.usedQueries,
+            results.size() * sizeof(uint64_t),
+            results.data(),
+            2 * sizeof(uint64_t),
+            vk::QueryResultFlagBits::e64 | vk::QueryResultFlagBits::eWithAvailability);
+        if (result != vk::Result::eSuccess && result != vk::Result::eNotReady)
+            return;
+
+        const auto is_available = [&](const uint32_t Query) { return results[Query * 2 + 1] != 0; };
+        const auto timestamp = [&](const uint32_t Query) { return results[Query * 2] & m_timestampMask; };
+        const auto is_valid = [&](const PendingScope &Scope)
+        { return is_available(Scope.beginQuery) && is_available(Scope.endQuery); };
+
+        /* Timestamps wrap after their valid bits, so ticks are counted modulo the mask from the first recorded
+         * scope. Differences past half the range mean the timestamp lies before it, e.g. another queue ran first. */
+        const auto first_scope = std::ranges::find_if(Queries.scopes, is_valid);
+        if (first_scope == Queries.scopes.end())
+            return;
+
+        const uint64_t reference = timestamp(first_scope->beginQuery);
+        const auto ticks_from_reference = [&](const uint64_t Timestamp)
+        {
+            const uint64_t forward = (Timestamp - reference) & m_timestampMask;
+            return forward <= m_timestampMask / 2 ? static_cast<int64_t>(forward) :
+                                                    -static_cast<int64_t>((reference - Timestamp) & m_timestampMask);
+        };
+
+        int64_t first = 0;
+        int64_t last = 0;
+        for (const auto &scope : Queries.scopes)
+        {
+            if (is_valid(scope))
+            {
+                first = std::min(first, ticks_from_reference(timestamp(scope.beginQuery)));
+                last = std::max(last, ticks_from_reference(timestamp(scope.endQuery)));
+            }
+        }
+
+        const auto to_ms = [&](const auto Ticks)
+        { return static_cast<double>(Ticks) * m_timestampPeriodNs / 1'000'000.0; };
+
+        GpuFrameTimings timings;
+        timings.frame = Queries.frame;
+        timings.gpuStartMs = to_ms(reference) + to_ms(first);
+        timings.gpuEndMs = to_ms(reference) + to_ms(last);
+        timings.scopes.reserve(Queries.scopes.size());
+        for (const auto &scope : Queries.scopes)
+        {
+            // Scopes that were never ended keep their slot so parent indices stay valid
+            const bool valid = is_valid(scope);
+            const double begin = valid ? to_ms(ticks_from_reference(timestamp(scope.beginQuery)) - first) : 0.0;
+            const double end = valid ? to_ms(ticks_from_reference(timestamp(scope.endQuery)) - first) : 0.0;
+            timings.scopes.push_back({scope.name, scope.depth, scope.parent, begin, std::max(begin, end)});
+        }
+
+        m_history.push_back(std::move(timings));
+        if (m_history.size() > HISTORY_SIZE)
+        {
+            m_history.pop_front();
+        }
+    }
+
+    bool GpuProfiler::ExportChromeTrace(const std::filesystem::path &FilePath) const
+    {
+        std::ofstream file(FilePath);
+        if (!file.is_open())
+        {
+            LOG_FORMAT("Failed to open '{}' for the gpu profile export.", FilePath.string())
+            return false;
+        }
+
+        const double origin_ms = m_history.empty() ? 0.0 : m_history.front().gpuStartMs;
+
+        file << "{\"traceEvents\":[";
+        bool first_event = true;
+        for (const auto &frame : m_history)
+        {
+            for (const auto &scope : frame.scopes)
+            {
+                file << (first_event ? "" : ",") << '\n'
+                     << std::format(R"({{"name":"{}","cat":"gpu","ph":"X","pid":0,"tid":{},"ts":{:.3f},"dur":{:.3f},)"
+                                    R"("args":{{"frame":{}}}}})",
+                                    String::escape_json(scope.name),
+                                    scope.depth,
+                                    (frame.gpuStartMs - origin_ms + scope.beginMs) * 1000.0,
+                                    scope.DurationMs() * 1000.0,
+                                    frame.frame);
+                first_event = false;
+            }
+        }
+        file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+        LOG_FORMAT("Exported {} frames of gpu timings to '{}'", m_history.size(), FilePath.string())
+        return true;
+    }
+
+    bool GpuProfiler::ExportCsv(const std::filesystem::path &FilePath) const
+    {
+        std::ofstream file(FilePath);
+        if (!file.is_open())
+        {
+            LOG_FORMAT("Failed to open '{}' for the gpu profile export.", FilePath.string())
+            return false;
+        }
+
+        file << "frame,scope,depth,parent,begin_ms,end_ms,duration_ms\n";
+        for (const auto &frame : m_history)
+        {
+            for (const auto &scope : frame.scopes)
+            {
+                file << std::format("{},\"{}\",{},{},{:.4f},{:.4f},{:.4f}\n",
+                                    frame.frame,
+                                    scope.name,
+                                    scope.depth,
+                                    scope.parent == INVALID_GPU_SCOPE ? -1 : static_cast<int64_t>(scope.parent),
+                                    scope.beginMs,
+                                    scope.endMs,
+                                    scope.DurationMs());
+            }
+        }
+
+        LOG_FORMAT("Exported {} frames of gpu timings to '{}'", m_history.size(), FilePath.string())
+        return true;
+    }
+
+    GpuProfileScope::GpuProfileScope(const vk::CommandBuffer CommandBuffer, const std::string_view Name)
+        : m_commandBuffer(CommandBuffer)
+    {
+        if (GpuProfiler::IsAvailable())
+        {
+            m_scope = GpuProfiler::Get().BeginScope(CommandBuffer, Name);
+        }
+    }
+
+    GpuProfileScope::~GpuProfileScope()
+    {
+        if (GpuProfiler::IsAvailable())
+        {
+            GpuProfiler::Get().EndScope(m_commandBuffer, m_scope);
+        }
+    }
+}  // namespace Slipper::GPU::Vulkan
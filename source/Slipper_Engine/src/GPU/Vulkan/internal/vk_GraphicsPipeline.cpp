@@ -1,6 +1,6 @@
 #include "../vk_GraphicsPipeline.h"
 
-#include "GraphicsSettings.h"
+#include "Vulkan/vk_CommandContext.h"
 #include "Vulkan/vk_Device.h"
 #include "Vulkan/vk_Mesh.h"
 #include "Vulkan/vk_PipelineLayout.h"
@@ -10,19 +10,45 @@ namespace Slipper::GPU::Vulkan
 GraphicsPipeline::GraphicsPipeline(
     const std::vector<VkPipelineShaderStageCreateInfo> &ShaderStages,
     const NonOwningPtr<const RenderPass> RenderPass,
-    const std::vector<VkDescriptorSetLayout> &DescriptorSetLayouts)
+    const std::vector<VkDescriptorSetLayout> &DescriptorSetLayouts,
+    const std::vector<vk::PushConstantRange> &PushConstantRanges)
     : device(VKDevice::Get()), m_renderPass(RenderPass), m_shaderStages(ShaderStages)
 {
-    vkPipelineLayout = PipelineLayout::CreatePipelineLayout(device, DescriptorSetLayouts);
+    vkPipelineLayout = PipelineLayout::CreatePipelineLayout(
+        device, DescriptorSetLayouts, PushConstantRanges);
     Create();
 }
 
 GraphicsPipeline::~GraphicsPipeline()
 {
     vkDestroyPipeline(device.logicalDevice, vkGraphicsPipeline, nullptr);
+    vkDestroyPipeline(device.logicalDevice, vkDepthOnlyPipeline, nullptr);
+    vkDestroyPipeline(device.logicalDevice, vkDepthEqualPipeline, nullptr);
     vkDestroyPipelineLayout(device.logicalDevice, vkPipelineLayout, nullptr);
 }
 
+void GraphicsPipeline::Recreate()
+{
+    vkDestroyPipeline(device.logicalDevice, vkGraphicsPipeline, nullptr);
+    vkDestroyPipeline(device.logicalDevice, vkDepthOnlyPipeline, nullptr);
+    vkDestroyPipeline(device.logicalDevice, vkDepthEqualPipeline, nullptr);
+    Create();
+}
+
+VkPipeline GraphicsPipeline::GetVkPipeline(const PipelineVariant Variant) const
+{
+    switch (Variant) {
+        case PipelineVariant::DepthOnly:
+            ASSERT(vkDepthOnlyPipeline, "Render pass '{}' has no depth pre-pass.", m_renderPass->name)
+            return vkDepthOnlyPipeline;
+        case PipelineVariant::DepthEqual:
+            ASSERT(vkDepthEqualPipeline, "Render pass '{}' has no depth pre-pass.", m_renderPass->name)
+            return vkDepthEqualPipeline;
+        default:
+            return vkGraphicsPipeline;
+    }
+}
+
 void GraphicsPipeline::Bind(const VkCommandBuffer &CommandBuffer, VkExtent2D Extent) const
 {
     vkCmdBindPipeline(CommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vkGraphicsPipeline);
@@ -42,8 +68,39 @@ void GraphicsPipeline::Bind(const VkCommandBuffer &CommandBuffer, VkExtent2D Ext
     vkCmdSetScissor(CommandBuffer, 0, 1, &scissor);
 }
 
+void GraphicsPipeline::Bind(CommandContext &Context, VkExtent2D Extent, const PipelineVariant Variant) const
+{
+    Context.BindPipeline(vk::PipelineBindPoint::eGraphics, GetVkPipeline(Variant));
+    Context.SetViewport(vk::Viewport(
+        0.0f, 0.0f, static_cast<float>(Extent.width), static_cast<float>(Extent.height), 0.0f, 1.0f));
+    Context.SetScissor(vk::Rect2D({0, 0}, Extent));
+}
+
 void GraphicsPipeline::Create()
 {
+    vkGraphicsPipeline = CreateVariant(PipelineVariant::Default);
+    if (m_renderPass->hasDepthPrePass) {
+        vkDepthOnlyPipeline = CreateVariant(PipelineVariant::DepthOnly);
+        vkDepthEqualPipeline = CreateVariant(PipelineVariant::DepthEqual);
+    }
+    else {
+        vkDepthOnlyPipeline = VK_NULL_HANDLE;
+        vkDepthEqualPipeline = VK_NULL_HANDLE;
+    }
+}
+
+VkPipeline GraphicsPipeline::CreateVariant(const PipelineVariant Variant) const
+{
+    // Depth only render passes have no color attachment in any variant
+    const bool depth_only = Variant == PipelineVariant::DepthOnly || m_renderPass->IsDepthOnly();
+
+    // Positions have to come out of the exact same vertex stage for the equal depth test to work
+    std::vector<VkPipelineShaderStageCreateInfo> shader_stages;
+    for (const auto &shader_stage : m_shaderStages) {
+        if (!depth_only || shader_stage.stage == VK_SHADER_STAGE_VERTEX_BIT)
+            shader_stages.push_back(shader_stage);
+    }
+
     VkPipelineVertexInputStateCreateInfo vertex_input_info{};
     vertex_input_info.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
 
@@ -79,14 +136,13 @@ void GraphicsPipeline::Create()
     VkPipelineMultisampleStateCreateInfo multisampling{};
     multisampling.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
     multisampling.sampleShadingEnable = VK_FALSE;
-    multisampling.rasterizationSamples = static_cast<VkSampleCountFlagBits>(
-        static_cast<vk::SampleCountFlagBits>(GraphicsSettings::MSAA_SAMPLES));
+    multisampling.rasterizationSamples = static_cast<VkSampleCountFlagBits>(m_renderPass->sampleCount);
 
     VkPipelineDepthStencilStateCreateInfo depth_stencil{};
     depth_stencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
     depth_stencil.depthTestEnable = VK_TRUE;
-    depth_stencil.depthWriteEnable = VK_TRUE;
-    depth_stencil.depthCompareOp = VK_COMPARE_OP_LESS;
+    depth_stencil.depthWriteEnable = Variant == PipelineVariant::DepthEqual ? VK_FALSE : VK_TRUE;
+    depth_stencil.depthCompareOp = Variant == PipelineVariant::DepthEqual ? VK_COMPARE_OP_EQUAL : VK_COMPARE_OP_LESS;
     depth_stencil.depthBoundsTestEnable = VK_FALSE;
     depth_stencil.stencilTestEnable = VK_FALSE;
 
@@ -99,7 +155,8 @@ void GraphicsPipeline::Create()
     color_blending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
     color_blending.logicOpEnable = VK_FALSE;
     color_blending.logicOp = VK_LOGIC_OP_COPY;
-    color_blending.attachmentCount = 1;
+    // The depth pre-pass subpass and depth only render passes have no color attachment
+    color_blending.attachmentCount = depth_only ? 0 : 1;
     color_blending.pAttachments = &color_blend_attachment;
     color_blending.blendConstants[0] = 0.0f;
     color_blending.blendConstants[1] = 0.0f;
@@ -115,8 +172,8 @@ void GraphicsPipeline::Create()
 
     VkGraphicsPipelineCreateInfo pipeline_info{};
     pipeline_info.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-    pipeline_info.stageCount = static_cast<uint32_t>(m_shaderStages.size());
-    pipeline_info.pStages = m_shaderStages.data();
+    pipeline_info.stageCount = static_cast<uint32_t>(shader_stages.size());
+    pipeline_info.pStages = shader_stages.data();
     pipeline_info.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
     pipeline_info.pVertexInputState = &vertex_input_info;
     pipeline_info.pInputAssemblyState = &input_assembly;
@@ -128,12 +185,14 @@ void GraphicsPipeline::Create()
     pipeline_info.pDynamicState = &dynamic_state;
     pipeline_info.layout = vkPipelineLayout;
     pipeline_info.renderPass = m_renderPass->vkRenderPass;
-    pipeline_info.subpass = 0;
+    pipeline_info.subpass = depth_only ? 0 : m_renderPass->GetMainSubpass();
     pipeline_info.basePipelineHandle = VK_NULL_HANDLE;
 
+    VkPipeline pipeline;
     VK_ASSERT(
         vkCreateGraphicsPipelines(
-            device.logicalDevice, VK_NULL_HANDLE, 1, &pipeline_info, nullptr, &vkGraphicsPipeline),
+            device.logicalDevice, VK_NULL_HANDLE, 1, &pipeline_info, nullptr, &pipeline),
         "Failed to create graphics pipeline!");
+    return pipeline;
 }
 }  // namespace Slipper
\ No newline at end of file
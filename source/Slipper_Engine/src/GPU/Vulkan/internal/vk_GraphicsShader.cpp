@@ -1,5 +1,6 @@
 #include "../vk_GraphicsShader.h"
 
+#include "Vulkan/vk_CommandContext.h"
 #include "Vulkan/vk_GraphicsPipeline.h"
 #include "Vulkan/vk_RenderPass.h"
 
@@ -7,10 +8,14 @@ namespace Slipper::GPU::Vulkan
 {
     GraphicsShader::GraphicsShader(const std::vector<std::tuple<std::string_view, ShaderType>> &ShaderStages,
                                    std::optional<std::vector<NonOwningPtr<RenderPass>>> RenderPasses)
+        : GraphicsShader(ReadCode(ShaderStages), std::move(RenderPasses))
     {
-        LoadShader(ShaderStages);
+    }
+
+    GraphicsShader::GraphicsShader(ShaderCode &&Code, std::optional<std::vector<NonOwningPtr<RenderPass>>> RenderPasses)
+    {
+        LoadShader(std::move(Code));
 
-        CreateDescriptorPool();
         CreateDescriptorSetLayouts();
         AllocateDescriptorSets();
 
@@ -47,6 +52,27 @@ namespace Slipper::GPU::Vulkan
         return CreateGraphicsPipeline(RenderPass, layouts);
     }
 
+    void GraphicsShader::RecreatePipeline(NonOwningPtr<const RenderPass> RenderPass)
+    {
+        if (const auto pipeline = m_graphicsPipelines.find(RenderPass); pipeline != m_graphicsPipelines.end())
+        {
+            pipeline->second->Recreate();
+        }
+    }
+
+    const GraphicsPipeline &GraphicsShader::GetPipeline(NonOwningPtr<const RenderPass> RenderPass) const
+    {
+        ASSERT(m_graphicsPipelines.contains(RenderPass),
+               "RenderPass {} is not registered for this shader.",
+               RenderPass->name)
+        return *m_graphicsPipelines.at(RenderPass);
+    }
+
+    vk::PipelineLayout GraphicsShader::GetPipelineLayout(NonOwningPtr<const RenderPass> RenderPass) const
+    {
+        return GetPipeline(RenderPass).vkPipelineLayout;
+    }
+
     void GraphicsShader::Use(const vk::CommandBuffer &CommandBuffer,
                              NonOwningPtr<const RenderPass> RenderPass,
                              VkExtent2D Extent) const
@@ -60,20 +86,27 @@ namespace Slipper::GPU::Vulkan
 
         pipeline->Bind(CommandBuffer, Extent);
 
-        const auto descriptor_sets = GetDescriptorSets();
         CommandBuffer.bindDescriptorSets(
             vk::PipelineBindPoint::eGraphics, pipeline->vkPipelineLayout, 0, GetDescriptorSets(), {});
     }
 
-    void GraphicsShader::LoadShader(const std::vector<std::tuple<std::string_view, ShaderType>> &Shaders)
+    void GraphicsShader::Use(CommandContext &Context,
+                             NonOwningPtr<const RenderPass> RenderPass,
+                             VkExtent2D Extent,
+                             const PipelineVariant Variant) const
+    {
+        const auto &pipeline = GetPipeline(RenderPass);
+        pipeline.Bind(Context, Extent, Variant);
+        Context.BindDescriptorSets(
+            vk::PipelineBindPoint::eGraphics, pipeline.vkPipelineLayout, 0, GetDescriptorSets());
+    }
+
+    void GraphicsShader::LoadShader(ShaderCode &&Code)
     {
-        std::vector<std::vector<char>> shader_codes;
-        shader_codes.reserve(Shaders.size());
-        for (const auto &[filepath, shader_type] : Shaders)
+        for (const auto &[filepath, shader_type, binary_code] : Code.stages)
         {
             ShaderStage new_shader_stage{};
             name = File::get_file_name_from_path(filepath);
-            const auto &binary_code = shader_codes.emplace_back(File::read_binary_file(filepath));
             new_shader_stage.shaderModule = CreateShaderModule(binary_code);
             new_shader_stage.pipelineStageCrateInfo = CreateShaderStage(shader_type, new_shader_stage.shaderModule);
             m_shaderStages.insert(std::make_pair(shader_type, new_shader_stage));
@@ -83,7 +116,8 @@ namespace Slipper::GPU::Vulkan
                        filepath)*/
         }
 
-        shaderLayout = new ShaderLayout(shader_codes);
+        shaderLayout = Code.layout.release();
+        m_hasDrawPushConstants = GetPushConstantRange(DRAW_PUSH_CONSTANT_NAME) != nullptr;
     }
 
     GraphicsPipeline &GraphicsShader::CreateGraphicsPipeline(
@@ -97,7 +131,11 @@ namespace Slipper::GPU::Vulkan
         }
 
         return *m_graphicsPipelines
-                    .emplace(RenderPass, new GraphicsPipeline(createInfos, RenderPass, DescriptorSetLayouts))
+                    .emplace(RenderPass,
+                             new GraphicsPipeline(createInfos,
+                                                  RenderPass,
+                                                  DescriptorSetLayouts,
+                                                  shaderLayout->GetVkPushConstantRanges()))
                     .first->second;
     }
 }  // namespace Slipper::GPU::Vulkan
@@ -0,0 +1,224 @@
+#include "../vk_Ktx.h"
+
+#include "Filesystem/VirtualFileSystem.h"
+#include "Vulkan/vk_BlockCompression.h"
+#include "Vulkan/vk_Device.h"
+
+namespace Slipper::GPU::Vulkan
+{
+    constexpr std::array<uint8_t, 12> KTX2_IDENTIFIER = {
+        0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+
+    // Header and index are followed by one entry of three uint64s per level
+    constexpr size_t KTX2_LEVEL_INDEX_OFFSET = 80;
+    constexpr size_t KTX2_LEVEL_INDEX_ENTRY_SIZE = 24;
+    // Basic data format descriptor of an uncompressed RGBA8 texel, one sample per channel
+    constexpr uint32_t KTX2_RGBA8_DFD_WORDS = 23;
+
+    // Fields of the header in file order, all of them little endian
+    struct Ktx2Header
+    {
+        uint32_t vkFormat;
+        uint32_t typeSize;
+        uint32_t pixelWidth;
+        uint32_t pixelHeight;
+        uint32_t pixelDepth;
+        uint32_t layerCount;
+        uint32_t faceCount;
+        uint32_t levelCount;
+        uint32_t supercompressionScheme;
+    };
+
+    template<typename T> void WriteKtxValue(std::vector<char> &File, const size_t Offset, const T Value)
+    {
+        std::memcpy(File.data() + Offset, &Value, sizeof(T));
+    }
+
+    template<typename T> T ReadKtxValue(const std::span<const char> File, const size_t Offset)
+    {
+        ASSERT(Offset <= File.size() && sizeof(T) <= File.size() - Offset,
+               "KTX2 file ends at {} before offset {}!",
+               File.size(),
+               Offset)
+
+        T value;
+        std::memcpy(&value, File.data() + Offset, sizeof(T));
+        return value;
+    }
+
+    vk::Extent3D KtxImage::GetLevelExtent(const uint32_t Level) const
+    {
+        return {std::max(extent.width >> Level, 1u), std::max(extent.height >> Level, 1u), 1};
+    }
+
+    KtxImage LoadKtx2(const std::string_view Filepath)
+    {
+        PROFILE_ZONE("LoadKtx2");
+
+        // The levels are copied straight out of the mapping of the file
+        const VirtualFile virtual_file = VirtualFileSystem::Open(Filepath);
+        const std::span<const char> file = virtual_file.GetChars();
+        ASSERT(file.size() >= KTX2_LEVEL_INDEX_OFFSET &&
+                   std::equal(KTX2_IDENTIFIER.begin(), KTX2_IDENTIFIER.end(), file.begin(), [](uint8_t A, char B) {
+                       return A == static_cast<uint8_t>(B);
+                   }),
+               "'{}' is not a KTX2 file!",
+               Filepath)
+
+        const auto header = ReadKtxValue<Ktx2Header>(file, KTX2_IDENTIFIER.size());
+        ASSERT(header.vkFormat != 0, "'{}' has to be transcoded from basis universal offline!", Filepath)
+        ASSERT(header.supercompressionScheme == 0, "'{}' is supercompressed, which is not supported!", Filepath)
+        ASSERT(header.pixelWidth > 0 && header.pixelHeight > 0 && header.pixelDepth <= 1 && header.layerCount <= 1 && header.faceCount == 1,
+               "'{}' is not a 2D texture!",
+               Filepath)
+
+        KtxImage image;
+        image.format = static_cast<vk::Format>(header.vkFormat);
+        image.extent = vk::Extent3D(header.pixelWidth, header.pixelHeight, 1);
+        image.filepath = Filepath;
+        ASSERT(GetFormatBlockInfo(image.format),
+               "'{}' uses format {} which textures do not support!",
+               Filepath,
+               vk::to_string(image.format))
+
+        // A level count of 0 asks for the mips to be generated at runtime, only the base level is stored then
+        const uint32_t level_count = std::max(header.levelCount, 1u);
+        const auto max_level_count =
+            static_cast<uint32_t>(std::bit_width(std::max(header.pixelWidth, header.pixelHeight)));
+        ASSERT(level_count <= max_level_count,
+               "'{}' has {} levels but a {}x{} image has at most {}!",
+               Filepath,
+               level_count,
+               header.pixelWidth,
+               header.pixelHeight,
+               max_level_count)
+        ASSERT(KTX2_LEVEL_INDEX_OFFSET + level_count * KTX2_LEVEL_INDEX_ENTRY_SIZE <= file.size(),
+               "Level index of '{}' is truncated!",
+               Filepath)
+
+        // Every level is validated before any pixels are copied
+        std::vector<std::pair<uint64_t, uint64_t>> level_ranges;
+        level_ranges.reserve(level_count);
+        for (uint32_t level = 0; level < level_count; ++level)
+        {
+            const size_t entry = KTX2_LEVEL_INDEX_OFFSET + level * KTX2_LEVEL_INDEX_ENTRY_SIZE;
+            const auto offset = ReadKtxValue<uint64_t>(file, entry);
+            const auto length = ReadKtxValue<uint64_t>(file, entry + sizeof(uint64_t));
+
+            const uint64_t bytes = GetLevelBytes(image.format, image.GetLevelExtent(level));
+            ASSERT(length >= bytes && offset <= file.size() && bytes <= file.size() - offset,
+                   "Level {} of '{}' is truncated!",
+                   level,
+                   Filepath)
+            level_ranges.emplace_back(offset, bytes);
+        }
+
+        image.levels.reserve(level_count);
+        for (const auto &[offset, bytes] : level_ranges)
+        {
+            image.levels.emplace_back(file.begin() + static_cast<ptrdiff_t>(offset),
+                                      file.begin() + static_cast<ptrdiff_t>(offset + bytes));
+        }
+        return image;
+    }
+
+    void SaveKtx2(const KtxImage &Image, const std::string_view Filepath)
+    {
+        PROFILE_ZONE("SaveKtx2");
+
+        const bool srgb = Image.format == vk::Format::eR8G8B8A8Srgb;
+        ASSERT(srgb || Image.format == vk::Format::eR8G8B8A8Unorm,
+               "Only RGBA8 images can be written to KTX2 files, '{}' is {}!",
+               Filepath,
+               vk::to_string(Image.format))
+
+        const auto level_count = static_cast<uint32_t>(Image.levels.size());
+        const size_t dfd_offset = KTX2_LEVEL_INDEX_OFFSET + level_count * KTX2_LEVEL_INDEX_ENTRY_SIZE;
+        const size_t dfd_size = KTX2_RGBA8_DFD_WORDS * sizeof(uint32_t);
+        size_t file_size = dfd_offset + dfd_size;
+        for (const auto &level : Image.levels)
+        {
+            file_size += level.size();
+        }
+
+        std::vector<char> file(file_size, 0);
+        std::copy(KTX2_IDENTIFIER.begin(), KTX2_IDENTIFIER.end(), file.begin());
+        const Ktx2Header header = {static_cast<uint32_t>(Image.format),
+                                   1,
+                                   Image.extent.width,
+                                   Image.extent.height,
+                                   0,
+                                   0,
+                                   1,
+                                   level_count,
+                                   0};
+        WriteKtxValue(file, KTX2_IDENTIFIER.size(), header);
+        WriteKtxValue(file, 48, static_cast<uint32_t>(dfd_offset));
+        WriteKtxValue(file, 52, static_cast<uint32_t>(dfd_size));
+
+        /* Color model RGBSDA with BT.709 primaries, one 8 bit sample per channel. Alpha of srgb textures is flagged
+         * linear since the transfer function only applies to the colors. */
+        const std::array<uint32_t, KTX2_RGBA8_DFD_WORDS> dfd = {
+            static_cast<uint32_t>(dfd_size),
+            0,
+            2 | (static_cast<uint32_t>(dfd_size) - 4) << 16,
+            1 | 1 << 8 | (srgb ? 2u : 1u) << 16,
+            0,
+            4,
+            0,
+            7 << 16,
+            0,
+            0,
+            255,
+            8 | 7 << 16 | 1u << 24,
+            0,
+            0,
+            255,
+            16 | 7 << 16 | 2u << 24,
+            0,
+            0,
+            255,
+            24 | 7 << 16 | (srgb ? 0x1Fu : 0x0Fu) << 24,
+            0,
+            0,
+            255};
+        std::memcpy(file.data() + dfd_offset, dfd.data(), dfd_size);
+
+        // Levels are stored from the smallest to the largest, so a partial read still gets a usable tail
+        size_t offset = dfd_offset + dfd_size;
+        for (uint32_t level = level_count; level-- > 0;)
+        {
+            const auto &pixels = Image.levels[level];
+            std::memcpy(file.data() + offset, pixels.data(), pixels.size());
+
+            const size_t entry = KTX2_LEVEL_INDEX_OFFSET + level * KTX2_LEVEL_INDEX_ENTRY_SIZE;
+            WriteKtxValue<uint64_t>(file, entry, offset);
+            WriteKtxValue<uint64_t>(file, entry + sizeof(uint64_t), pixels.size());
+            WriteKtxValue<uint64_t>(file, entry + 2 * sizeof(uint64_t), pixels.size());
+            offset += pixels.size();
+        }
+
+        File::write_file_atomic(Filepath, file);
+    }
+
+    void TranscodeIfUnsupported(KtxImage &Image)
+    {
+        if (VKDevice::Get().SupportsSampledFormat(Image.format))
+            return;
+
+        const auto decoded_format = GetDecodedFormat(Image.format);
+        ASSERT(decoded_format,
+               "Device can not sample '{}' and there is no decoder for its format {}!",
+               Image.filepath,
+               vk::to_string(Image.format))
+
+        LOG_FORMAT("Device can not sample {}, decoding '{}' on the cpu",
+                   vk::to_string(Image.format),
+                   Image.filepath)
+        for (uint32_t level = 0; level < Image.levels.size(); ++level)
+        {
+            Image.levels[level] = DecodeBlocks(Image.format, Image.GetLevelExtent(level), Image.levels[level]);
+        }
+        Image.format = decoded_format.value();
+    }
+}  // namespace Slipper::GPU::Vulkan
@@ -1,13 +1,32 @@
 #include "../vk_Material.h"
 
 #include "MaterialManager.h"
+#include "Vulkan/vk_BindlessHeap.h"
+#include "Vulkan/vk_CommandContext.h"
 #include "Vulkan/vk_GraphicsShader.h"
+#include "Vulkan/vk_MaterialParameterBuffer.h"
+#include "Vulkan/vk_Texture.h"
+#include "Vulkan/vk_UniformBuffer.h"
 
 namespace Slipper::GPU::Vulkan
 {
     Material::Material(NonOwningPtr<GraphicsShader> Shader)
     {
         shader = Shader;
+        m_shaderAsset = AssetCache::Find(Shader.get());
+        viewProjectionBinding = shader->GetBindingHandle(VIEW_PROJECTION_BINDING);
+        modelBinding = shader->GetBindingHandle(MODEL_BINDING);
+        parameterBlock = MaterialParameterBuffer::IsAvailable() ? MaterialParameterBuffer::Get().AllocateBlock() :
+                                                                  INVALID_MATERIAL_PARAMETER_BLOCK;
+    }
+
+    Material::~Material()
+    {
+        MaterialManager::RemoveUniformUpdates(*this);
+        if (MaterialParameterBuffer::IsAvailable())
+        {
+            MaterialParameterBuffer::Get().FreeBlock(parameterBlock);
+        }
     }
 
     bool Material::SetUniform(const std::string &Name, IShaderBindableData &Uniform)
@@ -22,21 +41,43 @@ namespace Slipper::GPU::Vulkan
 
             Uniform.AdditionalBindingChecks(binding.value());
 
-            if (uniforms.contains(Name))
-            {
-                auto &[shaderBinding, data] = uniforms.at(Name);
-                data = &Uniform;
-            }
-            else
-            {
-                uniforms.emplace(Name, MaterialUniform{binding.value(), &Uniform});
-            }
+            auto &uniform = uniforms.try_emplace(Name, MaterialUniform{binding.value(), &Uniform}).first->second;
+            uniform.data = &Uniform;
+            uniform.asset = AssetCache::Find(dynamic_cast<Texture *>(&Uniform));
 
-            MaterialManager::AddUniformUpdate(*this, uniforms.at(Name));
+            MaterialManager::AddUniformUpdate(*this, uniform);
+            UpdateDescriptorSets();
         }
         return false;
     }
 
+    bool Material::SetTexture(const uint32_t Slot, Texture &Texture)
+    {
+        const uint32_t index = Texture.RegisterBindless();
+        if (index == INVALID_BINDLESS_INDEX)
+        {
+            LOG("Bindless textures are not supported on this device. Use SetUniform instead.")
+            return false;
+        }
+
+        if (textures.size() <= Slot)
+        {
+            textures.resize(Slot + 1, nullptr);
+            m_textureAssets.resize(Slot + 1);
+        }
+        textures[Slot] = &Texture;
+        m_textureAssets[Slot] = AssetCache::Find(&Texture);
+        return true;
+    }
+
+    uint32_t Material::GetTextureIndex(const uint32_t Slot) const
+    {
+        if (Slot >= textures.size() || !textures[Slot])
+            return INVALID_BINDLESS_INDEX;
+
+        return textures[Slot]->bindlessIndex;
+    }
+
     void Material::Use(const VkCommandBuffer &CommandBuffer,
                        NonOwningPtr<const RenderPass> RenderPass,
                        VkExtent2D Extent) const
@@ -44,13 +85,92 @@ namespace Slipper::GPU::Vulkan
         shader->Use(CommandBuffer, RenderPass, Extent);
     }
 
+    void Material::Use(CommandContext &Context,
+                       NonOwningPtr<const RenderPass> RenderPass,
+                       VkExtent2D Extent,
+                       const PipelineVariant Variant) const
+    {
+        shader->Use(Context, RenderPass, Extent, Variant);
+        BindDescriptorSets(Context, shader->GetPipelineLayout(RenderPass));
+    }
+
     UniformBuffer *Material::GetUniformBuffer(const std::string Name, const std::optional<uint32_t> Index) const
     {
         return shader->GetUniformBuffer(Name, Index);
     }
 
+    UniformBuffer *Material::GetUniformBuffer(const BindingHandle Handle, const std::optional<uint32_t> Index) const
+    {
+        return shader->GetUniformBuffer(Handle, Index);
+    }
+
     void Material::BindUniformForThisFrame(const MaterialUniform &Uniform) const
     {
         shader->BindShaderUniform(Uniform.shaderBinding, *Uniform.data, GraphicsEngine::Get().GetCurrentFrame());
     }
+
+    void Material::UpdateDescriptorSets()
+    {
+        m_descriptorSets.clear();
+        for (const auto &set_layout : shader->shaderLayout->setLayouts)
+        {
+            if (shader->UsesBindlessHeap() && set_layout.setNumber == BINDLESS_DESCRIPTOR_SET)
+                continue;
+
+            MaterialDescriptorSet material_set{
+                set_layout.setNumber, shader->GetDescriptorSetLayout(set_layout.setNumber), {}};
+            bool has_uniform = false;
+            bool complete = true;
+            for (const auto &binding : set_layout.bindings)
+            {
+                if (const auto uniform = uniforms.find(binding.name); uniform != uniforms.end())
+                {
+                    material_set.bindings.push_back({binding.binding, uniform->second.data, {}});
+                    has_uniform = true;
+                }
+                else if (binding.descriptorType == vk::DescriptorType::eUniformBuffer)
+                {
+                    material_set.bindings.push_back({binding.binding, nullptr, shader->GetBindingHandle(binding.name)});
+                }
+                else
+                {
+                    complete = false;
+                }
+            }
+
+            // Sets with bindings the material knows nothing about keep using the descriptor sets of the shader
+            if (has_uniform && complete)
+            {
+                m_descriptorSets.push_back(std::move(material_set));
+            }
+        }
+    }
+
+    void Material::BindDescriptorSets(CommandContext &Context, const vk::PipelineLayout PipelineLayout) const
+    {
+        if (m_descriptorSets.empty())
+            return;
+
+        const uint32_t frame = GraphicsEngine::Get().GetCurrentFrame();
+        for (const auto &[set_number, layout, bindings] : m_descriptorSets)
+        {
+            m_setResources.clear();
+            for (const auto &[binding, data, buffer] : bindings)
+            {
+                m_setResources.push_back(DescriptorResource::FromBindable(
+                    binding, data ? *data : *shader->GetUniformBuffer(buffer, frame)));
+            }
+
+            const vk::DescriptorSet set = DescriptorAllocator::Get().GetOrCreateFrameSet(layout, m_setResources);
+            Context.BindDescriptorSets(vk::PipelineBindPoint::eGraphics, PipelineLayout, set_number, {&set, 1});
+        }
+    }
+
+    void Material::SetParameterData(const uint32_t Offset, const void *Data, const uint32_t Size) const
+    {
+        if (parameterBlock == INVALID_MATERIAL_PARAMETER_BLOCK)
+            return;
+
+        MaterialParameterBuffer::Get().Write(parameterBlock, Offset, Data, Size);
+    }
 }  // namespace Slipper::GPU::Vulkan
@@ -0,0 +1,185 @@
+#include "../vk_MaterialParameterBuffer.h"
+
+#include "Vulkan/vk_BindlessHeap.h"
+#include "Vulkan/vk_Buffer.h"
+
+namespace Slipper::GPU::Vulkan
+{
+    MaterialParameterBuffer::MaterialParameterBuffer()
+    {
+        constexpr VkDeviceSize buffer_size = static_cast<VkDeviceSize>(MATERIAL_PARAMETER_BLOCK_SIZE) *
+            MAX_MATERIAL_PARAMETER_BLOCKS;
+
+        m_shadow.resize(buffer_size);
+        m_dirtyFrames.resize(MAX_MATERIAL_PARAMETER_BLOCKS, 0);
+        m_bindlessIndices.fill(INVALID_BINDLESS_INDEX);
+
+        for (uint32_t frame = 0; frame < MAX_FRAMES_IN_FLIGHT; ++frame)
+        {
+            m_frameBuffers[frame] = new Buffer(buffer_size,
+                                               VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                                               VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                                                   VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+            // Stays mapped for the whole lifetime, flushes only copy the changed ranges
+            VK_ASSERT(vkMapMemory(device,
+                                  static_cast<VkDeviceMemory>(*m_frameBuffers[frame]),
+                                  0,
+                                  buffer_size,
+                                  0,
+                                  &m_mappedFrameBuffers[frame]),
+                      "Failed to map material parameter buffer!")
+            memset(m_mappedFrameBuffers[frame], 0, buffer_size);
+
+            if (BindlessHeap::IsAvailable())
+            {
+                m_bindlessIndices[frame] = BindlessHeap::Get().RegisterBuffer(*m_frameBuffers[frame]);
+            }
+        }
+    }
+
+    MaterialParameterBuffer::~MaterialParameterBuffer()
+    {
+        for (uint32_t frame = 0; frame < MAX_FRAMES_IN_FLIGHT; ++frame)
+        {
+            if (BindlessHeap::IsAvailable())
+            {
+                BindlessHeap::Get().ReleaseBuffer(m_bindlessIndices[frame]);
+            }
+            vkUnmapMemory(device, static_cast<VkDeviceMemory>(*m_frameBuffers[frame]));
+            m_frameBuffers[frame].reset();
+        }
+    }
+
+    void MaterialParameterBuffer::Init()
+    {
+        ASSERT(!m_instance, "Material parameter buffer already created!")
+        m_instance = new MaterialParameterBuffer();
+    }
+
+    void MaterialParameterBuffer::Shutdown()
+    {
+        delete m_instance;
+        m_instance = nullptr;
+    }
+
+    uint32_t MaterialParameterBuffer::AllocateBlock()
+    {
+        uint32_t block;
+        if (!m_freeBlocks.empty())
+        {
+            block = m_freeBlocks.back();
+            m_freeBlocks.pop_back();
+        }
+        else
+        {
+            ASSERT(m_nextBlock < MAX_MATERIAL_PARAMETER_BLOCKS,
+                   "Material parameter buffer is full! Capacity: {}",
+                   MAX_MATERIAL_PARAMETER_BLOCKS)
+            block = m_nextBlock++;
+        }
+
+        // Blocks are handed out zeroed so materials never see parameters of a previous owner
+        std::memset(m_shadow.data() + static_cast<size_t>(block) * MATERIAL_PARAMETER_BLOCK_SIZE,
+                    0,
+                    MATERIAL_PARAMETER_BLOCK_SIZE);
+        MarkDirty(block);
+
+        m_stats.blocksInUse++;
+        return block;
+    }
+
+    void MaterialParameterBuffer::FreeBlock(const uint32_t Block)
+    {
+        if (Block == INVALID_MATERIAL_PARAMETER_BLOCK)
+            return;
+
+        m_freeBlocks.push_back(Block);
+        m_stats.blocksInUse--;
+    }
+
+    void MaterialParameterBuffer::Write(const uint32_t Block,
+                                        const uint32_t Offset,
+                                        const void *Data,
+                                        const uint32_t Size)
+    {
+        ASSERT(Offset + Size <= MATERIAL_PARAMETER_BLOCK_SIZE,
+               "Material parameter write [{}, {}) exceeds the block size of {} bytes",
+               Offset,
+               Offset + Size,
+               MATERIAL_PARAMETER_BLOCK_SIZE)
+
+        std::memcpy(m_shadow.data() + static_cast<size_t>(Block) * MATERIAL_PARAMETER_BLOCK_SIZE + Offset, Data, Size);
+        MarkDirty(Block);
+    }
+
+    void MaterialParameterBuffer::MarkDirty(const uint32_t Block)
+    {
+        if (!m_dirtyFrames[Block])
+        {
+            m_dirtyBlocks.push_back(Block);
+        }
+        m_dirtyFrames[Block] = ALL_FRAMES_DIRTY;
+    }
+
+    void MaterialParameterBuffer::Flush(const uint32_t Frame)
+    {
+        m_stats.flushedBlocks = 0;
+        m_stats.flushedRanges = 0;
+        m_stats.flushedBytes = 0;
+
+        if (m_dirtyBlocks.empty())
+            return;
+
+        // Sorting lets neighbouring blocks be copied as one range
+        std::ranges::sort(m_dirtyBlocks);
+
+        const uint8_t frame_bit = 1u << Frame;
+        auto *mapped = static_cast<std::byte *>(m_mappedFrameBuffers[Frame]);
+
+        std::optional<uint32_t> range_begin;
+        uint32_t range_end = 0;
+        const auto copy_range = [&]
+        {
+            const size_t offset = static_cast<size_t>(range_begin.value()) * MATERIAL_PARAMETER_BLOCK_SIZE;
+            const size_t size = static_cast<size_t>(range_end - range_begin.value()) * MATERIAL_PARAMETER_BLOCK_SIZE;
+            std::memcpy(mapped + offset, m_shadow.data() + offset, size);
+            m_stats.flushedRanges++;
+            m_stats.flushedBytes += size;
+        };
+
+        size_t write_index = 0;
+        for (const uint32_t block : m_dirtyBlocks)
+        {
+            uint8_t &dirty_frames = m_dirtyFrames[block];
+            if (dirty_frames & frame_bit)
+            {
+                if (range_begin.has_value() && range_end != block)
+                {
+                    copy_range();
+                    range_begin.reset();
+                }
+                if (!range_begin.has_value())
+                {
+                    range_begin = block;
+                }
+                range_end = block + 1;
+
+                dirty_frames &= ~frame_bit;
+                m_stats.flushedBlocks++;
+            }
+
+            // Keep blocks that other frame slots still have to receive
+            if (dirty_frames)
+            {
+                m_dirtyBlocks[write_index++] = block;
+            }
+        }
+        if (range_begin.has_value())
+        {
+            copy_range();
+        }
+
+        m_dirtyBlocks.resize(write_index);
+    }
+}  // namespace Slipper::GPU::Vulkan
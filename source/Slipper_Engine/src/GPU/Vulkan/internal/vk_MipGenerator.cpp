@@ -0,0 +1,336 @@
+#include "../vk_MipGenerator.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#    include <emmintrin.h>
+#    define SLIPPER_MIP_SSE2
+#endif
+
+namespace Slipper::GPU::Vulkan
+{
+    namespace
+    {
+        // Offset of the first tap from twice the destination coordinate and the weight of every tap, per axis
+        struct FilterTaps
+        {
+            int32_t first;
+            std::vector<float> weights;
+        };
+
+        // Linear RGBA texels of a level that was not quantized yet
+        struct FloatLevel
+        {
+            vk::Extent3D extent;
+            std::vector<float> texels;
+        };
+
+        constexpr float KAISER_ALPHA = 4.0f;
+        // In destination texels, the six taps reach 1.25 texels out
+        constexpr float KAISER_RADIUS = 1.5f;
+        // Share of base level texels that have to be fully transparent or opaque to treat alpha as alpha tested
+        constexpr float ALPHA_TESTED_RATIO = 0.9f;
+        constexpr float MAX_COVERAGE_SCALE = 4.0f;
+        constexpr uint32_t COVERAGE_SEARCH_STEPS = 12;
+        // Resolution of the table used to store linear colors as srgb
+        constexpr uint32_t SRGB_TABLE_SIZE = 4096;
+
+#ifdef SLIPPER_MIP_SSE2
+        // A whole RGBA texel fits a single register, so filtering works on four channels at once
+        using Texel = __m128;
+
+        Texel LoadTexel(const float *Source)
+        {
+            return _mm_loadu_ps(Source);
+        }
+
+        void StoreTexel(float *Target, const Texel Value)
+        {
+            _mm_storeu_ps(Target, Value);
+        }
+
+        Texel ZeroTexel()
+        {
+            return _mm_setzero_ps();
+        }
+
+        Texel AddWeighted(const Texel Sum, const Texel Value, const float Weight)
+        {
+            return _mm_add_ps(Sum, _mm_mul_ps(Value, _mm_set1_ps(Weight)));
+        }
+#else
+        using Texel = glm::vec4;
+
+        Texel LoadTexel(const float *Source)
+        {
+            return glm::make_vec4(Source);
+        }
+
+        void StoreTexel(float *Target, const Texel Value)
+        {
+            std::copy_n(glm::value_ptr(Value), 4, Target);
+        }
+
+        Texel ZeroTexel()
+        {
+            return Texel(0.0f);
+        }
+
+        Texel AddWeighted(const Texel Sum, const Texel Value, const float Weight)
+        {
+            return Sum + Value * Weight;
+        }
+#endif
+
+        // Zeroth order modified bessel function of the first kind, the series converges quickly for the alphas used
+        float BesselI0(const float X)
+        {
+            float sum = 1.0f;
+            float term = 1.0f;
+            for (uint32_t k = 1; k < 16; ++k)
+            {
+                term *= (X * 0.5f / static_cast<float>(k)) * (X * 0.5f / static_cast<float>(k));
+                sum += term;
+            }
+            return sum;
+        }
+
+        FilterTaps GetFilterTaps(const MipFilter Filter)
+        {
+            if (Filter == MipFilter::Box)
+                return {0, {0.5f, 0.5f}};
+
+            // Source texel centers lie 0.5, 1.5 and 2.5 texels to each side of the destination texel center
+            FilterTaps taps{-2, std::vector<float>(6)};
+            float sum = 0.0f;
+            for (int32_t tap = 0; tap < 6; ++tap)
+            {
+                const float distance = (static_cast<float>(taps.first + tap) - 0.5f) * 0.5f;
+                const float x = glm::pi<float>() * distance;
+                const float sinc = std::sin(x) / x;
+                const float window_position = distance / KAISER_RADIUS;
+                const float window = BesselI0(KAISER_ALPHA * std::sqrt(1.0f - window_position * window_position)) /
+                    BesselI0(KAISER_ALPHA);
+                taps.weights[tap] = sinc * window;
+                sum += taps.weights[tap];
+            }
+            for (float &weight : taps.weights)
+            {
+                weight /= sum;
+            }
+            return taps;
+        }
+
+        // The taps of every destination texel along one axis
+        std::vector<FilterTaps> GetAxisTaps(const MipFilter Filter,
+                                            const FilterTaps &Taps,
+                                            const uint32_t SourceSize,
+                                            const uint32_t Size)
+        {
+            if (Filter != MipFilter::Box || SourceSize % 2 == 0 || SourceSize == 1)
+                return std::vector<FilterTaps>(Size, Taps);
+
+            /* An odd side does not halve evenly, every destination texel then covers 2 + 1 / Size source texels. The
+             * three source texels it overlaps are weighted by how much of each lies inside that footprint. */
+            std::vector<FilterTaps> taps(Size);
+            const float footprint = static_cast<float>(SourceSize);
+            for (uint32_t coordinate = 0; coordinate < Size; ++coordinate)
+            {
+                taps[coordinate] = {0,
+                                    {static_cast<float>(Size - coordinate) / footprint,
+                                     static_cast<float>(Size) / footprint,
+                                     static_cast<float>(coordinate + 1) / footprint}};
+            }
+            return taps;
+        }
+
+        // Separable, the horizontal pass is followed by a vertical one. Taps past the edges repeat the edge texels.
+        FloatLevel Downsample(const FloatLevel &Source, const MipFilter Filter, const FilterTaps &Taps)
+        {
+            const uint32_t source_width = Source.extent.width;
+            const uint32_t source_height = Source.extent.height;
+            FloatLevel target{vk::Extent3D(std::max(source_width / 2, 1u), std::max(source_height / 2, 1u), 1), {}};
+            const uint32_t width = target.extent.width;
+            const uint32_t height = target.extent.height;
+            const std::vector<FilterTaps> column_taps = GetAxisTaps(Filter, Taps, source_width, width);
+            const std::vector<FilterTaps> row_taps = GetAxisTaps(Filter, Taps, source_height, height);
+
+            const auto clamp_tap = [&](const uint32_t Coordinate,
+                                       const FilterTaps &AxisTaps,
+                                       const size_t Tap,
+                                       const uint32_t Size) {
+                // A side of 1 is not halved, the taps of the other side are then spread over the single texel
+                const int32_t position = Size == 1 ?
+                    0 :
+                    static_cast<int32_t>(Coordinate * 2) + AxisTaps.first + static_cast<int32_t>(Tap);
+                return static_cast<size_t>(std::clamp(position, 0, static_cast<int32_t>(Size) - 1));
+            };
+
+            std::vector<float> horizontal(static_cast<size_t>(width) * source_height * 4);
+            for (uint32_t y = 0; y < source_height; ++y)
+            {
+                const float *source_row = Source.texels.data() + static_cast<size_t>(y) * source_width * 4;
+                float *target_row = horizontal.data() + static_cast<size_t>(y) * width * 4;
+                for (uint32_t x = 0; x < width; ++x)
+                {
+                    const FilterTaps &taps = column_taps[x];
+                    Texel sum = ZeroTexel();
+                    for (size_t tap = 0; tap < taps.weights.size(); ++tap)
+                    {
+                        sum = AddWeighted(
+                            sum, LoadTexel(source_row + clamp_tap(x, taps, tap, source_width) * 4), taps.weights[tap]);
+                    }
+                    StoreTexel(target_row + static_cast<size_t>(x) * 4, sum);
+                }
+            }
+
+            // Whole rows are accumulated per tap so the reads stay sequential
+            target.texels.resize(static_cast<size_t>(width) * height * 4);
+            for (uint32_t y = 0; y < height; ++y)
+            {
+                float *target_row = target.texels.data() + static_cast<size_t>(y) * width * 4;
+                const FilterTaps &taps = row_taps[y];
+                for (size_t tap = 0; tap < taps.weights.size(); ++tap)
+                {
+                    const float *source_row = horizontal.data() + clamp_tap(y, taps, tap, source_height) * width * 4;
+                    for (uint32_t x = 0; x < width; ++x)
+                    {
+                        const size_t texel = static_cast<size_t>(x) * 4;
+                        const Texel sum = tap == 0 ? ZeroTexel() : LoadTexel(target_row + texel);
+                        StoreTexel(target_row + texel,
+                                   AddWeighted(sum, LoadTexel(source_row + texel), taps.weights[tap]));
+                    }
+                }
+            }
+            return target;
+        }
+
+        float GetAlphaCoverage(const FloatLevel &Level, const float Reference, const float Scale)
+        {
+            size_t covered = 0;
+            const size_t texel_count = Level.texels.size() / 4;
+            for (size_t texel = 0; texel < texel_count; ++texel)
+            {
+                if (Level.texels[texel * 4 + 3] * Scale > Reference)
+                {
+                    ++covered;
+                }
+            }
+            return static_cast<float>(covered) / static_cast<float>(texel_count);
+        }
+
+        /* Coverage only grows with the scale, so a binary search finds the one that matches the base level. The upper
+         * bound is returned since small mips jump from no coverage to almost full coverage within one step. */
+        float FindCoverageScale(const FloatLevel &Level, const float Reference, const float Coverage)
+        {
+            float low = 0.0f;
+            float high = MAX_COVERAGE_SCALE;
+            for (uint32_t step = 0; step < COVERAGE_SEARCH_STEPS; ++step)
+            {
+                const float scale = (low + high) * 0.5f;
+                if (GetAlphaCoverage(Level, Reference, scale) < Coverage)
+                {
+                    low = scale;
+                }
+                else
+                {
+                    high = scale;
+                }
+            }
+            return high;
+        }
+
+        uint8_t QuantizeLinear(const float Value)
+        {
+            return static_cast<uint8_t>(std::clamp(Value * 255.0f + 0.5f, 0.0f, 255.0f));
+        }
+
+        uint8_t QuantizeSrgb(const float Value)
+        {
+            static const auto table = [] {
+                std::array<uint8_t, SRGB_TABLE_SIZE> values{};
+                for (uint32_t i = 0; i < values.size(); ++i)
+                {
+                    values[i] = LinearToSrgb(static_cast<float>(i) / (SRGB_TABLE_SIZE - 1));
+                }
+                return values;
+            }();
+            const float index = std::clamp(Value, 0.0f, 1.0f) * (SRGB_TABLE_SIZE - 1) + 0.5f;
+            return table[static_cast<uint32_t>(index)];
+        }
+
+        std::vector<uint8_t> Quantize(const FloatLevel &Level, const bool Srgb, const float AlphaScale)
+        {
+            std::vector<uint8_t> pixels(Level.texels.size());
+            for (size_t texel = 0; texel < Level.texels.size(); texel += 4)
+            {
+                for (size_t channel = 0; channel < 3; ++channel)
+                {
+                    pixels[texel + channel] = Srgb ? QuantizeSrgb(Level.texels[texel + channel]) :
+                                                     QuantizeLinear(Level.texels[texel + channel]);
+                }
+                pixels[texel + 3] = QuantizeLinear(Level.texels[texel + 3] * AlphaScale);
+            }
+            return pixels;
+        }
+    }  // namespace
+
+    float SrgbToLinear(const uint8_t Value)
+    {
+        static const auto table = [] {
+            std::array<float, 256> values{};
+            for (uint32_t i = 0; i < values.size(); ++i)
+            {
+                const float c = static_cast<float>(i) / 255.0f;
+                values[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+            }
+            return values;
+        }();
+        return table[Value];
+    }
+
+    uint8_t LinearToSrgb(const float Value)
+    {
+        const float c = Value <= 0.0031308f ? Value * 12.92f : 1.055f * std::pow(Value, 1.0f / 2.4f) - 0.055f;
+        return static_cast<uint8_t>(std::clamp(c * 255.0f + 0.5f, 0.0f, 255.0f));
+    }
+
+    std::vector<std::vector<uint8_t>> GenerateMips(const uint8_t *Pixels,
+                                                   const vk::Extent3D Extent,
+                                                   const MipGeneratorSettings &Settings)
+    {
+        PROFILE_ZONE("GenerateMips");
+
+        const size_t texel_count = static_cast<size_t>(Extent.width) * Extent.height;
+        std::vector<std::vector<uint8_t>> mips;
+        mips.emplace_back(Pixels, Pixels + texel_count * 4);
+
+        FloatLevel level{vk::Extent3D(Extent.width, Extent.height, 1), std::vector<float>(texel_count * 4)};
+        size_t binary_alpha = 0;
+        size_t transparent = 0;
+        for (size_t texel = 0; texel < texel_count * 4; texel += 4)
+        {
+            for (size_t channel = 0; channel < 3; ++channel)
+            {
+                level.texels[texel + channel] = Settings.srgb ? SrgbToLinear(Pixels[texel + channel]) :
+                                                                Pixels[texel + channel] / 255.0f;
+            }
+            level.texels[texel + 3] = Pixels[texel + 3] / 255.0f;
+            binary_alpha += Pixels[texel + 3] == 0 || Pixels[texel + 3] == 255;
+            transparent += Pixels[texel + 3] < 255;
+        }
+
+        const bool alpha_tested = Settings.preserveAlphaCoverage && transparent > 0 &&
+            static_cast<float>(binary_alpha) >= ALPHA_TESTED_RATIO * static_cast<float>(texel_count);
+        const float coverage = alpha_tested ? GetAlphaCoverage(level, Settings.alphaTestReference, 1.0f) : 0.0f;
+
+        const FilterTaps taps = GetFilterTaps(Settings.filter);
+        while (level.extent.width > 1 || level.extent.height > 1)
+        {
+            level = Downsample(level, Settings.filter, taps);
+            const float alpha_scale = alpha_tested ?
+                FindCoverageScale(level, Settings.alphaTestReference, coverage) :
+                1.0f;
+            mips.push_back(Quantize(level, Settings.srgb, alpha_scale));
+        }
+        return mips;
+    }
+}  // namespace Slipper::GPU::Vulkan
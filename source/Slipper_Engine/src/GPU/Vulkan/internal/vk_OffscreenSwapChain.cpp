@@ -1,7 +1,6 @@
 #include "../vk_OffscreenSwapChain.h"
 
 #include "Core/Application.h"
-#include "Window.h"
 
 namespace Slipper
 {
@@ -27,13 +26,14 @@ void OffscreenSwapChain::UpdatePresentationTextures(VkCommandBuffer CommandBuffe
     if (!withPresentationTextures)
         return;
 
-    const auto viewport_resolution = GetResolution();
+    const auto viewport_resolution = GetRenderResolution();
     presentationTextures[GetCurrentSwapChainImageIndex()]->EnqueueCopyImage(
         CommandBuffer,
         GetCurrentSwapChainImage(),
         vk::ImageLayout::eTransferSrcOptimal,
         {viewport_resolution.width, viewport_resolution.height, 1},
-        vk::ImageLayout::eShaderReadOnlyOptimal);
+        vk::ImageLayout::eShaderReadOnlyOptimal,
+        viewport_resolution != GetResolution() ? vk::Filter::eLinear : vk::Filter::eNearest);
 }
 
 uint32_t OffscreenSwapChain::GetCurrentSwapChainImageIndex() const
@@ -85,7 +85,7 @@ void OffscreenSwapChain::Impl_Create()
     if (withPresentationTextures) {
         presentationTextures.reserve(Engine::MAX_FRAMES_IN_FLIGHT);
         for (uint32_t i = 0; i < numImages; ++i) {
-            presentationTextures.push_back(new Texture2D(Application::Get().window->GetSize(),
+            presentationTextures.push_back(new Texture2D(resolution,
                                                          Engine::TARGET_VIEWPORT_COLOR_FORMAT,
                                                          swapChainFormat,
                                                          false));
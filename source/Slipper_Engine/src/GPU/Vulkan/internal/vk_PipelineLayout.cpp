@@ -4,14 +4,17 @@
 namespace Slipper
 {
 VkPipelineLayout PipelineLayout::CreatePipelineLayout(
-    const Device &Device, const std::vector<VkDescriptorSetLayout> &DescriptorSetLayouts)
+    const VKDevice &Device,
+    const std::vector<VkDescriptorSetLayout> &DescriptorSetLayouts,
+    const std::vector<vk::PushConstantRange> &PushConstantRanges)
 {
     VkPipelineLayoutCreateInfo pipeline_layout_info{};
     pipeline_layout_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
     pipeline_layout_info.setLayoutCount = static_cast<uint32_t>(DescriptorSetLayouts.size());
     pipeline_layout_info.pSetLayouts = DescriptorSetLayouts.data();
-    pipeline_layout_info.pushConstantRangeCount = 0;     // Optional
-    pipeline_layout_info.pPushConstantRanges = nullptr;  // Optional
+    pipeline_layout_info.pushConstantRangeCount = static_cast<uint32_t>(PushConstantRanges.size());
+    pipeline_layout_info.pPushConstantRanges = reinterpret_cast<const VkPushConstantRange *>(
+        PushConstantRanges.data());
 
     VkPipelineLayout pipeline_layout;
     VK_ASSERT(vkCreatePipelineLayout(
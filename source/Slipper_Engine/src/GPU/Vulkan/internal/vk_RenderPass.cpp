@@ -7,27 +7,56 @@ static char8_t ActiveRenderPasses = 0;
 RenderPass::RenderPass(std::string_view Name,
                        vk::Format RenderingFormat,
                        vk::Format DepthFormat,
-                       bool ForPresentation)
-    : name(Name), m_activeSwapChain(nullptr)
+                       bool ForPresentation,
+                       bool DepthPrePass)
+    : name(Name),
+      renderingFormat(RenderingFormat),
+      depthFormat(DepthFormat),
+      forPresentation(ForPresentation),
+      hasDepthPrePass(DepthPrePass),
+      sampleCount(RenderingFormat == vk::Format::eUndefined ?
+                      vk::SampleCountFlagBits::e1 :
+                      static_cast<vk::SampleCountFlagBits>(GraphicsSettings::MSAA_SAMPLES)),
+      m_activeSwapChain(nullptr)
+{
+    if (IsDepthOnly())
+        CreateDepthOnly();
+    else
+        Create();
+}
+
+void RenderPass::SetSampleCount(const vk::SampleCountFlagBits SampleCount)
+{
+    if (SampleCount == sampleCount)
+        return;
+
+    ASSERT(!IsDepthOnly(), "Depth only render pass '{}' is always single sampled.", name)
+    ASSERT(!ActiveRenderPasses, "Render pass '{}' can not be recreated while recording.", name)
+    vkDestroyRenderPass(device, vkRenderPass, nullptr);
+    sampleCount = SampleCount;
+    Create();
+}
+
+void RenderPass::Create()
 {
     // Not used for presenting cause multisampled textures can not be presented
     // Presentation through color attachment resolve
     VkAttachmentDescription color_attachment{};
-    color_attachment.format = static_cast<VkFormat>(RenderingFormat);
-    color_attachment.samples = static_cast<VkSampleCountFlagBits>(GraphicsSettings::Get().MSAA_SAMPLES);
+    color_attachment.format = static_cast<VkFormat>(renderingFormat);
+    color_attachment.samples = static_cast<VkSampleCountFlagBits>(sampleCount);
     color_attachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
     color_attachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
     color_attachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
     color_attachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
     color_attachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    if (GraphicsSettings::Get().MSAA_SAMPLES != vk::SampleCountFlagBits::e1) {
+    if (sampleCount != vk::SampleCountFlagBits::e1) {
         color_attachment.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
     }
     else {
-        if (ForPresentation)
+        if (forPresentation)
             color_attachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-        else
-            color_attachment.finalLayout = VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL;
+        else  // Offscreen images get copied into their presentation textures, same as the resolve below
+            color_attachment.finalLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
     }
 
     VkAttachmentReference color_attachment_ref{};
@@ -36,29 +65,29 @@ RenderPass::RenderPass(std::string_view Name,
 
     // Used for presentation
     VkAttachmentDescription color_attachment_resolve{};
-    if (GraphicsSettings::Get().MSAA_SAMPLES != vk::SampleCountFlagBits::e1) {
-        color_attachment_resolve.format = static_cast<VkFormat>(RenderingFormat);
+    if (sampleCount != vk::SampleCountFlagBits::e1) {
+        color_attachment_resolve.format = static_cast<VkFormat>(renderingFormat);
         color_attachment_resolve.samples = VK_SAMPLE_COUNT_1_BIT;
         color_attachment_resolve.loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
         color_attachment_resolve.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
         color_attachment_resolve.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
         color_attachment_resolve.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
         color_attachment_resolve.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-        if (ForPresentation)
+        if (forPresentation)
             color_attachment_resolve.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
         else
             color_attachment_resolve.finalLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
     }
 
     VkAttachmentReference color_attachment_resolve_ref{};
-    if (GraphicsSettings::Get().MSAA_SAMPLES != vk::SampleCountFlagBits::e1) {
+    if (sampleCount != vk::SampleCountFlagBits::e1) {
         color_attachment_resolve_ref.attachment = 2;
         color_attachment_resolve_ref.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
     }
 
     VkAttachmentDescription depth_attachment{};
-    depth_attachment.format = static_cast<VkFormat>(DepthFormat);
-    depth_attachment.samples =  static_cast<VkSampleCountFlagBits>(GraphicsSettings::Get().MSAA_SAMPLES);
+    depth_attachment.format = static_cast<VkFormat>(depthFormat);
+    depth_attachment.samples =  static_cast<VkSampleCountFlagBits>(sampleCount);
     depth_attachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
     depth_attachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
     depth_attachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
@@ -70,16 +99,29 @@ RenderPass::RenderPass(std::string_view Name,
     depthAttachmentRef.attachment = 1;
     depthAttachmentRef.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
 
+    // The depth pre-pass only writes depth, the main subpass then shades every pixel exactly once. It always
+    // exists so toggling the pre-pass only changes which pipelines get bound, see VKRenderingStage.
+    VkSubpassDescription depth_subpass{};
+    depth_subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    depth_subpass.pDepthStencilAttachment = &depthAttachmentRef;
+
     VkSubpassDescription subpass{};
     subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
     subpass.colorAttachmentCount = 1;
     subpass.pColorAttachments = &color_attachment_ref;
     subpass.pDepthStencilAttachment = &depthAttachmentRef;
-    if (GraphicsSettings::Get().MSAA_SAMPLES != vk::SampleCountFlagBits::e1) {
+    if (sampleCount != vk::SampleCountFlagBits::e1) {
         subpass.pResolveAttachments = &color_attachment_resolve_ref;
     }
 
-    VkSubpassDependency dependency{};
+    std::vector<VkSubpassDescription> subpasses;
+    if (hasDepthPrePass) {
+        subpasses.push_back(depth_subpass);
+    }
+    subpasses.push_back(subpass);
+
+    std::vector<VkSubpassDependency> dependencies;
+    VkSubpassDependency &dependency = dependencies.emplace_back();
     dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
     dependency.dstSubpass = 0;
     dependency.srcAccessMask = 0;
@@ -90,21 +132,80 @@ RenderPass::RenderPass(std::string_view Name,
     dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
                                VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
 
+    if (hasDepthPrePass) {
+        VkSubpassDependency &depth_dependency = dependencies.emplace_back();
+        depth_dependency.srcSubpass = 0;
+        depth_dependency.dstSubpass = 1;
+        // The color subpass still writes depth, e.g. for draws that skipped the pre-pass
+        depth_dependency.srcStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+                                        VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+        depth_dependency.dstStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+                                        VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+        depth_dependency.srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        depth_dependency.dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
+                                         VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        depth_dependency.dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
+    }
+
     std::vector attachments = {color_attachment, depth_attachment};
-    if (GraphicsSettings::Get().MSAA_SAMPLES != vk::SampleCountFlagBits::e1) {
+    if (sampleCount != vk::SampleCountFlagBits::e1) {
         attachments.push_back(color_attachment_resolve);
     }
     VkRenderPassCreateInfo render_pass_info{};
     render_pass_info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
     render_pass_info.attachmentCount = static_cast<uint32_t>(attachments.size());
     render_pass_info.pAttachments = attachments.data();
+    render_pass_info.subpassCount = static_cast<uint32_t>(subpasses.size());
+    render_pass_info.pSubpasses = subpasses.data();
+    render_pass_info.dependencyCount = static_cast<uint32_t>(dependencies.size());
+    render_pass_info.pDependencies = dependencies.data();
+
+    VK_ASSERT(vkCreateRenderPass(device, &render_pass_info, nullptr, &vkRenderPass),
+              "Failed to create render pass")
+}
+
+void RenderPass::CreateDepthOnly()
+{
+    // Users only render into parts of the attachment, everything else has to survive
+    VkAttachmentDescription depth_attachment{};
+    depth_attachment.format = static_cast<VkFormat>(depthFormat);
+    depth_attachment.samples = VK_SAMPLE_COUNT_1_BIT;
+    depth_attachment.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+    depth_attachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+    depth_attachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    depth_attachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    depth_attachment.initialLayout = VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL;
+    depth_attachment.finalLayout = VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL;
+
+    VkAttachmentReference depth_attachment_ref{};
+    depth_attachment_ref.attachment = 0;
+    depth_attachment_ref.layout = VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL;
+
+    VkSubpassDescription subpass{};
+    subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    subpass.pDepthStencilAttachment = &depth_attachment_ref;
+
+    // Earlier copies and writes into the attachment have to land before the depth tests
+    VkSubpassDependency dependency{};
+    dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
+    dependency.dstSubpass = 0;
+    dependency.srcStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+    dependency.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    dependency.dstStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+    dependency.dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
+                               VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+
+    VkRenderPassCreateInfo render_pass_info{};
+    render_pass_info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+    render_pass_info.attachmentCount = 1;
+    render_pass_info.pAttachments = &depth_attachment;
     render_pass_info.subpassCount = 1;
     render_pass_info.pSubpasses = &subpass;
     render_pass_info.dependencyCount = 1;
     render_pass_info.pDependencies = &dependency;
 
     VK_ASSERT(vkCreateRenderPass(device, &render_pass_info, nullptr, &vkRenderPass),
-              "Failed to create render pass")
+              "Failed to create depth only render pass")
 }
 
 RenderPass::~RenderPass()
@@ -130,7 +231,7 @@ void RenderPass::BeginRenderPass(SwapChain *SwapChain,
     render_pass_info.framebuffer = SwapChain->GetVkFramebuffer(this, ImageIndex);
 
     render_pass_info.renderArea.offset = {0, 0};
-    render_pass_info.renderArea.extent = SwapChain->GetResolution();
+    render_pass_info.renderArea.extent = SwapChain->GetRenderResolution();
 
     std::array<VkClearValue, 2> clear_color{};
     clear_color[0].color = {0.0f, 0.0f, 0.0f, 1.0f};
@@ -142,6 +243,28 @@ void RenderPass::BeginRenderPass(SwapChain *SwapChain,
     vkCmdBeginRenderPass(CommandBuffer, &render_pass_info, VK_SUBPASS_CONTENTS_INLINE);
 }
 
+void RenderPass::BeginRenderPass(const vk::Framebuffer Framebuffer,
+                                 const vk::Extent2D Extent,
+                                 const VkCommandBuffer CommandBuffer)
+{
+    ActiveRenderPasses++;
+
+    VkRenderPassBeginInfo render_pass_info{};
+    render_pass_info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+    render_pass_info.renderPass = vkRenderPass;
+    render_pass_info.framebuffer = Framebuffer;
+    render_pass_info.renderArea.offset = {0, 0};
+    render_pass_info.renderArea.extent = Extent;
+
+    vkCmdBeginRenderPass(CommandBuffer, &render_pass_info, VK_SUBPASS_CONTENTS_INLINE);
+}
+
+void RenderPass::NextSubpass(const VkCommandBuffer CommandBuffer) const
+{
+    ASSERT(hasDepthPrePass, "Render pass '{}' only has a single subpass.", name)
+    vkCmdNextSubpass(CommandBuffer, VK_SUBPASS_CONTENTS_INLINE);
+}
+
 void RenderPass::EndRenderPass(VkCommandBuffer commandBuffer)
 {
     ActiveRenderPasses--;
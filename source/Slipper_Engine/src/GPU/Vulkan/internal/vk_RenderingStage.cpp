@@ -1,5 +1,14 @@
 #include "../vk_RenderingStage.h"
 
+#include "Vulkan/vk_BindlessHeap.h"
+#include "Vulkan/vk_ClusteredLighting.h"
+#include "Vulkan/vk_FrameReadback.h"
+#include "Vulkan/vk_GraphicsPipeline.h"
+#include "Vulkan/vk_GraphicsShader.h"
+#include "Vulkan/vk_Material.h"
+#include "Vulkan/vk_MaterialParameterBuffer.h"
+#include "Vulkan/vk_ShadowAtlas.h"
+#include "Vulkan/vk_TextureStreamer.h"
 
 namespace Slipper::GPU::Vulkan
 {
@@ -19,6 +28,16 @@ namespace Slipper::GPU::Vulkan
                 device.logicalDevice.createSemaphore(&semaphore_create_info, nullptr, &m_computeFinishedSemaphores[i]),
                 "Failed to create compute semaphore!");
         }
+
+        if (device.SupportsPipelineStatistics())
+        {
+            const vk::QueryPoolCreateInfo pool_info({},
+                                                    vk::QueryType::ePipelineStatistics,
+                                                    MAX_OVERDRAW_QUERIES * MAX_FRAMES_IN_FLIGHT,
+                                                    vk::QueryPipelineStatisticFlagBits::eFragmentShaderInvocations);
+            VK_HPP_ASSERT(device.logicalDevice.createQueryPool(&pool_info, nullptr, &m_overdrawQueryPool),
+                          "Failed to create overdraw query pool!")
+        }
     }
 
     VKRenderingStage::~VKRenderingStage()
@@ -27,11 +46,15 @@ namespace Slipper::GPU::Vulkan
         {
             device.logicalDevice.destroySemaphore(compute_finished_semaphore);
         }
+        if (m_overdrawQueryPool)
+        {
+            device.logicalDevice.destroyQueryPool(m_overdrawQueryPool);
+        }
 
         renderPasses.clear();
     }
 
-    void VKRenderingStage::BeginRender() const
+    void VKRenderingStage::BeginRender()
     {
         if (m_nativeSwapChain)
         {
@@ -50,12 +73,21 @@ namespace Slipper::GPU::Vulkan
         }
 
         const auto draw_command_buffer = graphicsCommandPool->BeginCurrentCommandBuffer();
-        for (const auto render_pass : renderPasses)
+        const auto compute_command_buffer = computeCommandPool->BeginCurrentCommandBuffer();
+
+        if (GpuProfiler::IsAvailable())
         {
-            render_pass->BeginRenderPass(GetSwapChain(), GetCurrentImageIndex(), draw_command_buffer);
+            m_stageProfileScope = GpuProfiler::Get().BeginScope(draw_command_buffer, name);
+            m_computeProfileScope = GpuProfiler::Get().BeginScope(compute_command_buffer, name + " Compute");
         }
 
-        computeCommandPool->BeginCurrentCommandBuffer();
+        if (m_overdrawQueryPool)
+        {
+            // The frame slots fence has been waited on in GraphicsEngine::NewFrame, so its queries are done
+            const uint32_t frame = GraphicsEngine::Get().GetCurrentFrame();
+            CollectOverdrawStats(frame);
+            draw_command_buffer.resetQueryPool(m_overdrawQueryPool, frame * MAX_OVERDRAW_QUERIES, MAX_OVERDRAW_QUERIES);
+        }
     }
 
     void VKRenderingStage::EndRender()
@@ -63,12 +95,34 @@ namespace Slipper::GPU::Vulkan
         const auto draw_command_buffer = graphicsCommandPool->GetCurrentCommandBuffer();
         const auto compute_command_buffer = computeCommandPool->GetCurrentCommandBuffer();
 
+        m_drawContext.Reset(draw_command_buffer);
+        m_drawContext.ResetStats();
+
+        const uint32_t frame = GraphicsEngine::Get().GetCurrentFrame();
+        const glm::mat4 view = GraphicsEngine::GetDefaultCamera().GetComponent<Camera>().GetView();
+
+        // Stages without draws have nothing to light, e.g. the window stage only presents the gui
+        const bool has_draws = std::ranges::any_of(queuedDraws | std::views::values,
+                                                   [](const auto &Draws) { return !Draws.empty(); });
+        if (has_draws && ShadowAtlas::IsAvailable())
+        {
+            // Renders into its own atlas, so it has to be recorded before any render pass of the stage begins
+            ShadowAtlas::Get().Record(draw_command_buffer, frame);
+        }
+        if (has_draws && ClusteredLighting::IsAvailable())
+        {
+            ClusteredLighting::Get().Record(*this, compute_command_buffer, frame);
+        }
+
         for (auto render_pass : renderPasses)
         {
             // Execute all compute commands
-            for (auto &repeated_compute_command : repeatedComputeCommands[render_pass])
             {
-                repeated_compute_command(compute_command_buffer);
+                GPU_PROFILE_SCOPE(compute_command_buffer, render_pass->name);
+                for (auto &repeated_compute_command : repeatedComputeCommands[render_pass])
+                {
+                    repeated_compute_command(compute_command_buffer);
+                }
             }
             for (auto &single_compute_command : singleComputeCommands[render_pass])
             {
@@ -76,6 +130,50 @@ namespace Slipper::GPU::Vulkan
             }
             singleComputeCommands.at(render_pass).clear();
 
+            // Begun only now so the commands above are recorded outside of it
+            if (GpuProfiler::IsAvailable())
+            {
+                m_renderPassProfileScopes[render_pass] = GpuProfiler::Get().BeginScope(draw_command_buffer,
+                                                                                      render_pass->name);
+            }
+            render_pass->BeginRenderPass(GetSwapChain(), GetCurrentImageIndex(), draw_command_buffer);
+
+            auto &draws = queuedDraws[render_pass];
+            const bool depth_pre_pass = m_depthPrePass && render_pass->hasDepthPrePass;
+            // Front to back lets early depth testing reject hidden fragments, with a pre-pass it only matters for
+            // the depth only draws
+            for (auto &draw : draws)
+            {
+                draw.viewDepth = -(view * draw.transform[3]).z;
+            }
+            std::ranges::sort(draws, std::less(), &QueuedDraw::viewDepth);
+
+            if (render_pass->hasDepthPrePass)
+            {
+                if (depth_pre_pass)
+                {
+                    GPU_PROFILE_SCOPE(draw_command_buffer, "Depth Pre-Pass");
+                    m_drawContext.Invalidate();
+                    RecordDraws(render_pass, draws, PipelineVariant::DepthOnly);
+                }
+                render_pass->NextSubpass(draw_command_buffer);
+
+                // Every pixel gets shaded once now, so grouping by material saves binds instead
+                if (depth_pre_pass)
+                {
+                    std::ranges::stable_sort(draws,
+                                             [](const QueuedDraw &A, const QueuedDraw &B)
+                                             { return A.material.get() < B.material.get(); });
+                }
+            }
+
+            const bool measure_overdraw = m_overdrawQueryPool && m_usedOverdrawQueries[frame] < MAX_OVERDRAW_QUERIES;
+            const uint32_t overdraw_query = frame * MAX_OVERDRAW_QUERIES + m_usedOverdrawQueries[frame];
+            if (measure_overdraw)
+            {
+                draw_command_buffer.beginQuery(m_overdrawQueryPool, overdraw_query, {});
+            }
+
             // Execute all graphics commands
             for (auto &repeated_draw_command : repeatedGraphicsCommands[render_pass])
             {
@@ -87,20 +185,53 @@ namespace Slipper::GPU::Vulkan
             }
             singleGraphicsCommands.at(render_pass).clear();
 
+            // The raw commands above might have bound anything, so the tracked state can not be trusted anymore
+            m_drawContext.Invalidate();
+            RecordDraws(render_pass, draws, depth_pre_pass ? PipelineVariant::DepthEqual : PipelineVariant::Default);
+            draws.clear();
+
+            if (measure_overdraw)
+            {
+                // Queries started in a subpass have to end in it
+                draw_command_buffer.endQuery(m_overdrawQueryPool, overdraw_query);
+                const auto [width, height] = GetSwapChain()->GetRenderResolution();
+                m_overdrawPixels[frame] += static_cast<uint64_t>(width) * height;
+                ++m_usedOverdrawQueries[frame];
+            }
+
             render_pass->EndRenderPass(draw_command_buffer);
+            if (GpuProfiler::IsAvailable())
+            {
+                GpuProfiler::Get().EndScope(draw_command_buffer, m_renderPassProfileScopes[render_pass]);
+            }
 
             if (HasPresentationTextures())
             {
-                const auto [width, height] = GetSwapChain()->GetResolution();
+                // Upscales the dynamic resolution render area to the full presentation texture
+                const auto [width, height] = GetSwapChain()->GetRenderResolution();
+                const bool scaled = GetSwapChain()->GetRenderResolution() != GetSwapChain()->GetResolution();
                 GetPresentationTexture()->EnqueueCopyImage(draw_command_buffer,
                                                            GetSwapChain()->GetCurrentSwapChainImage(),
                                                            vk::ImageLayout::eTransferSrcOptimal,
                                                            {width, height, 1},
-                                                           vk::ImageLayout::eShaderReadOnlyOptimal);
+                                                           vk::ImageLayout::eShaderReadOnlyOptimal,
+                                                           scaled ? vk::Filter::eLinear : vk::Filter::eNearest);
             }
         }
+        if (FrameReadback::IsAvailable())
+        {
+            FrameReadback::Get().Record(*this, draw_command_buffer, GraphicsEngine::Get().GetCurrentFrame());
+        }
+        if (GpuProfiler::IsAvailable())
+        {
+            GpuProfiler::Get().EndScope(compute_command_buffer, m_computeProfileScope);
+            GpuProfiler::Get().EndScope(draw_command_buffer, m_stageProfileScope);
+        }
+
         computeCommandPool->EndCommandBuffer(compute_command_buffer);
         graphicsCommandPool->EndCommandBuffer(draw_command_buffer);
+
+        m_lastCommandStats = m_drawContext.GetStats();
     }
 
     void VKRenderingStage::SubmitSingleComputeCommand(const RenderPass *RP,
@@ -120,28 +251,96 @@ namespace Slipper::GPU::Vulkan
                                     NonOwningPtr<const Model> Model,
                                     const glm::mat4 &Transform)
     {
-        SubmitSingleDrawCommand(RenderPass,
-                                [=, this](const VkCommandBuffer &CommandBuffer)
-                                {
-                                    const auto resolution = GetSwapChain()->GetResolution();
-                                    Material->Use(CommandBuffer, RenderPass, resolution);
+        queuedDraws[RenderPass].push_back({Material, Model, Transform, 0.0f});
+    }
+
+    void VKRenderingStage::RecordDraws(NonOwningPtr<const RenderPass> RenderPass,
+                                       const std::vector<QueuedDraw> &Draws,
+                                       const PipelineVariant Variant)
+    {
+        if (Draws.empty())
+            return;
+
+        const auto resolution = GetSwapChain()->GetRenderResolution();
+        const auto camera = GraphicsEngine::GetDefaultCamera();
+        const auto &cam_parameters = camera.GetComponent<Camera>();
+
+        UniformVP vp;
+        vp.view = cam_parameters.GetView();
+        vp.projection = cam_parameters.GetProjection(static_cast<float>(resolution.width) / resolution.height);
+
+        const uint32_t frame = GraphicsEngine::Get().GetCurrentFrame();
+        const uint32_t light_buffer = ClusteredLighting::IsAvailable() ?
+            ClusteredLighting::Get().GetLightBuffer(*this, frame) :
+            INVALID_BINDLESS_INDEX;
 
-                                    const auto camera = GraphicsEngine::GetDefaultCamera();
-                                    const auto &cam_parameters = camera.GetComponent<Camera>();
+        // Depth only draws do not sample anything, so only the color pass feeds the texture streamer
+        const bool stream_textures = TextureStreamer::IsAvailable() && Variant != PipelineVariant::DepthOnly;
+        const float pixels_per_unit = vp.projection[1][1] * static_cast<float>(resolution.height) * 0.5f;
 
-                                    UniformVP vp;
-                                    vp.view = cam_parameters.GetView();
-                                    vp.projection = cam_parameters.GetProjection(static_cast<float>(resolution.width) /
-                                                                                 resolution.height);
+        for (const auto &[material, model, transform, view_depth] : Draws)
+        {
+            if (stream_textures)
+            {
+                TextureStreamer::Get().RequestMaterial(
+                    *material,
+                    TextureStreamer::GetUvPixels(
+                        model->GetMesh(), transform, -(vp.view * transform[3]).z, pixels_per_unit));
+            }
+
+            material->Use(m_drawContext, RenderPass, resolution, Variant);
+
+            // Shaders that get the camera some other way, e.g. through push constants, have no vp uniform
+            if (material->viewProjectionBinding.IsValid())
+            {
+                material->GetUniformBuffer(material->viewProjectionBinding)->SubmitData(&vp);
+            }
+
+            // Shaders with a draw push constant block get their per draw data without
+            // touching any memory, the others still go through the model uniform
+            if (material->shader->HasDrawPushConstants())
+            {
+                const DrawPushConstants draw_constants{
+                    transform,
+                    material->GetTextureIndex(0),
+                    MaterialParameterBuffer::IsAvailable() ?
+                        MaterialParameterBuffer::Get().GetBindlessIndex(frame) :
+                        INVALID_BINDLESS_INDEX,
+                    material->GetParameterBlock(),
+                    light_buffer};
+                material->shader->Push(m_drawContext, RenderPass, draw_constants);
+            }
+            else if (material->modelBinding.IsValid())
+            {
+                UniformModel model_uniform;
+                model_uniform.model = transform;
+                material->GetUniformBuffer(material->modelBinding)->SubmitData(&model_uniform);
+            }
 
-                                    UniformModel model;
-                                    model.model = Transform;
+            model->Draw(m_drawContext);
+        }
+    }
 
-                                    Material->GetUniformBuffer("vp")->SubmitData(&vp);
-                                    Material->GetUniformBuffer("m")->SubmitData(&model);
+    void VKRenderingStage::CollectOverdrawStats(const uint32_t Frame)
+    {
+        const uint32_t used_queries = m_usedOverdrawQueries[Frame];
+        if (!used_queries)
+            return;
 
-                                    Model->Draw(CommandBuffer);
-                                });
+        std::array<uint64_t, MAX_OVERDRAW_QUERIES> invocations{};
+        VK_HPP_ASSERT(device.logicalDevice.getQueryPoolResults(m_overdrawQueryPool,
+                                                               Frame * MAX_OVERDRAW_QUERIES,
+                                                               used_queries,
+                                                               used_queries * sizeof(uint64_t),
+                                                               invocations.data(),
+                                                               sizeof(uint64_t),
+                                                               vk::QueryResultFlagBits::e64),
+                      "Failed to read overdraw queries!")
+
+        m_overdrawStats.fragmentInvocations = std::accumulate(invocations.begin(), invocations.end(), uint64_t{0});
+        m_overdrawStats.pixels = m_overdrawPixels[Frame];
+        m_usedOverdrawQueries[Frame] = 0;
+        m_overdrawPixels[Frame] = 0;
     }
 
     void VKRenderingStage::SubmitSingleDrawCommand(const RenderPass *RP,
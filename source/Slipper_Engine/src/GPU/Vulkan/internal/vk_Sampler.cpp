@@ -7,7 +7,8 @@ Sampler *Sampler::m_nearestSampler = nullptr;
 
 Sampler::Sampler(const VkFilter Filter,
                  const VkSamplerAddressMode AddressMode,
-                 const uint32_t MipLevels)
+                 const uint32_t MipLevels,
+                 const float MinLod)
 {
     VkSamplerCreateInfo sampler_info{};
     sampler_info.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
@@ -24,7 +25,7 @@ Sampler::Sampler(const VkFilter Filter,
     sampler_info.compareOp = VK_COMPARE_OP_ALWAYS;
     sampler_info.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
     sampler_info.mipLodBias = 0.0f;
-    sampler_info.minLod = static_cast<float>(0);
+    sampler_info.minLod = MinLod;
     sampler_info.maxLod = static_cast<float>(MipLevels);
 
     VK_ASSERT(vkCreateSampler(device, &sampler_info, nullptr, &sampler),
@@ -1,16 +1,50 @@
 #include "../vk_Shader.h"
 
-namespace Slipper
+#include "Vulkan/vk_BindlessHeap.h"
+#include "Vulkan/vk_CommandContext.h"
+#include "Vulkan/vk_DescriptorAllocator.h"
+
+namespace Slipper::GPU::Vulkan
 {
 const char *ShaderTypeNames[]{"UNDEFINED", "Vertex", "Fragment", "Compute"};
 
+ShaderCode Shader::ReadCode(const std::span<const std::tuple<std::string_view, ShaderType>> Stages)
+{
+    PROFILE_ZONE("Shader::ReadCode");
+
+    ShaderCode shader_code;
+    std::vector<std::vector<char>> binary_codes;
+    binary_codes.reserve(Stages.size());
+    for (const auto &[filepath, shader_type] : Stages) {
+        binary_codes.push_back(File::read_binary_file(filepath));
+    }
+    shader_code.layout = std::make_unique<ShaderLayout>(binary_codes);
+
+    shader_code.stages.reserve(Stages.size());
+    for (size_t stage = 0; stage < Stages.size(); ++stage) {
+        const auto &[filepath, shader_type] = Stages[stage];
+        shader_code.stages.push_back({std::string(filepath), shader_type, std::move(binary_codes[stage])});
+    }
+    return shader_code;
+}
+
 Shader::~Shader()
 {
     shaderLayout.reset();
-    if (m_vkDescriptorPool)
-        vkDestroyDescriptorPool(device, m_vkDescriptorPool, nullptr);
+    for (const auto &[set_number, vk_descriptor_sets] : m_vkDescriptorSets) {
+        if (UsesBindlessHeap() && set_number == BINDLESS_DESCRIPTOR_SET)
+            continue;
+
+        for (const auto vk_descriptor_set : vk_descriptor_sets) {
+            DescriptorAllocator::Get().FreePersistent(vk_descriptor_set);
+        }
+    }
+
+    for (const auto &[set_number, vk_descriptor_set_layout] : m_vkDescriptorSetLayouts) {
+        // The bindless layout is owned by the heap
+        if (UsesBindlessHeap() && set_number == BINDLESS_DESCRIPTOR_SET)
+            continue;
 
-    for (const auto vk_descriptor_set_layout : m_vkDescriptorSetLayouts | std::views::values) {
         vkDestroyDescriptorSetLayout(device, vk_descriptor_set_layout, nullptr);
     }
     uniformBindingBuffers.clear();
@@ -19,52 +53,27 @@ Shader::~Shader()
 UniformBuffer *Shader::GetUniformBuffer(const std::string Name,
                                         const std::optional<uint32_t> Index) const
 {
-    if (auto hash_binding = GetNamedBinding(Name); hash_binding.has_value()) {
-        if (const Ref<DescriptorSetLayoutBinding> binding = hash_binding.value();
-            uniformBindingBuffers.contains(GetHash(binding))) {
+    const BindingHandle handle = GetBindingHandle(Name);
+    ASSERT(handle.IsValid(), "Object '{}' does not exist.", Name);
+    ASSERT(!uniformBindingBuffers[handle.index].empty(), "Uniform '{}' is not a buffer.", Name);
 
-            return uniformBindingBuffers
-                .at(GetHash(binding))[Index.has_value() ? Index.value() :
-                                                          GraphicsEngine::Get().GetCurrentFrame()]
-                .get();
-        }
-        ASSERT(false, "Uniform '{}' is not a buffer.", Name);
-    }
-    ASSERT(false, "Object '{}' does not exist.", Name);
+    return GetUniformBuffer(handle, Index);
 }
 
-std::vector<vk::DescriptorSet> Shader::GetDescriptorSets(const std::optional<uint32_t> Index) const
+UniformBuffer *Shader::GetUniformBuffer(const BindingHandle Handle,
+                                        const std::optional<uint32_t> Index) const
 {
-    std::vector<vk::DescriptorSet> ds;
-    for (auto vk_descriptor_sets : m_vkDescriptorSets | std::ranges::views::values) {
-        ds.push_back(
-            vk_descriptor_sets[Index.has_value() ? Index.value() :
-                                                   GraphicsEngine::Get().GetCurrentFrame()]);
-    }
-    return ds;
+    return uniformBindingBuffers[Handle.index]
+                                [Index.has_value() ? Index.value() :
+                                                     GraphicsEngine::Get().GetCurrentFrame()]
+                                    .get();
 }
 
-void Shader::CreateDescriptorPool()
+const std::vector<vk::DescriptorSet> &Shader::GetDescriptorSets(
+    const std::optional<uint32_t> Index) const
 {
-    std::vector<vk::DescriptorPoolSize> pool_sizes;
-    for (const auto set_layout : shaderLayout->setLayouts) {
-        for (DescriptorSetLayoutBinding binding : set_layout.bindings) {
-            /* Need to multiply by Engine::MAX_FRAMES_IN_FLIGHT since vulkan needs to know the
-             * total amount of descriptors as well as the total amount of sets these descriptors
-             * divide into */
-            pool_sizes.push_back(
-                {binding.descriptorType, binding.descriptorCount * Engine::MAX_FRAMES_IN_FLIGHT});
-        }
-    }
-
-    vk::DescriptorPoolCreateInfo pool_info(vk::DescriptorPoolCreateFlags{},
-                                           shaderLayout->setLayouts.size() *
-                                               Engine::MAX_FRAMES_IN_FLIGHT,
-                                           pool_sizes);
-
-    VK_HPP_ASSERT(
-        device.logicalDevice.createDescriptorPool(&pool_info, nullptr, &m_vkDescriptorPool),
-        "Failed to create descriptor pool!")
+    return m_frameDescriptorSets[Index.has_value() ? Index.value() :
+                                                     GraphicsEngine::Get().GetCurrentFrame()];
 }
 
 VkShaderModule Shader::CreateShaderModule(const std::vector<char> &Code)
@@ -109,12 +118,14 @@ VkPipelineShaderStageCreateInfo Shader::CreateShaderStage(const ShaderType &Shad
 
 void Shader::CreateUniformBuffers()
 {
-    for (const auto layout_binding : shaderLayout->namedLayoutBindings | std::views::values) {
+    uniformBindingBuffers.resize(shaderLayout->bindings.size());
+    for (uint32_t index = 0; index < shaderLayout->bindings.size(); ++index) {
+        const auto layout_binding = shaderLayout->bindings[index];
         if (layout_binding->descriptorType == vk::DescriptorType::eUniformBuffer) {
-            auto &buffers = uniformBindingBuffers[GetHash(layout_binding)];
-            for (int i = 0; i < Engine::MAX_FRAMES_IN_FLIGHT; ++i) {
+            auto &buffers = uniformBindingBuffers[index];
+            for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i) {
                 auto &new_buffer = buffers.emplace_back(new UniformBuffer(layout_binding->size));
-                BindShaderUniform(layout_binding->name, *new_buffer, i);
+                BindShaderUniform(*layout_binding, *new_buffer, i);
             }
         }
     }
@@ -123,46 +134,106 @@ void Shader::CreateUniformBuffers()
 void Shader::CreateDescriptorSetLayouts()
 {
     for (auto set_layout : shaderLayout->setLayouts) {
+        if (set_layout.setNumber == BINDLESS_DESCRIPTOR_SET && BindlessHeap::IsAvailable()) {
+            m_vkDescriptorSetLayouts[set_layout.setNumber] = BindlessHeap::Get().GetLayout();
+            m_usesBindlessHeap = true;
+            continue;
+        }
+
         m_vkDescriptorSetLayouts[set_layout.setNumber] =
             device.logicalDevice.createDescriptorSetLayout(set_layout.createInfo);
     }
+
+    // Pipeline layouts and descriptor binds address sets by position, so set numbers that are skipped
+    // by the shader (e.g. when only the bindless set is used) get an empty layout
+    if (!m_vkDescriptorSetLayouts.empty()) {
+        const uint32_t highest_set = m_vkDescriptorSetLayouts.rbegin()->first;
+        for (uint32_t set_number = 0; set_number < highest_set; ++set_number) {
+            if (!m_vkDescriptorSetLayouts.contains(set_number)) {
+                m_vkDescriptorSetLayouts[set_number] = device.logicalDevice.createDescriptorSetLayout(
+                    vk::DescriptorSetLayoutCreateInfo{});
+            }
+        }
+    }
 }
 
 void Shader::AllocateDescriptorSets()
 {
-    std::vector<VkDescriptorSetLayout> layouts;
-    layouts.reserve(m_vkDescriptorSetLayouts.size() * Engine::MAX_FRAMES_IN_FLIGHT);
+    // Allocate a set for each frame so that they can be updated on a per frame basis
+    for (const auto &[set_number, vk_descriptor_set_layout] : m_vkDescriptorSetLayouts) {
+        auto &descriptor_sets = m_vkDescriptorSets[set_number];
+        descriptor_sets.reserve(MAX_FRAMES_IN_FLIGHT);
 
-    // Make a duplicate of each descriptor set layout for each frame so that they can be set on a
-    // per frame basis
-    for (auto vk_descriptor_set_layout : m_vkDescriptorSetLayouts | std::ranges::views::values) {
-        std::fill_n(
-            std::back_inserter(layouts), Engine::MAX_FRAMES_IN_FLIGHT, vk_descriptor_set_layout);
+        // There is only a single global bindless set which is shared by all frames and shaders
+        if (UsesBindlessHeap() && set_number == BINDLESS_DESCRIPTOR_SET) {
+            descriptor_sets.assign(MAX_FRAMES_IN_FLIGHT, BindlessHeap::Get().GetSet());
+            continue;
+        }
+
+        for (uint32_t frame = 0; frame < MAX_FRAMES_IN_FLIGHT; ++frame) {
+            descriptor_sets.push_back(
+                DescriptorAllocator::Get().AllocatePersistent(vk_descriptor_set_layout));
+        }
     }
 
-    std::vector<VkDescriptorSet> descriptor_sets;
-    descriptor_sets.resize(layouts.size());
+    m_frameDescriptorSets.assign(MAX_FRAMES_IN_FLIGHT, {});
+    for (uint32_t frame = 0; frame < MAX_FRAMES_IN_FLIGHT; ++frame) {
+        for (const auto &descriptor_sets : m_vkDescriptorSets | std::views::values) {
+            m_frameDescriptorSets[frame].push_back(descriptor_sets[frame]);
+        }
+    }
+}
+
+const PushConstantRange *Shader::GetPushConstantRange(const std::string_view Name) const
+{
+    for (const auto &range : shaderLayout->pushConstantRanges) {
+        if (range.name == Name) {
+            return &range;
+        }
+    }
+    return nullptr;
+}
 
-    VkDescriptorSetAllocateInfo allocate_info{};
-    allocate_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-    allocate_info.descriptorPool = m_vkDescriptorPool;
-    allocate_info.pSetLayouts = layouts.data();
-    allocate_info.descriptorSetCount = layouts.size();
+void Shader::PushConstantData(const vk::CommandBuffer CommandBuffer,
+                              const vk::PipelineLayout PipelineLayout,
+                              const void *Data,
+                              const uint32_t Size,
+                              const uint32_t Offset) const
+{
+    CommandBuffer.pushConstants(
+        PipelineLayout, GetPushConstantStageFlags(Offset, Size), Offset, Size, Data);
+}
 
-    VK_ASSERT(vkAllocateDescriptorSets(VKDevice::Get(), &allocate_info, descriptor_sets.data()),
-              "Failed to allocate descriptor sets!");
-    uint32_t i = 0;
-    for (const auto &set_number : m_vkDescriptorSetLayouts | std::views::keys) {
-        auto &set_layout = m_vkDescriptorSets[set_number];
-        auto begin_offset_it = descriptor_sets.begin();
-        std::advance(begin_offset_it, i * Engine::MAX_FRAMES_IN_FLIGHT);
-        auto end_offset_it = descriptor_sets.begin();
-        std::advance(end_offset_it,
-                     i * Engine::MAX_FRAMES_IN_FLIGHT + Engine::MAX_FRAMES_IN_FLIGHT);
-        set_layout.insert(set_layout.end(), begin_offset_it, end_offset_it);
+void Shader::PushConstantData(CommandContext &Context,
+                              const vk::PipelineLayout PipelineLayout,
+                              const void *Data,
+                              const uint32_t Size,
+                              const uint32_t Offset) const
+{
+    Context.PushConstants(
+        PipelineLayout, GetPushConstantStageFlags(Offset, Size), Offset, Size, Data);
+}
 
-        i++;
+vk::ShaderStageFlags Shader::GetPushConstantStageFlags(const uint32_t Offset,
+                                                       const uint32_t Size) const
+{
+    // Every stage whose range overlaps the written bytes has to be part of the stage flags
+    vk::ShaderStageFlags stage_flags;
+    uint32_t covered_end = 0;
+    for (const auto &range : shaderLayout->pushConstantRanges) {
+        if (range.offset < Offset + Size && Offset < range.offset + range.size) {
+            stage_flags |= range.stageFlags;
+            covered_end = std::max(covered_end, range.offset + range.size);
+        }
     }
+
+    ASSERT(stage_flags && Offset + Size <= covered_end,
+           "Push constant data [{}, {}) is not covered by the push constant ranges of shader '{}'",
+           Offset,
+           Offset + Size,
+           name)
+
+    return stage_flags;
 }
 
 void Shader::BindShaderUniform_Interface(const DescriptorSetLayoutBindingMinimal &Binding,
@@ -196,12 +267,12 @@ void Shader::UpdateDescriptorSets(vk::WriteDescriptorSet DescriptorWrite,
     else {
         // Update all descriptor sets at once
         std::vector<vk::WriteDescriptorSet> descriptor_writes;
-        descriptor_writes.reserve(Engine::MAX_FRAMES_IN_FLIGHT);
-        for (uint32_t frame = 0; frame < Engine::MAX_FRAMES_IN_FLIGHT; ++frame) {
+        descriptor_writes.reserve(MAX_FRAMES_IN_FLIGHT);
+        for (uint32_t frame = 0; frame < MAX_FRAMES_IN_FLIGHT; ++frame) {
             DescriptorWrite.dstSet = m_vkDescriptorSets.at(Binding.set)[frame];
             descriptor_writes.push_back(DescriptorWrite);
         }
         device.logicalDevice.updateDescriptorSets(descriptor_writes, {});
     }
 }
-}  // namespace Slipper
\ No newline at end of file
+}  // namespace Slipper::GPU::Vulkan
\ No newline at end of file
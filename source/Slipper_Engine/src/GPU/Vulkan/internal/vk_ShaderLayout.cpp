@@ -7,6 +7,7 @@ namespace Slipper
 ShaderLayout::ShaderLayout(const std::vector<std::vector<char>> &BinaryCode)
 {
     setLayouts = ShaderReflection::GetMergedDescriptorSetsLayoutData(BinaryCode);
+    pushConstantRanges = ShaderReflection::GetMergedPushConstantRanges(BinaryCode);
 
     PopulateNamesLayoutBindings();
 }
@@ -16,7 +17,17 @@ void ShaderLayout::PopulateNamesLayoutBindings()
     for (auto &layout_data : setLayouts) {
 	    for (auto &binding : layout_data.bindings)
 	    {
-            namedLayoutBindings[String::to_lower(binding.name)] = &binding;
+            const auto [handle, inserted] = bindingHandles.try_emplace(
+                String::hash_name(binding.name), BindingHandle{static_cast<uint32_t>(bindings.size())});
+            if (!inserted) {
+                ASSERT(String::equals_name(bindings[handle->second.index]->name, binding.name),
+                       "Shader bindings '{}' and '{}' have the same name hash!",
+                       bindings[handle->second.index]->name,
+                       binding.name)
+                // Same name in another set, the last one wins as it always did
+                handle->second.index = static_cast<uint32_t>(bindings.size());
+            }
+            bindings.push_back(&binding);
 	    }
     }
 }
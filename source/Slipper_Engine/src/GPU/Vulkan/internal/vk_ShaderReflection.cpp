@@ -68,6 +68,50 @@ std::vector<DescriptorSetLayoutData> ShaderReflection::GetMergedDescriptorSetsLa
 
     return dslds;
 }
+
+std::vector<PushConstantRange> ShaderReflection::GetMergedPushConstantRanges(
+    const std::vector<std::vector<char>> &SpirvCodes)
+{
+    std::vector<PushConstantRange> ranges;
+    for (const auto &spirv_code : SpirvCodes) {
+        SpvReflectShaderModule module;
+        SpvReflectResult result = spvReflectCreateShaderModule(
+            spirv_code.size(), spirv_code.data(), &module);
+        assert(result == SPV_REFLECT_RESULT_SUCCESS);
+
+        uint32_t count = 0;
+        result = spvReflectEnumeratePushConstantBlocks(&module, &count, nullptr);
+        assert(result == SPV_REFLECT_RESULT_SUCCESS);
+
+        std::vector<SpvReflectBlockVariable *> blocks(count);
+        result = spvReflectEnumeratePushConstantBlocks(&module, &count, blocks.data());
+        assert(result == SPV_REFLECT_RESULT_SUCCESS);
+
+        const auto stage = static_cast<vk::ShaderStageFlagBits>(module.shader_stage);
+        for (const SpvReflectBlockVariable *block : blocks) {
+            // Blocks without a name still need to be distinguishable per stage
+            const std::string name = block->name ? block->name : "";
+
+            const auto existing = std::ranges::find_if(
+                ranges, [&name](const PushConstantRange &Range) { return Range.name == name; });
+            if (existing != ranges.end()) {
+                ASSERT(existing->offset == block->offset && existing->size == block->size,
+                       "Push constant block '{}' is defined with different layouts in the shader "
+                       "stages. This is not allowed.",
+                       name)
+                existing->stageFlags |= stage;
+                continue;
+            }
+
+            ranges.push_back({name, block->offset, block->size, stage});
+        }
+
+        spvReflectDestroyShaderModule(&module);
+    }
+
+    return ranges;
+}
+
 std::vector<IntermediateDSLD> ShaderReflection::GetDescriptorSetsLayoutData(
     const std::vector<char> &SpirvCode)
 {
@@ -7,6 +7,7 @@ namespace Slipper
 {
 	struct IntermediateDSLD;
 	struct DescriptorSetLayoutData;
+	struct PushConstantRange;
 
 class ShaderReflection
 {
@@ -14,6 +15,10 @@ class ShaderReflection
     static std::vector<DescriptorSetLayoutData> GetMergedDescriptorSetsLayoutData(
         std::vector<std::vector<char>> SpirvCodes);
 
+    // Push constant blocks with the same name in multiple stages get merged into a single range
+    static std::vector<PushConstantRange> GetMergedPushConstantRanges(
+        const std::vector<std::vector<char>> &SpirvCodes);
+
  private:
     static std::vector<IntermediateDSLD> GetDescriptorSetsLayoutData(
         const std::vector<char> &SpirvCode);
@@ -0,0 +1,561 @@
+#include "../vk_ShadowAtlas.h"
+
+#include "GraphicsEngine.h"
+#include "Model/Model.h"
+#include "ShaderManager.h"
+#include "Vulkan/vk_BindlessHeap.h"
+#include "Vulkan/vk_Buffer.h"
+#include "Vulkan/vk_CommandPool.h"
+#include "Vulkan/vk_Framebuffer.h"
+#include "Vulkan/vk_GpuProfiler.h"
+#include "Vulkan/vk_GraphicsPipeline.h"
+#include "Vulkan/vk_GraphicsShader.h"
+#include "Vulkan/vk_Texture.h"
+
+namespace Slipper::GPU::Vulkan
+{
+    // Must match the push constant block of Shaders/ShadowDepth.vert
+    struct ShadowPushConstants
+    {
+        glm::mat4 model;
+        glm::mat4 lightViewProjection;
+    };
+    static_assert(sizeof(ShadowPushConstants) <= 128, "Vulkan only guarantees 128 bytes of push constants");
+
+    // Same order as the major axis face selection in Shaders/Include/Shadows.glsl
+    constexpr std::array<std::pair<glm::vec3, glm::vec3>, SHADOW_FACES> CUBE_FACES = {{
+        {{1.0f, 0.0f, 0.0f}, {0.0f, -1.0f, 0.0f}},
+        {{-1.0f, 0.0f, 0.0f}, {0.0f, -1.0f, 0.0f}},
+        {{0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}},
+        {{0.0f, -1.0f, 0.0f}, {0.0f, 0.0f, -1.0f}},
+        {{0.0f, 0.0f, 1.0f}, {0.0f, -1.0f, 0.0f}},
+        {{0.0f, 0.0f, -1.0f}, {0.0f, -1.0f, 0.0f}},
+    }};
+
+    constexpr vk::Format SHADOW_ATLAS_FORMAT = vk::Format::eD16Unorm;
+
+    namespace
+    {
+        bool SpheresIntersect(const glm::vec4 A, const glm::vec4 B)
+        {
+            const float radius = A.w + B.w;
+            const glm::vec3 offset = glm::vec3(A) - glm::vec3(B);
+            return glm::dot(offset, offset) <= radius * radius;
+        }
+    }  // namespace
+
+    ShadowAtlasAllocator::ShadowAtlasAllocator(const uint32_t AtlasSize, const uint32_t MinTileSize)
+        : m_atlasSize(AtlasSize)
+    {
+        ASSERT(std::has_single_bit(AtlasSize) && std::has_single_bit(MinTileSize) && MinTileSize <= AtlasSize,
+               "Shadow atlas and tile sizes have to be powers of two!")
+
+        m_freeTiles.resize(std::countr_zero(AtlasSize / MinTileSize) + 1);
+        m_freeTiles.front().push_back({0, 0, AtlasSize});
+    }
+
+    std::optional<ShadowTile> ShadowAtlasAllocator::Allocate(const uint32_t Size)
+    {
+        const uint32_t min_size = m_atlasSize >> (m_freeTiles.size() - 1);
+        const uint32_t size = std::clamp(std::bit_ceil(Size), min_size, m_atlasSize);
+        const uint32_t level = GetLevel(size);
+
+        // Splitting the smallest tile that fits keeps the larger ones available as long as possible
+        int32_t source_level = static_cast<int32_t>(level);
+        while (source_level >= 0 && m_freeTiles[source_level].empty())
+        {
+            --source_level;
+        }
+        if (source_level < 0)
+            return std::nullopt;
+
+        ShadowTile tile = m_freeTiles[source_level].back();
+        m_freeTiles[source_level].pop_back();
+        for (uint32_t split_level = source_level; split_level < level; ++split_level)
+        {
+            const uint32_t half = tile.size / 2;
+            auto &free_tiles = m_freeTiles[split_level + 1];
+            free_tiles.push_back({tile.x + half, tile.y, half});
+            free_tiles.push_back({tile.x, tile.y + half, half});
+            free_tiles.push_back({tile.x + half, tile.y + half, half});
+            tile.size = half;
+        }
+
+        m_usedTexels += static_cast<uint64_t>(size) * size;
+        return tile;
+    }
+
+    void ShadowAtlasAllocator::Free(ShadowTile Tile)
+    {
+        m_usedTexels -= static_cast<uint64_t>(Tile.size) * Tile.size;
+
+        uint32_t level = GetLevel(Tile.size);
+        while (level > 0)
+        {
+            const uint32_t parent_size = Tile.size * 2;
+            const ShadowTile parent = {Tile.x - Tile.x % parent_size, Tile.y - Tile.y % parent_size, parent_size};
+            const auto is_buddy = [&](const ShadowTile &Other) {
+                return Other.x >= parent.x && Other.x < parent.x + parent_size && Other.y >= parent.y &&
+                    Other.y < parent.y + parent_size;
+            };
+
+            // Free tiles never overlap, so three free tiles of the same size inside the parent are the buddies
+            auto &free_tiles = m_freeTiles[level];
+            if (std::ranges::count_if(free_tiles, is_buddy) != 3)
+                break;
+
+            std::erase_if(free_tiles, is_buddy);
+            Tile = parent;
+            --level;
+        }
+        m_freeTiles[level].push_back(Tile);
+    }
+
+    uint32_t ShadowAtlasAllocator::GetLevel(const uint32_t Size) const
+    {
+        return std::countr_zero(m_atlasSize / Size);
+    }
+
+    ShadowAtlas::ShadowAtlas(AssetHandle<GraphicsShader> DepthShader)
+        : m_depthShader(std::move(DepthShader)), m_allocator(SHADOW_ATLAS_SIZE, MIN_SHADOW_TILE_SIZE)
+    {
+        m_renderPass = new RenderPass("Shadow Atlas", vk::Format::eUndefined, SHADOW_ATLAS_FORMAT, false);
+        m_depthShader->RegisterRenderPass(m_renderPass);
+
+        constexpr vk::Extent3D atlas_extent = {SHADOW_ATLAS_SIZE, SHADOW_ATLAS_SIZE, 1};
+        const auto create_atlas = [&](const vk::ImageUsageFlags Usage) {
+            return new Texture(vk::ImageType::e2D,
+                               atlas_extent,
+                               SHADOW_ATLAS_FORMAT,
+                               {},
+                               false,
+                               vk::SampleCountFlagBits::e1,
+                               vk::ImageTiling::eOptimal,
+                               vk::ImageUsageFlagBits::eDepthStencilAttachment | Usage,
+                               vk::ImageAspectFlagBits::eDepth);
+        };
+
+        // The descriptors are written with the current layout, so the atlases start out in the one they are read in
+        SingleUseCommandBuffer command_buffer(*GraphicsEngine::Get().memoryCommandPool);
+        m_cacheAtlas = create_atlas(vk::ImageUsageFlagBits::eTransferSrc);
+        Texture::EnqueueTransitionImageLayout(
+            m_cacheAtlas->vkImage, m_cacheAtlas->imageInfo, command_buffer.Get(), vk::ImageLayout::eTransferSrcOptimal);
+        VkImageView cache_view = m_cacheAtlas->GetViews().front();
+        m_cacheFramebuffer = new Framebuffer(m_renderPass.get(), &cache_view, 1, {SHADOW_ATLAS_SIZE, SHADOW_ATLAS_SIZE});
+
+        for (uint32_t frame = 0; frame < MAX_FRAMES_IN_FLIGHT; ++frame)
+        {
+            auto &atlas = m_liveAtlases[frame];
+            atlas = create_atlas(vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled);
+            Texture::EnqueueTransitionImageLayout(
+                atlas->vkImage, atlas->imageInfo, command_buffer.Get(), vk::ImageLayout::eShaderReadOnlyOptimal);
+            VkImageView live_view = atlas->GetViews().front();
+            m_liveFramebuffers[frame] = new Framebuffer(
+                m_renderPass.get(), &live_view, 1, {SHADOW_ATLAS_SIZE, SHADOW_ATLAS_SIZE});
+
+            constexpr VkDeviceSize shadow_buffer_size = sizeof(ShadowBufferHeader) +
+                sizeof(GpuShadow) * MAX_SHADOWED_LIGHTS;
+            m_shadowBuffers[frame] = new Buffer(shadow_buffer_size,
+                                                VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                                                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                                                    VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+            VK_ASSERT(vkMapMemory(device,
+                                  static_cast<VkDeviceMemory>(*m_shadowBuffers[frame]),
+                                  0,
+                                  shadow_buffer_size,
+                                  0,
+                                  &m_mappedShadowBuffers[frame]),
+                      "Failed to map shadow buffer!")
+        }
+        command_buffer.Submit();
+
+        for (uint32_t frame = 0; frame < MAX_FRAMES_IN_FLIGHT; ++frame)
+        {
+            m_liveAtlasIndices[frame] = m_liveAtlases[frame]->RegisterBindless();
+            m_shadowBufferIndices[frame] = BindlessHeap::Get().RegisterBuffer(*m_shadowBuffers[frame]);
+        }
+        m_recordedFrames.fill(std::numeric_limits<uint64_t>::max());
+    }
+
+    ShadowAtlas::~ShadowAtlas()
+    {
+        for (uint32_t frame = 0; frame < MAX_FRAMES_IN_FLIGHT; ++frame)
+        {
+            BindlessHeap::Get().ReleaseBuffer(m_shadowBufferIndices[frame]);
+            vkUnmapMemory(device, static_cast<VkDeviceMemory>(*m_shadowBuffers[frame]));
+        }
+    }
+
+    void ShadowAtlas::Init()
+    {
+        ASSERT(!m_instance, "Shadow atlas already created!")
+
+        // Shaders can only find the atlas and the shadow buffer through the heap
+        if (!BindlessHeap::IsAvailable())
+        {
+            LOG("The shadow atlas needs the bindless heap, lit shaders will render without shadows.")
+            return;
+        }
+
+        m_instance = new ShadowAtlas(
+            ShaderManager::LoadGraphicsShader({{"./EngineContent/Shaders/Spir-V/ShadowDepth.vert.spv"}}));
+    }
+
+    void ShadowAtlas::Shutdown()
+    {
+        delete m_instance;
+        m_instance = nullptr;
+    }
+
+    void ShadowAtlas::BeginFrame()
+    {
+        m_stats.shadowedLights = static_cast<uint32_t>(m_lightSlots.size());
+        m_stats.droppedLights = m_droppedLights;
+        m_stats.staticCasters = static_cast<uint32_t>(m_staticCasters.size());
+        m_stats.dynamicCasters = static_cast<uint32_t>(m_dynamicCasters.size());
+        m_droppedLights = 0;
+
+        // Lights that were not submitted last frame were removed or stopped casting shadows
+        for (auto slot = m_lightSlots.begin(); slot != m_lightSlots.end();)
+        {
+            auto &light = m_lights[slot->second];
+            if (light.submitted)
+            {
+                light.submitted = false;
+                ++slot;
+                continue;
+            }
+
+            FreeTiles(light);
+            light = {};
+            slot = m_lightSlots.erase(slot);
+        }
+
+        m_staticCasters.clear();
+        m_dynamicCasters.clear();
+    }
+
+    uint32_t ShadowAtlas::SubmitLight(const entt::entity Entity,
+                                      const glm::vec3 Location,
+                                      const float Range,
+                                      const uint64_t TransformVersion,
+                                      const ShadowViewer &Viewer)
+    {
+        uint32_t slot;
+        if (const auto existing = m_lightSlots.find(Entity); existing != m_lightSlots.end())
+        {
+            slot = existing->second;
+        }
+        else
+        {
+            const auto free_light = std::ranges::find(m_lights, entt::entity(entt::null), &ShadowedLight::entity);
+            if (free_light == m_lights.end())
+            {
+                ++m_droppedLights;
+                return INVALID_SHADOW;
+            }
+
+            slot = static_cast<uint32_t>(std::distance(m_lights.begin(), free_light));
+            free_light->entity = Entity;
+            free_light->transformVersion = TransformVersion;
+            free_light->liveVersions.fill(std::numeric_limits<uint64_t>::max());
+            m_lightSlots[Entity] = slot;
+        }
+
+        auto &light = m_lights[slot];
+        light.submitted = true;
+
+        if (light.transformVersion != TransformVersion || light.range != Range || !light.tileSize)
+        {
+            light.location = Location;
+            light.range = Range;
+            light.transformVersion = TransformVersion;
+            light.staticDirty = true;
+            UpdateViewProjections(light);
+        }
+
+        // Grows right away but only shrinks once the light covers a quarter of its tile, so lights at the edge of a
+        // size do not get new tiles and re-render their cache every other frame
+        const uint32_t tile_size = GetDesiredTileSize(Location, Range, Viewer);
+        if (tile_size > light.tileSize || tile_size * 4 <= light.tileSize)
+        {
+            if (!AllocateTiles(light, tile_size))
+            {
+                ++m_droppedLights;
+                return INVALID_SHADOW;
+            }
+        }
+        return slot;
+    }
+
+    void ShadowAtlas::SubmitCaster(const NonOwningPtr<const Model> Model,
+                                   const glm::mat4 &Transform,
+                                   const glm::vec4 Bounds,
+                                   const bool Static)
+    {
+        (Static ? m_staticCasters : m_dynamicCasters).push_back({Model, Transform, Bounds});
+    }
+
+    void ShadowAtlas::InvalidateStatic(const glm::vec4 Bounds)
+    {
+        m_staticInvalidations.push_back(Bounds);
+    }
+
+    void ShadowAtlas::Record(const vk::CommandBuffer CommandBuffer, const uint32_t Frame)
+    {
+        if (m_recordedFrames[Frame] == FRAME_COUNT)
+            return;
+        m_recordedFrames[Frame] = FRAME_COUNT;
+
+        PROFILE_ZONE("ShadowAtlas::Record");
+
+        const bool static_casters_changed = m_staticCasters.size() != m_lastStaticCasterCount;
+        m_lastStaticCasterCount = m_staticCasters.size();
+
+        std::vector<uint32_t> static_lights;
+        std::vector<uint32_t> copied_lights;
+        std::vector<uint32_t> dynamic_lights;
+        for (const uint32_t slot : m_lightSlots | std::views::values)
+        {
+            auto &light = m_lights[slot];
+            if (!light.tileSize)
+                continue;
+
+            const glm::vec4 light_bounds = glm::vec4(light.location, light.range);
+            light.staticDirty |= static_casters_changed ||
+                std::ranges::any_of(m_staticInvalidations,
+                                    [&](const glm::vec4 &Bounds) { return SpheresIntersect(light_bounds, Bounds); });
+            light.hasDynamic = std::ranges::any_of(
+                m_dynamicCasters, [&](const Caster &Caster) { return SpheresIntersect(light_bounds, Caster.bounds); });
+
+            if (light.staticDirty)
+            {
+                static_lights.push_back(slot);
+                light.staticDirty = false;
+                light.cacheVersion = ++m_cacheVersion;
+            }
+            // Dynamic casters of an earlier frame have to be covered by the cached tiles again
+            if (light.liveVersions[Frame] != light.cacheVersion || light.liveHasDynamic[Frame] || light.hasDynamic)
+            {
+                copied_lights.push_back(slot);
+                light.liveVersions[Frame] = light.cacheVersion;
+            }
+            if (light.hasDynamic)
+            {
+                dynamic_lights.push_back(slot);
+            }
+            light.liveHasDynamic[Frame] = light.hasDynamic;
+        }
+        m_staticInvalidations.clear();
+
+        m_stats.staticFaces = static_cast<uint32_t>(static_lights.size()) * SHADOW_FACES;
+        m_stats.copiedFaces = static_cast<uint32_t>(copied_lights.size()) * SHADOW_FACES;
+        m_stats.dynamicFaces = static_cast<uint32_t>(dynamic_lights.size()) * SHADOW_FACES;
+        m_stats.usedTexels = m_allocator.GetUsedTexels();
+
+        WriteShadowBuffer(Frame);
+        if (copied_lights.empty())
+            return;
+
+        GPU_PROFILE_SCOPE(CommandBuffer, "Shadow Atlas");
+        auto &live_atlas = *m_liveAtlases[Frame];
+
+        if (!static_lights.empty())
+        {
+            Texture::EnqueueTransitionImageLayout(
+                m_cacheAtlas->vkImage, m_cacheAtlas->imageInfo, CommandBuffer, vk::ImageLayout::eDepthAttachmentOptimal);
+            RenderFaces(CommandBuffer, *m_cacheFramebuffer, static_lights, m_staticCasters, true);
+            Texture::EnqueueTransitionImageLayout(
+                m_cacheAtlas->vkImage, m_cacheAtlas->imageInfo, CommandBuffer, vk::ImageLayout::eTransferSrcOptimal);
+        }
+
+        std::vector<vk::ImageCopy> regions;
+        regions.reserve(copied_lights.size() * SHADOW_FACES);
+        for (const uint32_t slot : copied_lights)
+        {
+            for (const auto &tile : m_lights[slot].tiles)
+            {
+                const vk::Offset3D offset(static_cast<int32_t>(tile.x), static_cast<int32_t>(tile.y), 0);
+                regions.emplace_back(vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eDepth, 0, 0, 1),
+                                     offset,
+                                     vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eDepth, 0, 0, 1),
+                                     offset,
+                                     vk::Extent3D(tile.size, tile.size, 1));
+            }
+        }
+        Texture::EnqueueTransitionImageLayout(
+            live_atlas.vkImage, live_atlas.imageInfo, CommandBuffer, vk::ImageLayout::eTransferDstOptimal);
+        CommandBuffer.copyImage(m_cacheAtlas->vkImage,
+                                vk::ImageLayout::eTransferSrcOptimal,
+                                live_atlas.vkImage,
+                                vk::ImageLayout::eTransferDstOptimal,
+                                regions);
+
+        if (!dynamic_lights.empty())
+        {
+            Texture::EnqueueTransitionImageLayout(
+                live_atlas.vkImage, live_atlas.imageInfo, CommandBuffer, vk::ImageLayout::eDepthAttachmentOptimal);
+            RenderFaces(CommandBuffer, *m_liveFramebuffers[Frame], dynamic_lights, m_dynamicCasters, false);
+        }
+        Texture::EnqueueTransitionImageLayout(
+            live_atlas.vkImage, live_atlas.imageInfo, CommandBuffer, vk::ImageLayout::eShaderReadOnlyOptimal);
+    }
+
+    uint32_t ShadowAtlas::GetShadowBuffer(const uint32_t Frame) const
+    {
+        return m_recordedFrames[Frame] == FRAME_COUNT ? m_shadowBufferIndices[Frame] : INVALID_BINDLESS_INDEX;
+    }
+
+    uint32_t ShadowAtlas::GetDesiredTileSize(const glm::vec3 Location, const float Range, const ShadowViewer &Viewer)
+    {
+        const float distance = glm::distance(Location, Viewer.location);
+        const float tan_half_fov = std::tan(glm::radians(Viewer.fov) * 0.5f);
+
+        // Fraction of the screen height the sphere of the light covers, the camera might as well be inside of it
+        const float coverage = distance > Range ? std::min(Range / (distance * tan_half_fov), 1.0f) : 1.0f;
+        const auto size = static_cast<uint32_t>(coverage * static_cast<float>(MAX_SHADOW_TILE_SIZE));
+        return std::clamp(std::bit_ceil(size), MIN_SHADOW_TILE_SIZE, MAX_SHADOW_TILE_SIZE);
+    }
+
+    bool ShadowAtlas::AllocateTiles(ShadowedLight &Light, const uint32_t TileSize)
+    {
+        FreeTiles(Light);
+
+        // Falls back to smaller tiles while the atlas is crowded
+        for (uint32_t size = TileSize; size >= MIN_SHADOW_TILE_SIZE; size /= 2)
+        {
+            uint32_t allocated = 0;
+            for (; allocated < SHADOW_FACES; ++allocated)
+            {
+                const auto tile = m_allocator.Allocate(size);
+                if (!tile)
+                    break;
+                Light.tiles[allocated] = tile.value();
+            }
+
+            if (allocated == SHADOW_FACES)
+            {
+                Light.tileSize = size;
+                Light.staticDirty = true;
+                return true;
+            }
+            for (uint32_t face = 0; face < allocated; ++face)
+            {
+                m_allocator.Free(Light.tiles[face]);
+            }
+        }
+        return false;
+    }
+
+    void ShadowAtlas::FreeTiles(ShadowedLight &Light)
+    {
+        if (!Light.tileSize)
+            return;
+
+        for (const auto &tile : Light.tiles)
+        {
+            m_allocator.Free(tile);
+        }
+        Light.tileSize = 0;
+    }
+
+    void ShadowAtlas::UpdateViewProjections(ShadowedLight &Light)
+    {
+        // A short near plane keeps close casters, a relative one keeps the precision of the 16 bit depth
+        const float near_plane = std::max(0.05f, Light.range * 0.005f);
+        glm::mat4 projection = glm::perspective(glm::radians(90.0f), 1.0f, near_plane, Light.range);
+        projection[1][1] *= -1;
+
+        for (uint32_t face = 0; face < SHADOW_FACES; ++face)
+        {
+            const auto &[direction, up] = CUBE_FACES[face];
+            Light.viewProjections[face] = projection * glm::lookAt(Light.location, Light.location + direction, up);
+        }
+    }
+
+    void ShadowAtlas::RenderFaces(const vk::CommandBuffer CommandBuffer,
+                                  const Framebuffer &Target,
+                                  const std::vector<uint32_t> &Lights,
+                                  const std::vector<Caster> &Casters,
+                                  const bool Clear)
+    {
+        m_renderPass->BeginRenderPass(static_cast<VkFramebuffer>(Target), {SHADOW_ATLAS_SIZE, SHADOW_ATLAS_SIZE}, CommandBuffer);
+        CommandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics,
+                                   m_depthShader->GetPipeline(m_renderPass).GetVkPipeline(PipelineVariant::Default));
+
+        std::vector<const Caster *> light_casters;
+        for (const uint32_t slot : Lights)
+        {
+            const auto &light = m_lights[slot];
+            const glm::vec4 light_bounds = glm::vec4(light.location, light.range);
+
+            light_casters.clear();
+            for (const auto &caster : Casters)
+            {
+                if (SpheresIntersect(light_bounds, caster.bounds))
+                    light_casters.push_back(&caster);
+            }
+
+            for (uint32_t face = 0; face < SHADOW_FACES; ++face)
+            {
+                const auto &tile = light.tiles[face];
+                const vk::Rect2D rect({static_cast<int32_t>(tile.x), static_cast<int32_t>(tile.y)},
+                                      {tile.size, tile.size});
+                CommandBuffer.setViewport(0,
+                                          vk::Viewport(static_cast<float>(tile.x),
+                                                       static_cast<float>(tile.y),
+                                                       static_cast<float>(tile.size),
+                                                       static_cast<float>(tile.size),
+                                                       0.0f,
+                                                       1.0f));
+                CommandBuffer.setScissor(0, rect);
+
+                // Only the tile is cleared, the render pass loads the rest of the atlas
+                if (Clear)
+                {
+                    const vk::ClearAttachment clear_attachment(
+                        vk::ImageAspectFlagBits::eDepth, 0, vk::ClearDepthStencilValue(1.0f, 0));
+                    CommandBuffer.clearAttachments(clear_attachment, vk::ClearRect(rect, 0, 1));
+                }
+
+                for (const auto caster : light_casters)
+                {
+                    m_depthShader->Push(CommandBuffer,
+                                        m_renderPass,
+                                        ShadowPushConstants{caster->transform, light.viewProjections[face]});
+                    caster->model->Draw(CommandBuffer);
+                }
+            }
+        }
+
+        m_renderPass->EndRenderPass(CommandBuffer);
+    }
+
+    void ShadowAtlas::WriteShadowBuffer(const uint32_t Frame)
+    {
+        auto *header = static_cast<ShadowBufferHeader *>(m_mappedShadowBuffers[Frame]);
+        auto *shadows = reinterpret_cast<GpuShadow *>(header + 1);
+
+        *header = {.atlas = m_liveAtlasIndices[Frame], .texelSize = 1.0f / SHADOW_ATLAS_SIZE, .reserved = {}};
+
+        for (uint32_t slot = 0; slot < MAX_SHADOWED_LIGHTS; ++slot)
+        {
+            const auto &light = m_lights[slot];
+            auto &shadow = shadows[slot];
+            if (light.entity == entt::null || !light.tileSize)
+            {
+                shadow.positionRange = glm::vec4(0.0f);
+                continue;
+            }
+
+            shadow.positionRange = glm::vec4(light.location, light.range);
+            for (uint32_t face = 0; face < SHADOW_FACES; ++face)
+            {
+                const auto &tile = light.tiles[face];
+                shadow.faces[face].viewProjection = light.viewProjections[face];
+                shadow.faces[face].uvRect = glm::vec4(glm::vec2(tile.x, tile.y), glm::vec2(tile.size)) /
+                    static_cast<float>(SHADOW_ATLAS_SIZE);
+            }
+        }
+    }
+}  // namespace Slipper::GPU::Vulkan
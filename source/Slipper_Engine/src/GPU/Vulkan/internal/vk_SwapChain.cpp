@@ -12,7 +12,9 @@ SwapChain::SwapChain(vk::Extent2D Extent, vk::Format RenderingFormat)
     : imageRenderingFormat(RenderingFormat),
       imageColorSpace(vk::ColorSpaceKHR::eSrgbNonlinear),
       depthFormat(Texture2D::FindDepthFormat()),
-      resolution(Extent)
+      resolution(Extent),
+      renderResolution(Extent),
+      sampleCount(static_cast<vk::SampleCountFlagBits>(GraphicsSettings::MSAA_SAMPLES))
 {
 }
 
@@ -46,11 +48,41 @@ void SwapChain::Recreate(uint32_t Width, uint32_t Height)
     device.logicalDevice.waitIdle();
     resolution.width = Width;
     resolution.height = Height;
+    SetRenderScale(m_renderScale);
 
     Cleanup(true);
     Create();
 }
 
+void SwapChain::SetRenderScale(const float Scale)
+{
+    m_renderScale = std::clamp(Scale, 0.0f, 1.0f);
+    renderResolution.width = std::clamp(
+        static_cast<uint32_t>(std::lround(static_cast<float>(resolution.width) * m_renderScale)),
+        1u,
+        resolution.width);
+    renderResolution.height = std::clamp(
+        static_cast<uint32_t>(std::lround(static_cast<float>(resolution.height) * m_renderScale)),
+        1u,
+        resolution.height);
+}
+
+void SwapChain::SetSampleCount(const vk::SampleCountFlagBits SampleCount)
+{
+    if (SampleCount == sampleCount)
+        return;
+
+    device.logicalDevice.waitIdle();
+    sampleCount = SampleCount;
+
+    // The images are left alone so their views, e.g. the presentation textures used by the editor, stay valid
+    renderTarget = std::make_unique<RenderTarget>(resolution, imageRenderingFormat, sampleCount);
+    depthBuffer = std::make_unique<DepthBuffer>(resolution, depthFormat, sampleCount);
+    for (const auto render_pass : m_vkFramebuffers | std::views::keys) {
+        CreateFramebuffers(render_pass);
+    }
+}
+
 vk::Image SwapChain::GetCurrentSwapChainImage() const
 {
     return m_vkImages[GetCurrentSwapChainImageIndex()];
@@ -62,14 +94,14 @@ void SwapChain::Create()
 
     CreateImageViews();
     if (!renderTarget) {
-        renderTarget = std::make_unique<RenderTarget>(resolution, imageRenderingFormat);
+        renderTarget = std::make_unique<RenderTarget>(resolution, imageRenderingFormat, sampleCount);
     }
     else {
         renderTarget->Resize(VkExtent3D(resolution.width, resolution.height, 1));
     }
 
     if (!depthBuffer) {
-        depthBuffer = std::make_unique<DepthBuffer>(resolution, depthFormat);
+        depthBuffer = std::make_unique<DepthBuffer>(resolution, depthFormat, sampleCount);
     }
     else {
         depthBuffer->Resize(VkExtent3D(resolution.width, resolution.height, 1));
@@ -101,7 +133,7 @@ void SwapChain::CreateFramebuffers(NonOwningPtr<RenderPass> RenderPass)
     vk_framebuffers.resize(m_vkImageViews.size());
     for (size_t i = 0; i < m_vkImageViews.size(); i++) {
         std::vector<vk::ImageView> attachments;
-        if (GraphicsSettings::MSAA_SAMPLES != SampleCount::e1) {
+        if (sampleCount != vk::SampleCountFlagBits::e1) {
             attachments.push_back(renderTarget->imageInfo.views[0]);
             attachments.push_back(depthBuffer->imageInfo.views[0]);
             attachments.push_back(m_vkImageViews[i]);
@@ -1,6 +1,8 @@
 #include "../vk_Texture.h"
 
+#include "Vulkan/vk_Buffer.h"
 #include "Vulkan/vk_Device.h"
+#include "Vulkan/vk_TextureStreamer.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
@@ -16,7 +18,8 @@ Texture::Texture(const vk::ImageType Type,
                  const vk::ImageTiling Tiling,
                  const vk::ImageUsageFlags Usage,
                  const vk::ImageAspectFlags ImageAspect,
-                 const uint32_t ArrayLayers)
+                 const uint32_t ArrayLayers,
+                 const std::optional<uint32_t> MipLevels)
     : imageInfo{VK_NULL_HANDLE,
                 {},
                 vk::ImageLayout::eUndefined,
@@ -32,7 +35,13 @@ Texture::Texture(const vk::ImageType Type,
                 GenerateMipMaps,
                 0}
 {
-    if (imageInfo.generateMipMaps) {
+    // Block compressed formats can not be blitted, so their mips are never generated on the gpu
+    if (MipLevels.has_value()) {
+        imageInfo.generateMipMaps = false;
+        imageInfo.usage |= vk::ImageUsageFlagBits::eTransferDst;
+        imageInfo.mipLevels = MipLevels.value();
+    }
+    else if (imageInfo.generateMipMaps) {
         imageInfo.usage |= vk::ImageUsageFlagBits::eTransferSrc |
                            vk::ImageUsageFlagBits::eTransferDst;
         imageInfo.mipLevels = static_cast<uint32_t>(std::floor(std::log2(std::max(
@@ -190,6 +199,14 @@ void Texture::EnqueueGenerateMipMaps(vk::CommandBuffer CommandBuffer)
 
 Texture::~Texture()
 {
+    if (TextureStreamer::IsAvailable()) {
+        TextureStreamer::Get().Unregister(*this);
+    }
+
+    if (bindlessIndex != INVALID_BINDLESS_INDEX && BindlessHeap::IsAvailable()) {
+        BindlessHeap::Get().ReleaseTexture(bindlessIndex);
+    }
+
     for (const auto vk_image_view : imageInfo.views) {
         device.logicalDevice.destroyImageView(vk_image_view, nullptr);
     }
@@ -210,6 +227,37 @@ void Texture::Resize(const vk::Extent3D Extent)
     device.logicalDevice.freeMemory(vkImageMemory, nullptr);
 
     Create();
+
+    // Keep the bindless slot pointing at the recreated view instead of the destroyed one
+    if (bindlessIndex != INVALID_BINDLESS_INDEX && BindlessHeap::IsAvailable()) {
+        BindlessHeap::Get().UpdateTexture(bindlessIndex, *this);
+    }
+}
+
+uint32_t Texture::RegisterBindless()
+{
+    if (bindlessIndex == INVALID_BINDLESS_INDEX && BindlessHeap::IsAvailable()) {
+        bindlessIndex = BindlessHeap::Get().RegisterTexture(*this);
+    }
+    return bindlessIndex;
+}
+
+void Texture::ReregisterBindless()
+{
+    if (bindlessIndex != INVALID_BINDLESS_INDEX) {
+        const uint32_t old_index = bindlessIndex;
+        bindlessIndex = INVALID_BINDLESS_INDEX;
+        RegisterBindless();
+        BindlessHeap::Get().ReleaseTexture(old_index);
+    }
+}
+
+void Texture::SwapImage(Texture &Other)
+{
+    std::swap(vkImage, Other.vkImage);
+    std::swap(vkImageMemory, Other.vkImageMemory);
+    std::swap(imageInfo, Other.imageInfo);
+    std::swap(sampler, Other.sampler);
 }
 
 void Texture::EnqueueTransitionImageLayout(vk::Image Image,
@@ -235,7 +283,8 @@ void Texture::EnqueueTransitionImageLayout(vk::Image Image,
         }
     }
     else {
-        barrier.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
+        // Depth textures that are sampled keep their depth aspect
+        barrier.subresourceRange.aspectMask = ImageInfo.imageAspect;
     }
 
     if (barrier.oldLayout == vk::ImageLayout::eUndefined) {
@@ -255,6 +304,10 @@ void Texture::EnqueueTransitionImageLayout(vk::Image Image,
         barrier.srcStageMask = vk::PipelineStageFlagBits2::eFragmentShader |
                                vk::PipelineStageFlagBits2::eVertexShader;
     }
+    else if (barrier.oldLayout == vk::ImageLayout::eDepthAttachmentOptimal) {
+        barrier.srcAccessMask = vk::AccessFlagBits2::eDepthStencilAttachmentWrite;
+        barrier.srcStageMask = vk::PipelineStageFlagBits2::eLateFragmentTests;
+    }
     else {
         throw std::invalid_argument("Unsupported layout transition!");
     }
@@ -346,11 +399,61 @@ void Texture::CopyBuffer(const Buffer &Buffer, const bool TransitionToShaderUse)
     command_buffer.Submit();
 }
 
+void Texture::CopyLevels(const std::vector<std::vector<uint8_t>> &Levels)
+{
+    ASSERT(Levels.size() == imageInfo.mipLevels,
+           "Texture has {} mip levels but {} were supplied!",
+           imageInfo.mipLevels,
+           Levels.size())
+
+    VkDeviceSize size = 0;
+    for (const auto &level : Levels) {
+        size += level.size();
+    }
+    const Buffer staging_buffer(size,
+                                VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                                    VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+    SingleUseCommandBuffer command_buffer = CreateTransitionImageLayout(
+        vkImage, imageInfo, vk::ImageLayout::eTransferDstOptimal);
+
+    // Every level gets its own region of the staging buffer, partial blocks at the edges are fine
+    void *data;
+    VK_ASSERT(vkMapMemory(device, static_cast<VkDeviceMemory>(staging_buffer), 0, size, 0, &data),
+              "Failed to map staging buffer!")
+    std::vector<vk::BufferImageCopy2> regions;
+    VkDeviceSize offset = 0;
+    for (uint32_t level = 0; level < Levels.size(); ++level) {
+        std::memcpy(static_cast<uint8_t *>(data) + offset, Levels[level].data(), Levels[level].size());
+        regions.emplace_back(
+            offset,
+            0,
+            0,
+            vk::ImageSubresourceLayers(imageInfo.imageAspect, level, 0, imageInfo.arrayLayerCount),
+            vk::Offset3D{0, 0, 0},
+            vk::Extent3D(std::max(imageInfo.extent.width >> level, 1u),
+                         std::max(imageInfo.extent.height >> level, 1u),
+                         std::max(imageInfo.extent.depth >> level, 1u)));
+        offset += Levels[level].size();
+    }
+    vkUnmapMemory(device, static_cast<VkDeviceMemory>(staging_buffer));
+
+    const vk::CopyBufferToImageInfo2 copy_buffer_to_image_info(
+        staging_buffer, vkImage, vk::ImageLayout::eTransferDstOptimal, regions);
+    command_buffer.Get().copyBufferToImage2(copy_buffer_to_image_info);
+
+    EnqueueTransitionImageLayout(
+        vkImage, imageInfo, command_buffer, vk::ImageLayout::eShaderReadOnlyOptimal);
+    command_buffer.Submit();
+}
+
 void Texture::EnqueueCopyImage(vk::CommandBuffer CommandBuffer,
                                vk::Image SrcImage,
                                vk::ImageLayout SrcLayout,
                                vk::Extent3D SrcExtent,
-                               vk::ImageLayout TargetLayout)
+                               vk::ImageLayout TargetLayout,
+                               vk::Filter Filter)
 {
     EnqueueTransitionImageLayout(
         vkImage, imageInfo, CommandBuffer, vk::ImageLayout::eTransferDstOptimal);
@@ -366,7 +469,7 @@ void Texture::EnqueueCopyImage(vk::CommandBuffer CommandBuffer,
                                       static_cast<int32_t>(imageInfo.extent.height),
                                       static_cast<int32_t>(imageInfo.extent.depth))});
     const vk::BlitImageInfo2 blit_info(
-        SrcImage, SrcLayout, vkImage, imageInfo.layout, blit, vk::Filter::eNearest);
+        SrcImage, SrcLayout, vkImage, imageInfo.layout, blit, Filter);
     CommandBuffer.blitImage2(blit_info);
 
     EnqueueTransitionImageLayout(vkImage, imageInfo, CommandBuffer, TargetLayout);
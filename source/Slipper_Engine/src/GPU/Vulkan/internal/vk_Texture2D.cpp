@@ -1,6 +1,7 @@
 #include "../vk_Texture2D.h"
 
 #include "Vulkan/vk_Buffer.h"
+#include "Vulkan/vk_Ktx.h"
 
 namespace Slipper::GPU::Vulkan
 {
@@ -12,6 +13,30 @@ Texture2D::Texture2D(const StbImage Image, const bool GenerateMipMaps)
     stbi_image_free(Image.pixels);
 }
 
+Texture2D::Texture2D(const KtxImage &Image)
+    : Texture2D(VkExtent2D{Image.extent.width, Image.extent.height},
+                Image.format,
+                static_cast<uint32_t>(Image.levels.size()))
+{
+    filepath = Image.filepath;
+    CopyLevels(Image.levels);
+}
+
+Texture2D::Texture2D(const VkExtent2D Extent, const vk::Format ImageFormat, const uint32_t MipLevels)
+    : Texture(vk::ImageType::e2D,
+              VkExtent3D(Extent.width, Extent.height, 1),
+              ImageFormat,
+              {},
+              false,
+              vk::SampleCountFlagBits::e1,
+              vk::ImageTiling::eOptimal,
+              vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled,
+              vk::ImageAspectFlagBits::eColor,
+              1,
+              MipLevels)
+{
+}
+
 Texture2D::Texture2D(const VkExtent2D Extent,
                      const vk::Format ImageFormat,
                      std::optional<vk::Format> ViewFormat,
@@ -0,0 +1,509 @@
+#include "../vk_TextureStreamer.h"
+
+#include "GraphicsEngine.h"
+#include "MaterialManager.h"
+#include "Mesh/Mesh.h"
+#include "Vulkan/vk_BindlessHeap.h"
+#include "Vulkan/vk_BlockCompression.h"
+#include "Vulkan/vk_Buffer.h"
+#include "Vulkan/vk_CommandPool.h"
+#include "Vulkan/vk_Ktx.h"
+#include "Vulkan/vk_Material.h"
+#include "Vulkan/vk_Texture2D.h"
+
+namespace Slipper::GPU::Vulkan
+{
+    namespace
+    {
+        // Closer bounds would ask for more than the full resolution anyways
+        constexpr float MIN_STREAMING_DEPTH = 0.1f;
+
+        /* Moves a single mip between the shader read and transfer dst layouts. Mips that are not being uploaded are
+         * always in shader read layout, the whole image transition of Recreate or the previous upload left them
+         * there, so the barrier waits on those instead of discarding the layout. */
+        void TransitionMip(const vk::CommandBuffer CommandBuffer,
+                           const vk::Image Image,
+                           const uint32_t Level,
+                           const vk::ImageLayout OldLayout,
+                           const vk::ImageLayout NewLayout)
+        {
+            vk::ImageMemoryBarrier2 barrier;
+            barrier.oldLayout = OldLayout;
+            barrier.newLayout = NewLayout;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.image = Image;
+            barrier.subresourceRange = vk::ImageSubresourceRange(vk::ImageAspectFlagBits::eColor, Level, 1, 0, 1);
+
+            if (NewLayout == vk::ImageLayout::eTransferDstOptimal)
+            {
+                barrier.srcAccessMask = vk::AccessFlagBits2::eShaderRead;
+                barrier.srcStageMask = vk::PipelineStageFlagBits2::eFragmentShader |
+                    vk::PipelineStageFlagBits2::eVertexShader;
+                barrier.dstAccessMask = vk::AccessFlagBits2::eTransferWrite;
+                barrier.dstStageMask = vk::PipelineStageFlagBits2::eTransfer;
+            }
+            else
+            {
+                barrier.srcAccessMask = vk::AccessFlagBits2::eTransferWrite;
+                barrier.srcStageMask = vk::PipelineStageFlagBits2::eTransfer;
+                barrier.dstAccessMask = vk::AccessFlagBits2::eShaderRead;
+                barrier.dstStageMask = vk::PipelineStageFlagBits2::eFragmentShader |
+                    vk::PipelineStageFlagBits2::eVertexShader;
+            }
+
+            const vk::DependencyInfo dependency_info({}, nullptr, nullptr, barrier);
+            CommandBuffer.pipelineBarrier2(dependency_info);
+        }
+    }  // namespace
+
+    TextureStreamer::TextureStreamer()
+    {
+        m_commandPool = new CommandPool(
+            device.graphicsQueue, device.queueFamilyIndices.graphicsFamily.value(), MAX_FRAMES_IN_FLIGHT);
+        m_recordedFrames.fill(std::numeric_limits<uint64_t>::max());
+    }
+
+    TextureStreamer::~TextureStreamer()
+    {
+        for (auto &retired : m_retiredImages)
+        {
+            for (const auto view : retired.views)
+            {
+                device.logicalDevice.destroyImageView(view);
+            }
+            device.logicalDevice.destroyImage(retired.image);
+            device.logicalDevice.freeMemory(retired.memory);
+        }
+        m_retiredImages.clear();
+    }
+
+    void TextureStreamer::Init()
+    {
+        ASSERT(!m_instance, "Texture streamer already created!")
+
+        m_instance = new TextureStreamer();
+    }
+
+    void TextureStreamer::Shutdown()
+    {
+        delete m_instance;
+        m_instance = nullptr;
+    }
+
+    Texture2D *TextureStreamer::CreateTexture2D(KtxImage &&Image)
+    {
+        PROFILE_ZONE("TextureStreamer::CreateTexture2D");
+
+        StreamedTexture streamed;
+        for (uint32_t level = 0; level < Image.levels.size(); ++level)
+        {
+            streamed.extents.push_back(Image.GetLevelExtent(level));
+        }
+        streamed.mips = std::move(Image.levels);
+
+        return Stream(std::move(streamed), Image.format, Image.filepath);
+    }
+
+    Texture2D *TextureStreamer::Stream(StreamedTexture &&Streamed, const vk::Format Format, const std::string &Filepath)
+    {
+        const auto mip_count = static_cast<uint32_t>(Streamed.mips.size());
+        while (Streamed.tailMip + 1 < mip_count &&
+               std::max(Streamed.extents[Streamed.tailMip].width, Streamed.extents[Streamed.tailMip].height) >
+                   settings.residentTailSize)
+        {
+            ++Streamed.tailMip;
+        }
+        Streamed.allocatedMip = Streamed.tailMip;
+        Streamed.residentMip = Streamed.tailMip;
+        Streamed.requestedMip = mip_count;
+        Streamed.lastNeeded.resize(mip_count, 0);
+
+        const vk::Extent3D tail_extent = Streamed.extents[Streamed.tailMip];
+        auto *texture = new Texture2D(
+            VkExtent2D{tail_extent.width, tail_extent.height}, Format, mip_count - Streamed.tailMip);
+        texture->filepath = Filepath;
+        Streamed.texture = texture;
+
+        CommandPool *command_pool = GraphicsEngine::Get().GetViewportCommandPool();
+        SingleUseCommandBuffer command_buffer(*command_pool);
+        Texture::EnqueueTransitionImageLayout(
+            texture->vkImage, texture->imageInfo, command_buffer, vk::ImageLayout::eTransferDstOptimal);
+        for (uint32_t mip = Streamed.tailMip; mip < mip_count; ++mip)
+        {
+            CopyMip(command_buffer, Streamed, mip);
+        }
+        Texture::EnqueueTransitionImageLayout(
+            texture->vkImage, texture->imageInfo, command_buffer, vk::ImageLayout::eShaderReadOnlyOptimal);
+        command_buffer.Submit();
+
+        m_textureSlots.emplace(texture, m_textures.size());
+        m_textures.push_back(std::move(Streamed));
+        return texture;
+    }
+
+    void TextureStreamer::Transfer(const Texture &From, Texture &To)
+    {
+        const auto slot = m_textureSlots.find(&From);
+        if (slot == m_textureSlots.end())
+            return;
+
+        const size_t index = slot->second;
+        m_textureSlots.erase(slot);
+        m_textureSlots.emplace(&To, index);
+        m_textures[index].texture = &To;
+    }
+
+    void TextureStreamer::Unregister(const Texture &Texture)
+    {
+        const auto slot = m_textureSlots.find(&Texture);
+        if (slot == m_textureSlots.end())
+            return;
+
+        // Order does not matter so swap and pop
+        const size_t index = slot->second;
+        m_textureSlots.erase(slot);
+        if (index != m_textures.size() - 1)
+        {
+            m_textures[index] = std::move(m_textures.back());
+            m_textureSlots[m_textures[index].texture.get()] = index;
+        }
+        m_textures.pop_back();
+    }
+
+    void TextureStreamer::RequestMaterial(const Material &Material, const float UvPixels)
+    {
+        for (const auto &texture : Material.GetTextures())
+        {
+            if (texture)
+            {
+                Request(*texture, UvPixels);
+            }
+        }
+
+        for (const auto &uniform : Material.uniforms | std::views::values)
+        {
+            if (uniform.shaderBinding.get().descriptorType != vk::DescriptorType::eCombinedImageSampler)
+                continue;
+
+            if (const auto *texture = dynamic_cast<const Texture *>(uniform.data.get()))
+            {
+                Request(*texture, UvPixels);
+            }
+        }
+    }
+
+    void TextureStreamer::Request(const Texture &Texture, const float UvPixels)
+    {
+        if (UvPixels <= 0.0f)
+            return;
+
+        const auto slot = m_textureSlots.find(&Texture);
+        if (slot == m_textureSlots.end())
+            return;
+
+        // Mip at which one texel covers about one pixel
+        auto &streamed = m_textures[slot->second];
+        const vk::Extent3D extent = streamed.extents.front();
+        const float mip = std::log2(static_cast<float>(std::max(extent.width, extent.height)) / UvPixels) +
+            settings.mipBias;
+        const uint32_t needed = mip <= 0.0f ?
+            0 :
+            std::min(static_cast<uint32_t>(mip), static_cast<uint32_t>(streamed.mips.size()) - 1);
+        streamed.requestedMip = std::min(streamed.requestedMip, needed);
+    }
+
+    void TextureStreamer::Update()
+    {
+        PROFILE_ZONE("TextureStreamer::Update");
+
+        // The frame slot is free again, so are its staging buffers and the images no frame in flight can sample
+        const uint32_t frame = GraphicsEngine::Get().GetCurrentFrame();
+        m_stagingBuffers[frame].clear();
+        while (!m_retiredImages.empty() && m_retiredImages.front().releaseFrame <= FRAME_COUNT)
+        {
+            const auto &retired = m_retiredImages.front();
+            for (const auto view : retired.views)
+            {
+                device.logicalDevice.destroyImageView(view);
+            }
+            device.logicalDevice.destroyImage(retired.image);
+            device.logicalDevice.freeMemory(retired.memory);
+            m_retiredImages.pop_front();
+        }
+
+        m_stats = {};
+        m_stats.streamedTextures = static_cast<uint32_t>(m_textures.size());
+
+        uint64_t used_bytes = 0;
+        std::vector<uint32_t> allocated_mips;
+        std::vector<uint32_t> wanted_mips;
+        allocated_mips.reserve(m_textures.size());
+        wanted_mips.reserve(m_textures.size());
+        for (auto &texture : m_textures)
+        {
+            const auto mip_count = static_cast<uint32_t>(texture.mips.size());
+            for (uint32_t mip = texture.requestedMip; mip < mip_count; ++mip)
+            {
+                texture.lastNeeded[mip] = FRAME_COUNT;
+            }
+            used_bytes += GetBytes(texture, texture.allocatedMip);
+            allocated_mips.push_back(texture.allocatedMip);
+            wanted_mips.push_back(std::min(texture.requestedMip, texture.tailMip));
+        }
+
+        // A lowered budget drops the coldest mips even if they were needed recently
+        while (used_bytes > settings.budgetBytes)
+        {
+            const auto candidate = FindEvictionCandidate(allocated_mips, std::numeric_limits<uint64_t>::max());
+            if (!candidate)
+                break;
+
+            used_bytes -= m_textures[*candidate].mips[allocated_mips[*candidate]].size();
+            ++allocated_mips[*candidate];
+            ++m_stats.evictedMips;
+        }
+
+        // Textures that miss the most mips go first
+        std::vector<size_t> growing;
+        for (size_t i = 0; i < m_textures.size(); ++i)
+        {
+            if (wanted_mips[i] < m_textures[i].residentMip)
+            {
+                growing.push_back(i);
+            }
+        }
+        std::ranges::sort(growing, std::greater(), [&](const size_t Index) {
+            return m_textures[Index].residentMip - wanted_mips[Index];
+        });
+
+        const uint64_t protected_frame = FRAME_COUNT > settings.evictionDelay ? FRAME_COUNT - settings.evictionDelay :
+                                                                                 0;
+        for (const size_t index : growing)
+        {
+            const auto &texture = m_textures[index];
+
+            // Makes room by dropping mips nobody needed for a while, takes fewer mips if that is not enough
+            for (uint32_t target = wanted_mips[index]; target < allocated_mips[index]; ++target)
+            {
+                const uint64_t extra_bytes = GetBytes(texture, target) - GetBytes(texture, allocated_mips[index]);
+                while (used_bytes + extra_bytes > settings.budgetBytes)
+                {
+                    const auto candidate = FindEvictionCandidate(allocated_mips, protected_frame);
+                    if (!candidate)
+                        break;
+
+                    used_bytes -= m_textures[*candidate].mips[allocated_mips[*candidate]].size();
+                    ++allocated_mips[*candidate];
+                    ++m_stats.evictedMips;
+                }
+
+                if (used_bytes + extra_bytes <= settings.budgetBytes)
+                {
+                    used_bytes += extra_bytes;
+                    allocated_mips[index] = target;
+                    break;
+                }
+            }
+            m_stats.deniedMips += allocated_mips[index] - std::min(wanted_mips[index], allocated_mips[index]);
+        }
+
+        vk::CommandBuffer command_buffer;
+        const auto begin_recording = [&] {
+            if (!command_buffer)
+            {
+                command_buffer = m_commandPool->BeginCurrentCommandBuffer();
+                m_recordedFrames[frame] = FRAME_COUNT;
+            }
+            return command_buffer;
+        };
+
+        uint64_t uploaded_bytes = 0;
+        std::vector<bool> changed(m_textures.size(), false);
+        for (size_t i = 0; i < m_textures.size(); ++i)
+        {
+            if (allocated_mips[i] != m_textures[i].allocatedMip)
+            {
+                uploaded_bytes += Recreate(begin_recording(), m_textures[i], allocated_mips[i]);
+                changed[i] = true;
+            }
+        }
+
+        // Missing mips are uploaded from the smallest to the largest, so every frame gets the texture a bit sharper
+        for (const size_t index : growing)
+        {
+            auto &texture = m_textures[index];
+            const uint32_t target = std::max(wanted_mips[index], texture.allocatedMip);
+            while (texture.residentMip > target &&
+                   (uploaded_bytes < settings.uploadBytesPerFrame || m_stats.uploadedMips == 0))
+            {
+                const uint32_t mip = texture.residentMip - 1;
+                const uint32_t level = mip - texture.allocatedMip;
+                TransitionMip(begin_recording(),
+                              texture.texture->vkImage,
+                              level,
+                              vk::ImageLayout::eShaderReadOnlyOptimal,
+                              vk::ImageLayout::eTransferDstOptimal);
+                uploaded_bytes += CopyMip(command_buffer, texture, mip);
+                TransitionMip(command_buffer,
+                              texture.texture->vkImage,
+                              level,
+                              vk::ImageLayout::eTransferDstOptimal,
+                              vk::ImageLayout::eShaderReadOnlyOptimal);
+
+                texture.residentMip = mip;
+                changed[index] = true;
+                ++m_stats.uploadedMips;
+            }
+        }
+
+        for (size_t i = 0; i < m_textures.size(); ++i)
+        {
+            auto &texture = m_textures[i];
+            if (changed[i])
+            {
+                Publish(texture);
+            }
+            if (const uint32_t target = std::max(wanted_mips[i], texture.allocatedMip); texture.residentMip > target)
+            {
+                m_stats.pendingMips += texture.residentMip - target;
+            }
+            texture.requestedMip = static_cast<uint32_t>(texture.mips.size());
+        }
+
+        if (command_buffer)
+        {
+            m_commandPool->EndCommandBuffer(command_buffer);
+        }
+
+        m_stats.residentBytes = used_bytes;
+        m_stats.uploadedBytes = uploaded_bytes;
+    }
+
+    std::optional<vk::CommandBuffer> TextureStreamer::GetRecordedCommandBuffer() const
+    {
+        if (m_recordedFrames[GraphicsEngine::Get().GetCurrentFrame()] != FRAME_COUNT)
+            return {};
+
+        return m_commandPool->GetCurrentCommandBuffer();
+    }
+
+    float TextureStreamer::GetUvPixels(const Mesh &Mesh,
+                                       const glm::mat4 &Transform,
+                                       const float ViewDepth,
+                                       const float PixelsPerUnit)
+    {
+        const float scale = std::max(
+            {glm::length(glm::vec3(Transform[0])), glm::length(glm::vec3(Transform[1])),
+             glm::length(glm::vec3(Transform[2]))});
+        const float radius = Mesh.GetBoundingRadius() * scale;
+        if (Mesh.GetUvDensity() <= 0.0f || ViewDepth + radius <= 0.0f)
+            return 0.0f;
+
+        // The closest point of the bounds decides, that is where the texture is magnified the most
+        const float depth = std::max(ViewDepth - radius, MIN_STREAMING_DEPTH);
+        return Mesh.GetUvDensity() * scale * PixelsPerUnit / depth;
+    }
+
+    uint64_t TextureStreamer::GetBytes(const StreamedTexture &Texture, const uint32_t FirstMip)
+    {
+        uint64_t bytes = 0;
+        for (uint32_t mip = FirstMip; mip < Texture.mips.size(); ++mip)
+        {
+            bytes += Texture.mips[mip].size();
+        }
+        return bytes;
+    }
+
+    std::optional<size_t> TextureStreamer::FindEvictionCandidate(const std::vector<uint32_t> &AllocatedMips,
+                                                                 const uint64_t NeededBefore) const
+    {
+        std::optional<size_t> candidate;
+        uint64_t oldest = NeededBefore;
+        for (size_t i = 0; i < m_textures.size(); ++i)
+        {
+            const auto &texture = m_textures[i];
+            if (AllocatedMips[i] < texture.tailMip && texture.lastNeeded[AllocatedMips[i]] < oldest)
+            {
+                oldest = texture.lastNeeded[AllocatedMips[i]];
+                candidate = i;
+            }
+        }
+        return candidate;
+    }
+
+    uint64_t TextureStreamer::Recreate(const vk::CommandBuffer CommandBuffer,
+                                       StreamedTexture &Texture,
+                                       const uint32_t AllocatedMip)
+    {
+        auto &texture = *Texture.texture;
+
+        // Frames in flight still sample the old image through their descriptors
+        m_retiredImages.push_back({FRAME_COUNT + MAX_FRAMES_IN_FLIGHT,
+                                   texture.vkImage,
+                                   texture.vkImageMemory,
+                                   std::move(texture.imageInfo.views)});
+        texture.imageInfo.views.clear();
+
+        texture.imageInfo.extent = Texture.extents[AllocatedMip];
+        texture.imageInfo.mipLevels = static_cast<uint32_t>(Texture.mips.size()) - AllocatedMip;
+        texture.imageInfo.layout = vk::ImageLayout::eUndefined;
+        texture.Create();
+
+        Texture.allocatedMip = AllocatedMip;
+        Texture.residentMip = std::max(Texture.residentMip, AllocatedMip);
+
+        // Mips that are still missing get the transition as well, minLod keeps them from being sampled
+        uint64_t bytes = 0;
+        Texture::EnqueueTransitionImageLayout(
+            texture.vkImage, texture.imageInfo, CommandBuffer, vk::ImageLayout::eTransferDstOptimal);
+        for (uint32_t mip = Texture.residentMip; mip < Texture.mips.size(); ++mip)
+        {
+            bytes += CopyMip(CommandBuffer, Texture, mip);
+        }
+        Texture::EnqueueTransitionImageLayout(
+            texture.vkImage, texture.imageInfo, CommandBuffer, vk::ImageLayout::eShaderReadOnlyOptimal);
+        return bytes;
+    }
+
+    uint64_t TextureStreamer::CopyMip(const vk::CommandBuffer CommandBuffer,
+                                      const StreamedTexture &Texture,
+                                      const uint32_t Mip)
+    {
+        const auto &pixels = Texture.mips[Mip];
+        const auto &staging_buffer = m_stagingBuffers[GraphicsEngine::Get().GetCurrentFrame()].emplace_back(
+            new Buffer(pixels.size(),
+                       VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                       VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT));
+        Buffer::SetBufferData(pixels.data(), *staging_buffer);
+
+        const vk::BufferImageCopy2 region(
+            0,
+            0,
+            0,
+            vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, Mip - Texture.allocatedMip, 0, 1),
+            {0, 0, 0},
+            Texture.extents[Mip]);
+        const vk::CopyBufferToImageInfo2 copy_info(
+            *staging_buffer, Texture.texture->vkImage, vk::ImageLayout::eTransferDstOptimal, region);
+        CommandBuffer.copyBufferToImage2(copy_info);
+        return pixels.size();
+    }
+
+    void TextureStreamer::Publish(StreamedTexture &Texture)
+    {
+        auto &texture = *Texture.texture;
+        texture.imageInfo.sampler = GetSampler(texture.imageInfo.mipLevels, Texture.residentMip - Texture.allocatedMip);
+
+        texture.ReregisterBindless();
+        MaterialManager::RefreshUniforms(texture);
+    }
+
+    const Sampler &TextureStreamer::GetSampler(const uint32_t MipLevels, const uint32_t MinLod)
+    {
+        const auto key = std::make_pair(MipLevels, MinLod);
+        return m_samplers
+            .try_emplace(key, VK_FILTER_LINEAR, VK_SAMPLER_ADDRESS_MODE_REPEAT, MipLevels, static_cast<float>(MinLod))
+            .first->second;
+    }
+}  // namespace Slipper::GPU::Vulkan
@@ -49,7 +49,7 @@ void DestroyDebugReportCallbackEXT(VkInstance instance,
 
 namespace Slipper::GPU::Vulkan
 {
-    VulkanInstance::VulkanInstance()
+    VulkanInstance::VulkanInstance(const bool Headless)
     {
 
         ASSERT(!m_instance, "Instance allready created!");
@@ -73,7 +73,7 @@ namespace Slipper::GPU::Vulkan
         }
 
         // Extensions
-        auto extensions = GetRequiredExtensions();
+        auto extensions = GetRequiredExtensions(Headless);
         extensions.insert(extensions.end(), Vulkan::INSTANCE_EXTENSIONS.begin(), Vulkan::INSTANCE_EXTENSIONS.end());
         std::cout << "\nRequested Instance Extensions:\n";
         for (const char *extension_name : extensions)
@@ -142,11 +142,15 @@ namespace Slipper::GPU::Vulkan
                                    });
     }
 
-    std::vector<const char *> VulkanInstance::GetRequiredExtensions()
+    std::vector<const char *> VulkanInstance::GetRequiredExtensions(const bool Headless)
     {
-        uint32_t glfw_extension_count = 0;
-        const char **glfw_extensions = glfwGetRequiredInstanceExtensions(&glfw_extension_count);
-        std::vector<const char *> extensions(glfw_extensions, glfw_extensions + glfw_extension_count);
+        std::vector<const char *> extensions;
+        if (!Headless)
+        {
+            uint32_t glfw_extension_count = 0;
+            const char **glfw_extensions = glfwGetRequiredInstanceExtensions(&glfw_extension_count);
+            extensions.assign(glfw_extensions, glfw_extensions + glfw_extension_count);
+        }
 
         if (Vulkan::EnableValidationLayers)
         {
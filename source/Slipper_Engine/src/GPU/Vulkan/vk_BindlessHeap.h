@@ -0,0 +1,114 @@
+#pragma once
+
+#include "vk_DeviceDependentObject.h"
+#include "vk_Settings.h"
+
+namespace Slipper::GPU::Vulkan
+{
+    class Texture;
+    class Buffer;
+
+    // Shaders that want to use the heap have to declare it at this set (see Shaders/Bindless.glsl)
+    inline constexpr uint32_t BINDLESS_DESCRIPTOR_SET = 2;
+    inline constexpr uint32_t BINDLESS_TEXTURE_BINDING = 0;
+    inline constexpr uint32_t BINDLESS_BUFFER_BINDING = 1;
+    inline constexpr uint32_t INVALID_BINDLESS_INDEX = std::numeric_limits<uint32_t>::max();
+
+    inline constexpr uint32_t MAX_BINDLESS_TEXTURES = 16384;
+    inline constexpr uint32_t MAX_BINDLESS_BUFFERS = 16384;
+
+    /* One global descriptor set holding partially bound, update after bind arrays of all registered
+     * sampled images and storage buffers. Resources get a stable index on registration which can be handed
+     * to shaders as plain integers, so draws using different textures can share a single descriptor bind. */
+    class BindlessHeap : DeviceDependentObject
+    {
+        struct SlotAllocator
+        {
+            uint32_t capacity = 0;
+            uint32_t next = 0;
+            std::vector<uint32_t> freeSlots;
+
+            uint32_t Acquire();
+            void Release(uint32_t Slot);
+
+            [[nodiscard]] uint32_t InUse() const
+            {
+                return next - static_cast<uint32_t>(freeSlots.size());
+            }
+        };
+
+        struct PendingRelease
+        {
+            uint64_t releaseFrame;
+            uint32_t slot;
+            bool isTexture;
+        };
+
+     public:
+        static BindlessHeap &Get()
+        {
+            return *m_instance;
+        }
+
+        // Returns false if the device does not support the required descriptor indexing features
+        static bool IsAvailable()
+        {
+            return m_instance != nullptr;
+        }
+
+        static void Init();
+        static void Shutdown();
+
+        [[nodiscard]] uint32_t RegisterTexture(const Texture &Texture);
+        // Rewrites the descriptor of an already registered texture, e.g. after its image view changed
+        void UpdateTexture(uint32_t Index, const Texture &Texture) const;
+        void ReleaseTexture(uint32_t Index);
+
+        [[nodiscard]] uint32_t RegisterBuffer(const Buffer &Buffer);
+        void UpdateBuffer(uint32_t Index, const Buffer &Buffer) const;
+        void ReleaseBuffer(uint32_t Index);
+
+        // Slots are only handed out again once no frame in flight can reference them anymore
+        void BeginFrame();
+
+        void Bind(vk::CommandBuffer CommandBuffer,
+                  vk::PipelineBindPoint BindPoint,
+                  vk::PipelineLayout PipelineLayout) const;
+
+        [[nodiscard]] vk::DescriptorSetLayout GetLayout() const
+        {
+            return m_layout;
+        }
+
+        [[nodiscard]] vk::DescriptorSet GetSet() const
+        {
+            return m_set;
+        }
+
+        [[nodiscard]] uint32_t GetTextureCount() const
+        {
+            return m_textureSlots.InUse();
+        }
+
+        [[nodiscard]] uint32_t GetBufferCount() const
+        {
+            return m_bufferSlots.InUse();
+        }
+
+     private:
+        BindlessHeap(uint32_t TextureCapacity, uint32_t BufferCapacity);
+        ~BindlessHeap();
+
+     private:
+        static inline BindlessHeap *m_instance = nullptr;
+
+        vk::DescriptorSetLayout m_layout;
+        vk::DescriptorPool m_pool;
+        vk::DescriptorSet m_set;
+
+        SlotAllocator m_textureSlots;
+        SlotAllocator m_bufferSlots;
+        std::deque<PendingRelease> m_pendingReleases;
+        uint64_t m_frame = 0;
+    };
+}  // namespace Slipper::GPU::Vulkan
@@ -0,0 +1,26 @@
+#pragma once
+
+namespace Slipper::GPU::Vulkan
+{
+    struct FormatBlockInfo
+    {
+        uint32_t width = 1;
+        uint32_t height = 1;
+        uint32_t bytes = 0;
+    };
+
+    // Blocks a format is stored in, uncompressed formats have 1x1 blocks. Nothing for formats textures can not use.
+    [[nodiscard]] std::optional<FormatBlockInfo> GetFormatBlockInfo(vk::Format Format);
+    [[nodiscard]] bool IsBlockCompressed(vk::Format Format);
+    [[nodiscard]] bool IsSrgbFormat(vk::Format Format);
+    // Size of a tightly packed level, blocks that only partially cover the level at its edges count fully
+    [[nodiscard]] uint64_t GetLevelBytes(vk::Format Format, vk::Extent3D Extent);
+
+    /* Uncompressed format DecodeBlocks turns a block format into or nothing if there is no cpu decoder for it.
+     * BC1 to BC7 decode to 4 bytes per pixel, there is no decoder for ASTC. */
+    [[nodiscard]] std::optional<vk::Format> GetDecodedFormat(vk::Format Format);
+    // Used as fallback for devices that can not sample the block format
+    [[nodiscard]] std::vector<uint8_t> DecodeBlocks(vk::Format Format,
+                                                    vk::Extent3D Extent,
+                                                    std::span<const uint8_t> Blocks);
+}  // namespace Slipper::GPU::Vulkan
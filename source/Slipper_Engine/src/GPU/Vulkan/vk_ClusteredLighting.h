@@ -0,0 +1,136 @@
+#pragma once
+
+#include "AssetCache.h"
+#include "vk_DeviceDependentObject.h"
+#include "vk_Settings.h"
+
+namespace Slipper
+{
+    struct Light;
+}
+
+namespace Slipper::GPU::Vulkan
+{
+    class Buffer;
+    class ComputeShader;
+    class VKRenderingStage;
+
+    // Froxel grid of every view, the xy tiles cover the render area and the slices are spaced exponentially
+    inline constexpr uint32_t CLUSTER_GRID_X = 16;
+    inline constexpr uint32_t CLUSTER_GRID_Y = 9;
+    inline constexpr uint32_t CLUSTER_GRID_Z = 24;
+    inline constexpr uint32_t CLUSTER_COUNT = CLUSTER_GRID_X * CLUSTER_GRID_Y * CLUSTER_GRID_Z;
+    // Lights past the limit are dropped from the cluster, each cluster stores its count followed by the indices
+    inline constexpr uint32_t MAX_LIGHTS_PER_CLUSTER = 255;
+    inline constexpr uint32_t MAX_CLUSTERED_LIGHTS = 16384;
+    // Must match LIGHT_HEADER_WORDS in Shaders/Include/ClusteredLights.glsl and Shaders/ClusterCull.comp
+    inline constexpr uint32_t LIGHT_HEADER_WORDS = 20;
+
+    /* Start of every light buffer, read by the cull shader and the lit shaders.
+     * Floats are stored as their bits since the buffers are only accessed as uint arrays. */
+    struct LightBufferHeader
+    {
+        uint32_t clusterBuffer;
+        uint32_t lightCount;
+        uint32_t gridSize[3];
+        float tileSize[2];
+        float nearPlane;
+        float farPlane;
+        // log(depth) * sliceScale - sliceBias is the slice of a view space depth
+        float sliceScale;
+        float sliceBias;
+        // Projection scale of x and y, used to rebuild the view space bounds of a tile
+        float p00;
+        float p11;
+        uint32_t maxLightsPerCluster;
+        float resolution[2];
+        // Bindless index of the ShadowAtlas buffer of the frame or INVALID_BINDLESS_INDEX
+        uint32_t shadowBuffer;
+        uint32_t reserved[3];
+    };
+    static_assert(sizeof(LightBufferHeader) == LIGHT_HEADER_WORDS * sizeof(uint32_t));
+
+    // The clusters are built in view space, so the positions are transformed into it once on the cpu
+    struct GpuLight
+    {
+        glm::vec4 positionRange;
+        // Color premultiplied with the intensity, w holds the bits of the ShadowAtlas slot or INVALID_SHADOW
+        glm::vec4 color;
+    };
+
+    struct ClusteredLightingStats
+    {
+        // Submitted by the LightUpdateSystem during the last frame
+        uint32_t submittedLights = 0;
+        // Uploaded for the last culled view, lights outside the depth range or past the capacity are skipped
+        uint32_t uploadedLights = 0;
+        // Views culled during the last frame
+        uint32_t views = 0;
+    };
+
+    /* Clustered forward lighting. Lights are gathered from the ECS each frame and written to a host visible buffer
+     * per view and frame slot. Before a view is drawn a compute pass bins them into the clusters of a 3D froxel
+     * grid, so the lit shaders only iterate the lights that can reach their cluster instead of all of them.
+     * Both buffers live in the BindlessHeap and shaders find them through the lightBuffer draw push constant. */
+    class ClusteredLighting : DeviceDependentObject
+    {
+        struct View
+        {
+            std::array<OwningPtr<Buffer>, MAX_FRAMES_IN_FLIGHT> lightBuffers;
+            std::array<void *, MAX_FRAMES_IN_FLIGHT> mappedLightBuffers = {};
+            std::array<uint32_t, MAX_FRAMES_IN_FLIGHT> lightBufferIndices = {};
+            std::array<OwningPtr<Buffer>, MAX_FRAMES_IN_FLIGHT> clusterBuffers;
+            std::array<uint32_t, MAX_FRAMES_IN_FLIGHT> clusterBufferIndices = {};
+            // Frame the light buffer of the slot was last written in
+            std::array<uint64_t, MAX_FRAMES_IN_FLIGHT> recordedFrames = {};
+        };
+
+     public:
+        static ClusteredLighting &Get()
+        {
+            return *m_instance;
+        }
+
+        // Returns false if there is no BindlessHeap, lit shaders then fall back to unlit
+        static bool IsAvailable()
+        {
+            return m_instance != nullptr;
+        }
+
+        static void Init();
+        static void Shutdown();
+
+        // Drops the lights of the previous frame
+        void BeginFrame();
+
+        void SubmitLight(glm::vec3 Location, const Light &Light, uint32_t Shadow);
+
+        // Uploads the lights for the stages camera and records the cull dispatch, the graphics queue waits on it
+        void Record(VKRenderingStage &Stage, vk::CommandBuffer ComputeCommandBuffer, uint32_t Frame);
+
+        // Bindless index of the light buffer the stage recorded this frame or INVALID_BINDLESS_INDEX
+        [[nodiscard]] uint32_t GetLightBuffer(const VKRenderingStage &Stage, uint32_t Frame) const;
+
+        [[nodiscard]] const ClusteredLightingStats &GetStats() const
+        {
+            return m_stats;
+        }
+
+     private:
+        explicit ClusteredLighting(AssetHandle<ComputeShader> CullShader);
+        ~ClusteredLighting();
+
+        View &GetView(const VKRenderingStage &Stage);
+
+     private:
+        static inline ClusteredLighting *m_instance = nullptr;
+
+        AssetHandle<ComputeShader> m_cullShader;
+        std::unordered_map<const VKRenderingStage *, View> m_views;
+        // World space until they are transformed into the view that is recorded
+        std::vector<GpuLight> m_lights;
+        uint32_t m_recordedViews = 0;
+
+        ClusteredLightingStats m_stats;
+    };
+}  // namespace Slipper::GPU::Vulkan
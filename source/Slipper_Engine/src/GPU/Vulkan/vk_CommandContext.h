@@ -0,0 +1,117 @@
+#pragma once
+
+namespace Slipper::GPU::Vulkan
+{
+    struct CommandCounter
+    {
+        uint64_t issued = 0;
+        uint64_t elided = 0;
+
+        void Add(const CommandCounter &Other)
+        {
+            issued += Other.issued;
+            elided += Other.elided;
+        }
+    };
+
+    struct CommandContextStats
+    {
+        CommandCounter pipelineBinds;
+        CommandCounter descriptorSetBinds;
+        CommandCounter vertexBufferBinds;
+        CommandCounter indexBufferBinds;
+        CommandCounter viewports;
+        CommandCounter scissors;
+        uint64_t pushConstants = 0;
+        uint64_t draws = 0;
+
+        void Add(const CommandContextStats &Other);
+
+        [[nodiscard]] CommandCounter Total() const;
+    };
+
+    /* Records into a vk::CommandBuffer while remembering the currently bound state.
+     * Binds and dynamic state changes that would not change anything are skipped. */
+    class CommandContext
+    {
+        struct BindPointState
+        {
+            vk::Pipeline pipeline;
+            vk::PipelineLayout layout;
+            std::vector<vk::DescriptorSet> descriptorSets;
+        };
+
+     public:
+        CommandContext() = default;
+        explicit CommandContext(vk::CommandBuffer CommandBuffer);
+
+        // Forgets all tracked state, has to be called whenever recording into a new command buffer starts
+        void Reset(vk::CommandBuffer CommandBuffer);
+
+        // Forces the next calls to be issued, e.g. after foreign code recorded into the command buffer
+        void Invalidate();
+
+        void BindPipeline(vk::PipelineBindPoint BindPoint, vk::Pipeline Pipeline);
+        void BindDescriptorSets(vk::PipelineBindPoint BindPoint,
+                                vk::PipelineLayout Layout,
+                                uint32_t FirstSet,
+                                std::span<const vk::DescriptorSet> DescriptorSets);
+        void BindVertexBuffer(uint32_t Binding, vk::Buffer Buffer, vk::DeviceSize Offset = 0);
+        void BindIndexBuffer(vk::Buffer Buffer, vk::DeviceSize Offset, vk::IndexType IndexType);
+        void SetViewport(const vk::Viewport &Viewport);
+        void SetScissor(const vk::Rect2D &Scissor);
+
+        void PushConstants(vk::PipelineLayout Layout,
+                           vk::ShaderStageFlags StageFlags,
+                           uint32_t Offset,
+                           uint32_t Size,
+                           const void *Data);
+        void DrawIndexed(uint32_t IndexCount,
+                         uint32_t InstanceCount = 1,
+                         uint32_t FirstIndex = 0,
+                         int32_t VertexOffset = 0,
+                         uint32_t FirstInstance = 0);
+
+        [[nodiscard]] vk::CommandBuffer GetCommandBuffer() const
+        {
+            return m_commandBuffer;
+        }
+
+        operator vk::CommandBuffer() const
+        {
+            return m_commandBuffer;
+        }
+
+        [[nodiscard]] const CommandContextStats &GetStats() const
+        {
+            return m_stats;
+        }
+
+        void ResetStats()
+        {
+            m_stats = {};
+        }
+
+     private:
+        BindPointState &GetBindPointState(vk::PipelineBindPoint BindPoint);
+
+     public:
+        static constexpr uint32_t MAX_VERTEX_BINDINGS = 4;
+
+     private:
+        vk::CommandBuffer m_commandBuffer;
+
+        BindPointState m_graphicsState;
+        BindPointState m_computeState;
+
+        std::array<std::pair<vk::Buffer, vk::DeviceSize>, MAX_VERTEX_BINDINGS> m_vertexBuffers;
+        vk::Buffer m_indexBuffer;
+        vk::DeviceSize m_indexBufferOffset = 0;
+        vk::IndexType m_indexType = vk::IndexType::eUint16;
+
+        std::optional<vk::Viewport> m_viewport;
+        std::optional<vk::Rect2D> m_scissor;
+
+        CommandContextStats m_stats;
+    };
+}  // namespace Slipper::GPU::Vulkan
@@ -7,7 +7,8 @@ namespace Slipper::GPU::Vulkan
     {
      public:
         explicit ComputePipeline(const vk::PipelineShaderStageCreateInfo &ComputeShader,
-                                 vk::DescriptorSetLayout &Layout);
+                                 const std::vector<vk::DescriptorSetLayout> &DescriptorSetLayouts,
+                                 const std::vector<vk::PushConstantRange> &PushConstantRanges = {});
 
         ~ComputePipeline();
 
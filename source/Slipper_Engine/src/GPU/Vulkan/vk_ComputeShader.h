@@ -20,11 +20,23 @@ class ComputeShader : public Shader
                   uint32_t GroupCountY,
                   uint32_t GroupCountZ) const;
 
+    // Has to be called before Dispatch, see Shader::PushConstants
+    template<typename T>
+        requires std::is_trivially_copyable_v<T>
+    void Push(const vk::CommandBuffer CommandBuffer, const T &Data, const uint32_t Offset = 0) const
+    {
+        PushConstants(CommandBuffer, GetPipelineLayout(), Data, Offset);
+    }
+
  private:
+    [[nodiscard]] vk::PipelineLayout GetPipelineLayout() const;
+
     ComputeShader() = delete;
     ComputeShader(std::string_view ComputeShaderPath);
+    // Creates the shader from code that was read beforehand, see ShaderManager::LoadComputeShaderAsync
+    explicit ComputeShader(ShaderCode &&Code);
 
-    void LoadShader(const std::string_view ShaderPath);
+    void LoadShader(ShaderCode &&Code);
     ComputePipeline &CreateComputePipeline();
 
  private:
@@ -6,8 +6,8 @@ namespace Slipper::GPU::Vulkan
 class DepthBuffer : public Texture
 {
 public:
-    //MSAA Settings set in Engine::Settings::MSAA_SAMPLES
     DepthBuffer(VkExtent2D Extent,
-                vk::Format Format);
+                vk::Format Format,
+                vk::SampleCountFlagBits NumSamples);
 };
 }
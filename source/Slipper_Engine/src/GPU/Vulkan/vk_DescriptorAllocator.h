@@ -0,0 +1,184 @@
+#pragma once
+
+#include "vk_DeviceDependentObject.h"
+#include "vk_Settings.h"
+
+namespace Slipper::GPU::Vulkan
+{
+    class IShaderBindableData;
+
+    struct DescriptorAllocatorStats
+    {
+        uint64_t setsAllocated = 0;
+        uint64_t setsFreed = 0;
+        uint64_t poolsCreated = 0;
+        uint64_t poolResets = 0;
+        uint64_t cacheHits = 0;
+        uint64_t cacheMisses = 0;
+
+        [[nodiscard]] double HitRate() const
+        {
+            const uint64_t lookups = cacheHits + cacheMisses;
+            return lookups ? static_cast<double>(cacheHits) / static_cast<double>(lookups) : 0.0;
+        }
+    };
+
+    // A single resource that will be written into a cached descriptor set.
+    struct DescriptorResource
+    {
+        uint32_t binding = 0;
+        vk::DescriptorType descriptorType = vk::DescriptorType::eUniformBuffer;
+        std::optional<vk::DescriptorBufferInfo> bufferInfo;
+        std::optional<vk::DescriptorImageInfo> imageInfo;
+
+        static DescriptorResource FromBindable(uint32_t Binding, const IShaderBindableData &Data);
+
+        bool operator==(const DescriptorResource &) const = default;
+    };
+
+    // Layout and resources a cached frame set was written with, compared in full so hash collisions cannot alias
+    struct DescriptorSetKey
+    {
+        vk::DescriptorSetLayout layout;
+        std::vector<DescriptorResource> resources;
+    };
+
+    // Allows looking up the cache with a span of resources without copying them into a key first
+    struct DescriptorSetKeyView
+    {
+        vk::DescriptorSetLayout layout;
+        std::span<const DescriptorResource> resources;
+
+        DescriptorSetKeyView(const vk::DescriptorSetLayout Layout, const std::span<const DescriptorResource> Resources)
+            : layout(Layout), resources(Resources)
+        {
+        }
+
+        DescriptorSetKeyView(const DescriptorSetKey &Key) : layout(Key.layout), resources(Key.resources)
+        {
+        }
+
+        bool operator==(const DescriptorSetKeyView &Other) const
+        {
+            return layout == Other.layout && std::ranges::equal(resources, Other.resources);
+        }
+    };
+
+    struct DescriptorSetKeyHash
+    {
+        using is_transparent = void;
+
+        size_t operator()(DescriptorSetKeyView Key) const;
+    };
+
+    struct DescriptorSetKeyEqual
+    {
+        using is_transparent = void;
+
+        bool operator()(const DescriptorSetKeyView A, const DescriptorSetKeyView B) const
+        {
+            return A == B;
+        }
+    };
+
+    /* Chain of descriptor pools that grows whenever the current pool runs out of space.
+     * Every newly created pool holds more sets than the previous one up to a fixed maximum. */
+    class DescriptorPoolChain : DeviceDependentObject
+    {
+     public:
+        DescriptorPoolChain(vk::DescriptorPoolCreateFlags Flags, uint32_t InitialSetsPerPool);
+        ~DescriptorPoolChain();
+
+        DescriptorPoolChain(const DescriptorPoolChain &) = delete;
+        DescriptorPoolChain &operator=(const DescriptorPoolChain &) = delete;
+
+        [[nodiscard]] vk::DescriptorSet Allocate(vk::DescriptorSetLayout Layout,
+                                                 DescriptorAllocatorStats &Stats,
+                                                 vk::DescriptorPool *OutPool = nullptr);
+
+        // Only valid for chains created with vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet
+        void Free(vk::DescriptorPool Pool, vk::DescriptorSet Set);
+
+        // Returns every set of every pool back to the chain
+        void Reset(DescriptorAllocatorStats &Stats);
+
+        [[nodiscard]] size_t GetPoolCount() const
+        {
+            return m_readyPools.size() + m_fullPools.size();
+        }
+
+     private:
+        vk::DescriptorPool GrabPool(DescriptorAllocatorStats &Stats);
+        vk::DescriptorPool CreatePool(uint32_t SetCount) const;
+
+     public:
+        static constexpr uint32_t MAX_SETS_PER_POOL = 4096;
+
+     private:
+        vk::DescriptorPoolCreateFlags m_flags;
+        uint32_t m_setsPerPool;
+        std::vector<vk::DescriptorPool> m_readyPools;
+        std::vector<vk::DescriptorPool> m_fullPools;
+    };
+
+    /* Global descriptor allocator.
+     * Persistent sets live until they are freed explicitly (e.g. the per frame sets of a shader).
+     * Frame sets are allocated from pools that get reset once the frame slot they belong to is reused,
+     * identical resource bindings inside the same frame slot share a single descriptor set. */
+    class DescriptorAllocator : DeviceDependentObject
+    {
+     public:
+        static DescriptorAllocator &Get()
+        {
+            return *m_instance;
+        }
+
+        static void Init();
+        static void Shutdown();
+
+        [[nodiscard]] vk::DescriptorSet AllocatePersistent(vk::DescriptorSetLayout Layout);
+        void FreePersistent(vk::DescriptorSet Set);
+
+        [[nodiscard]] vk::DescriptorSet AllocateFrame(vk::DescriptorSetLayout Layout);
+
+        /* Returns a descriptor set of the current frame slot that has the given resources written to it.
+         * The set is only written the first time a combination of layout and resources is requested. */
+        [[nodiscard]] vk::DescriptorSet GetOrCreateFrameSet(vk::DescriptorSetLayout Layout,
+                                                            std::span<const DescriptorResource> Resources);
+
+        // Has to be called after the frame slot has been waited for, since all of its sets become invalid.
+        void BeginFrame(uint32_t Frame);
+
+        [[nodiscard]] const DescriptorAllocatorStats &GetStats() const
+        {
+            return m_stats;
+        }
+
+        [[nodiscard]] size_t GetPoolCount() const;
+
+        void ResetStats()
+        {
+            m_stats = {};
+        }
+
+        static size_t HashResources(vk::DescriptorSetLayout Layout, std::span<const DescriptorResource> Resources);
+
+     private:
+        DescriptorAllocator();
+        ~DescriptorAllocator();
+
+     private:
+        static inline DescriptorAllocator *m_instance = nullptr;
+
+        DescriptorAllocatorStats m_stats;
+
+        OwningPtr<DescriptorPoolChain> m_persistentPools;
+        std::unordered_map<VkDescriptorSet, vk::DescriptorPool> m_persistentSetPools;
+
+        std::array<OwningPtr<DescriptorPoolChain>, MAX_FRAMES_IN_FLIGHT> m_framePools;
+        std::array<std::unordered_map<DescriptorSetKey, vk::DescriptorSet, DescriptorSetKeyHash, DescriptorSetKeyEqual>,
+                   MAX_FRAMES_IN_FLIGHT>
+            m_frameSetCaches;
+        uint32_t m_currentFrame = 0;
+    };
+}  // namespace Slipper::GPU::Vulkan
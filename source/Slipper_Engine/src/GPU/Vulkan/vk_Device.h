@@ -13,13 +13,23 @@ namespace Slipper::GPU::Vulkan
         std::optional<uint32_t> presentFamily;
         std::optional<uint32_t> transferFamily;
 
-        [[nodiscard]] bool IsComplete() const
+        // Headless devices never present so they do not need a present family
+        [[nodiscard]] bool IsComplete(const bool RequirePresent = true) const
         {
-            return graphicsFamily.has_value() && presentFamily.has_value() && transferFamily.has_value() &&
-                computeFamily.has_value();
+            return graphicsFamily.has_value() && (presentFamily.has_value() || !RequirePresent) &&
+                transferFamily.has_value() && computeFamily.has_value();
         }
     };
 
+    struct MemoryHeapUsage
+    {
+        vk::DeviceSize size = 0;
+        // Both stay 0 if the device does not support VK_EXT_memory_budget
+        vk::DeviceSize budget = 0;
+        vk::DeviceSize usage = 0;
+        bool deviceLocal = false;
+    };
+
     struct SwapChainSupportDetails
     {
         vk::SurfaceCapabilitiesKHR capabilities;
@@ -70,11 +80,12 @@ namespace Slipper::GPU::Vulkan
 
         void InitLogicalDevice();
 
+        // Passing no surface picks a headless device that only renders offscreen and has no present queue
         static VKDevice *PickPhysicalDevice(const Surface *Surface, bool InitLogicalDevice);
 
         [[nodiscard]] std::string DeviceInfoToString() const;
 
-        [[nodiscard]] static std::vector<const char *> GetRequiredExtensions();
+        [[nodiscard]] static std::vector<const char *> GetRequiredExtensions(bool Headless);
 
         vk::SurfaceCapabilitiesKHR GetPhysicalDeviceSurfaceCapabilities(const Surface *Surface) const;
         uint32_t SurfaceSwapChainImagesCount(const Surface *Surface) const;
@@ -85,6 +96,18 @@ namespace Slipper::GPU::Vulkan
 
         uint32_t FindMemoryType(uint32_t TypeFilter, vk::MemoryPropertyFlags Properties) const;
 
+        // Descriptor indexing features required by the BindlessHeap
+        [[nodiscard]] bool SupportsBindless() const;
+        // Timestamp queries on graphics and compute queues plus host query reset, required by the GpuProfiler
+        [[nodiscard]] bool SupportsGpuTimestamps() const;
+        // Pipeline statistics queries, used for the overdraw statistics of rendering stages
+        [[nodiscard]] bool SupportsPipelineStatistics() const;
+        // Optimal tiling images of the format can be uploaded to and sampled with linear filtering
+        [[nodiscard]] bool SupportsSampledFormat(vk::Format Format) const;
+
+        // Current usage of every memory heap as reported by the driver, includes allocations of other processes
+        [[nodiscard]] std::vector<MemoryHeapUsage> GetMemoryHeapUsage() const;
+
      private:
         VKDevice(vk::PhysicalDevice PhysicalDevice);
         ~VKDevice();
@@ -102,6 +125,13 @@ namespace Slipper::GPU::Vulkan
 
         vk::PhysicalDeviceProperties deviceProperties;
         vk::PhysicalDeviceFeatures deviceFeatures;
+        vk::PhysicalDeviceDescriptorIndexingFeatures descriptorIndexingFeatures;
+        vk::PhysicalDeviceDescriptorIndexingProperties descriptorIndexingProperties;
+        vk::PhysicalDeviceHostQueryResetFeatures hostQueryResetFeatures;
+        // Physical device level query, does not have to be enabled on the logical device
+        bool memoryBudgetSupported = false;
+        // Picked without a surface, presentQueue stays empty and swap chain functionality is not enabled
+        bool headless = false;
 
         QueueFamilyIndices queueFamilyIndices;
 
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "vk_DeviceDependentObject.h"
+#include "vk_Settings.h"
+
+namespace Slipper::GPU::Vulkan
+{
+    class Buffer;
+    class VKRenderingStage;
+
+    inline constexpr uint32_t INVALID_READBACK_CAPTURE = std::numeric_limits<uint32_t>::max();
+
+    enum class ReadbackFormat
+    {
+        // Bytes exactly as they are stored in the stages color image
+        Native,
+        // Converted on the cpu, for image writers and video encoders that expect a fixed channel order
+        Rgba8,
+        Rgb8,
+    };
+
+    struct ReadbackImage
+    {
+        // Frame the pixels were rendered in
+        uint64_t frame = 0;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        // Format of the stages color image, the pixels have been converted if anything but Native was requested
+        vk::Format sourceFormat = vk::Format::eUndefined;
+        ReadbackFormat format = ReadbackFormat::Native;
+        uint32_t bytesPerPixel = 0;
+        uint32_t rowPitch = 0;
+        // Only valid during the callback, copy the pixels if they are needed afterwards
+        std::span<const std::byte> pixels;
+    };
+
+    using ReadbackCallback = std::function<void(const ReadbackImage &)>;
+
+    /* Copies the color image of offscreen rendering stages back to the cpu. Every capture owns a persistently
+     * mapped host buffer per frame slot which the copy is recorded into at the end of the stage. The slots fence
+     * signals availability, so the pixels are handed to the callback in GraphicsEngine::NewFrame once it has been
+     * waited on anyways and arrive MAX_FRAMES_IN_FLIGHT frames late without ever stalling the frame loop. */
+    class FrameReadback : DeviceDependentObject
+    {
+        struct Slot
+        {
+            OwningPtr<Buffer> buffer;
+            void *mapped = nullptr;
+            vk::DeviceSize size = 0;
+            // Set while a copy has been recorded that was not handed to the callback yet
+            bool pending = false;
+            uint64_t frame = 0;
+            vk::Extent2D extent;
+            vk::Format format = vk::Format::eUndefined;
+        };
+
+        struct Capture
+        {
+            NonOwningPtr<VKRenderingStage> stage;
+            ReadbackCallback callback;
+            ReadbackFormat format = ReadbackFormat::Native;
+            // Single shot captures deactivate themselves after recording their copy
+            bool continuous = true;
+            bool active = true;
+            std::array<Slot, MAX_FRAMES_IN_FLIGHT> slots;
+        };
+
+     public:
+        static FrameReadback &Get()
+        {
+            return *m_instance;
+        }
+
+        static bool IsAvailable()
+        {
+            return m_instance != nullptr;
+        }
+
+        static void Init();
+        static void Shutdown();
+
+        // Only stages with an OffscreenSwapChain can be captured. Returns the id used to remove the capture.
+        uint32_t AddCapture(NonOwningPtr<VKRenderingStage> Stage,
+                            ReadbackCallback Callback,
+                            ReadbackFormat Format = ReadbackFormat::Native,
+                            bool Continuous = true);
+
+        // Captures the next frame of the stage only
+        uint32_t CaptureOnce(NonOwningPtr<VKRenderingStage> Stage,
+                             ReadbackCallback Callback,
+                             ReadbackFormat Format = ReadbackFormat::Native)
+        {
+            return AddCapture(Stage, std::move(Callback), Format, false);
+        }
+
+        // Stops recording new copies, frames already in flight are still handed to the callback
+        void RemoveCapture(uint32_t Capture);
+
+        // Hands the finished copies of the frame slot to their callbacks, requires the slots fence to be signaled
+        void BeginFrame(uint32_t Frame);
+
+        // Records the copies of all active captures of the stage, called by the stage after its render passes
+        void Record(VKRenderingStage &Stage, vk::CommandBuffer CommandBuffer, uint32_t Frame);
+
+        [[nodiscard]] bool HasCaptures(const VKRenderingStage &Stage) const;
+
+        [[nodiscard]] static uint32_t GetBytesPerPixel(vk::Format Format);
+
+     private:
+        FrameReadback();
+        ~FrameReadback();
+
+        void Deliver(Capture &Capture, Slot &Slot);
+        void EnsureSlotSize(Slot &Slot, vk::DeviceSize Size) const;
+
+     private:
+        static inline FrameReadback *m_instance = nullptr;
+
+        std::unordered_map<uint32_t, Capture> m_captures;
+        uint32_t m_nextCapture = 0;
+
+        // Host cached memory makes reading the pixels a lot faster where it is available
+        VkMemoryPropertyFlags m_memoryProperties = 0;
+        // Reused for the cpu side conversions
+        std::vector<std::byte> m_conversionBuffer;
+    };
+}  // namespace Slipper::GPU::Vulkan
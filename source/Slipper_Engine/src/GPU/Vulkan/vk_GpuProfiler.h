@@ -0,0 +1,151 @@
+#pragma once
+
+#include "vk_DeviceDependentObject.h"
+#include "vk_Settings.h"
+
+namespace Slipper::GPU::Vulkan
+{
+    inline constexpr uint32_t INVALID_GPU_SCOPE = std::numeric_limits<uint32_t>::max();
+
+    struct GpuTimingScope
+    {
+        std::string name;
+        uint32_t depth;
+        // Index of the enclosing scope of the same frame or INVALID_GPU_SCOPE
+        uint32_t parent;
+        // Relative to the first timestamp of the frame
+        double beginMs;
+        double endMs;
+
+        [[nodiscard]] double DurationMs() const
+        {
+            return endMs - beginMs;
+        }
+    };
+
+    struct GpuFrameTimings
+    {
+        uint64_t frame = 0;
+        // Absolute gpu time of the first timestamp, only meaningful relative to other frames
+        double gpuStartMs = 0.0;
+        double gpuEndMs = 0.0;
+        std::vector<GpuTimingScope> scopes;
+
+        [[nodiscard]] double DurationMs() const
+        {
+            return gpuEndMs - gpuStartMs;
+        }
+    };
+
+    /* Measures gpu time with timestamp queries. Every frame slot owns a query pool, scopes are written while
+     * recording and read back without stalling once the slots fence has been waited on in
+     * GraphicsEngine::NewFrame, so results lag MAX_FRAMES_IN_FLIGHT frames behind. */
+    class GpuProfiler : DeviceDependentObject
+    {
+        struct PendingScope
+        {
+            std::string name;
+            uint32_t depth;
+            uint32_t parent;
+            uint32_t beginQuery;
+            uint32_t endQuery;
+        };
+
+        struct FrameQueries
+        {
+            vk::QueryPool pool;
+            uint32_t usedQueries = 0;
+            uint64_t frame = 0;
+            std::vector<PendingScope> scopes;
+        };
+
+     public:
+        static constexpr uint32_t MAX_QUERIES_PER_FRAME = 512;
+        static constexpr size_t HISTORY_SIZE = 240;
+
+        static GpuProfiler &Get()
+        {
+            return *m_instance;
+        }
+
+        // Returns false if the device can not write or reset timestamps
+        static bool IsAvailable()
+        {
+            return m_instance != nullptr;
+        }
+
+        static void Init();
+        static void Shutdown();
+
+        // Collects the results of the frame slot and recycles its queries, requires the slots fence to be signaled
+        void BeginFrame(uint32_t Frame);
+        // Collects the results of every frame slot oldest first, e.g. at the end of a capture. Requires an idle device.
+        void CollectInFlight();
+
+        // Scopes nest per command buffer. Returns INVALID_GPU_SCOPE if the profiler is paused or out of queries.
+        [[nodiscard]] uint32_t BeginScope(vk::CommandBuffer CommandBuffer,
+                                          std::string_view Name,
+                                          vk::PipelineStageFlagBits Stage = vk::PipelineStageFlagBits::eTopOfPipe);
+        void EndScope(vk::CommandBuffer CommandBuffer,
+                      uint32_t Scope,
+                      vk::PipelineStageFlagBits Stage = vk::PipelineStageFlagBits::eBottomOfPipe);
+
+        // Most recent frame whose results have been read back, nullptr if there is none yet
+        [[nodiscard]] const GpuFrameTimings *GetLatestTimings() const
+        {
+            return m_history.empty() ? nullptr : &m_history.back();
+        }
+
+        [[nodiscard]] const std::deque<GpuFrameTimings> &GetHistory() const
+        {
+            return m_history;
+        }
+
+        // Chrome trace event format, can be opened in chrome://tracing or Perfetto
+        bool ExportChromeTrace(const std::filesystem::path &FilePath) const;
+        bool ExportCsv(const std::filesystem::path &FilePath) const;
+
+     private:
+        GpuProfiler();
+        ~GpuProfiler();
+
+        void CollectResults(FrameQueries &Queries);
+        // Collects and resets the queries of the slot if it has any
+        void Recycle(FrameQueries &Queries);
+
+     public:
+        // New scopes are ignored while paused, the history stays as is
+        bool paused = false;
+
+     private:
+        static inline GpuProfiler *m_instance = nullptr;
+
+        std::array<FrameQueries, MAX_FRAMES_IN_FLIGHT> m_frames;
+        uint32_t m_currentFrame = 0;
+
+        // Open scopes of every command buffer recorded this frame, used to build the hierarchy
+        std::unordered_map<VkCommandBuffer, std::vector<uint32_t>> m_openScopes;
+
+        double m_timestampPeriodNs = 1.0;
+        uint64_t m_timestampMask = std::numeric_limits<uint64_t>::max();
+
+        std::deque<GpuFrameTimings> m_history;
+    };
+
+    class GpuProfileScope
+    {
+     public:
+        GpuProfileScope(vk::CommandBuffer CommandBuffer, std::string_view Name);
+        ~GpuProfileScope();
+
+        GpuProfileScope(const GpuProfileScope &) = delete;
+        GpuProfileScope &operator=(const GpuProfileScope &) = delete;
+
+     private:
+        vk::CommandBuffer m_commandBuffer;
+        uint32_t m_scope = INVALID_GPU_SCOPE;
+    };
+}  // namespace Slipper::GPU::Vulkan
+
+#define GPU_PROFILE_SCOPE(CommandBuffer, Name) \
+    const ::Slipper::GPU::Vulkan::GpuProfileScope CONCAT(gpu_profile_scope_, __LINE__)(CommandBuffer, Name)
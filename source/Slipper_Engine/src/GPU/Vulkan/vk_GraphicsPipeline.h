@@ -6,6 +6,17 @@ namespace Slipper::GPU::Vulkan
 {
     class VKDevice;
     class Surface;
+    class CommandContext;
+
+    enum class PipelineVariant
+    {
+        // Depth test less with depth writes
+        Default,
+        // Vertex stage only, for the depth pre-pass subpass
+        DepthOnly,
+        // Depth test equal without depth writes, for the main subpass after a depth pre-pass
+        DepthEqual,
+    };
 
     class GraphicsPipeline
     {
@@ -13,19 +24,31 @@ namespace Slipper::GPU::Vulkan
         GraphicsPipeline() = delete;
         GraphicsPipeline(const std::vector<VkPipelineShaderStageCreateInfo> &ShaderStages,
                          NonOwningPtr<const RenderPass> RenderPass,
-                         const std::vector<VkDescriptorSetLayout> &DescriptorSetLayouts);
+                         const std::vector<VkDescriptorSetLayout> &DescriptorSetLayouts,
+                         const std::vector<vk::PushConstantRange> &PushConstantRanges = {});
         ~GraphicsPipeline();
 
         void Bind(const VkCommandBuffer &CommandBuffer, VkExtent2D Extent) const;
+        // Same as above but skips the pipeline bind and dynamic state if they are already set
+        void Bind(CommandContext &Context, VkExtent2D Extent, PipelineVariant Variant = PipelineVariant::Default) const;
+
+        // The depth variants only exist for render passes with a depth pre-pass
+        [[nodiscard]] VkPipeline GetVkPipeline(PipelineVariant Variant) const;
+
+        // Picks up changes of the render pass, e.g. its sample count. The layout is kept.
+        void Recreate();
 
      private:
         void Create();
+        [[nodiscard]] VkPipeline CreateVariant(PipelineVariant Variant) const;
 
      public:
         VKDevice &device;
 
         VkPipelineLayout vkPipelineLayout;
         VkPipeline vkGraphicsPipeline;
+        VkPipeline vkDepthOnlyPipeline = VK_NULL_HANDLE;
+        VkPipeline vkDepthEqualPipeline = VK_NULL_HANDLE;
 
      private:
         NonOwningPtr<const RenderPass> m_renderPass;
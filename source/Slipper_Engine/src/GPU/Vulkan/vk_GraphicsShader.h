@@ -1,10 +1,11 @@
 #pragma once
 
+#include "vk_GraphicsPipeline.h"
 #include "vk_Shader.h"
 
 namespace Slipper::GPU::Vulkan
 {
-    class GraphicsPipeline;
+    class CommandContext;
     class RenderPass;
     enum class ShaderType;
 
@@ -22,20 +23,62 @@ namespace Slipper::GPU::Vulkan
         void Use(const vk::CommandBuffer &CommandBuffer,
                  NonOwningPtr<const RenderPass> RenderPass,
                  VkExtent2D Extent) const;
+        // Binds through the context so state that is already bound (e.g. by the previous draw) is skipped
+        void Use(CommandContext &Context,
+                 NonOwningPtr<const RenderPass> RenderPass,
+                 VkExtent2D Extent,
+                 PipelineVariant Variant = PipelineVariant::Default) const;
 
         GraphicsPipeline &RegisterRenderPass(NonOwningPtr<const RenderPass> RenderPass);
+        // Recreates the pipeline of the render pass if the shader is registered for it
+        void RecreatePipeline(NonOwningPtr<const RenderPass> RenderPass);
+
+        [[nodiscard]] const GraphicsPipeline &GetPipeline(NonOwningPtr<const RenderPass> RenderPass) const;
+
+        // Resolved on creation, so draws can check for the 'draw' push block without looking it up by name
+        [[nodiscard]] bool HasDrawPushConstants() const
+        {
+            return m_hasDrawPushConstants;
+        }
+
+        // Pushes Data with the pipeline layout of the given render pass, see Shader::PushConstants
+        template<typename T>
+            requires std::is_trivially_copyable_v<T>
+        void Push(const vk::CommandBuffer CommandBuffer,
+                  const NonOwningPtr<const RenderPass> RenderPass,
+                  const T &Data,
+                  const uint32_t Offset = 0) const
+        {
+            PushConstants(CommandBuffer, GetPipelineLayout(RenderPass), Data, Offset);
+        }
+
+        template<typename T>
+            requires std::is_trivially_copyable_v<T>
+        void Push(CommandContext &Context,
+                  const NonOwningPtr<const RenderPass> RenderPass,
+                  const T &Data,
+                  const uint32_t Offset = 0) const
+        {
+            PushConstants(Context, GetPipelineLayout(RenderPass), Data, Offset);
+        }
 
      private:
+        [[nodiscard]] vk::PipelineLayout GetPipelineLayout(NonOwningPtr<const RenderPass> RenderPass) const;
+
         GraphicsShader() = delete;
         GraphicsShader(const std::vector<std::tuple<std::string_view, ShaderType>> &ShaderStages,
                        std::optional<std::vector<NonOwningPtr<RenderPass>>> RenderPasses = {});
+        // Creates the shader from code that was read beforehand, see ShaderManager::LoadGraphicsShaderAsync
+        explicit GraphicsShader(ShaderCode &&Code,
+                                std::optional<std::vector<NonOwningPtr<RenderPass>>> RenderPasses = {});
 
-        void LoadShader(const std::vector<std::tuple<std::string_view, ShaderType>> &Shaders);
+        void LoadShader(ShaderCode &&Code);
         GraphicsPipeline &CreateGraphicsPipeline(NonOwningPtr<const RenderPass> RenderPass,
                                                  const std::vector<VkDescriptorSetLayout> &DescriptorSetLayouts);
 
      private:
         std::unordered_map<ShaderType, ShaderStage> m_shaderStages;
         std::unordered_map<NonOwningPtr<const RenderPass>, OwningPtr<GraphicsPipeline>> m_graphicsPipelines;
+        bool m_hasDrawPushConstants = false;
     };
 }  // namespace Slipper::GPU::Vulkan
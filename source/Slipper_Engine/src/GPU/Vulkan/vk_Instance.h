@@ -29,7 +29,8 @@ namespace Slipper::GPU::Vulkan
     class VulkanInstance
     {
      public:
-        VulkanInstance();
+        // Headless instances do not request the surface extensions and work without glfw being initialized
+        explicit VulkanInstance(bool Headless = false);
 
         ~VulkanInstance()
         {
@@ -60,7 +61,7 @@ namespace Slipper::GPU::Vulkan
             return instance;
         }
 
-        static std::vector<const char *> GetRequiredExtensions();
+        static std::vector<const char *> GetRequiredExtensions(bool Headless);
 
      private:
         static bool CheckValidationLayerSupport(std::vector<char const *> const &Layers,
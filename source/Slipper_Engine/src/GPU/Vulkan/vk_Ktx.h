@@ -0,0 +1,27 @@
+#pragma once
+
+namespace Slipper::GPU::Vulkan
+{
+    // Texture loaded from a KTX2 container with the mip chain that was built offline
+    struct KtxImage
+    {
+        vk::Format format = vk::Format::eUndefined;
+        vk::Extent3D extent = {0, 0, 1};
+        // Tightly packed pixels or blocks of every level, level 0 is the full size image
+        std::vector<std::vector<uint8_t>> levels;
+        std::string filepath;
+
+        [[nodiscard]] vk::Extent3D GetLevelExtent(uint32_t Level) const;
+    };
+
+    /* Reads a 2D texture in any format GetFormatBlockInfo knows. Supercompressed files, basis universal files that
+     * still have to be transcoded, arrays, cube maps and 3D textures are not supported. */
+    [[nodiscard]] KtxImage LoadKtx2(std::string_view Filepath);
+    /* Writes R8G8B8A8 images with all their levels, which is what the texture cache cooks. The file is replaced
+     * atomically, so concurrent readers see either the old or the new file. */
+    void SaveKtx2(const KtxImage &Image, std::string_view Filepath);
+
+    /* Decodes the levels into an uncompressed format if the device can not sample the format of the image.
+     * Throws if there is no cpu decoder for the format either, which is the case for ASTC. */
+    void TranscodeIfUnsupported(KtxImage &Image);
+}  // namespace Slipper::GPU::Vulkan
@@ -1,5 +1,10 @@
 #pragma once
 
+#include "AssetCache.h"
+#include "vk_DescriptorAllocator.h"
+#include "vk_GraphicsPipeline.h"
+#include "vk_ShaderLayout.h"
+
 namespace Slipper
 {
     class MaterialManager;
@@ -11,12 +16,36 @@ namespace Slipper::GPU::Vulkan
     class RenderPass;
     class GraphicsShader;
     class IShaderBindableData;
+    class Texture;
+    class CommandContext;
     struct DescriptorSetLayoutBinding;
 
+    // A binding of a material descriptor set, either data the material bound or the shaders own uniform buffer
+    struct MaterialSetBinding
+    {
+        uint32_t binding;
+        NonOwningPtr<IShaderBindableData> data;
+        // Used if data is null, the buffer of the current frame gets bound
+        BindingHandle buffer;
+    };
+
+    /* Descriptor set whose bindings are all known to the material. It is fetched from the DescriptorAllocator frame
+     * set cache for every draw, so materials sharing a shader no longer overwrite each others uniforms. */
+    struct MaterialDescriptorSet
+    {
+        uint32_t setNumber;
+        vk::DescriptorSetLayout layout;
+        std::vector<MaterialSetBinding> bindings;
+    };
+
     struct MaterialUniform
     {
         Ref<DescriptorSetLayoutBinding> shaderBinding;
         NonOwningPtr<IShaderBindableData> data;
+        // Keeps bound textures of the managers loaded, invalid for other data
+        AssetHandle<Texture> asset;
+        // One bit per frame slot whose descriptor set still has to be updated, see MaterialManager
+        uint8_t dirtyFrames = 0;
     };
 
     class Material
@@ -25,22 +54,75 @@ namespace Slipper::GPU::Vulkan
 
      public:
         Material(NonOwningPtr<GraphicsShader> Shader);
+        ~Material();
 
         bool SetUniform(const std::string &Name, IShaderBindableData &Uniform);
 
+        /* Stores the texture in the given slot, draws pass its BindlessHeap index. Unlike SetUniform this does not
+         * touch any descriptor set, the shader reads the texture through the global bindless set. */
+        bool SetTexture(uint32_t Slot, Texture &Texture);
+
+        /* Writes a constant into the materials block of the MaterialParameterBuffer. Offset is in bytes and has to
+         * match the layout the shader reads the block with. Only the changed block gets uploaded. */
+        template<typename T>
+            requires std::is_trivially_copyable_v<T>
+        void SetParameter(const uint32_t Offset, const T &Value)
+        {
+            SetParameterData(Offset, &Value, sizeof(T));
+        }
+
+        [[nodiscard]] uint32_t GetParameterBlock() const
+        {
+            return parameterBlock;
+        }
+
+        // BindlessHeap index of the texture in the slot or INVALID_BINDLESS_INDEX if the slot is empty
+        [[nodiscard]] uint32_t GetTextureIndex(uint32_t Slot) const;
+
+        [[nodiscard]] const std::vector<NonOwningPtr<Texture>> &GetTextures() const
+        {
+            return textures;
+        }
+
         void Use(const VkCommandBuffer &CommandBuffer,
                  NonOwningPtr<const RenderPass> RenderPass,
                  VkExtent2D Extent) const;
+        void Use(CommandContext &Context,
+                 NonOwningPtr<const RenderPass> RenderPass,
+                 VkExtent2D Extent,
+                 PipelineVariant Variant = PipelineVariant::Default) const;
 
         [[nodiscard]] UniformBuffer *GetUniformBuffer(const std::string Name,
                                                       const std::optional<uint32_t> Index = {}) const;
+        [[nodiscard]] UniformBuffer *GetUniformBuffer(BindingHandle Handle, std::optional<uint32_t> Index = {}) const;
 
      private:
         void BindUniformForThisFrame(const MaterialUniform &Uniform) const;
+        // Collects the sets that contain uniforms of this material, has to run whenever a uniform is bound
+        void UpdateDescriptorSets();
+        void BindDescriptorSets(CommandContext &Context, vk::PipelineLayout PipelineLayout) const;
+        void SetParameterData(uint32_t Offset, const void *Data, uint32_t Size) const;
 
      public:
         NonOwningPtr<GraphicsShader> shader;
         // Uses string_view hash
         std::unordered_map<std::string, MaterialUniform> uniforms;
+        // Texture per bindless texture slot, the index is looked up per draw since streaming moves textures
+        std::vector<NonOwningPtr<Texture>> textures;
+        // Block inside the MaterialParameterBuffer
+        uint32_t parameterBlock;
+
+        // Resolved once on creation since they are written for every draw (invalid if the shader lacks them)
+        BindingHandle viewProjectionBinding;
+        BindingHandle modelBinding;
+
+     private:
+        // Keep the shader and the textures in the slots loaded for as long as the material exists
+        AssetHandle<GraphicsShader> m_shaderAsset;
+        std::vector<AssetHandle<Texture>> m_textureAssets;
+
+        std::vector<MaterialDescriptorSet> m_descriptorSets;
+        // Reused for every draw to avoid allocating while assembling the resources of a set
+        mutable std::vector<DescriptorResource> m_setResources;
     };
 }  // namespace Slipper::GPU::Vulkan
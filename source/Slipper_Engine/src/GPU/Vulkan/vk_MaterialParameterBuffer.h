@@ -0,0 +1,94 @@
+#pragma once
+
+#include "vk_DeviceDependentObject.h"
+#include "vk_Settings.h"
+
+namespace Slipper::GPU::Vulkan
+{
+    class Buffer;
+
+    // Every material owns one fixed size block of constants (see Shaders/Include/MaterialParameters.glsl)
+    inline constexpr uint32_t MATERIAL_PARAMETER_BLOCK_SIZE = 256;
+    inline constexpr uint32_t MAX_MATERIAL_PARAMETER_BLOCKS = 4096;
+    inline constexpr uint32_t INVALID_MATERIAL_PARAMETER_BLOCK = std::numeric_limits<uint32_t>::max();
+
+    struct MaterialParameterStats
+    {
+        uint32_t blocksInUse = 0;
+        // Of the last flush
+        uint32_t flushedBlocks = 0;
+        uint32_t flushedRanges = 0;
+        uint64_t flushedBytes = 0;
+    };
+
+    /* All material constants live in a single storage buffer with one copy per frame in flight.
+     * Writes go to a cpu side shadow copy and mark the block dirty for every frame slot. Flushing a frame slot
+     * only copies the blocks that are still dirty for it, so the cost scales with the number of changes
+     * and not with the number of materials. */
+    class MaterialParameterBuffer : DeviceDependentObject
+    {
+     public:
+        static MaterialParameterBuffer &Get()
+        {
+            return *m_instance;
+        }
+
+        static bool IsAvailable()
+        {
+            return m_instance != nullptr;
+        }
+
+        static void Init();
+        static void Shutdown();
+
+        [[nodiscard]] uint32_t AllocateBlock();
+        void FreeBlock(uint32_t Block);
+
+        void Write(uint32_t Block, uint32_t Offset, const void *Data, uint32_t Size);
+
+        // Copies all blocks that are dirty for the frame slot into its buffer, call before the frame is submitted
+        void Flush(uint32_t Frame);
+
+        [[nodiscard]] const Buffer &GetBuffer(uint32_t Frame) const
+        {
+            return *m_frameBuffers[Frame];
+        }
+
+        // Index of the frames buffer inside the BindlessHeap or INVALID_BINDLESS_INDEX
+        [[nodiscard]] uint32_t GetBindlessIndex(uint32_t Frame) const
+        {
+            return m_bindlessIndices[Frame];
+        }
+
+        [[nodiscard]] const MaterialParameterStats &GetStats() const
+        {
+            return m_stats;
+        }
+
+     private:
+        MaterialParameterBuffer();
+        ~MaterialParameterBuffer();
+
+        void MarkDirty(uint32_t Block);
+
+     private:
+        static inline MaterialParameterBuffer *m_instance = nullptr;
+        static constexpr uint8_t ALL_FRAMES_DIRTY = (1u << MAX_FRAMES_IN_FLIGHT) - 1;
+        static_assert(MAX_FRAMES_IN_FLIGHT <= 8, "Dirty frame bits have to fit into a byte");
+
+        std::array<OwningPtr<Buffer>, MAX_FRAMES_IN_FLIGHT> m_frameBuffers;
+        std::array<void *, MAX_FRAMES_IN_FLIGHT> m_mappedFrameBuffers = {};
+        std::array<uint32_t, MAX_FRAMES_IN_FLIGHT> m_bindlessIndices = {};
+
+        std::vector<std::byte> m_shadow;
+        // One bit per frame slot that still has to receive the blocks current data
+        std::vector<uint8_t> m_dirtyFrames;
+        // Blocks with any dirty bit set, each block is contained at most once
+        std::vector<uint32_t> m_dirtyBlocks;
+
+        uint32_t m_nextBlock = 0;
+        std::vector<uint32_t> m_freeBlocks;
+
+        MaterialParameterStats m_stats;
+    };
+}  // namespace Slipper::GPU::Vulkan
@@ -0,0 +1,34 @@
+#pragma once
+
+namespace Slipper::GPU::Vulkan
+{
+    enum class MipFilter : uint8_t
+    {
+        // 2x2 average, cheap but blurs more and aliases fine detail
+        Box,
+        // Kaiser windowed sinc over 6x6 texels, keeps more detail than the box at the cost of slight ringing
+        Kaiser,
+    };
+
+    struct MipGeneratorSettings
+    {
+        MipFilter filter = MipFilter::Kaiser;
+        // Color channels are filtered in linear space and stored as srgb again, alpha is always linear
+        bool srgb = true;
+        /* Scales the alpha of every mip so the same fraction of texels passes the alpha test as on the base level,
+         * alpha tested foliage and fences would thin out in the distance otherwise. Only images whose alpha is
+         * almost entirely 0 or 1 are treated as alpha tested, blended alpha keeps its plain average. */
+        bool preserveAlphaCoverage = true;
+        float alphaTestReference = 0.5f;
+    };
+
+    [[nodiscard]] float SrgbToLinear(uint8_t Value);
+    [[nodiscard]] uint8_t LinearToSrgb(float Value);
+
+    /* Builds the full mip chain of an RGBA8 image on the cpu down to 1x1, level 0 is a copy of the image.
+     * Filtering runs on linear floats with SSE2 where available, each level is filtered from the unquantized
+     * level above it. */
+    [[nodiscard]] std::vector<std::vector<uint8_t>> GenerateMips(const uint8_t *Pixels,
+                                                                 vk::Extent3D Extent,
+                                                                 const MipGeneratorSettings &Settings);
+}  // namespace Slipper::GPU::Vulkan
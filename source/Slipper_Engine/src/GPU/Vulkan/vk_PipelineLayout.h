@@ -13,7 +13,9 @@ class PipelineLayout
 {
  public:
     static VkPipelineLayout CreatePipelineLayout(
-        const VKDevice &Device, const std::vector<VkDescriptorSetLayout> &DescriptorSetLayouts);
+        const VKDevice &Device,
+        const std::vector<VkDescriptorSetLayout> &DescriptorSetLayouts,
+        const std::vector<vk::PushConstantRange> &PushConstantRanges = {});
 
     static VkPipelineVertexInputStateCreateInfo SetupVertexInputState();
 
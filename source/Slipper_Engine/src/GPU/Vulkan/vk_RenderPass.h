@@ -6,6 +6,8 @@ namespace Slipper::GPU::Vulkan
 {
     class SwapChain;
 
+    /* Without a RenderingFormat the render pass only has a single sample depth attachment that is loaded and stored,
+     * e.g. for rendering into parts of a shadow atlas. Those are begun on a framebuffer of the caller. */
     class RenderPass : DeviceDependentObject
     {
      public:
@@ -13,12 +15,30 @@ namespace Slipper::GPU::Vulkan
         RenderPass(std::string_view Name,
                    vk::Format RenderingFormat,
                    vk::Format DepthFormat,
-                   bool ForPresentation = true);
+                   bool ForPresentation = true,
+                   bool DepthPrePass = false);
         ~RenderPass();
 
+        // Recreates the vulkan render pass, pipelines and framebuffers created for it have to be recreated too
+        void SetSampleCount(vk::SampleCountFlagBits SampleCount);
+
         void BeginRenderPass(SwapChain *SwapChain, uint32_t ImageIndex, VkCommandBuffer CommandBuffer);
+        void BeginRenderPass(vk::Framebuffer Framebuffer, vk::Extent2D Extent, VkCommandBuffer CommandBuffer);
+        // Moves from the depth pre-pass to the main subpass
+        void NextSubpass(VkCommandBuffer CommandBuffer) const;
         void EndRenderPass(VkCommandBuffer commandBuffer);
 
+        // Subpass the regular pipelines are created for, the depth pre-pass is always subpass 0
+        [[nodiscard]] uint32_t GetMainSubpass() const
+        {
+            return hasDepthPrePass ? 1 : 0;
+        }
+
+        [[nodiscard]] bool IsDepthOnly() const
+        {
+            return renderingFormat == vk::Format::eUndefined;
+        }
+
         [[nodiscard]] SwapChain *GetActiveSwapChain() const
         {
             return m_activeSwapChain;
@@ -34,10 +54,21 @@ namespace Slipper::GPU::Vulkan
             return vkRenderPass;
         }
 
+     private:
+        void Create();
+        void CreateDepthOnly();
+
      public:
         std::string name;
         VkRenderPass vkRenderPass;
 
+        vk::Format renderingFormat;
+        vk::Format depthFormat;
+        bool forPresentation;
+        // Adds a depth only subpass in front of the main one, see VKRenderingStage::SetDepthPrePass
+        bool hasDepthPrePass;
+        vk::SampleCountFlagBits sampleCount;
+
         std::unordered_set<NonOwningPtr<RenderingStage>> registeredRenderingStages;
 
      private:
@@ -7,9 +7,9 @@ namespace Slipper::GPU::Vulkan
 class RenderTarget : public Texture
 {
 public:
-    // MSAA Settings set in Engine::Settings::MSAA_SAMPLES
     RenderTarget(
             VkExtent2D Extent,
-            vk::Format Format);
+            vk::Format Format,
+            vk::SampleCountFlagBits NumSamples);
 };
 }
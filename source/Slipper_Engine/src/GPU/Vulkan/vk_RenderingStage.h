@@ -1,9 +1,26 @@
 #pragma once
 #include "RenderingStage.h"
+#include "vk_CommandContext.h"
 #include "vk_DeviceDependentObject.h"
+#include "vk_GpuProfiler.h"
 
 namespace Slipper::GPU::Vulkan
 {
+    enum class PipelineVariant;
+
+    // Fragment shader invocations of the main subpasses against the pixels they cover
+    struct OverdrawStats
+    {
+        uint64_t fragmentInvocations = 0;
+        uint64_t pixels = 0;
+
+        // 1 means every pixel got shaded exactly once
+        [[nodiscard]] double Overdraw() const
+        {
+            return pixels ? static_cast<double>(fragmentInvocations) / static_cast<double>(pixels) : 0.0;
+        }
+    };
+
     class VKRenderingStage : public RenderingStage, public DeviceDependentObject
     {
      public:
@@ -16,7 +33,7 @@ namespace Slipper::GPU::Vulkan
         VKRenderingStage(std::string Name, NonOwningPtr<VKSwapChain> SwapChain, bool NativeSwapChain);
         ~VKRenderingStage();
 
-        void BeginRender() const;
+        void BeginRender();
         void EndRender();
 
         void SubmitSingleComputeCommand(const VKRenderPass *RP, std::function<void(const VkCommandBuffer &)> Command);
@@ -69,6 +86,31 @@ namespace Slipper::GPU::Vulkan
             return m_nativeSwapChain;
         }
 
+        // Bind statistics of the last recorded frame
+        const CommandContextStats &GetCommandStats() const
+        {
+            return m_lastCommandStats;
+        }
+
+        /* Lays down depth for all queued draws in the depth only subpass of render passes created with one, sorted
+         * front to back. The main subpass then tests for equal depth without writing it, so every pixel is shaded
+         * once no matter the submission order. Can be toggled at any time, see GetOverdrawStats to decide. */
+        void SetDepthPrePass(const bool Enabled)
+        {
+            m_depthPrePass = Enabled;
+        }
+
+        [[nodiscard]] bool IsDepthPrePassEnabled() const
+        {
+            return m_depthPrePass;
+        }
+
+        // Statistics of the latest frame whose results are available, empty without pipeline statistics support
+        [[nodiscard]] const OverdrawStats &GetOverdrawStats() const
+        {
+            return m_overdrawStats;
+        }
+
      public:
         std::string name;
         NonOwningPtr<VkSwapChain> swapChain;
@@ -80,6 +122,17 @@ namespace Slipper::GPU::Vulkan
             singleGraphicsCommands;
         std::unordered_map<NonOwningPtr<const VKRenderPass>, std::vector<std::function<void(const VkCommandBuffer &)>>>
             repeatedGraphicsCommands;
+        struct QueuedDraw
+        {
+            NonOwningPtr<const VKMaterial> material;
+            NonOwningPtr<const VKModel> model;
+            glm::mat4 transform;
+            // Distance along the view direction, only valid while sorting
+            float viewDepth;
+        };
+
+        // Draws submitted with SubmitDraw, sorted and recorded through the state tracking context in EndRender
+        std::unordered_map<NonOwningPtr<const VKRenderPass>, std::vector<QueuedDraw>> queuedDraws;
 
         // Compute Commands
         OwningPtr<VKCommandPool> computeCommandPool;
@@ -89,8 +142,31 @@ namespace Slipper::GPU::Vulkan
             repeatedComputeCommands;
 
      private:
+        void RecordDraws(NonOwningPtr<const VKRenderPass> RenderPass,
+                         const std::vector<QueuedDraw> &Draws,
+                         PipelineVariant Variant);
+        void CollectOverdrawStats(uint32_t Frame);
+
+     private:
+        static constexpr uint32_t MAX_OVERDRAW_QUERIES = 4;
+
         bool m_nativeSwapChain;
+        bool m_depthPrePass = false;
+
+        CommandContext m_drawContext;
+        CommandContextStats m_lastCommandStats;
+
+        // Open GpuProfiler scopes between BeginRender and EndRender
+        uint32_t m_stageProfileScope = INVALID_GPU_SCOPE;
+        uint32_t m_computeProfileScope = INVALID_GPU_SCOPE;
+        std::unordered_map<NonOwningPtr<const VKRenderPass>, uint32_t> m_renderPassProfileScopes;
 
         std::vector<vk::Semaphore> m_computeFinishedSemaphores;
+
+        // MAX_OVERDRAW_QUERIES pipeline statistics queries per frame slot, one per render pass
+        vk::QueryPool m_overdrawQueryPool;
+        std::array<uint32_t, MAX_FRAMES_IN_FLIGHT> m_usedOverdrawQueries{};
+        std::array<uint64_t, MAX_FRAMES_IN_FLIGHT> m_overdrawPixels{};
+        OverdrawStats m_overdrawStats;
     };
 }  // namespace Slipper::GPU
@@ -7,7 +7,8 @@ namespace Slipper::GPU::Vulkan
     {
      public:
         Sampler() = default;
-        Sampler(VkFilter Filter, VkSamplerAddressMode AddressMode, uint32_t MipLevels);
+        // Mips before MinLod are never sampled, e.g. while a streamed texture waits for their pixels
+        Sampler(VkFilter Filter, VkSamplerAddressMode AddressMode, uint32_t MipLevels, float MinLod = 0.0f);
         Sampler(const Sampler &Other) = delete;
         Sampler(Sampler &&Other) noexcept
         {
@@ -12,6 +12,8 @@ namespace Slipper
 
 namespace Slipper::GPU::Vulkan
 {
+    class CommandContext;
+
     extern const char *ShaderTypeNames[];
 
     // DO NOT CHANGE NUMBERS WITHOUT CHANGING SHADERTYPENAMES ARRAY!!!
@@ -23,6 +25,22 @@ namespace Slipper::GPU::Vulkan
         COMPUTE = 3
     };
 
+    // Spir-v of one stage as it was read from disk
+    struct ShaderStageCode
+    {
+        std::string filepath;
+        ShaderType type;
+        std::vector<char> code;
+    };
+
+    /* Everything a shader needs from its files. Reading and reflecting them touches no vulkan objects, so it can
+     * happen on a worker while the shader itself is created on the main thread. */
+    struct ShaderCode
+    {
+        std::vector<ShaderStageCode> stages;
+        std::unique_ptr<ShaderLayout> layout;
+    };
+
     struct ShaderUniformObject
     {
      protected:
@@ -54,6 +72,27 @@ namespace Slipper::GPU::Vulkan
         }
     };
 
+    // Names of the bindings the renderer fills for every draw, see Shader::GetBindingHandle
+    inline constexpr uint64_t VIEW_PROJECTION_BINDING = String::hash_name("vp");
+    inline constexpr uint64_t MODEL_BINDING = String::hash_name("m");
+
+    // Name of the push constant block the renderer fills for every draw
+    inline constexpr std::string_view DRAW_PUSH_CONSTANT_NAME = "draw";
+
+    /* Per draw data that is pushed instead of written to a uniform buffer.
+     * Has to match the "draw" push constant block in the shaders (see Shaders/Include/DrawPushConstants.glsl) */
+    struct DrawPushConstants
+    {
+        glm::mat4 model;
+        uint32_t textureIndex;
+        // Bindless index of the current frames MaterialParameterBuffer and the block of the drawn material
+        uint32_t materialBuffer;
+        uint32_t materialBlock;
+        // Bindless index of the clustered light buffer of the view, see ClusteredLighting
+        uint32_t lightBuffer;
+    };
+    static_assert(sizeof(DrawPushConstants) <= 128, "Vulkan only guarantees 128 bytes of push constants");
+
     enum class ShaderMemberType : uint32_t
     {
         UNDEFINED,
@@ -97,6 +136,8 @@ namespace Slipper::GPU::Vulkan
 
         virtual ~Shader();
 
+        [[nodiscard]] static ShaderCode ReadCode(std::span<const std::tuple<std::string_view, ShaderType>> Stages);
+
         std::optional<Ref<DescriptorSetLayoutBinding>> BindShaderUniform(const std::string_view Name,
                                                                          const IShaderBindableData &Object,
                                                                          std::optional<uint32_t> Index = {}) const
@@ -139,27 +180,94 @@ namespace Slipper::GPU::Vulkan
 
         [[nodiscard]] UniformBuffer *GetUniformBuffer(const std::string Name,
                                                       const std::optional<uint32_t> Index = {}) const;
+        // Lookup without any string handling, resolve the handle once with GetBindingHandle
+        [[nodiscard]] UniformBuffer *GetUniformBuffer(BindingHandle Handle,
+                                                      std::optional<uint32_t> Index = {}) const;
+
+        [[nodiscard]] BindingHandle GetBindingHandle(const std::string_view Name) const
+        {
+            return shaderLayout->FindBinding(Name);
+        }
+
+        // Use with a compile time hash, e.g. GetBindingHandle(VIEW_PROJECTION_BINDING)
+        [[nodiscard]] BindingHandle GetBindingHandle(const uint64_t NameHash) const
+        {
+            return shaderLayout->FindBinding(NameHash);
+        }
 
-        [[nodiscard]] std::vector<vk::DescriptorSet> GetDescriptorSets(std::optional<uint32_t> Index = {}) const;
+        // Sets of the given frame ordered by set number, ready to be bound starting at set 0
+        [[nodiscard]] const std::vector<vk::DescriptorSet> &GetDescriptorSets(std::optional<uint32_t> Index = {}) const;
+
+        [[nodiscard]] vk::DescriptorSetLayout GetDescriptorSetLayout(const uint32_t Set) const
+        {
+            return m_vkDescriptorSetLayouts.at(Set);
+        }
 
         [[nodiscard]] std::optional<Ref<DescriptorSetLayoutBinding>> GetNamedBinding(std::string_view Name) const
         {
-            auto lowered_name = String::to_lower(Name);
-            if (shaderLayout->namedLayoutBindings.contains(lowered_name))
+            if (const BindingHandle handle = GetBindingHandle(Name); handle.IsValid())
             {
-                return {*shaderLayout->namedLayoutBindings.at(String::to_lower(Name))};
+                return {shaderLayout->GetBinding(handle)};
             }
             return {};
         }
 
+        // Returns the reflected push constant block with the given name or nullptr if there is none
+        [[nodiscard]] const PushConstantRange *GetPushConstantRange(std::string_view Name) const;
+
+        [[nodiscard]] bool HasPushConstants() const
+        {
+            return !shaderLayout->pushConstantRanges.empty();
+        }
+
+        /* Pushes a small block of data (e.g. a transform or a material index). The stage flags are derived from the
+         * reflected ranges so the data only has to match the layout in the shader. */
+        template<typename T>
+            requires std::is_trivially_copyable_v<T>
+        void PushConstants(const vk::CommandBuffer CommandBuffer,
+                           const vk::PipelineLayout PipelineLayout,
+                           const T &Data,
+                           const uint32_t Offset = 0) const
+        {
+            PushConstantData(CommandBuffer, PipelineLayout, &Data, sizeof(T), Offset);
+        }
+
+        template<typename T>
+            requires std::is_trivially_copyable_v<T>
+        void PushConstants(CommandContext &Context,
+                           const vk::PipelineLayout PipelineLayout,
+                           const T &Data,
+                           const uint32_t Offset = 0) const
+        {
+            PushConstantData(Context, PipelineLayout, &Data, sizeof(T), Offset);
+        }
+
+        // True if the shader declares the global bindless set (BINDLESS_DESCRIPTOR_SET)
+        [[nodiscard]] bool UsesBindlessHeap() const
+        {
+            return m_usesBindlessHeap;
+        }
+
      protected:
-        void CreateDescriptorPool();
         void CreateDescriptorSetLayouts();
         void AllocateDescriptorSets();
 
         void BindShaderUniform_Interface(const DescriptorSetLayoutBindingMinimal &Binding,
                                          const IShaderBindableData &Object,
                                          std::optional<uint32_t> Index = {}) const;
+        void PushConstantData(vk::CommandBuffer CommandBuffer,
+                              vk::PipelineLayout PipelineLayout,
+                              const void *Data,
+                              uint32_t Size,
+                              uint32_t Offset) const;
+        void PushConstantData(CommandContext &Context,
+                              vk::PipelineLayout PipelineLayout,
+                              const void *Data,
+                              uint32_t Size,
+                              uint32_t Offset) const;
+        // Union of the stages whose reflected ranges overlap [Offset, Offset + Size)
+        [[nodiscard]] vk::ShaderStageFlags GetPushConstantStageFlags(uint32_t Offset, uint32_t Size) const;
+
         void UpdateDescriptorSets(vk::WriteDescriptorSet DescriptorWrite,
                                   const DescriptorSetLayoutBindingMinimal &Binding,
                                   std::optional<uint32_t> Index) const;
@@ -173,13 +281,17 @@ namespace Slipper::GPU::Vulkan
      public:
         std::string name;
         OwningPtr<ShaderLayout> shaderLayout;
-        std::map<DescriptorSetLayoutBinding::HashT, std::vector<OwningPtr<UniformBuffer>>> uniformBindingBuffers;
+        // One buffer per frame for every uniform buffer binding, indexed by BindingHandle::index
+        std::vector<std::vector<OwningPtr<UniformBuffer>>> uniformBindingBuffers;
 
      protected:
-        vk::DescriptorPool m_vkDescriptorPool = VK_NULL_HANDLE;
-        std::map<uint32_t, std::vector<vk::DescriptorSet>> m_vkDescriptorSets;  // One set for every frame
+        // One set for every frame, allocated from the global DescriptorAllocator
+        std::map<uint32_t, std::vector<vk::DescriptorSet>> m_vkDescriptorSets;
+        // The same sets transposed to one list per frame so binding does not have to assemble them every draw
+        std::vector<std::vector<vk::DescriptorSet>> m_frameDescriptorSets;
 
         std::map<uint32_t, vk::DescriptorSetLayout> m_vkDescriptorSetLayouts;  // One layout for set
+        bool m_usesBindlessHeap = false;
     };
 
     // extern template void Shader::BindShaderUniform(const std::string Name, const UniformBuffer
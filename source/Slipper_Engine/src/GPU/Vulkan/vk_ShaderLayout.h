@@ -162,20 +162,91 @@ namespace Slipper::GPU::Vulkan
         }
     };
 
+    /* Index of a binding inside a ShaderLayout. Resolve it once (e.g. when setting up a material) and use it
+     * for per frame lookups instead of the binding name. */
+    struct BindingHandle
+    {
+        static constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+        uint32_t index = INVALID_INDEX;
+
+        [[nodiscard]] bool IsValid() const
+        {
+            return index != INVALID_INDEX;
+        }
+
+        bool operator==(const BindingHandle &Other) const = default;
+    };
+
+    struct PushConstantRange
+    {
+        std::string name;
+        uint32_t offset;  // Measured in bytes
+        uint32_t size;  // Measured in bytes
+        vk::ShaderStageFlags stageFlags;
+
+        [[nodiscard]] vk::PushConstantRange GetVkRange() const
+        {
+            return {stageFlags, offset, size};
+        }
+    };
+
     class ShaderLayout : DeviceDependentObject
     {
      public:
         explicit ShaderLayout(const std::vector<std::vector<char>> &BinaryCodes);
-        ShaderLayout(const ShaderLayout &Other) : setLayouts(Other.setLayouts)
+        ShaderLayout(const ShaderLayout &Other)
+            : setLayouts(Other.setLayouts), pushConstantRanges(Other.pushConstantRanges)
         {
             PopulateNamesLayoutBindings();
         }
 
+        /* Name is matched case insensitive, see String::hash_name. Names of one layout are checked for hash
+         * collisions on creation, so a hash only lookup can not return the binding of another name. */
+        [[nodiscard]] BindingHandle FindBinding(uint64_t NameHash) const
+        {
+            if (const auto handle = bindingHandles.find(NameHash); handle != bindingHandles.end())
+            {
+                return handle->second;
+            }
+            return {};
+        }
+
+        [[nodiscard]] BindingHandle FindBinding(const std::string_view Name) const
+        {
+            // A name outside the layout can still share the hash of one inside it
+            const BindingHandle handle = FindBinding(String::hash_name(Name));
+            if (handle.IsValid() && String::equals_name(bindings[handle.index]->name, Name))
+            {
+                return handle;
+            }
+            return {};
+        }
+
+        [[nodiscard]] DescriptorSetLayoutBinding &GetBinding(const BindingHandle Handle) const
+        {
+            return *bindings[Handle.index];
+        }
+
+        [[nodiscard]] std::vector<vk::PushConstantRange> GetVkPushConstantRanges() const
+        {
+            std::vector<vk::PushConstantRange> ranges;
+            ranges.reserve(pushConstantRanges.size());
+            for (const auto &range : pushConstantRanges)
+            {
+                ranges.push_back(range.GetVkRange());
+            }
+            return ranges;
+        }
+
      private:
         void PopulateNamesLayoutBindings();
 
      public:
         std::vector<DescriptorSetLayoutData> setLayouts;
-        std::unordered_map<std::string, DescriptorSetLayoutBinding *> namedLayoutBindings;
+        std::vector<PushConstantRange> pushConstantRanges;
+        // All bindings of all sets, a BindingHandle indexes into this
+        std::vector<DescriptorSetLayoutBinding *> bindings;
+        std::unordered_map<uint64_t, BindingHandle> bindingHandles;
     };
 }  // namespace Slipper
@@ -0,0 +1,236 @@
+#pragma once
+
+#include "AssetCache.h"
+#include "vk_DeviceDependentObject.h"
+#include "vk_Settings.h"
+
+namespace Slipper
+{
+    class Model;
+}
+
+namespace Slipper::GPU::Vulkan
+{
+    class Buffer;
+    class Framebuffer;
+    class GraphicsShader;
+    class RenderPass;
+    class Texture;
+    class VKRenderingStage;
+
+    inline constexpr uint32_t SHADOW_ATLAS_SIZE = 4096;
+    // Tile sizes of a single cube face, the allocator only hands out powers of two in between
+    inline constexpr uint32_t MIN_SHADOW_TILE_SIZE = 64;
+    inline constexpr uint32_t MAX_SHADOW_TILE_SIZE = 1024;
+    inline constexpr uint32_t MAX_SHADOWED_LIGHTS = 64;
+    // Point lights render one tile per cube face
+    inline constexpr uint32_t SHADOW_FACES = 6;
+    inline constexpr uint32_t INVALID_SHADOW = std::numeric_limits<uint32_t>::max();
+    // Must match SHADOW_HEADER_WORDS in Shaders/Include/Shadows.glsl
+    inline constexpr uint32_t SHADOW_HEADER_WORDS = 4;
+
+    // Start of every shadow buffer, followed by MAX_SHADOWED_LIGHTS GpuShadows
+    struct ShadowBufferHeader
+    {
+        // Bindless index of the atlas the lit shaders sample this frame
+        uint32_t atlas;
+        float texelSize;
+        uint32_t reserved[2];
+    };
+    static_assert(sizeof(ShadowBufferHeader) == SHADOW_HEADER_WORDS * sizeof(uint32_t));
+
+    struct GpuShadowFace
+    {
+        glm::mat4 viewProjection;
+        // Offset and scale of the faces tile in atlas uv space
+        glm::vec4 uvRect;
+    };
+
+    struct GpuShadow
+    {
+        // World space, a range of 0 marks a slot without shadow
+        glm::vec4 positionRange;
+        GpuShadowFace faces[SHADOW_FACES];
+    };
+
+    struct ShadowTile
+    {
+        uint32_t x = 0;
+        uint32_t y = 0;
+        uint32_t size = 0;
+    };
+
+    /* Quadtree allocator for square power of two tiles. Every level keeps a list of its free tiles, requests split
+     * the smallest free tile that fits and freed tiles merge back with their three buddies once they are free too. */
+    class ShadowAtlasAllocator
+    {
+     public:
+        ShadowAtlasAllocator(uint32_t AtlasSize, uint32_t MinTileSize);
+
+        // Size is rounded up to a power of two and clamped to the sizes the allocator supports
+        [[nodiscard]] std::optional<ShadowTile> Allocate(uint32_t Size);
+        void Free(ShadowTile Tile);
+
+        [[nodiscard]] uint64_t GetUsedTexels() const
+        {
+            return m_usedTexels;
+        }
+
+     private:
+        [[nodiscard]] uint32_t GetLevel(uint32_t Size) const;
+
+     private:
+        uint32_t m_atlasSize;
+        // Level 0 is the whole atlas, every level below halves the tile size
+        std::vector<std::vector<ShadowTile>> m_freeTiles;
+        uint64_t m_usedTexels = 0;
+    };
+
+    // Camera the tile sizes are picked for, resolved once per frame before the lights are submitted
+    struct ShadowViewer
+    {
+        glm::vec3 location = glm::vec3(0.0f);
+        // Vertical field of view in degrees
+        float fov = 90.0f;
+    };
+
+    struct ShadowAtlasStats
+    {
+        uint32_t shadowedLights = 0;
+        // Shadow casting lights that did not get a slot or tiles
+        uint32_t droppedLights = 0;
+        uint32_t staticCasters = 0;
+        uint32_t dynamicCasters = 0;
+        // Faces rendered during the last frame, static ones only when the cache was invalidated
+        uint32_t staticFaces = 0;
+        uint32_t dynamicFaces = 0;
+        uint32_t copiedFaces = 0;
+        uint64_t usedTexels = 0;
+    };
+
+    /* Point light shadows in a single depth atlas. Every shadow casting light gets six tiles, one per cube face,
+     * sized by how much of the screen the light covers. Static casters are rendered into a cache atlas that is only
+     * touched when a light moves or gets new tiles, or when a static caster moves through its range. Each frame the
+     * tiles are copied into the atlas of the frame slot and dynamic casters are rendered on top of them, lights
+     * without dynamic casters whose cache did not change skip even the copy.
+     * Lights and casters are gathered from the ECS, moves are detected through the version of their Transform. */
+    class ShadowAtlas : DeviceDependentObject
+    {
+        struct ShadowedLight
+        {
+            entt::entity entity = entt::null;
+            glm::vec3 location = {};
+            float range = 0.0f;
+            uint64_t transformVersion = 0;
+            bool submitted = false;
+
+            uint32_t tileSize = 0;
+            std::array<ShadowTile, SHADOW_FACES> tiles;
+            std::array<glm::mat4, SHADOW_FACES> viewProjections;
+
+            // Set when the static casters in the cached tiles have to be rendered again
+            bool staticDirty = true;
+            uint64_t cacheVersion = 0;
+            // Cache version copied into the atlas of each frame slot and whether dynamic casters were drawn over it
+            std::array<uint64_t, MAX_FRAMES_IN_FLIGHT> liveVersions = {};
+            std::array<bool, MAX_FRAMES_IN_FLIGHT> liveHasDynamic = {};
+            bool hasDynamic = false;
+        };
+
+        struct Caster
+        {
+            NonOwningPtr<const Model> model;
+            glm::mat4 transform;
+            // World space bounding sphere
+            glm::vec4 bounds;
+        };
+
+     public:
+        static ShadowAtlas &Get()
+        {
+            return *m_instance;
+        }
+
+        // Returns false if there is no BindlessHeap, lit shaders then render without shadows
+        static bool IsAvailable()
+        {
+            return m_instance != nullptr;
+        }
+
+        static void Init();
+        static void Shutdown();
+
+        // Drops the casters of the previous frame and frees the tiles of lights that were not submitted
+        void BeginFrame();
+
+        // Returns the shadow slot of the light or INVALID_SHADOW if the atlas is full
+        uint32_t SubmitLight(entt::entity Entity,
+                             glm::vec3 Location,
+                             float Range,
+                             uint64_t TransformVersion,
+                             const ShadowViewer &Viewer);
+        void SubmitCaster(NonOwningPtr<const Model> Model, const glm::mat4 &Transform, glm::vec4 Bounds, bool Static);
+        // Re-renders the cached tiles of all lights that reach the sphere, e.g. where a static caster was or is now
+        void InvalidateStatic(glm::vec4 Bounds);
+
+        // Updates the atlas of the frame slot, only the first call of each frame records anything
+        void Record(vk::CommandBuffer CommandBuffer, uint32_t Frame);
+
+        // Bindless index of the shadow buffer of the frame slot or INVALID_BINDLESS_INDEX if nothing was recorded
+        [[nodiscard]] uint32_t GetShadowBuffer(uint32_t Frame) const;
+
+        [[nodiscard]] const ShadowAtlasStats &GetStats() const
+        {
+            return m_stats;
+        }
+
+     private:
+        explicit ShadowAtlas(AssetHandle<GraphicsShader> DepthShader);
+        ~ShadowAtlas();
+
+        [[nodiscard]] static uint32_t GetDesiredTileSize(glm::vec3 Location, float Range, const ShadowViewer &Viewer);
+        bool AllocateTiles(ShadowedLight &Light, uint32_t TileSize);
+        void FreeTiles(ShadowedLight &Light);
+        static void UpdateViewProjections(ShadowedLight &Light);
+
+        void RenderFaces(vk::CommandBuffer CommandBuffer,
+                         const Framebuffer &Target,
+                         const std::vector<uint32_t> &Lights,
+                         const std::vector<Caster> &Casters,
+                         bool Clear);
+        void WriteShadowBuffer(uint32_t Frame);
+
+     private:
+        static inline ShadowAtlas *m_instance = nullptr;
+
+        AssetHandle<GraphicsShader> m_depthShader;
+        OwningPtr<RenderPass> m_renderPass;
+
+        // Static casters only, copied from into the atlas of the frame slot
+        OwningPtr<Texture> m_cacheAtlas;
+        OwningPtr<Framebuffer> m_cacheFramebuffer;
+        std::array<OwningPtr<Texture>, MAX_FRAMES_IN_FLIGHT> m_liveAtlases;
+        std::array<OwningPtr<Framebuffer>, MAX_FRAMES_IN_FLIGHT> m_liveFramebuffers;
+        std::array<uint32_t, MAX_FRAMES_IN_FLIGHT> m_liveAtlasIndices = {};
+
+        std::array<OwningPtr<Buffer>, MAX_FRAMES_IN_FLIGHT> m_shadowBuffers;
+        std::array<void *, MAX_FRAMES_IN_FLIGHT> m_mappedShadowBuffers = {};
+        std::array<uint32_t, MAX_FRAMES_IN_FLIGHT> m_shadowBufferIndices = {};
+        std::array<uint64_t, MAX_FRAMES_IN_FLIGHT> m_recordedFrames = {};
+
+        ShadowAtlasAllocator m_allocator;
+        std::array<ShadowedLight, MAX_SHADOWED_LIGHTS> m_lights;
+        std::unordered_map<entt::entity, uint32_t> m_lightSlots;
+
+        std::vector<Caster> m_staticCasters;
+        std::vector<Caster> m_dynamicCasters;
+        std::vector<glm::vec4> m_staticInvalidations;
+        // A static caster that disappears does not invalidate anything on its own
+        size_t m_lastStaticCasterCount = 0;
+        // Handed out whenever cached tiles are rendered, so a slot that changes lights never matches an old copy
+        uint64_t m_cacheVersion = 0;
+        uint32_t m_droppedLights = 0;
+
+        ShadowAtlasStats m_stats;
+    };
+}  // namespace Slipper::GPU::Vulkan
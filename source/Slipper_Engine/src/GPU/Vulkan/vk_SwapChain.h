@@ -34,6 +34,29 @@ namespace Slipper::GPU::Vulkan
             return resolution;
         }
 
+        // Part of the images that gets rendered to, smaller than the resolution while the render scale is below 1
+        [[nodiscard]] const vk::Extent2D &GetRenderResolution() const
+        {
+            return renderResolution;
+        }
+
+        [[nodiscard]] float GetRenderScale() const
+        {
+            return m_renderScale;
+        }
+
+        // Only shrinks the render area, the images keep their size so this never has to wait for the device
+        void SetRenderScale(float Scale);
+
+        [[nodiscard]] vk::SampleCountFlagBits GetSampleCount() const
+        {
+            return sampleCount;
+        }
+
+        // Recreates the multisampled attachments and all framebuffers, waits for the device to be idle.
+        // The render passes of the framebuffers have to use the same sample count.
+        void SetSampleCount(vk::SampleCountFlagBits SampleCount);
+
         [[nodiscard]] const vk::Format &GetImageFormat() const
         {
             return imageRenderingFormat;
@@ -95,8 +118,12 @@ namespace Slipper::GPU::Vulkan
         vk::ColorSpaceKHR imageColorSpace;
         vk::Format depthFormat;
         vk::Extent2D resolution;
+        vk::Extent2D renderResolution;
+        vk::SampleCountFlagBits sampleCount;
 
      private:
+        float m_renderScale = 1.0f;
+
         std::vector<vk::Image> m_vkImages;
         std::vector<vk::ImageView> m_vkImageViews;
         std::unordered_map<NonOwningPtr<RenderPass>, std::vector<vk::Framebuffer>> m_vkFramebuffers;
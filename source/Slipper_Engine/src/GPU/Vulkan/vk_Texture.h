@@ -1,4 +1,5 @@
 #pragma once
+#include "vk_BindlessHeap.h"
 #include "vk_CommandPool.h"
 #include "vk_DeviceDependentObject.h"
 #include "vk_IShaderBindableData.h"
@@ -31,6 +32,9 @@ struct ImageInfo
 
 class Texture : DeviceDependentObject, public IShaderBindableData
 {
+    // Recreates the image of streamed textures whenever their resident mips change
+    friend class TextureStreamer;
+
  public:
     Texture(vk::ImageType Type,
             vk::Extent3D Extent,
@@ -42,7 +46,9 @@ class Texture : DeviceDependentObject, public IShaderBindableData
             vk::ImageUsageFlags Usage = vk::ImageUsageFlagBits::eTransferDst |
                                         vk::ImageUsageFlagBits::eSampled,
             vk::ImageAspectFlags ImageAspect = vk::ImageAspectFlagBits::eColor,
-            uint32_t ArrayLayers = 1);
+            uint32_t ArrayLayers = 1,
+            // Mip chains that were built offline, the levels are uploaded through CopyLevels
+            std::optional<uint32_t> MipLevels = {});
 
     Texture(const Texture &Other) = delete;
 
@@ -50,11 +56,13 @@ class Texture : DeviceDependentObject, public IShaderBindableData
         : vkImage(Other.vkImage),
           vkImageMemory(Other.vkImageMemory),
           imageInfo(std::move(Other.imageInfo)),
-          sampler(std::move(Other.sampler))
+          sampler(std::move(Other.sampler)),
+          bindlessIndex(Other.bindlessIndex)
     {
         Other.vkImage = VK_NULL_HANDLE;
         Other.vkImageMemory = VK_NULL_HANDLE;
         Other.imageInfo.views.clear();
+        Other.bindlessIndex = INVALID_BINDLESS_INDEX;
     }
 
     virtual ~Texture();
@@ -85,6 +93,14 @@ class Texture : DeviceDependentObject, public IShaderBindableData
 
     virtual void Resize(const vk::Extent3D Extent);
 
+    // Registers the texture in the BindlessHeap, the slot is released again on destruction
+    uint32_t RegisterBindless();
+    // Moves a registered texture to a fresh slot after its image changed, frames in flight may still read the old one
+    void ReregisterBindless();
+    /* Exchanges image, views and sampler with the other texture while both keep their bindless slots. Used to give
+     * a texture that is already bound its final image. */
+    void SwapImage(Texture &Other);
+
     const std::vector<vk::ImageView> &GetViews() const
     {
         return imageInfo.views;
@@ -104,11 +120,15 @@ class Texture : DeviceDependentObject, public IShaderBindableData
                                                               vk::ImageLayout NewLayout);
 
     void CopyBuffer(const Buffer &Buffer, bool TransitionToShaderUse = true);
+    // Uploads the tightly packed pixels or blocks of every mip level and transitions them to shader use
+    void CopyLevels(const std::vector<std::vector<uint8_t>> &Levels);
+    // Blits the SrcExtent region of the image onto the whole texture, scaling it if the sizes differ
     void EnqueueCopyImage(vk::CommandBuffer CommandBuffer,
                           vk::Image SrcImage,
                           vk::ImageLayout SrcLayout,
                           vk::Extent3D SrcExtent,
-                          vk::ImageLayout TargetLayout);
+                          vk::ImageLayout TargetLayout,
+                          vk::Filter Filter = vk::Filter::eNearest);
     void CopyImage(vk::Image SrcImage,
                    vk::ImageLayout SrcLayout,
                    vk::Extent3D SrcExtent,
@@ -167,5 +187,6 @@ class Texture : DeviceDependentObject, public IShaderBindableData
     vk::DeviceMemory vkImageMemory;
     ImageInfo imageInfo;
     Sampler sampler;
+    uint32_t bindlessIndex = INVALID_BINDLESS_INDEX;
 };
 }  // namespace Slipper
\ No newline at end of file
@@ -5,6 +5,7 @@
 namespace Slipper::GPU::Vulkan
 {
 typedef unsigned char stbi_uc;
+struct KtxImage;
 
 struct StbImage
 {
@@ -19,6 +20,10 @@ class Texture2D : public Texture
  public:
     ~Texture2D() override;
     Texture2D(StbImage Image, bool GenerateMipMaps);
+    // Uploads the mip chain of the image, its format has to be one the device can sample
+    explicit Texture2D(const KtxImage &Image);
+    // Empty texture whose levels are uploaded by the caller, e.g. with a mip chain that was built offline
+    Texture2D(VkExtent2D Extent, vk::Format ImageFormat, uint32_t MipLevels);
     Texture2D(VkExtent2D Extent,
               vk::Format ImageFormat,
               std::optional<vk::Format> ViewFormat = {},
@@ -0,0 +1,168 @@
+#pragma once
+
+#include "vk_DeviceDependentObject.h"
+#include "vk_Sampler.h"
+#include "vk_Settings.h"
+
+namespace Slipper
+{
+    class Mesh;
+}
+
+namespace Slipper::GPU::Vulkan
+{
+    class Buffer;
+    class CommandPool;
+    class Material;
+    class Texture;
+    class Texture2D;
+    struct KtxImage;
+
+    struct TextureStreamerSettings
+    {
+        // Memory all streamed textures may use together, the resident tails are always kept even if they exceed it
+        uint64_t budgetBytes = 256ull << 20;
+        // Largest side of the low mips that are uploaded on load and never dropped
+        uint32_t residentTailSize = 128;
+        // Uploads of a frame stop once this is reached, at least one mip is uploaded per frame
+        uint64_t uploadBytesPerFrame = 8ull << 20;
+        // Mips that were needed during the last frames are not dropped to make room for other textures
+        uint32_t evictionDelay = 60;
+        // Added to the mip estimated from the screen size, positive values stream less
+        float mipBias = 0.0f;
+    };
+
+    struct TextureStreamerStats
+    {
+        uint32_t streamedTextures = 0;
+        uint64_t residentBytes = 0;
+        // Mips that were uploaded or dropped during the last frame
+        uint32_t uploadedMips = 0;
+        uint64_t uploadedBytes = 0;
+        uint32_t evictedMips = 0;
+        // Mips that are needed but did not fit into the budget or are still waiting for their upload
+        uint32_t deniedMips = 0;
+        uint32_t pendingMips = 0;
+    };
+
+    /* Streams the mips of 2D textures by how large they appear on screen. Textures are loaded with only their low
+     * mips resident, rendering reports the mip every draw samples and once per frame the missing mips are uploaded
+     * from the cpu copy of the chain. When the budget is exceeded the mips that were needed least recently are
+     * dropped again.
+     * The device does not use sparse residency, so the image of a texture only holds its allocated mip tail and is
+     * created anew when that changes. Mips of a new image are uploaded over several frames and the sampler clamps
+     * minLod to the first one that has arrived. The swap gives the texture a new bindless slot and queues descriptor
+     * updates for materials that bind it, the old image is destroyed once no frame in flight can sample it. */
+    class TextureStreamer : DeviceDependentObject
+    {
+        struct StreamedTexture
+        {
+            NonOwningPtr<Texture> texture;
+            // Tightly packed pixels or blocks of every mip, level 0 is the full size image
+            std::vector<std::vector<uint8_t>> mips;
+            std::vector<vk::Extent3D> extents;
+            // Mips below this one are streamed, the tail from here on is always resident
+            uint32_t tailMip = 0;
+            // Level 0 of the image is this mip of the chain
+            uint32_t allocatedMip = 0;
+            // First mip of the image whose pixels were uploaded, the sampler hides the ones before it
+            uint32_t residentMip = 0;
+            // Smallest mip requested by rendering since the last update
+            uint32_t requestedMip = 0;
+            std::vector<uint64_t> lastNeeded;
+        };
+
+        // Image and views a texture used before it was recreated, kept until no frame in flight uses them
+        struct RetiredImage
+        {
+            uint64_t releaseFrame;
+            vk::Image image;
+            vk::DeviceMemory memory;
+            std::vector<vk::ImageView> views;
+        };
+
+     public:
+        static TextureStreamer &Get()
+        {
+            return *m_instance;
+        }
+
+        static bool IsAvailable()
+        {
+            return m_instance != nullptr;
+        }
+
+        static void Init();
+        static void Shutdown();
+
+        // Streams the mip chain the image was stored with, its format has to be one the device can sample
+        [[nodiscard]] Texture2D *CreateTexture2D(KtxImage &&Image);
+        // Streams the mips of From into To from now on, for textures that took over the image of a streamed one
+        void Transfer(const Texture &From, Texture &To);
+        // Called by the texture on destruction
+        void Unregister(const Texture &Texture);
+
+        /* Reports the textures of a material for a draw. UvPixels is how many pixels one uv unit of the mesh covers
+         * on screen, the streamer turns that into the mip each texture needs. */
+        void RequestMaterial(const Material &Material, float UvPixels);
+        void Request(const Texture &Texture, float UvPixels);
+
+        // Uploads requested mips and drops cold ones, called once per frame after the frame slot is free again
+        void Update();
+
+        // Command buffer with the uploads of this frame or nothing, submitted before the rendering stages
+        [[nodiscard]] std::optional<vk::CommandBuffer> GetRecordedCommandBuffer() const;
+
+        [[nodiscard]] const TextureStreamerStats &GetStats() const
+        {
+            return m_stats;
+        }
+
+        // Estimated on screen size of one uv unit of a mesh
+        [[nodiscard]] static float GetUvPixels(const Mesh &Mesh,
+                                               const glm::mat4 &Transform,
+                                               float ViewDepth,
+                                               float PixelsPerUnit);
+
+     private:
+        TextureStreamer();
+        ~TextureStreamer();
+
+        // Picks the resident tail of the chain and creates the texture with only the tail uploaded
+        [[nodiscard]] Texture2D *Stream(StreamedTexture &&Streamed, vk::Format Format, const std::string &Filepath);
+
+        [[nodiscard]] static uint64_t GetBytes(const StreamedTexture &Texture, uint32_t FirstMip);
+        // Texture whose top allocated mip was needed longest ago, as long as that was before NeededBefore
+        [[nodiscard]] std::optional<size_t> FindEvictionCandidate(const std::vector<uint32_t> &AllocatedMips,
+                                                                  uint64_t NeededBefore) const;
+
+        // Replaces the image with one that starts at AllocatedMip and uploads the resident mips into it
+        uint64_t Recreate(vk::CommandBuffer CommandBuffer, StreamedTexture &Texture, uint32_t AllocatedMip);
+        // Copies the pixels of the mip into the image, which has to be in transfer dst layout
+        uint64_t CopyMip(vk::CommandBuffer CommandBuffer, const StreamedTexture &Texture, uint32_t Mip);
+        // Clamps the sampler to the resident mips and points the bindless slot and materials at the texture again
+        void Publish(StreamedTexture &Texture);
+        // Sampler that hides the mips before MinLod, shared by every texture with the same mip count and MinLod
+        [[nodiscard]] const Sampler &GetSampler(uint32_t MipLevels, uint32_t MinLod);
+
+     public:
+        TextureStreamerSettings settings;
+
+     private:
+        static inline TextureStreamer *m_instance = nullptr;
+
+        OwningPtr<CommandPool> m_commandPool;
+        std::array<uint64_t, MAX_FRAMES_IN_FLIGHT> m_recordedFrames = {};
+
+        std::vector<StreamedTexture> m_textures;
+        std::unordered_map<const Texture *, size_t> m_textureSlots;
+
+        std::deque<RetiredImage> m_retiredImages;
+        // Never destroyed before shutdown, so descriptors of frames in flight can always keep using them
+        std::map<std::pair<uint32_t, uint32_t>, Sampler> m_samplers;
+        // Staging buffers of the frame slot, freed once the slot is reused
+        std::array<std::vector<OwningPtr<Buffer>>, MAX_FRAMES_IN_FLIGHT> m_stagingBuffers;
+
+        TextureStreamerStats m_stats;
+    };
+}  // namespace Slipper::GPU::Vulkan
@@ -0,0 +1,145 @@
+#include "../DynamicResolution.h"
+
+#include "GraphicsEngine.h"
+#include "Vulkan/vk_GpuProfiler.h"
+#include "Vulkan/vk_RenderPass.h"
+#include "Vulkan/vk_Settings.h"
+#include "Vulkan/vk_SwapChain.h"
+
+namespace Slipper::GPU
+{
+    DynamicResolution::DynamicResolution(const NonOwningPtr<Vulkan::SwapChain> SwapChain,
+                                         const NonOwningPtr<Vulkan::RenderPass> RenderPass)
+        : m_swapChain(SwapChain), m_renderPass(RenderPass), m_maxSampleCount(RenderPass->sampleCount)
+    {
+    }
+
+    void DynamicResolution::Init(const NonOwningPtr<Vulkan::SwapChain> SwapChain,
+                                 const NonOwningPtr<Vulkan::RenderPass> RenderPass)
+    {
+        ASSERT(!m_instance, "Dynamic resolution already created!")
+        m_instance = new DynamicResolution(SwapChain, RenderPass);
+
+        if (!Vulkan::GpuProfiler::IsAvailable())
+        {
+            LOG("Dynamic resolution needs gpu timestamps, the viewport will always render at full resolution.")
+        }
+    }
+
+    void DynamicResolution::Shutdown()
+    {
+        delete m_instance;
+        m_instance = nullptr;
+    }
+
+    void DynamicResolution::Update()
+    {
+        const bool enabled = settings.enabled && Vulkan::GpuProfiler::IsAvailable();
+        if (enabled != m_wasEnabled)
+        {
+            // Going back to full quality when disabled, the sample count is only rebuilt here or under load
+            Reset(!enabled);
+            m_wasEnabled = enabled;
+        }
+        if (!enabled)
+            return;
+
+        const Vulkan::GpuFrameTimings *timings = Vulkan::GpuProfiler::Get().GetLatestTimings();
+        if (!timings || timings->frame == m_lastTimedFrame || timings->frame < m_settledFrame)
+            return;
+        m_lastTimedFrame = timings->frame;
+
+        const double frame_ms = timings->DurationMs();
+        m_smoothedFrameMs = m_smoothedFrameMs > 0.0 ?
+            std::lerp(m_smoothedFrameMs, frame_ms, static_cast<double>(settings.smoothing)) :
+            frame_ms;
+
+        // A scale change resets the smoothed time, so the sample count waits for timings of the new scale
+        if (!UpdateScale() && settings.adjustSampleCount)
+        {
+            UpdateSampleCount();
+        }
+    }
+
+    float DynamicResolution::GetScale() const
+    {
+        return m_swapChain->GetRenderScale();
+    }
+
+    vk::SampleCountFlagBits DynamicResolution::GetSampleCount() const
+    {
+        return m_renderPass->sampleCount;
+    }
+
+    bool DynamicResolution::UpdateScale()
+    {
+        const double target_ms = settings.targetFrameMs;
+        if (m_smoothedFrameMs <= target_ms && m_smoothedFrameMs >= target_ms * settings.headroom)
+            return false;
+
+        // Gpu time mostly grows with the pixel count, so aim the square of the scale at the middle of the band
+        const double goal_ms = target_ms * (1.0 + settings.headroom) * 0.5;
+        const float scale = GetScale();
+        float new_scale = scale * static_cast<float>(std::sqrt(goal_ms / m_smoothedFrameMs));
+        new_scale = std::clamp(new_scale, scale - settings.maxStep, scale + settings.maxStep);
+        new_scale = std::clamp(new_scale, settings.minScale, settings.maxScale);
+
+        // Skips changes that would not even move the render area by a pixel
+        const auto resolution = m_swapChain->GetResolution();
+        if (std::abs(new_scale - scale) * static_cast<float>(std::max(resolution.width, resolution.height)) < 1.0f)
+            return false;
+
+        m_swapChain->SetRenderScale(new_scale);
+        m_settledFrame = Vulkan::FRAME_COUNT;
+        m_smoothedFrameMs = 0.0;
+        return true;
+    }
+
+    void DynamicResolution::UpdateSampleCount()
+    {
+        const float scale = GetScale();
+        const bool over_budget = scale <= settings.minScale && m_smoothedFrameMs > settings.targetFrameMs;
+        const bool under_budget = scale >= settings.maxScale &&
+            m_smoothedFrameMs < settings.targetFrameMs * settings.sampleCountHeadroom;
+        m_overBudgetFrames = over_budget ? m_overBudgetFrames + 1 : 0;
+        m_underBudgetFrames = under_budget ? m_underBudgetFrames + 1 : 0;
+
+        const auto sample_count = static_cast<uint32_t>(GetSampleCount());
+        uint32_t new_sample_count = sample_count;
+        if (m_overBudgetFrames >= settings.sampleCountFrames && sample_count > 1)
+        {
+            new_sample_count = sample_count >> 1;
+        }
+        else if (m_underBudgetFrames >= settings.sampleCountFrames &&
+                 sample_count < static_cast<uint32_t>(m_maxSampleCount))
+        {
+            new_sample_count = sample_count << 1;
+        }
+
+        if (new_sample_count == sample_count)
+            return;
+
+        LOG_FORMAT("Dynamic resolution changes the viewport sample count from {} to {}",
+                   sample_count,
+                   new_sample_count)
+        GraphicsEngine::Get().SetViewportSampleCount(static_cast<vk::SampleCountFlagBits>(new_sample_count));
+        m_settledFrame = Vulkan::FRAME_COUNT;
+        m_smoothedFrameMs = 0.0;
+        m_overBudgetFrames = 0;
+        m_underBudgetFrames = 0;
+    }
+
+    void DynamicResolution::Reset(const bool RestoreQuality)
+    {
+        m_smoothedFrameMs = 0.0;
+        m_overBudgetFrames = 0;
+        m_underBudgetFrames = 0;
+        m_settledFrame = Vulkan::FRAME_COUNT;
+
+        if (RestoreQuality)
+        {
+            m_swapChain->SetRenderScale(1.0f);
+            GraphicsEngine::Get().SetViewportSampleCount(m_maxSampleCount);
+        }
+    }
+}  // namespace Slipper::GPU
@@ -1,22 +1,32 @@
 #include "GraphicsEngine.h"
 
 #include "Application.h"
+#include "AssetTask.h"
 #include "Camera.h"
 #include "CameraComponent.h"
 #include "CommandPool.h"
 #include "Context.h"
+#include "DynamicResolution.h"
 #include "MaterialManager.h"
 #include "ModelManager.h"
 #include "ShaderManager.h"
 #include "TextureManager.h"
 #include "Window.h"
+#include "Vulkan/vk_BindlessHeap.h"
+#include "Vulkan/vk_ClusteredLighting.h"
 #include "Vulkan/vk_CommandPool.h"
+#include "Vulkan/vk_DescriptorAllocator.h"
 #include "Vulkan/vk_Device.h"
+#include "Vulkan/vk_FrameReadback.h"
+#include "Vulkan/vk_GpuProfiler.h"
+#include "Vulkan/vk_MaterialParameterBuffer.h"
 #include "Vulkan/vk_Mesh.h"
 #include "Vulkan/vk_OffscreenSwapChain.h"
 #include "Vulkan/vk_RenderPass.h"
 #include "Vulkan/vk_Settings.h"
+#include "Vulkan/vk_ShadowAtlas.h"
 #include "Vulkan/vk_Texture2D.h"
+#include "Vulkan/vk_TextureStreamer.h"
 
 namespace Slipper::GPU
 {
@@ -49,55 +59,120 @@ namespace Slipper::GPU
             device.logicalDevice.destroyFence(compute_in_flight_fence);
         }
 
+        DynamicResolution::Shutdown();
+        Vulkan::ClusteredLighting::Shutdown();
+        Vulkan::ShadowAtlas::Shutdown();
+        m_litShader = nullptr;
         ShaderManager::Shutdown();
         ModelManager::Shutdown();
+        // Textures unregister themselves on destruction, so they have to go before the streamer
         TextureManager::Shutdown();
+        AssetCache::Shutdown();
+        Vulkan::TextureStreamer::Shutdown();
+
+        // Shaders, meshes and textures return their descriptors on destruction so these have to go last
+        Vulkan::FrameReadback::Shutdown();
+        Vulkan::GpuProfiler::Shutdown();
+        Vulkan::MaterialParameterBuffer::Shutdown();
+        Vulkan::BindlessHeap::Shutdown();
+        Vulkan::DescriptorAllocator::Shutdown();
     }
 
-    void GraphicsEngine::Init()
+    InitTaskId GraphicsEngine::Init(InitGraph &Graph, const InitTaskId Dependency, const VkExtent2D &ViewportResolution)
     {
-        m_graphicsInstance = new GraphicsEngine();
-        auto &device = Vulkan::VKDevice::Get();
-
-        vk::FenceCreateInfo fence_info{};
-        fence_info.flags = vk::FenceCreateFlagBits::eSignaled;
-
-        m_graphicsInstance->m_renderingInFlightFences.resize(Vulkan::MAX_FRAMES_IN_FLIGHT);
-        m_graphicsInstance->m_computeInFlightFences.resize(Vulkan::MAX_FRAMES_IN_FLIGHT);
-        for (int i = 0; i < Vulkan::MAX_FRAMES_IN_FLIGHT; ++i)
-        {
-            VK_HPP_ASSERT(
-                device.logicalDevice.createFence(&fence_info, nullptr, &m_graphicsInstance->m_computeInFlightFences[i]),
-                "Failed to create compute fence !")
-
-            VK_HPP_ASSERT(device.logicalDevice.createFence(
-                              &fence_info, nullptr, &m_graphicsInstance->m_renderingInFlightFences[i]),
-                          "Failed to create graphics fence !")
-        }
-
-
-        m_graphicsInstance->memoryCommandPool = std::unique_ptr<CommandPool>(CommandPool::Create());
-
-        m_graphicsInstance->windowRenderPass = m_graphicsInstance->CreateRenderPass(
-            "Window",
-            Vulkan::SwapChain::swapChainFormat,
-            Vulkan::Texture2D::FindDepthFormat(), true);
-
-        m_graphicsInstance->viewportRenderPass = m_graphicsInstance->CreateRenderPass(
-            "Viewport", Vulkan::TARGET_VIEWPORT_COLOR_FORMAT,
-            Vulkan::Texture2D::FindDepthFormat(), false);
-
-        m_graphicsInstance->viewportSwapChain = new Vulkan::OffscreenSwapChain(Application::Get().window->GetSize(),
-                                                                               Vulkan::TARGET_VIEWPORT_COLOR_FORMAT,
-                                                                               Vulkan::MAX_FRAMES_IN_FLIGHT,
-                                                                               true);
-
-        m_graphicsInstance->viewportRenderingStage = m_graphicsInstance->AddRenderingStage(
-            "Viewport", m_graphicsInstance->viewportSwapChain, false);
-
-        m_graphicsInstance->viewportRenderingStage->RegisterForRenderPass(m_graphicsInstance->viewportRenderPass);
+        /* Everything here creates vulkan objects or fills registries of the main thread, so the tasks stay on it and
+         * are added in the order they always ran in. Only the debug resource loads start early, their reading,
+         * cooking and decoding runs on the workers while the render passes and the swap chain are created. */
+        const InitTaskId engine = Graph.Add("GraphicsEngine", InitThread::Main, [] {
+            m_graphicsInstance = new GraphicsEngine();
+            auto &device = Vulkan::VKDevice::Get();
+
+            vk::FenceCreateInfo fence_info{};
+            fence_info.flags = vk::FenceCreateFlagBits::eSignaled;
+
+            m_graphicsInstance->m_renderingInFlightFences.resize(Vulkan::MAX_FRAMES_IN_FLIGHT);
+            m_graphicsInstance->m_computeInFlightFences.resize(Vulkan::MAX_FRAMES_IN_FLIGHT);
+            for (int i = 0; i < Vulkan::MAX_FRAMES_IN_FLIGHT; ++i)
+            {
+                VK_HPP_ASSERT(device.logicalDevice.createFence(
+                                  &fence_info, nullptr, &m_graphicsInstance->m_computeInFlightFences[i]),
+                              "Failed to create compute fence !")
 
-        SetupDebugResources();
+                VK_HPP_ASSERT(device.logicalDevice.createFence(
+                                  &fence_info, nullptr, &m_graphicsInstance->m_renderingInFlightFences[i]),
+                              "Failed to create graphics fence !")
+            }
+        }, {Dependency});
+
+        const InitTaskId descriptors = Graph.Add("DescriptorAllocator", InitThread::Main, [] {
+            Vulkan::DescriptorAllocator::Init();
+        }, {engine});
+        const InitTaskId bindless_heap = Graph.Add("BindlessHeap", InitThread::Main, [] {
+            Vulkan::BindlessHeap::Init();
+        }, {descriptors});
+        const InitTaskId material_parameters = Graph.Add("MaterialParameterBuffer", InitThread::Main, [] {
+            Vulkan::MaterialParameterBuffer::Init();
+        }, {bindless_heap});
+        const InitTaskId gpu_profiler = Graph.Add("GpuProfiler", InitThread::Main, [] {
+            Vulkan::GpuProfiler::Init();
+        }, {engine});
+        const InitTaskId frame_readback = Graph.Add("FrameReadback", InitThread::Main, [] {
+            Vulkan::FrameReadback::Init();
+        }, {engine});
+        // Loads its culling shader
+        const InitTaskId clustered_lighting = Graph.Add("ClusteredLighting", InitThread::Main, [] {
+            Vulkan::ClusteredLighting::Init();
+        }, {bindless_heap});
+
+        const InitTaskId memory_command_pool = Graph.Add("MemoryCommandPool", InitThread::Main, [] {
+            m_graphicsInstance->memoryCommandPool = std::unique_ptr<CommandPool>(CommandPool::Create());
+        }, {engine});
+        // Transitions its atlases through the memory command pool
+        const InitTaskId shadow_atlas = Graph.Add("ShadowAtlas", InitThread::Main, [] {
+            Vulkan::ShadowAtlas::Init();
+        }, {bindless_heap, memory_command_pool});
+        const InitTaskId texture_streamer = Graph.Add("TextureStreamer", InitThread::Main, [] {
+            Vulkan::TextureStreamer::Init();
+        }, {bindless_heap, memory_command_pool});
+
+        // Textures upload their placeholder right away, everything else the loads create waits for the main thread
+        auto loads = std::make_shared<DebugResourceLoads>();
+        const InitTaskId start_loads = Graph.Add("StartDebugResourceLoads", InitThread::Main, [loads] {
+            *loads = StartDebugResourceLoads();
+        }, {material_parameters, texture_streamer});
+
+        const InitTaskId render_passes = Graph.Add("RenderPasses", InitThread::Main, [] {
+            m_graphicsInstance->windowRenderPass = m_graphicsInstance->CreateRenderPass(
+                "Window",
+                Vulkan::SwapChain::swapChainFormat,
+                Vulkan::Texture2D::FindDepthFormat(), true);
+
+            m_graphicsInstance->viewportRenderPass = m_graphicsInstance->CreateRenderPass(
+                "Viewport", Vulkan::TARGET_VIEWPORT_COLOR_FORMAT,
+                Vulkan::Texture2D::FindDepthFormat(), false, true);
+        }, {engine});
+
+        const InitTaskId viewport = Graph.Add("ViewportSwapChain", InitThread::Main, [&ViewportResolution] {
+            m_graphicsInstance->viewportSwapChain = new Vulkan::OffscreenSwapChain(ViewportResolution,
+                                                                                   Vulkan::TARGET_VIEWPORT_COLOR_FORMAT,
+                                                                                   Vulkan::MAX_FRAMES_IN_FLIGHT,
+                                                                                   true);
+
+            m_graphicsInstance->viewportRenderingStage = m_graphicsInstance->AddRenderingStage(
+                "Viewport", m_graphicsInstance->viewportSwapChain, false);
+
+            m_graphicsInstance->viewportRenderingStage->RegisterForRenderPass(
+                m_graphicsInstance->viewportRenderPass);
+        }, {render_passes, memory_command_pool});
+
+        const InitTaskId dynamic_resolution = Graph.Add("DynamicResolution", InitThread::Main, [] {
+            DynamicResolution::Init(m_graphicsInstance->viewportSwapChain, m_graphicsInstance->viewportRenderPass);
+        }, {viewport});
+
+        // Shaders create their pipelines for the render passes once they get back to the main thread
+        return Graph.Add("FinishDebugResourceLoads", InitThread::Main, [loads] {
+            FinishDebugResourceLoads(*loads);
+        }, {start_loads, clustered_lighting, shadow_atlas, gpu_profiler, frame_readback, dynamic_resolution});
     }
 
     void GraphicsEngine::Shutdown()
@@ -109,27 +184,53 @@ namespace Slipper::GPU
         m_graphicsInstance = nullptr;
     }
 
-    void GraphicsEngine::SetupDebugResources()
+    GraphicsEngine::DebugResourceLoads GraphicsEngine::StartDebugResourceLoads()
     {
-        // The default material depends on these so initialize them first
-        TextureManager::Load2D(Vulkan::DEMO_TEXTURE_PATH, true);
-        ModelManager::Load(Vulkan::DEMO_MODEL_PATH);
+        // All loads are started before waiting for any, so cooking, decoding and reflecting overlap on the workers
+        DebugResourceLoads loads;
+        loads.model = ModelManager::LoadAsync(Vulkan::DEMO_MODEL_PATH);
+        loads.material = LoadBasicMaterial();
+
+        // Reads its lights and textures through the bindless heap
+        if (Vulkan::BindlessHeap::IsAvailable())
+        {
+            loads.litShader = ShaderManager::LoadGraphicsShaderAsync(
+                {"./EngineContent/Shaders/Spir-V/Lit.vert.spv", "./EngineContent/Shaders/Spir-V/Lit.frag.spv"});
+        }
+        return loads;
+    }
 
-        /* CreateCamera material for this pipeline. */
+    void GraphicsEngine::FinishDebugResourceLoads(const DebugResourceLoads &Loads)
+    {
+        // The model is picked up by name in SetupSimpleDraw, it only has to be loaded by then
+        Loads.model.Wait();
+        Loads.material.Wait();
+        if (Loads.litShader.IsValid())
+        {
+            m_litShader = Loads.litShader.Wait();
+        }
+    }
 
-        MaterialManager::AddMaterial(
-            "Basic",
-            ShaderManager::LoadGraphicsShader(
-                {{"./EngineContent/Shaders/Spir-V/Basic.vert.spv"}, {"./EngineContent/Shaders/Spir-V/Basic.frag.spv"}}))
-            ->SetUniform("texSampler", *TextureManager::Get2D("viking_room"));
+    AssetTask<NonOwningPtr<Material>> GraphicsEngine::LoadBasicMaterial()
+    {
+        auto shader = ShaderManager::LoadGraphicsShaderAsync(
+            {"./EngineContent/Shaders/Spir-V/Basic.vert.spv", "./EngineContent/Shaders/Spir-V/Basic.frag.spv"});
+        auto texture = TextureManager::LoadAsync(Vulkan::DEMO_TEXTURE_PATH, true);
+
+        const auto material = MaterialManager::AddMaterial("Basic", co_await shader);
+        // Binding the placeholder would work as well, waiting keeps the first frames from showing it
+        material->SetUniform("texSampler", *co_await texture);
+        co_return material;
     }
 
     Vulkan::RenderPass *GraphicsEngine::CreateRenderPass(const std::string &Name,
                                                          const vk::Format RenderingFormat,
                                                          const vk::Format DepthFormat,
-                                                         const bool ForPresentation)
+                                                         const bool ForPresentation,
+                                                         const bool DepthPrePass)
     {
-        renderPasses[Name] = std::make_unique<Vulkan::RenderPass>(Name, RenderingFormat, DepthFormat, ForPresentation);
+        renderPasses[Name] = std::make_unique<Vulkan::RenderPass>(
+            Name, RenderingFormat, DepthFormat, ForPresentation, DepthPrePass);
         renderPassNames[renderPasses[Name].get()] = Name;
         return renderPasses[Name].get();
     }
@@ -144,6 +245,18 @@ namespace Slipper::GPU
         }
     }
 
+    void GraphicsEngine::SetViewportSampleCount(const vk::SampleCountFlagBits SampleCount) const
+    {
+        if (viewportRenderPass->sampleCount == SampleCount)
+            return;
+
+        device.logicalDevice.waitIdle();
+
+        viewportRenderPass->SetSampleCount(SampleCount);
+        ShaderManager::RecreatePipelines(viewportRenderPass);
+        viewportSwapChain->SetSampleCount(SampleCount);
+    }
+
     Entity GraphicsEngine::GetDefaultCamera()
     {
         for (const auto entity : EcsInterface::GetRegistry().view<Camera>())
@@ -194,6 +307,36 @@ namespace Slipper::GPU
     {
         device.logicalDevice.waitForFences(
             {m_renderingInFlightFences[m_currentFrame], m_computeInFlightFences[m_currentFrame]}, VK_TRUE, UINT64_MAX);
+
+        // The gpu is done with this frame slot so its transient descriptor sets can be recycled
+        Vulkan::DescriptorAllocator::Get().BeginFrame(m_currentFrame);
+        if (Vulkan::BindlessHeap::IsAvailable())
+        {
+            Vulkan::BindlessHeap::Get().BeginFrame();
+        }
+        if (Vulkan::GpuProfiler::IsAvailable())
+        {
+            Vulkan::GpuProfiler::Get().BeginFrame(m_currentFrame);
+        }
+        // Runs before anything is recorded so a changed render scale applies to the whole frame
+        DynamicResolution::Get().Update();
+        Vulkan::FrameReadback::Get().BeginFrame(m_currentFrame);
+        if (Vulkan::ClusteredLighting::IsAvailable())
+        {
+            Vulkan::ClusteredLighting::Get().BeginFrame();
+        }
+        if (Vulkan::ShadowAtlas::IsAvailable())
+        {
+            Vulkan::ShadowAtlas::Get().BeginFrame();
+        }
+        // Runs first so textures that finished loading are already streamed this frame
+        TextureManager::Update();
+        // Continues the loads waiting for the main thread, including those that waited for the textures above
+        AssetScheduler::Update();
+        // After the fence wait, so assets the gpu stopped using can be unloaded
+        AssetCache::Trim();
+        // Consumes the mips rendering requested during the last frame
+        Vulkan::TextureStreamer::Get().Update();
     }
 
     void GraphicsEngine::BeginRenderingStage(std::string_view Name)
@@ -225,11 +368,19 @@ namespace Slipper::GPU
 
     void GraphicsEngine::EndFrame()
     {
+        PROFILE_FUNCTION();
+
         // We reset both fences together since we also wait for both together so there isnt really a
         // point in doing them seperately
         device.logicalDevice.resetFences(
             {m_renderingInFlightFences[m_currentFrame], m_computeInFlightFences[m_currentFrame]});
 
+        // Upload the material constants changed since this frame slot was last used
+        if (Vulkan::MaterialParameterBuffer::IsAvailable())
+        {
+            Vulkan::MaterialParameterBuffer::Get().Flush(m_currentFrame);
+        }
+
         // Submit compute commands
         std::vector<vk::Semaphore> compute_finished_semaphores;
         for (const auto &rendering_stage : renderingStages | std::ranges::views::values)
@@ -262,11 +413,12 @@ namespace Slipper::GPU
             }
         }
 
+        // One stage per wait semaphore, headless frames only wait on compute
         std::vector<vk::PipelineStageFlags> wait_stages;
         wait_stages.insert(wait_stages.begin(),
                            compute_finished_semaphores.size(),
                            vk::PipelineStageFlagBits::eVertexInput);  // Compute shader stage mask
-        wait_stages.emplace_back(vk::PipelineStageFlagBits::eColorAttachmentOutput);
+        wait_stages.resize(wait_semaphores.size(), vk::PipelineStageFlagBits::eColorAttachmentOutput);
 
         std::vector<vk::Semaphore> render_finished_semaphores;
         for (const auto &rendering_stage : renderingStages | std::ranges::views::values)
@@ -277,8 +429,13 @@ namespace Slipper::GPU
             }
         }
 
+        // Texture uploads go first so every stage samples the mips they published
         std::vector<vk::CommandBuffer> command_buffers;
-        command_buffers.reserve(renderingStages.size());
+        command_buffers.reserve(renderingStages.size() + 1);
+        if (const auto streaming_command_buffer = Vulkan::TextureStreamer::Get().GetRecordedCommandBuffer())
+        {
+            command_buffers.push_back(streaming_command_buffer.value());
+        }
         for (const auto &rendering_stage : renderingStages | std::ranges::views::values)
         {
             command_buffers.push_back(rendering_stage->GetGraphicsCommandPool()->GetCurrentCommandBuffer());
@@ -301,6 +458,12 @@ namespace Slipper::GPU
             }
         }
 
+        if (present_swap_chains.empty())
+        {
+            m_currentFrame = (m_currentFrame + 1) % Vulkan::MAX_FRAMES_IN_FLIGHT;
+            return;
+        }
+
         const vk::PresentInfoKHR present_info(
             render_finished_semaphores, present_swap_chains, swap_chain_image_indices, nullptr);
 
@@ -0,0 +1,179 @@
+#include "MeshFile.h"
+
+#include "Filesystem/File.h"
+#include "Filesystem/Path.h"
+#include "ObjImporter.h"
+#include "Util/StringUtil.h"
+
+namespace Slipper
+{
+namespace
+{
+struct SourceStamp
+{
+    uint64_t size;
+    int64_t writeTime;
+};
+
+SourceStamp GetSourceStamp(const std::string &SourcePath)
+{
+    return {static_cast<uint64_t>(std::filesystem::file_size(SourcePath)),
+            static_cast<int64_t>(std::filesystem::last_write_time(SourcePath).time_since_epoch().count())};
+}
+
+bool IsCompatible(const MeshFileHeader &Header)
+{
+    return Header.magic == MESH_FILE_MAGIC && Header.version == MESH_FILE_VERSION &&
+        Header.vertexStride == sizeof(GPU::Vulkan::Vertex) && Header.indexSize == sizeof(VertexIndex);
+}
+
+// The views are typed, so every blob has to lie inside the file at an address aligned for its type
+template<typename T>
+bool IsBlobValid(const std::span<const std::byte> File, const uint64_t Offset, const uint32_t Count)
+{
+    return Offset <= File.size() && uint64_t{Count} * sizeof(T) <= File.size() - Offset &&
+        reinterpret_cast<uintptr_t>(File.data() + Offset) % alignof(T) == 0;
+}
+
+// Only reads the header, the rest of the file is not touched
+bool IsUpToDate(const std::string &CookedPath, const std::string &SourcePath)
+{
+    std::ifstream file(CookedPath, std::ios::binary);
+    MeshFileHeader header;
+    if (!file.is_open() || !file.read(reinterpret_cast<char *>(&header), sizeof(header))) {
+        return false;
+    }
+
+    const SourceStamp stamp = GetSourceStamp(SourcePath);
+    return IsCompatible(header) && header.sourceSize == stamp.size && header.sourceWriteTime == stamp.writeTime;
+}
+}  // namespace
+
+void SaveMeshFile(const MeshData &Mesh, const std::string &Filepath, const std::string &SourcePath)
+{
+    PROFILE_ZONE("SaveMeshFile");
+
+    const SourceStamp stamp = GetSourceStamp(SourcePath);
+    MeshFileHeader header = {};
+    header.magic = MESH_FILE_MAGIC;
+    header.version = MESH_FILE_VERSION;
+    header.vertexStride = sizeof(GPU::Vulkan::Vertex);
+    header.indexSize = sizeof(VertexIndex);
+    header.vertexCount = static_cast<uint32_t>(Mesh.vertices.size());
+    header.indexCount = static_cast<uint32_t>(Mesh.indices.size());
+    header.submeshCount = static_cast<uint32_t>(Mesh.submeshes.size());
+    header.sourceSize = stamp.size;
+    header.sourceWriteTime = stamp.writeTime;
+    header.bounds = Mesh.bounds;
+
+    const std::span vertex_bytes = std::as_bytes(std::span(Mesh.vertices));
+    const std::span index_bytes = std::as_bytes(std::span(Mesh.indices));
+    const std::span submesh_bytes = std::as_bytes(std::span(Mesh.submeshes));
+    header.vertexOffset = File::align_blob_offset(sizeof(MeshFileHeader));
+    header.indexOffset = File::align_blob_offset(header.vertexOffset + vertex_bytes.size());
+    header.submeshOffset = File::align_blob_offset(header.indexOffset + index_bytes.size());
+
+    std::vector<char> file(header.submeshOffset + submesh_bytes.size(), 0);
+    std::memcpy(file.data(), &header, sizeof(header));
+    std::memcpy(file.data() + header.vertexOffset, vertex_bytes.data(), vertex_bytes.size());
+    std::memcpy(file.data() + header.indexOffset, index_bytes.data(), index_bytes.size());
+    std::memcpy(file.data() + header.submeshOffset, submesh_bytes.data(), submesh_bytes.size());
+
+    File::write_file_atomic(Filepath, file);
+}
+
+std::optional<MeshFileView> ReadMeshFile(const std::span<const std::byte> File, const std::string_view Filepath)
+{
+    if (File.size() < sizeof(MeshFileHeader)) {
+        LOG_FORMAT("'{}' is not a cooked mesh", Filepath)
+        return {};
+    }
+
+    MeshFileHeader header;
+    std::memcpy(&header, File.data(), sizeof(header));
+    if (!IsCompatible(header)) {
+        LOG_FORMAT(
+            "'{}' is not a cooked mesh of version {} with the current vertex layout", Filepath, MESH_FILE_VERSION)
+        return {};
+    }
+
+    if (!IsBlobValid<GPU::Vulkan::Vertex>(File, header.vertexOffset, header.vertexCount) ||
+        !IsBlobValid<VertexIndex>(File, header.indexOffset, header.indexCount) ||
+        !IsBlobValid<Submesh>(File, header.submeshOffset, header.submeshCount)) {
+        LOG_FORMAT("'{}' is truncated or its blobs are misaligned", Filepath)
+        return {};
+    }
+
+    MeshFileView view;
+    view.vertices = {reinterpret_cast<const GPU::Vulkan::Vertex *>(File.data() + header.vertexOffset),
+                     header.vertexCount};
+    view.indices = {reinterpret_cast<const VertexIndex *>(File.data() + header.indexOffset), header.indexCount};
+    view.submeshes = {reinterpret_cast<const Submesh *>(File.data() + header.submeshOffset), header.submeshCount};
+    view.bounds = header.bounds;
+
+    // Out of range indices would make the gpu read past the vertex buffer
+    const auto index_in_range = [&](const VertexIndex Index) { return Index < header.vertexCount; };
+    const auto submesh_in_range = [&](const Submesh &Submesh) {
+        return uint64_t{Submesh.firstIndex} + Submesh.indexCount <= header.indexCount;
+    };
+    if (!std::ranges::all_of(view.indices, index_in_range) || !std::ranges::all_of(view.submeshes, submesh_in_range)) {
+        LOG_FORMAT("'{}' has indices or submeshes outside of the mesh", Filepath)
+        return {};
+    }
+    return view;
+}
+
+std::string CookMesh(const std::string &AbsoluteSourcePath, const bool Force)
+{
+    const std::string cache_directory = Path::make_engine_relative_path_absolute("./Cache/Meshes");
+    // Named after the source for readability, the hash of the full path keeps equally named sources apart
+    const std::string cooked_path = std::format("{}/{}_{:016x}{}",
+                                                cache_directory,
+                                                File::get_file_name_from_path(AbsoluteSourcePath),
+                                                String::hash_name(AbsoluteSourcePath),
+                                                MESH_FILE_EXTENSION);
+    if (!Force && IsUpToDate(cooked_path, AbsoluteSourcePath)) {
+        return cooked_path;
+    }
+
+    PROFILE_ZONE("CookMesh");
+    ASSERT(AbsoluteSourcePath.ends_with(".obj"), "There is no importer for '{}'!", AbsoluteSourcePath)
+
+    const MeshData mesh = ImportObj(AbsoluteSourcePath);
+    std::filesystem::create_directories(cache_directory);
+    SaveMeshFile(mesh, cooked_path, AbsoluteSourcePath);
+    LOG_FORMAT("Cooked mesh '{}' into {}", AbsoluteSourcePath, cooked_path)
+    return cooked_path;
+}
+
+MappedMeshFile MapMeshFile(const std::string &AbsolutePath)
+{
+    const auto map = [](const std::string &CookedPath) {
+        MappedMeshFile mapped;
+        mapped.file = std::make_unique<MappedFile>(CookedPath);
+        if (const auto view = ReadMeshFile(mapped.file->GetData(), CookedPath)) {
+            mapped.view = view.value();
+        }
+        else {
+            mapped.file.reset();
+        }
+        return mapped;
+    };
+
+    // Cooked files have no source they could be rebuilt from
+    if (AbsolutePath.ends_with(MESH_FILE_EXTENSION)) {
+        MappedMeshFile mapped = map(AbsolutePath);
+        ASSERT(mapped.file, "'{}' is not a usable cooked mesh!", AbsolutePath)
+        return mapped;
+    }
+
+    // Sources are only imported when they changed, every other load maps the cooked file
+    if (MappedMeshFile mapped = map(CookMesh(AbsolutePath)); mapped.file) {
+        return mapped;
+    }
+    LOG_FORMAT("Cooking '{}' again since its cooked file is not usable", AbsolutePath)
+    MappedMeshFile mapped = map(CookMesh(AbsolutePath, true));
+    ASSERT(mapped.file, "Cooking '{}' did not produce a usable mesh!", AbsolutePath)
+    return mapped;
+}
+}  // namespace Slipper
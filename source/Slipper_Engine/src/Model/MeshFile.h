@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Filesystem/MappedFile.h"
+#include "Mesh/Mesh.h"
+
+namespace Slipper
+{
+constexpr std::array<char, 4> MESH_FILE_MAGIC = {'S', 'M', 'S', 'H'};
+// Has to be bumped whenever the layout of the file, the Vertex or the importers change
+constexpr uint32_t MESH_FILE_VERSION = 2;
+inline constexpr std::string_view MESH_FILE_EXTENSION = ".smesh";
+
+/* Cooked meshes start with this header, followed by the vertex blob, the index blob and the submesh table at the
+ * offsets below. Blobs are in the exact layout the buffers are created with, so loading maps the file and copies
+ * them into staging memory without looking at a single vertex. */
+struct MeshFileHeader
+{
+    std::array<char, 4> magic;
+    uint32_t version;
+    // The blobs are only usable with the vertex and index types they were written with
+    uint32_t vertexStride;
+    uint32_t indexSize;
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    uint32_t submeshCount;
+    uint32_t reserved;
+    // Size and last write time of the source file, the mesh is cooked again once either changes
+    uint64_t sourceSize;
+    int64_t sourceWriteTime;
+    MeshBounds bounds;
+    uint64_t vertexOffset;
+    uint64_t indexOffset;
+    uint64_t submeshOffset;
+};
+
+// Geometry of a mesh in the layout it is uploaded with
+struct MeshData
+{
+    std::vector<GPU::Vulkan::Vertex> vertices;
+    std::vector<VertexIndex> indices;
+    std::vector<Submesh> submeshes;
+    MeshBounds bounds;
+};
+
+// Points into the mapped file, only valid as long as the mapping is
+struct MeshFileView
+{
+    std::span<const GPU::Vulkan::Vertex> vertices;
+    std::span<const VertexIndex> indices;
+    std::span<const Submesh> submeshes;
+    MeshBounds bounds;
+};
+
+// Mapping of a cooked mesh together with the views into it
+struct MappedMeshFile
+{
+    std::unique_ptr<MappedFile> file;
+    MeshFileView view;
+};
+
+void SaveMeshFile(const MeshData &Mesh, const std::string &Filepath, const std::string &SourcePath);
+/* Validates the header, the placement of the blobs and that every index and submesh stays inside the mesh, then
+ * returns views of the blobs. Nothing is copied. Logs why and returns nothing if the file is not usable. */
+[[nodiscard]] std::optional<MeshFileView> ReadMeshFile(std::span<const std::byte> File, std::string_view Filepath);
+
+/* Path of the cooked file of the source under Cache/Meshes. The source is imported and cooked first if that file
+ * is missing, was cooked from an older version of the source or Force is set. */
+[[nodiscard]] std::string CookMesh(const std::string &AbsoluteSourcePath, bool Force = false);
+
+/* Maps the cooked mesh of a source, cooking it first if needed, or a cooked file (MESH_FILE_EXTENSION) directly.
+ * A cooked file of a source that fails validation is cooked again once. Touches no vulkan objects, so it can run
+ * on a worker. */
+[[nodiscard]] MappedMeshFile MapMeshFile(const std::string &AbsolutePath);
+}  // namespace Slipper
@@ -1,58 +1,32 @@
 #include "Model.h"
 
 #include "Filesystem/Path.h"
-#include "tiny_obj_loader.h"
-#include <unordered_map>
+#include "MeshFile.h"
+#include "Vulkan/vk_CommandContext.h"
 
 namespace Slipper
 {
 Model::Model(std::string_view FilePath)
 {
-    tinyobj::attrib_t attrib;
-    std::vector<tinyobj::shape_t> shapes;
-    std::vector<tinyobj::material_t> materials;
-    std::string warn, err;
+    PROFILE_ZONE("Model::Model");
 
-    if (!tinyobj::LoadObj(&attrib,
-                          &shapes,
-                          &materials,
-                          &warn,
-                          &err,
-                          Path::make_engine_relative_path_absolute(DEMO_MODEL_PATH).c_str())) {
-        throw std::runtime_error(warn + err);
-    }
-
-    std::vector<Vertex> vertices;
-    std::unordered_map<Vertex, uint32_t> uniqueVertices;
-    std::vector<VertexIndex> indices;
-
-    for (const auto &shape : shapes) {
-        for (const auto &index : shape.mesh.indices) {
-            Vertex vertex{};
-
-            vertex.pos = {attrib.vertices[3 * index.vertex_index + 0],
-                          attrib.vertices[3 * index.vertex_index + 1],
-                          attrib.vertices[3 * index.vertex_index + 2]};
-
-            vertex.texCoord = {attrib.texcoords[2 * index.texcoord_index + 0],
-                               1.0f - attrib.texcoords[2 * index.texcoord_index + 1]};
-
-            vertex.color = {1.0f, 1.0f, 1.0f};
-
-            if (!uniqueVertices.contains(vertex)) {
-                uniqueVertices[vertex] = static_cast<uint32_t>(vertices.size());
-                vertices.push_back(vertex);
-            }
+    // The buffers copy the blobs from the mapping into their staging memory
+    const MappedMeshFile cooked = MapMeshFile(Path::make_engine_relative_path_absolute(FilePath));
+    const MeshFileView &mesh = cooked.view;
+    m_mesh = std::make_unique<Mesh>(
+        File::get_file_name_from_path(FilePath), mesh.vertices, mesh.indices, mesh.bounds, mesh.submeshes);
+}
 
-            indices.push_back(uniqueVertices[vertex]);
-        }
-    }
+Model::Model(const std::string_view Name, const MeshFileView &Cooked)
+{
+    m_mesh = std::make_unique<Mesh>(Name, Cooked.vertices, Cooked.indices, Cooked.bounds, Cooked.submeshes);
+}
 
-    m_mesh = std::make_unique<Mesh>(File::get_file_name_from_path(FilePath),
-                                    vertices.data(),
-                                    vertices.size(),
-                                    indices.data(),
-                                    indices.size());
+Model::Model(const std::string_view Name,
+             const std::span<const GPU::Vulkan::Vertex> Vertices,
+             const std::span<const VertexIndex> Indices)
+{
+    m_mesh = std::make_unique<Mesh>(Name, Vertices.data(), Vertices.size(), Indices.data(), Indices.size());
 }
 
 void Model::Draw(VkCommandBuffer CommandBuffer, uint32_t InstanceCount) const
@@ -61,4 +35,10 @@ void Model::Draw(VkCommandBuffer CommandBuffer, uint32_t InstanceCount) const
     vkCmdDrawIndexed(
         CommandBuffer, static_cast<uint32_t>(m_mesh->NumIndex()), InstanceCount, 0, 0, 0);
 }
+
+void Model::Draw(GPU::Vulkan::CommandContext &Context, uint32_t InstanceCount) const
+{
+    m_mesh->Bind(Context);
+    Context.DrawIndexed(static_cast<uint32_t>(m_mesh->NumIndex()), InstanceCount);
+}
 }  // namespace Slipper
\ No newline at end of file
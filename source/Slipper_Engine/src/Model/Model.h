@@ -7,6 +7,8 @@
 
 namespace Slipper
 {
+struct MeshFileView;
+
 struct UniformModel : ShaderUniformObject
 {
     glm::mat4 model = {};
@@ -25,8 +27,15 @@ class Model
 {
  public:
     explicit Model(std::string_view FilePath);
+    // Uploads a mesh file that was read beforehand, see ModelManager::LoadAsync
+    Model(std::string_view Name, const MeshFileView &Cooked);
+    // Creates the model from already generated geometry, e.g. procedural meshes
+    Model(std::string_view Name,
+          std::span<const GPU::Vulkan::Vertex> Vertices,
+          std::span<const VertexIndex> Indices);
 
     void Draw(VkCommandBuffer CommandBuffer, uint32_t InstanceCount = 1) const;
+    void Draw(GPU::Vulkan::CommandContext &Context, uint32_t InstanceCount = 1) const;
 	const Mesh &GetMesh() const
     {
         return *m_mesh;
@@ -0,0 +1,418 @@
+#include "ObjImporter.h"
+
+#include "Filesystem/MappedFile.h"
+#include "ThreadPool.h"
+#include "tiny_obj_loader.h"
+#include <unordered_map>
+
+namespace Slipper
+{
+namespace
+{
+// More chunks than threads, so threads that got cheap lines pick up the remaining work
+constexpr uint32_t OBJ_CHUNKS_PER_THREAD = 4;
+// Welding splits the vertices into this many independent tables by the top bits of their hash
+constexpr uint32_t WELD_SHARD_BITS = 6;
+constexpr uint32_t WELD_SHARD_COUNT = 1u << WELD_SHARD_BITS;
+constexpr uint32_t NO_TEX_COORD = std::numeric_limits<uint32_t>::max();
+constexpr uint32_t EMPTY_SLOT = std::numeric_limits<uint32_t>::max();
+
+// Zero based indices of a face corner
+struct ObjCorner
+{
+    uint32_t position;
+    uint32_t texCoord;
+};
+
+struct ObjChunk
+{
+    std::string_view text;
+    uint32_t positionCount = 0;
+    uint32_t texCoordCount = 0;
+    // Elements defined by all chunks before this one
+    uint32_t positionOffset = 0;
+    uint32_t texCoordOffset = 0;
+    uint64_t cornerOffset = 0;
+    std::vector<ObjCorner> corners;
+    // Corners of the chunk at which an object or group starts
+    std::vector<uint32_t> groupStarts;
+};
+
+struct WeldSlot
+{
+    uint64_t hash;
+    uint32_t vertex;
+};
+
+// Unique vertices of all corners whose hash falls into the shard
+struct WeldShard
+{
+    std::vector<uint64_t> corners;
+    std::vector<GPU::Vulkan::Vertex> vertices;
+};
+
+// Calls Body with every non empty line of the text, without line break and leading whitespace
+template<typename F> void ForEachLine(std::string_view Text, F &&Body)
+{
+    while (!Text.empty()) {
+        const size_t end = Text.find('\n');
+        std::string_view line = Text.substr(0, end);
+        Text.remove_prefix(end == std::string_view::npos ? Text.size() : end + 1);
+
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        if (const size_t first = line.find_first_not_of(" \t"); first != std::string_view::npos) {
+            Body(line.substr(first));
+        }
+    }
+}
+
+bool StartsWithKeyword(const std::string_view Line, const std::string_view Keyword)
+{
+    return Line.size() > Keyword.size() && Line.starts_with(Keyword) &&
+        (Line[Keyword.size()] == ' ' || Line[Keyword.size()] == '\t');
+}
+
+// Skips leading whitespace and moves the text past the parsed value
+template<typename T> T ParseValue(std::string_view &Text, const std::string_view Filepath)
+{
+    const size_t first = Text.find_first_not_of(" \t");
+    Text.remove_prefix(first == std::string_view::npos ? Text.size() : first);
+
+    T value{};
+    const auto [end, error] = std::from_chars(Text.data(), Text.data() + Text.size(), value);
+    ASSERT(error == std::errc(),
+           "Malformed value '{}' in '{}'!",
+           Text.substr(0, Text.find_first_of(" \t")),
+           Filepath)
+    Text.remove_prefix(static_cast<size_t>(end - Text.data()));
+    return value;
+}
+
+// Chunks end after a line break, so no line is split between two of them
+std::vector<ObjChunk> SplitIntoChunks(const std::string_view Text, const uint32_t Count)
+{
+    std::vector<ObjChunk> chunks;
+    size_t begin = 0;
+    for (uint32_t chunk = 0; chunk < Count && begin < Text.size(); ++chunk) {
+        size_t end = std::max(begin, Text.size() * (chunk + 1) / Count);
+        end = Text.find('\n', end);
+        end = end == std::string_view::npos ? Text.size() : end + 1;
+
+        chunks.emplace_back().text = Text.substr(begin, end - begin);
+        begin = end;
+    }
+    return chunks;
+}
+
+void CountElements(ObjChunk &Chunk)
+{
+    ForEachLine(Chunk.text, [&](const std::string_view Line) {
+        if (StartsWithKeyword(Line, "v")) {
+            ++Chunk.positionCount;
+        }
+        else if (StartsWithKeyword(Line, "vt")) {
+            ++Chunk.texCoordCount;
+        }
+    });
+}
+
+// Writes the elements of the chunk at its offsets and collects its triangulated faces
+void ParseChunk(ObjChunk &Chunk,
+                const std::span<glm::vec3> Positions,
+                const std::span<glm::vec2> TexCoords,
+                const std::string_view Filepath)
+{
+    uint32_t positions = Chunk.positionOffset;
+    uint32_t tex_coords = Chunk.texCoordOffset;
+
+    // Indices start at 1, negative ones count back from the last element defined before the face
+    const auto resolve = [&](const int64_t Index, const uint32_t Defined, const size_t Total) {
+        const int64_t resolved = Index > 0 ? Index - 1 : static_cast<int64_t>(Defined) + Index;
+        ASSERT(Index != 0 && resolved >= 0 && static_cast<uint64_t>(resolved) < Total,
+               "Invalid face index {} in '{}'!",
+               Index,
+               Filepath)
+        return static_cast<uint32_t>(resolved);
+    };
+
+    std::vector<ObjCorner> face;
+    ForEachLine(Chunk.text, [&](std::string_view Line) {
+        if (StartsWithKeyword(Line, "v")) {
+            Line.remove_prefix(1);
+            glm::vec3 &position = Positions[positions++];
+            position.x = ParseValue<float>(Line, Filepath);
+            position.y = ParseValue<float>(Line, Filepath);
+            position.z = ParseValue<float>(Line, Filepath);
+        }
+        else if (StartsWithKeyword(Line, "vt")) {
+            Line.remove_prefix(2);
+            glm::vec2 &tex_coord = TexCoords[tex_coords++];
+            tex_coord.x = ParseValue<float>(Line, Filepath);
+            // v is optional and defaults to 0
+            tex_coord.y = 0.0f;
+            if (Line.find_first_not_of(" \t") != std::string_view::npos) {
+                tex_coord.y = ParseValue<float>(Line, Filepath);
+            }
+        }
+        else if (StartsWithKeyword(Line, "f")) {
+            Line.remove_prefix(1);
+            face.clear();
+            while (Line.find_first_not_of(" \t") != std::string_view::npos) {
+                ObjCorner corner{resolve(ParseValue<int64_t>(Line, Filepath), positions, Positions.size()),
+                                 NO_TEX_COORD};
+                if (!Line.empty() && Line.front() == '/') {
+                    Line.remove_prefix(1);
+                    if (!Line.empty() && Line.front() != '/') {
+                        corner.texCoord = resolve(
+                            ParseValue<int64_t>(Line, Filepath), tex_coords, TexCoords.size());
+                    }
+                    // Normal index, the vertex has no normal
+                    if (!Line.empty() && Line.front() == '/') {
+                        Line.remove_prefix(1);
+                        ParseValue<int64_t>(Line, Filepath);
+                    }
+                }
+                face.push_back(corner);
+            }
+
+            for (size_t corner = 2; corner < face.size(); ++corner) {
+                Chunk.corners.push_back(face[0]);
+                Chunk.corners.push_back(face[corner - 1]);
+                Chunk.corners.push_back(face[corner]);
+            }
+        }
+        else if (StartsWithKeyword(Line, "o") || StartsWithKeyword(Line, "g")) {
+            Chunk.groupStarts.push_back(static_cast<uint32_t>(Chunk.corners.size()));
+        }
+    });
+}
+
+GPU::Vulkan::Vertex MakeVertex(const ObjCorner &Corner,
+                               const std::span<const glm::vec3> Positions,
+                               const std::span<const glm::vec2> TexCoords)
+{
+    GPU::Vulkan::Vertex vertex{};
+    vertex.pos = Positions[Corner.position];
+    if (Corner.texCoord != NO_TEX_COORD) {
+        vertex.texCoord = {TexCoords[Corner.texCoord].x, 1.0f - TexCoords[Corner.texCoord].y};
+    }
+    vertex.color = {1.0f, 1.0f, 1.0f};
+    return vertex;
+}
+
+uint32_t GetWeldShard(const uint64_t Hash)
+{
+    return static_cast<uint32_t>(Hash >> (64 - WELD_SHARD_BITS));
+}
+
+// Assigns every corner of the shard to a unique vertex, corners are visited in file order
+void WeldShardVertices(WeldShard &Shard,
+                       const std::span<const ObjCorner> Corners,
+                       const std::span<const glm::vec3> Positions,
+                       const std::span<const glm::vec2> TexCoords,
+                       const std::span<uint32_t> CornerVertices)
+{
+    // Linear probing on the low bits of the hash, the top bits are the same for the whole shard
+    const size_t capacity = std::bit_ceil(std::max<size_t>(Shard.corners.size() * 2, 16));
+    const size_t mask = capacity - 1;
+    std::vector<WeldSlot> table(capacity, {0, EMPTY_SLOT});
+
+    for (const uint64_t corner : Shard.corners) {
+        const GPU::Vulkan::Vertex vertex = MakeVertex(Corners[corner], Positions, TexCoords);
+        const uint64_t hash = GPU::Vulkan::HashVertex(vertex);
+        for (size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+            WeldSlot &entry = table[slot];
+            if (entry.vertex == EMPTY_SLOT) {
+                entry = {hash, static_cast<uint32_t>(Shard.vertices.size())};
+                Shard.vertices.push_back(vertex);
+            }
+            else if (entry.hash != hash || !(Shard.vertices[entry.vertex] == vertex)) {
+                continue;
+            }
+            CornerVertices[corner] = entry.vertex;
+            break;
+        }
+    }
+}
+}  // namespace
+
+MeshData ImportObj(const std::string &AbsolutePath)
+{
+    PROFILE_ZONE("ImportObj");
+
+    const MappedFile file(AbsolutePath);
+    const std::string_view text(reinterpret_cast<const char *>(file.GetData().data()), file.GetData().size());
+    std::vector<ObjChunk> chunks = SplitIntoChunks(text, ThreadPool::GetConcurrency() * OBJ_CHUNKS_PER_THREAD);
+    const auto chunk_count = static_cast<uint32_t>(chunks.size());
+
+    // Elements are counted first so every chunk knows where its elements go and what negative indices refer to
+    ThreadPool::ParallelFor(chunk_count, [&](const uint32_t Chunk) { CountElements(chunks[Chunk]); });
+    uint32_t position_count = 0;
+    uint32_t tex_coord_count = 0;
+    for (auto &chunk : chunks) {
+        chunk.positionOffset = position_count;
+        chunk.texCoordOffset = tex_coord_count;
+        position_count += chunk.positionCount;
+        tex_coord_count += chunk.texCoordCount;
+    }
+
+    std::vector<glm::vec3> positions(position_count);
+    std::vector<glm::vec2> tex_coords(tex_coord_count);
+    {
+        PROFILE_ZONE("ParseObj");
+        ThreadPool::ParallelFor(chunk_count, [&](const uint32_t Chunk) {
+            ParseChunk(chunks[Chunk], positions, tex_coords, AbsolutePath);
+        });
+    }
+
+    MeshData mesh;
+    std::vector<uint64_t> group_starts = {0};
+    uint64_t corner_count = 0;
+    for (auto &chunk : chunks) {
+        chunk.cornerOffset = corner_count;
+        corner_count += chunk.corners.size();
+        for (const uint32_t start : chunk.groupStarts) {
+            group_starts.push_back(chunk.cornerOffset + start);
+        }
+    }
+    group_starts.push_back(corner_count);
+    for (size_t group = 0; group + 1 < group_starts.size(); ++group) {
+        if (group_starts[group + 1] > group_starts[group]) {
+            mesh.submeshes.push_back({static_cast<uint32_t>(group_starts[group]),
+                                      static_cast<uint32_t>(group_starts[group + 1] - group_starts[group])});
+        }
+    }
+
+    PROFILE_ZONE("WeldVertices");
+    std::vector<ObjCorner> corners(corner_count);
+    std::vector<uint8_t> corner_shards(corner_count);
+    std::vector<std::array<uint64_t, WELD_SHARD_COUNT>> chunk_shard_counts(chunk_count);
+    ThreadPool::ParallelFor(chunk_count, [&](const uint32_t Chunk) {
+        auto &chunk = chunks[Chunk];
+        auto &shard_counts = chunk_shard_counts[Chunk];
+        shard_counts.fill(0);
+        for (size_t i = 0; i < chunk.corners.size(); ++i) {
+            const ObjCorner &corner = chunk.corners[i];
+            const uint32_t shard = GetWeldShard(GPU::Vulkan::HashVertex(MakeVertex(corner, positions, tex_coords)));
+            corners[chunk.cornerOffset + i] = corner;
+            corner_shards[chunk.cornerOffset + i] = static_cast<uint8_t>(shard);
+            ++shard_counts[shard];
+        }
+        chunk.corners = {};
+    });
+
+    // Chunks write their corners into disjoint ranges of every shard, which keeps each shard in file order
+    std::array<WeldShard, WELD_SHARD_COUNT> shards;
+    for (uint32_t shard = 0; shard < WELD_SHARD_COUNT; ++shard) {
+        uint64_t shard_size = 0;
+        for (auto &shard_counts : chunk_shard_counts) {
+            const uint64_t count = shard_counts[shard];
+            shard_counts[shard] = shard_size;
+            shard_size += count;
+        }
+        shards[shard].corners.resize(shard_size);
+    }
+    ThreadPool::ParallelFor(chunk_count, [&](const uint32_t Chunk) {
+        auto &shard_offsets = chunk_shard_counts[Chunk];
+        const uint64_t end = Chunk + 1 < chunk_count ? chunks[Chunk + 1].cornerOffset : corner_count;
+        for (uint64_t corner = chunks[Chunk].cornerOffset; corner < end; ++corner) {
+            const uint8_t shard = corner_shards[corner];
+            shards[shard].corners[shard_offsets[shard]++] = corner;
+        }
+    });
+
+    std::vector<uint32_t> corner_vertices(corner_count);
+    ThreadPool::ParallelFor(WELD_SHARD_COUNT, [&](const uint32_t Shard) {
+        WeldShardVertices(shards[Shard], corners, positions, tex_coords, corner_vertices);
+        shards[Shard].corners = {};
+    });
+
+    size_t vertex_count = 0;
+    for (const auto &shard : shards) {
+        vertex_count += shard.vertices.size();
+    }
+    ASSERT(vertex_count <= size_t{std::numeric_limits<VertexIndex>::max()} + 1,
+           "'{}' has {} unique vertices, more than {} bit indices can address!",
+           AbsolutePath,
+           vertex_count,
+           sizeof(VertexIndex) * 8)
+
+    // Vertices are numbered by their first use like a serial import would, which keeps the order of the vertex
+    // buffer close to the order it is fetched in
+    std::array<std::vector<uint32_t>, WELD_SHARD_COUNT> shard_indices;
+    for (uint32_t shard = 0; shard < WELD_SHARD_COUNT; ++shard) {
+        shard_indices[shard].resize(shards[shard].vertices.size(), EMPTY_SLOT);
+    }
+    mesh.vertices.reserve(vertex_count);
+    mesh.indices.resize(corner_count);
+    for (uint64_t corner = 0; corner < corner_count; ++corner) {
+        const uint8_t shard = corner_shards[corner];
+        uint32_t &index = shard_indices[shard][corner_vertices[corner]];
+        if (index == EMPTY_SLOT) {
+            index = static_cast<uint32_t>(mesh.vertices.size());
+            mesh.vertices.push_back(shards[shard].vertices[corner_vertices[corner]]);
+        }
+        mesh.indices[corner] = static_cast<VertexIndex>(index);
+    }
+
+    mesh.bounds = Mesh::ComputeBounds(mesh.vertices, mesh.indices);
+    return mesh;
+}
+
+MeshData ImportObjTinyObj(const std::string &AbsolutePath)
+{
+    tinyobj::attrib_t attrib;
+    std::vector<tinyobj::shape_t> shapes;
+    std::vector<tinyobj::material_t> materials;
+    std::string warn, err;
+
+    PROFILE_ZONE("ImportObjTinyObj");
+    if (!tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err, AbsolutePath.c_str())) {
+        throw std::runtime_error(warn + err);
+    }
+
+    MeshData mesh;
+    std::unordered_map<GPU::Vulkan::Vertex, uint32_t> unique_vertices;
+
+    PROFILE_ZONE("Deduplicate Vertices");
+    for (const auto &shape : shapes) {
+        Submesh submesh{static_cast<uint32_t>(mesh.indices.size()), 0};
+        for (const auto &index : shape.mesh.indices) {
+            GPU::Vulkan::Vertex vertex{};
+
+            vertex.pos = {attrib.vertices[3 * index.vertex_index + 0],
+                          attrib.vertices[3 * index.vertex_index + 1],
+                          attrib.vertices[3 * index.vertex_index + 2]};
+
+            if (index.texcoord_index >= 0) {
+                vertex.texCoord = {attrib.texcoords[2 * index.texcoord_index + 0],
+                                   1.0f - attrib.texcoords[2 * index.texcoord_index + 1]};
+            }
+
+            vertex.color = {1.0f, 1.0f, 1.0f};
+
+            const auto [unique_vertex, inserted] = unique_vertices.try_emplace(
+                vertex, static_cast<uint32_t>(mesh.vertices.size()));
+            if (inserted) {
+                mesh.vertices.push_back(vertex);
+            }
+            mesh.indices.push_back(static_cast<VertexIndex>(unique_vertex->second));
+        }
+
+        submesh.indexCount = static_cast<uint32_t>(mesh.indices.size()) - submesh.firstIndex;
+        if (submesh.indexCount > 0) {
+            mesh.submeshes.push_back(submesh);
+        }
+    }
+    ASSERT(mesh.vertices.size() <= size_t{std::numeric_limits<VertexIndex>::max()} + 1,
+           "'{}' has {} unique vertices, more than {} bit indices can address!",
+           AbsolutePath,
+           mesh.vertices.size(),
+           sizeof(VertexIndex) * 8)
+
+    mesh.bounds = Mesh::ComputeBounds(mesh.vertices, mesh.indices);
+    return mesh;
+}
+}  // namespace Slipper
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "MeshFile.h"
+
+namespace Slipper
+{
+/* Parses the OBJ in chunks of lines on the ThreadPool and welds equal vertices in parallel. Faces with more than
+ * three corners are triangulated as fans and every object or group becomes a submesh. Normals, materials and
+ * smoothing groups are ignored, the Vertex has no room for them. Has to be called from outside the pool. */
+[[nodiscard]] MeshData ImportObj(const std::string &AbsolutePath);
+
+// Single threaded import through tinyobjloader, kept as the reference the parallel importer is measured against
+[[nodiscard]] MeshData ImportObjTinyObj(const std::string &AbsolutePath);
+}  // namespace Slipper
@@ -0,0 +1,139 @@
+#include "AssetCache.h"
+
+#include "Vulkan/vk_Settings.h"
+
+namespace Slipper
+{
+void AssetCache::Trim()
+{
+    std::vector<std::shared_ptr<AssetRecord>> evicted;
+    {
+        std::scoped_lock lock(m_mutex);
+        while (m_resident.Total() > settings.budgetBytes && !m_unreferenced.empty()) {
+            const std::shared_ptr<AssetRecord> oldest = m_unreferenced.front();
+            // Frames recorded before the last handle was released may still be reading the asset
+            if (oldest->releaseFrame + GPU::Vulkan::MAX_FRAMES_IN_FLIGHT > GPU::Vulkan::FRAME_COUNT) {
+                break;
+            }
+
+            ++m_stats.evictions;
+            m_stats.evictedBytes += oldest->memory.Total();
+            Detach(*oldest);
+            evicted.push_back(oldest);
+        }
+    }
+
+    if (!evicted.empty()) {
+        PROFILE_ZONE("AssetCache::Trim");
+        for (const auto &record : evicted) {
+            LOG_FORMAT("Unloaded unused {} '{}' to free {:.2f} MiB",
+                       magic_enum::enum_name(record->type),
+                       record->name,
+                       static_cast<double>(record->memory.Total()) / (1024.0 * 1024.0))
+        }
+        Unload(std::move(evicted));
+    }
+}
+
+void AssetCache::UnloadAll(const AssetType Type)
+{
+    std::vector<std::shared_ptr<AssetRecord>> records;
+    {
+        std::scoped_lock lock(m_mutex);
+        for (const auto &record : m_records | std::views::values) {
+            if (record->type == Type) {
+                records.push_back(record);
+            }
+        }
+        for (const auto &record : records) {
+            Detach(*record);
+        }
+    }
+    Unload(std::move(records));
+}
+
+void AssetCache::Shutdown()
+{
+    std::vector<std::shared_ptr<AssetRecord>> records;
+    {
+        std::scoped_lock lock(m_mutex);
+        for (const auto &record : m_records | std::views::values) {
+            records.push_back(record);
+        }
+        for (const auto &record : records) {
+            Detach(*record);
+        }
+        m_stats = {};
+    }
+    Unload(std::move(records));
+}
+
+AssetCacheStats AssetCache::GetStats()
+{
+    std::scoped_lock lock(m_mutex);
+    AssetCacheStats stats = m_stats;
+    stats.unreferencedAssets = static_cast<uint32_t>(m_unreferenced.size());
+    stats.referencedAssets = static_cast<uint32_t>(m_records.size()) - stats.unreferencedAssets;
+    stats.resident = m_resident;
+    for (const auto &record : m_unreferenced) {
+        stats.unreferencedBytes += record->memory.Total();
+    }
+    return stats;
+}
+
+std::vector<UnreferencedAsset> AssetCache::GetUnreferencedAssets()
+{
+    std::scoped_lock lock(m_mutex);
+    std::vector<UnreferencedAsset> assets;
+    assets.reserve(m_unreferenced.size());
+    for (const auto &record : m_unreferenced) {
+        assets.push_back({record->name, record->type, record->memory, record->releaseFrame});
+    }
+    return assets;
+}
+
+void AssetCache::Release(const std::weak_ptr<AssetRecord> &Record)
+{
+    const auto record = Record.lock();
+    std::scoped_lock lock(m_mutex);
+    // Unloaded while it was still referenced, e.g. during shutdown
+    if (!record || !record->address) {
+        return;
+    }
+    // Another thread may have acquired the asset again between the last release and taking the lock
+    if (!record->users.expired() || record->unreferencedEntry) {
+        return;
+    }
+    record->releaseFrame = GPU::Vulkan::FRAME_COUNT;
+    record->unreferencedEntry = m_unreferenced.insert(m_unreferenced.end(), record);
+}
+
+void AssetCache::SetMemory(AssetRecord &Record, const AssetMemory Memory)
+{
+    m_resident.cpuBytes = m_resident.cpuBytes - Record.memory.cpuBytes + Memory.cpuBytes;
+    m_resident.gpuBytes = m_resident.gpuBytes - Record.memory.gpuBytes + Memory.gpuBytes;
+    Record.memory = Memory;
+}
+
+void AssetCache::Detach(AssetRecord &Record)
+{
+    if (Record.unreferencedEntry) {
+        m_unreferenced.erase(*Record.unreferencedEntry);
+        Record.unreferencedEntry.reset();
+    }
+    m_records.erase(Record.address);
+    Record.address = nullptr;
+    m_resident.cpuBytes -= Record.memory.cpuBytes;
+    m_resident.gpuBytes -= Record.memory.gpuBytes;
+}
+
+void AssetCache::Unload(std::vector<std::shared_ptr<AssetRecord>> &&Records)
+{
+    for (const auto &record : Records) {
+        if (record->onUnload) {
+            record->onUnload();
+        }
+        record->asset.reset();
+    }
+}
+}  // namespace Slipper
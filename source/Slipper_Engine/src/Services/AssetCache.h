@@ -0,0 +1,255 @@
+#pragma once
+
+#include <list>
+
+namespace Slipper
+{
+    enum class AssetType : uint8_t
+    {
+        Model,
+        Texture,
+        Shader,
+    };
+
+    struct AssetMemory
+    {
+        uint64_t cpuBytes = 0;
+        // Size of the buffers and images, not of the memory blocks they were suballocated from
+        uint64_t gpuBytes = 0;
+
+        [[nodiscard]] uint64_t Total() const
+        {
+            return cpuBytes + gpuBytes;
+        }
+    };
+
+    /* Counted reference to an asset of the ModelManager, TextureManager or ShaderManager. The asset stays loaded as
+     * long as a handle refers to it, once the last one is gone it moves into the AssetCache and gets unloaded when
+     * the cache has to make room. Copying and releasing handles is thread safe. */
+    template<typename T> class AssetHandle
+    {
+        friend class AssetCache;
+        template<typename U> friend class AssetHandle;
+
+     public:
+        AssetHandle() = default;
+
+        AssetHandle(std::nullptr_t)
+        {
+        }
+
+        template<typename U>
+            requires std::is_convertible_v<U *, T *>
+        AssetHandle(const AssetHandle<U> &Other) : m_ptr(Other.m_ptr)
+        {
+        }
+
+        T &operator*() const
+        {
+            return *m_ptr;
+        }
+
+        T *operator->() const
+        {
+            return m_ptr.get();
+        }
+
+        T *get() const
+        {
+            return m_ptr.get();
+        }
+
+        operator T *() const
+        {
+            return m_ptr.get();
+        }
+
+        // The non owning pointer does not keep the asset loaded
+        template<typename U>
+            requires std::is_convertible_v<T *, U *>
+        operator NonOwningPtr<U>() const
+        {
+            return m_ptr.get();
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return IsValid();
+        }
+
+        [[nodiscard]] bool IsValid() const noexcept
+        {
+            return bool(m_ptr);
+        }
+
+        // Refers to the same asset if it is a U, invalid otherwise
+        template<typename U> AssetHandle<U> TryCast() const
+        {
+            return AssetHandle<U>(std::dynamic_pointer_cast<U>(m_ptr));
+        }
+
+     private:
+        explicit AssetHandle(std::shared_ptr<T> Ptr) : m_ptr(std::move(Ptr))
+        {
+        }
+
+     private:
+        std::shared_ptr<T> m_ptr;
+    };
+
+    struct AssetCacheSettings
+    {
+        /* Cpu and gpu memory of all loaded assets. Only unreferenced assets are unloaded to stay below it, so the
+         * assets that are in use can exceed it. */
+        uint64_t budgetBytes = 1ull << 30;
+    };
+
+    struct AssetCacheStats
+    {
+        uint32_t referencedAssets = 0;
+        uint32_t unreferencedAssets = 0;
+        // Referenced and unreferenced assets together
+        AssetMemory resident;
+        uint64_t unreferencedBytes = 0;
+        // Totals since startup
+        uint64_t evictions = 0;
+        uint64_t evictedBytes = 0;
+        // Unreferenced assets that were requested again before they had to be unloaded
+        uint64_t reuses = 0;
+    };
+
+    struct UnreferencedAsset
+    {
+        std::string name;
+        AssetType type;
+        AssetMemory memory;
+        uint64_t releaseFrame;
+    };
+
+    /* Owns the assets of the managers and tracks who uses them. Assets nobody holds a handle to stay loaded in least
+     * recently released order, so loading them again is free, until the resident memory exceeds the budget. */
+    class AssetCache
+    {
+        // Bookkeeping of one loaded asset, users is only alive while handles to the asset exist
+        struct AssetRecord
+        {
+            std::string name;
+            AssetType type;
+            AssetMemory memory;
+            std::shared_ptr<void> asset;
+            // Key of the record, see GetAddress. Null once the record was detached from the cache.
+            const void *address = nullptr;
+            std::weak_ptr<void> users;
+            std::function<void()> onUnload;
+            // Frame the last handle was released in
+            uint64_t releaseFrame = 0;
+            std::optional<std::list<std::shared_ptr<AssetRecord>>::iterator> unreferencedEntry;
+        };
+
+     public:
+        /* Takes ownership of the asset and returns the first handle to it. OnUnload has to remove the asset from the
+         * lookups of its manager, it runs on the main thread right before the asset is destroyed. */
+        template<typename T>
+        static AssetHandle<T> Register(std::string Name,
+                                       const AssetType Type,
+                                       T *Asset,
+                                       const AssetMemory Memory,
+                                       std::function<void()> OnUnload)
+        {
+            auto record = std::make_shared<AssetRecord>();
+            record->name = std::move(Name);
+            record->type = Type;
+            record->memory = Memory;
+            record->asset = std::shared_ptr<T>(Asset);
+            record->address = GetAddress(Asset);
+            record->onUnload = std::move(OnUnload);
+
+            std::scoped_lock lock(m_mutex);
+            ASSERT(m_records.emplace(record->address, record).second,
+                   "Asset '{}' is already registered!",
+                   record->name)
+            m_resident.cpuBytes += Memory.cpuBytes;
+            m_resident.gpuBytes += Memory.gpuBytes;
+            return Acquire(record, Asset);
+        }
+
+        // Handle to an asset that is only known by its pointer, invalid if the asset is not owned by the cache
+        template<typename T> static AssetHandle<T> Find(T *Asset)
+        {
+            if (!Asset) {
+                return {};
+            }
+
+            std::scoped_lock lock(m_mutex);
+            const auto record = m_records.find(GetAddress(Asset));
+            return record != m_records.end() ? Acquire(record->second, Asset) : AssetHandle<T>();
+        }
+
+        // For assets whose size changes after they were registered, e.g. textures that got their real image
+        template<typename T> static void UpdateMemory(T *Asset, const AssetMemory Memory)
+        {
+            std::scoped_lock lock(m_mutex);
+            if (const auto record = m_records.find(GetAddress(Asset)); record != m_records.end()) {
+                SetMemory(*record->second, Memory);
+            }
+        }
+
+        // Unloads the least recently released assets until the resident memory fits the budget, once per frame
+        static void Trim();
+        // Unloads every asset of the type, referenced or not. Handles that are still around dangle afterwards.
+        static void UnloadAll(AssetType Type);
+        static void Shutdown();
+
+        [[nodiscard]] static AssetCacheStats GetStats();
+        // From the next asset to be unloaded to the most recently released one
+        [[nodiscard]] static std::vector<UnreferencedAsset> GetUnreferencedAssets();
+
+     private:
+        // Address of the complete object, so pointers to different bases of an asset find the same record
+        template<typename T> static const void *GetAddress(T *Asset)
+        {
+            if constexpr (std::is_polymorphic_v<T>) {
+                return dynamic_cast<const void *>(Asset);
+            }
+            else {
+                return Asset;
+            }
+        }
+
+        // Has to be called with the mutex locked
+        template<typename T> static AssetHandle<T> Acquire(const std::shared_ptr<AssetRecord> &Record, T *Asset)
+        {
+            std::shared_ptr<void> users = Record->users.lock();
+            if (!users) {
+                // Holds no reference to the record, which would keep it alive through the weak users pointer
+                users = std::shared_ptr<void>(Record->asset.get(),
+                                              [Record = std::weak_ptr(Record)](void *) { Release(Record); });
+                Record->users = users;
+                if (Record->unreferencedEntry) {
+                    m_unreferenced.erase(*Record->unreferencedEntry);
+                    Record->unreferencedEntry.reset();
+                    ++m_stats.reuses;
+                }
+            }
+            return AssetHandle<T>(std::shared_ptr<T>(users, Asset));
+        }
+
+        static void Release(const std::weak_ptr<AssetRecord> &Record);
+        static void SetMemory(AssetRecord &Record, AssetMemory Memory);
+        // Removes the record from the cache, has to be called with the mutex locked
+        static void Detach(AssetRecord &Record);
+        // Destroys the detached assets, the mutex must not be locked since destructors may release other handles
+        static void Unload(std::vector<std::shared_ptr<AssetRecord>> &&Records);
+
+     public:
+        static inline AssetCacheSettings settings;
+
+     private:
+        static inline std::mutex m_mutex;
+        static inline std::unordered_map<const void *, std::shared_ptr<AssetRecord>> m_records;
+        // Least recently released first
+        static inline std::list<std::shared_ptr<AssetRecord>> m_unreferenced;
+        static inline AssetMemory m_resident;
+        static inline AssetCacheStats m_stats;
+    };
+}  // namespace Slipper
@@ -0,0 +1,87 @@
+#include "AssetTask.h"
+
+#include "TextureManager.h"
+#include "ThreadPool.h"
+
+namespace Slipper
+{
+bool AssetScheduler::WorkerAwaiter::await_ready() const noexcept
+{
+    return !ThreadPool::IsAvailable();
+}
+
+void AssetScheduler::WorkerAwaiter::await_suspend(const std::coroutine_handle<> Continuation) const
+{
+    ThreadPool::Get().Submit([Continuation] { Continuation.resume(); });
+}
+
+bool AssetScheduler::MainThreadAwaiter::await_ready() const noexcept
+{
+    return IsMainThread();
+}
+
+void AssetScheduler::MainThreadAwaiter::await_suspend(const std::coroutine_handle<> Continuation) const
+{
+    Post(Continuation);
+}
+
+void AssetScheduler::Init()
+{
+    m_mainThread = std::this_thread::get_id();
+}
+
+void AssetScheduler::Shutdown()
+{
+    RunUntil([] { return m_activeTasks == 0; });
+}
+
+void AssetScheduler::Update()
+{
+    PROFILE_ZONE("AssetScheduler::Update");
+    RunMainThreadWork();
+}
+
+void AssetScheduler::Post(const std::coroutine_handle<> Continuation)
+{
+    {
+        std::scoped_lock lock(m_mutex);
+        m_mainThreadWork.push_back(Continuation);
+    }
+    m_condition.notify_one();
+}
+
+void AssetScheduler::RunUntil(const std::function<bool()> &Done)
+{
+    ASSERT(IsMainThread(), "Loads can only be waited for on the main thread!")
+
+    while (!Done()) {
+        // Uploads the textures that finished decoding, which queues the loads that wait for them
+        TextureManager::Update();
+        if (RunMainThreadWork()) {
+            continue;
+        }
+
+        // Finished texture decodes do not notify the condition, so it is not waited on for long
+        std::unique_lock lock(m_mutex);
+        m_condition.wait_for(lock, std::chrono::milliseconds(1), [] { return !m_mainThreadWork.empty(); });
+    }
+}
+
+bool AssetScheduler::IsMainThread()
+{
+    return std::this_thread::get_id() == m_mainThread;
+}
+
+bool AssetScheduler::RunMainThreadWork()
+{
+    std::vector<std::coroutine_handle<>> work;
+    {
+        std::scoped_lock lock(m_mutex);
+        work.swap(m_mainThreadWork);
+    }
+    for (const auto continuation : work) {
+        continuation.resume();
+    }
+    return !work.empty();
+}
+}  // namespace Slipper
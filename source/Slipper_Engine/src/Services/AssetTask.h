@@ -0,0 +1,219 @@
+#pragma once
+
+#include <coroutine>
+
+namespace Slipper
+{
+    /* Decides where asset load coroutines continue. Loads hop to the ThreadPool for reading, decoding and reflecting
+     * and back to the main thread to create vulkan objects and register the asset, see ModelManager::LoadAsync. */
+    class AssetScheduler
+    {
+        template<typename T> friend class AssetTask;
+
+     public:
+        struct WorkerAwaiter
+        {
+            [[nodiscard]] bool await_ready() const noexcept;
+            void await_suspend(std::coroutine_handle<> Continuation) const;
+
+            void await_resume() const noexcept
+            {
+            }
+        };
+
+        struct MainThreadAwaiter
+        {
+            [[nodiscard]] bool await_ready() const noexcept;
+            void await_suspend(std::coroutine_handle<> Continuation) const;
+
+            void await_resume() const noexcept
+            {
+            }
+        };
+
+        // Has to be called from the main thread
+        static void Init();
+        // Finishes every load that was started, they may still need the workers and the main thread to do so
+        static void Shutdown();
+        // Continues the loads that wait for the main thread, called once per frame
+        static void Update();
+
+        // Continues on a worker, or right away if there is no ThreadPool
+        [[nodiscard]] static WorkerAwaiter ToWorker()
+        {
+            return {};
+        }
+
+        // Continues in the next Update, or right away if the coroutine already runs on the main thread
+        [[nodiscard]] static MainThreadAwaiter ToMainThread()
+        {
+            return {};
+        }
+
+        // Resumes the coroutine on the main thread in the next Update
+        static void Post(std::coroutine_handle<> Continuation);
+
+        /* Does the main thread work of all loads, including texture uploads, until Done returns true. Lets code that
+         * is no coroutine wait for loads, e.g. during startup. Has to be called from the main thread. */
+        static void RunUntil(const std::function<bool()> &Done);
+
+        [[nodiscard]] static bool IsMainThread();
+
+     private:
+        // Returns whether there was anything to continue
+        static bool RunMainThreadWork();
+
+     private:
+        static inline std::thread::id m_mainThread;
+        static inline std::mutex m_mutex;
+        static inline std::condition_variable m_condition;
+        static inline std::vector<std::coroutine_handle<>> m_mainThreadWork;
+        // Coroutines of loads that did not finish yet
+        static inline std::atomic<uint32_t> m_activeTasks = 0;
+    };
+
+    /* Result of a load that is written as a coroutine. The coroutine runs on the calling thread until it first
+     * suspends, so starting several loads before awaiting any of them lets them overlap. Any number of coroutines
+     * can co_await the same task, they continue on the thread that finished it. The loads of the managers always
+     * finish on the main thread. Copies refer to the same load. */
+    template<typename T> class AssetTask
+    {
+        struct State
+        {
+            std::mutex mutex;
+            bool finished = false;
+            std::optional<T> result;
+            std::exception_ptr error;
+            std::vector<std::coroutine_handle<>> continuations;
+
+            void Finish()
+            {
+                std::vector<std::coroutine_handle<>> waiting;
+                {
+                    std::scoped_lock lock(mutex);
+                    finished = true;
+                    waiting.swap(continuations);
+                }
+                for (const auto continuation : waiting)
+                {
+                    continuation.resume();
+                }
+            }
+        };
+
+     public:
+        struct promise_type
+        {
+            promise_type()
+            {
+                ++AssetScheduler::m_activeTasks;
+            }
+
+            ~promise_type()
+            {
+                --AssetScheduler::m_activeTasks;
+            }
+
+            // Destroys the coroutine before its dependents continue, so they do not run on top of its frame
+            struct FinalAwaiter
+            {
+                bool await_ready() const noexcept
+                {
+                    return false;
+                }
+
+                void await_suspend(const std::coroutine_handle<promise_type> Coroutine) const noexcept
+                {
+                    const std::shared_ptr<State> state = Coroutine.promise().state;
+                    Coroutine.destroy();
+                    state->Finish();
+                }
+
+                void await_resume() const noexcept
+                {
+                }
+            };
+
+            AssetTask get_return_object()
+            {
+                return AssetTask(state);
+            }
+
+            std::suspend_never initial_suspend() const noexcept
+            {
+                return {};
+            }
+
+            FinalAwaiter final_suspend() const noexcept
+            {
+                return {};
+            }
+
+            void return_value(T Value)
+            {
+                state->result = std::move(Value);
+            }
+
+            // Rethrown to everyone who awaits the task
+            void unhandled_exception()
+            {
+                state->error = std::current_exception();
+            }
+
+            std::shared_ptr<State> state = std::make_shared<State>();
+        };
+
+        AssetTask() = default;
+
+        [[nodiscard]] bool IsValid() const noexcept
+        {
+            return m_state != nullptr;
+        }
+
+        [[nodiscard]] bool IsReady() const
+        {
+            std::scoped_lock lock(m_state->mutex);
+            return m_state->finished;
+        }
+
+        // Blocks until the load finished, see AssetScheduler::RunUntil
+        T Wait() const
+        {
+            AssetScheduler::RunUntil([this] { return IsReady(); });
+            return await_resume();
+        }
+
+        bool await_ready() const
+        {
+            return IsReady();
+        }
+
+        bool await_suspend(const std::coroutine_handle<> Continuation) const
+        {
+            std::scoped_lock lock(m_state->mutex);
+            if (m_state->finished)
+            {
+                return false;
+            }
+            m_state->continuations.push_back(Continuation);
+            return true;
+        }
+
+        T await_resume() const
+        {
+            if (m_state->error)
+            {
+                std::rethrow_exception(m_state->error);
+            }
+            return *m_state->result;
+        }
+
+     private:
+        explicit AssetTask(std::shared_ptr<State> State) : m_state(std::move(State))
+        {
+        }
+
+     private:
+        std::shared_ptr<State> m_state;
+    };
+}  // namespace Slipper
@@ -33,33 +33,70 @@ namespace Slipper
         return m_materials.at(Name).get();
     }
 
-    void MaterialManager::AddUniformUpdate(const GPU::Material &Material,
-                                           const GPU::Vulkan::MaterialUniform UniformUpdate)
+    void MaterialManager::AddUniformUpdate(const GPU::Vulkan::Material &Material,
+                                           GPU::Vulkan::MaterialUniform &Uniform)
     {
-        auto &uniform_updates = m_uniformUpdates[&Material];
-        auto &[frame_updated, uniform] = uniform_updates
-                                             .try_emplace(&UniformUpdate.shaderBinding.get(),
-                                                          UniformUpdateFunc{0, UniformUpdate})
-                                             .first->second;
-        uniform = UniformUpdate;
+        constexpr uint8_t all_frames = (1u << GPU::Vulkan::MAX_FRAMES_IN_FLIGHT) - 1;
+        if (!Uniform.dirtyFrames)
+        {
+            m_uniformUpdates.push_back({&Material, &Uniform});
+        }
+        Uniform.dirtyFrames = all_frames;
+
+        auto &bindings = m_dataBindings[Uniform.data.get()];
+        const auto is_uniform = [&](const UniformUpdate &Binding) { return Binding.uniform.get() == &Uniform; };
+        if (std::ranges::none_of(bindings, is_uniform))
+        {
+            bindings.push_back({&Material, &Uniform});
+        }
+    }
+
+    void MaterialManager::RemoveUniformUpdates(const GPU::Vulkan::Material &Material)
+    {
+        const auto of_material = [&](const UniformUpdate &Update) { return Update.material == &Material; };
+        std::erase_if(m_uniformUpdates, of_material);
+        for (auto &bindings : m_dataBindings | std::views::values)
+        {
+            std::erase_if(bindings, of_material);
+        }
+    }
+
+    void MaterialManager::RefreshUniforms(const GPU::Vulkan::IShaderBindableData &Data)
+    {
+        const auto bindings = m_dataBindings.find(&Data);
+        if (bindings == m_dataBindings.end())
+            return;
+
+        std::erase_if(bindings->second,
+                      [&](const UniformUpdate &Binding) { return Binding.uniform->data.get() != &Data; });
+        for (const auto &[material, uniform] : bindings->second)
+        {
+            AddUniformUpdate(*material, *uniform);
+        }
     }
 
     void MaterialManager::OnUpdate()
     {
-        for (auto &[material, binding_update] : m_uniformUpdates)
+        const uint8_t frame_bit = 1u << GraphicsEngine::Get().GetCurrentFrame();
+
+        for (size_t i = 0; i < m_uniformUpdates.size();)
         {
-            for (auto map = binding_update.begin(); map != binding_update.end();)
+            auto &[material, uniform] = m_uniformUpdates[i];
+            if (uniform->dirtyFrames & frame_bit)
+            {
+                material->BindUniformForThisFrame(*uniform);
+                uniform->dirtyFrames &= ~frame_bit;
+            }
+
+            // Every frame slot got the update, order does not matter so swap and pop
+            if (!uniform->dirtyFrames)
+            {
+                m_uniformUpdates[i] = m_uniformUpdates.back();
+                m_uniformUpdates.pop_back();
+            }
+            else
             {
-                if (map->second.frames_updated >= GPU::Vulkan::MAX_FRAMES_IN_FLIGHT)
-                {
-                    map = binding_update.erase(map);
-                }
-                else
-                {
-                    material->BindUniformForThisFrame(map->second.uniform);
-                    map->second.frames_updated++;
-                    ++map;
-                }
+                ++i;
             }
         }
     }
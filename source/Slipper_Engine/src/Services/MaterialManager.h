@@ -9,6 +9,7 @@ namespace Slipper
     class MaterialManager : public AppComponent
     {
         friend GPU::Material;
+        friend GPU::Vulkan::Material;
 
      public:
         MaterialManager(const std::string_view &Name = "Material Manager") : AppComponent(Name)
@@ -20,22 +21,29 @@ namespace Slipper
         static NonOwningPtr<GPU::Material> GetMaterial(std::string Name);
         static std::optional<NonOwningPtr<GPU::Material>> TryGetMaterial(std::string Name);
 
+        // Updates the descriptor sets of every uniform bound to the data again, e.g. after a texture got a new image
+        static void RefreshUniforms(const GPU::Vulkan::IShaderBindableData &Data);
+
      private:
-        struct UniformUpdateFunc
+        struct UniformUpdate
         {
-            uint32_t frames_updated;
-            GPU::Vulkan::MaterialUniform uniform;
+            NonOwningPtr<const GPU::Vulkan::Material> material;
+            NonOwningPtr<GPU::Vulkan::MaterialUniform> uniform;
         };
 
-        static void AddUniformUpdate(const GPU::Material &Material, GPU::Vulkan::MaterialUniform UniformUpdate);
+        // Marks the uniform dirty for all frame slots, their descriptor sets get updated in OnUpdate
+        static void AddUniformUpdate(const GPU::Vulkan::Material &Material, GPU::Vulkan::MaterialUniform &Uniform);
+        static void RemoveUniformUpdates(const GPU::Vulkan::Material &Material);
 
         void OnUpdate() override;
 
      private:
+        // Only uniforms with pending frames are in here, so updating scales with the number of changes.
+        // Declared before the materials so it outlives them during static destruction.
+        static inline std::vector<UniformUpdate> m_uniformUpdates;
+        // Uniforms by the data that was bound to them, entries of uniforms that got other data are dropped lazily
+        static inline std::unordered_map<const GPU::Vulkan::IShaderBindableData *, std::vector<UniformUpdate>>
+            m_dataBindings;
         static inline std::unordered_map<std::string, OwningPtr<GPU::Material>> m_materials;
-        static inline std::unordered_map<
-            NonOwningPtr<const GPU::Material>,
-            std::unordered_map<NonOwningPtr<GPU::Vulkan::DescriptorSetLayoutBinding>, UniformUpdateFunc>>
-            m_uniformUpdates;
     };
 }  // namespace Slipper
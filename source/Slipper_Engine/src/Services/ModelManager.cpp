@@ -1,41 +1,90 @@
 #include "ModelManager.h"
 
 #include "File.h"
+#include "Filesystem/Path.h"
+#include "Model/MeshFile.h"
 #include "Model/Model.h"
 
 namespace Slipper
 {
-std::vector<OwningPtr<Model>> ModelManager::m_models;
 std::map<size_t, NonOwningPtr<Model>> ModelManager::m_namedModels;
 
-NonOwningPtr<Model> ModelManager::Load(std::string_view Filepath)
+AssetHandle<Model> ModelManager::Load(std::string_view Filepath)
 {
     const auto model_name = File::remove_file_type_from_name(File::get_file_name_from_path(Filepath));
     const auto model_name_hash = StringViewHash{}(model_name);
 
     if (m_namedModels.contains(model_name_hash)) {
         LOG_FORMAT("Returned already loaded model '{}'", model_name)
-        return m_namedModels.at(model_name_hash);
+        return AssetCache::Find(m_namedModels.at(model_name_hash).get());
     }
 
+    PROFILE_ZONE("ModelManager::Load");
     LOG_FORMAT("Loaded model '{}' from '{}'", model_name, Filepath);
-    auto &new_model = m_models.emplace_back(new Model(Filepath));
-    return m_namedModels.emplace(model_name_hash, new_model).first->second;
+    return Register(model_name, new Model(Filepath));
 }
 
-NonOwningPtr<Model> ModelManager::GetModel(std::string_view Name)
+AssetTask<AssetHandle<Model>> ModelManager::LoadAsync(const std::string Filepath)
+{
+    const auto model_name = File::remove_file_type_from_name(File::get_file_name_from_path(Filepath));
+    const auto model_name_hash = StringViewHash{}(model_name);
+    if (m_namedModels.contains(model_name_hash)) {
+        co_return AssetCache::Find(m_namedModels.at(model_name_hash).get());
+    }
+
+    co_await AssetScheduler::ToWorker();
+    const MappedMeshFile cooked = MapMeshFile(Path::make_engine_relative_path_absolute(Filepath));
+
+    co_await AssetScheduler::ToMainThread();
+    if (m_namedModels.contains(model_name_hash)) {
+        co_return AssetCache::Find(m_namedModels.at(model_name_hash).get());
+    }
+    PROFILE_ZONE("ModelManager::LoadAsync");
+    LOG_FORMAT("Loaded model '{}' from '{}'", model_name, Filepath);
+    co_return Register(model_name, new Model(File::get_file_name_from_path(Filepath), cooked.view));
+}
+
+AssetHandle<Model> ModelManager::Create(const std::string_view Name,
+                                        const std::span<const GPU::Vulkan::Vertex> Vertices,
+                                        const std::span<const VertexIndex> Indices)
 {
     const auto model_name_hash = StringViewHash{}(Name);
     if (m_namedModels.contains(model_name_hash)) {
-        return m_namedModels.at(model_name_hash);
+        LOG_FORMAT("Model '{}' already exists. Returned the existing one", Name)
+        return AssetCache::Find(m_namedModels.at(model_name_hash).get());
+    }
+
+    return Register(Name, new Model(Name, Vertices, Indices));
+}
+
+AssetHandle<Model> ModelManager::GetModel(std::string_view Name)
+{
+    const auto model_name_hash = StringViewHash{}(Name);
+    if (m_namedModels.contains(model_name_hash)) {
+        return AssetCache::Find(m_namedModels.at(model_name_hash).get());
     }
     LOG_FORMAT("Model '{}' does not exist!", Name);
     return nullptr;
 }
 
+AssetHandle<Model> ModelManager::Register(const std::string_view Name, Model *NewModel)
+{
+    const auto model_name_hash = StringViewHash{}(Name);
+    m_namedModels.emplace(model_name_hash, NewModel);
+
+    const Mesh &mesh = NewModel->GetMesh();
+    const AssetMemory memory = {sizeof(Model) + sizeof(Mesh),
+                                mesh.NumVertex() * sizeof(GPU::Vulkan::Vertex) +
+                                    mesh.NumIndex() * sizeof(VertexIndex)};
+    return AssetCache::Register(
+        std::string(Name), AssetType::Model, NewModel, memory, [model_name_hash] {
+            m_namedModels.erase(model_name_hash);
+        });
+}
+
 void ModelManager::Shutdown()
 {
+    AssetCache::UnloadAll(AssetType::Model);
     m_namedModels.clear();
-    m_models.clear();
 }
 }  // namespace Slipper
@@ -1,18 +1,37 @@
 #pragma once
 
+#include "AssetCache.h"
+#include "AssetTask.h"
+#include "Vulkan/vk_IndexBuffer.h"
+
 namespace Slipper
 {
+namespace GPU::Vulkan
+{
+struct Vertex;
+}
+
 class Model;
 
+// Models stay loaded while a handle to them exists, unused ones are unloaded by the AssetCache
 class ModelManager
 {
  public:
-    static NonOwningPtr<Model> Load(std::string_view Filepath);
-    static NonOwningPtr<Model> GetModel(std::string_view Name);
+    static AssetHandle<Model> Load(std::string_view Filepath);
+    /* Cooks and reads the mesh file on a worker and uploads it on the main thread, has to be started on the main
+     * thread. If another load of the model finished in the meantime its model is returned instead. */
+    static AssetTask<AssetHandle<Model>> LoadAsync(std::string Filepath);
+    // Registers a model built from generated geometry under the given name
+    static AssetHandle<Model> Create(std::string_view Name,
+                                     std::span<const GPU::Vulkan::Vertex> Vertices,
+                                     std::span<const VertexIndex> Indices);
+    static AssetHandle<Model> GetModel(std::string_view Name);
     static void Shutdown();
 
  private:
-    static std::vector<OwningPtr<Model>> m_models;
+    static AssetHandle<Model> Register(std::string_view Name, Model *NewModel);
+
+ private:
     static std::map<size_t, NonOwningPtr<Model>> m_namedModels;
 };
-}  // namespace Slipper
\ No newline at end of file
+}  // namespace Slipper
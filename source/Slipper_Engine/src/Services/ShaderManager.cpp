@@ -12,17 +12,17 @@ namespace Slipper
         enum class ShaderType;
     }
 
-    NonOwningPtr<GPU::Vulkan::Shader> ShaderManager::GetShader(const std::string_view &Name)
+    AssetHandle<GPU::Vulkan::Shader> ShaderManager::GetShader(const std::string_view &Name)
     {
         if (const auto hash = StringViewHash{}(Name); m_namedShaders.contains(hash))
         {
-            return m_namedShaders.at(hash);
+            return AssetCache::Find(m_namedShaders.at(hash).get());
         }
         LOG_FORMAT("Shader '{}' does not exist!", Name)
         return {};
     }
 
-    NonOwningPtr<GPU::Vulkan::GraphicsShader> ShaderManager::TryGetGraphicsShader(const std::string_view Name)
+    AssetHandle<GPU::Vulkan::GraphicsShader> ShaderManager::TryGetGraphicsShader(const std::string_view Name)
     {
         if (auto shader = GetShader(Name))
         {
@@ -31,7 +31,7 @@ namespace Slipper
         return nullptr;
     }
 
-    NonOwningPtr<GPU::Vulkan::ComputeShader> ShaderManager::TryGetComputeShader(const std::string_view Name)
+    AssetHandle<GPU::Vulkan::ComputeShader> ShaderManager::TryGetComputeShader(const std::string_view Name)
     {
         if (auto shader = GetShader(Name))
         {
@@ -40,25 +40,141 @@ namespace Slipper
         return nullptr;
     }
 
-    NonOwningPtr<GPU::Vulkan::GraphicsShader> ShaderManager::LoadGraphicsShader(
+    AssetHandle<GPU::Vulkan::GraphicsShader> ShaderManager::LoadGraphicsShader(
         const std::vector<std::string_view> &Filepaths)
     {
         const auto shader_name = File::remove_file_type_from_name(File::get_file_name_from_path(Filepaths[0]));
-        const auto hash = StringViewHash{}(shader_name);
-        if (m_namedShaders.contains(hash))
+        if (auto loaded = FindLoaded<GPU::Vulkan::GraphicsShader>(shader_name))
         {
-            if (auto shader = m_namedShaders.at(hash); shader.TryCast<GPU::Vulkan::GraphicsShader>())
-            {
-                LOG_FORMAT("Returned already loaded shader '{}'", shader_name)
-                return shader.TryCast<GPU::Vulkan::GraphicsShader>();
-            }
-            else
-            {
-                LOG_FORMAT("Returned null. Allready loaded shader '{}' is not a graphics shader.", shader_name)
-                return nullptr;
-            }
+            return loaded.value();
+        }
+
+        PROFILE_ZONE("ShaderManager::LoadGraphicsShader");
+        const auto shader_stages = GetGraphicsShaderStages(Filepaths);
+        const auto new_shader = new GPU::Vulkan::GraphicsShader(shader_stages);
+        LogLoadedShader(shader_name, shader_stages);
+        return Register(shader_name, new_shader, Filepaths);
+    }
+
+    AssetTask<AssetHandle<GPU::Vulkan::GraphicsShader>> ShaderManager::LoadGraphicsShaderAsync(
+        const std::vector<std::string> Filepaths)
+    {
+        const auto shader_name = File::remove_file_type_from_name(File::get_file_name_from_path(Filepaths[0]));
+        if (auto loaded = FindLoaded<GPU::Vulkan::GraphicsShader>(shader_name))
+        {
+            co_return loaded.value();
+        }
+
+        const std::vector<std::string_view> filepaths(Filepaths.begin(), Filepaths.end());
+        const auto shader_stages = GetGraphicsShaderStages(filepaths);
+        co_await AssetScheduler::ToWorker();
+        GPU::Vulkan::ShaderCode code = GPU::Vulkan::Shader::ReadCode(shader_stages);
+
+        co_await AssetScheduler::ToMainThread();
+        if (auto loaded = FindLoaded<GPU::Vulkan::GraphicsShader>(shader_name))
+        {
+            co_return loaded.value();
+        }
+        PROFILE_ZONE("ShaderManager::LoadGraphicsShaderAsync");
+        const auto new_shader = new GPU::Vulkan::GraphicsShader(std::move(code));
+        LogLoadedShader(shader_name, shader_stages);
+        co_return Register(shader_name, new_shader, filepaths);
+    }
+
+    AssetHandle<GPU::Vulkan::ComputeShader> ShaderManager::LoadComputeShader(const std::string_view Filepath)
+    {
+        const auto shader_name = File::remove_file_type_from_name(File::get_file_name_from_path(Filepath));
+        if (auto loaded = FindLoaded<GPU::Vulkan::ComputeShader>(shader_name))
+        {
+            return loaded.value();
+        }
+
+        PROFILE_ZONE("ShaderManager::LoadComputeShader");
+        auto file_ending = File::get_shader_type_from_spirv_path(Filepath);
+        if (file_ending != "comp")
+            ASSERT(false, "If you want to load Graphics Shaders use LoadGraphicsShader instead!")
+
+        const auto new_shader = new GPU::Vulkan::ComputeShader(Filepath);
+        LOG_FORMAT("Loaded Compute shader '{}'", shader_name);
+        return Register(shader_name, new_shader, std::span(&Filepath, 1));
+    }
+
+    AssetTask<AssetHandle<GPU::Vulkan::ComputeShader>> ShaderManager::LoadComputeShaderAsync(const std::string Filepath)
+    {
+        const auto shader_name = File::remove_file_type_from_name(File::get_file_name_from_path(Filepath));
+        if (auto loaded = FindLoaded<GPU::Vulkan::ComputeShader>(shader_name))
+        {
+            co_return loaded.value();
         }
 
+        if (File::get_shader_type_from_spirv_path(Filepath) != "comp")
+            ASSERT(false, "If you want to load Graphics Shaders use LoadGraphicsShaderAsync instead!")
+
+        const std::string_view filepath = Filepath;
+        co_await AssetScheduler::ToWorker();
+        GPU::Vulkan::ShaderCode code = GPU::Vulkan::Shader::ReadCode(
+            std::array{std::tuple(filepath, GPU::Vulkan::ShaderType::COMPUTE)});
+
+        co_await AssetScheduler::ToMainThread();
+        if (auto loaded = FindLoaded<GPU::Vulkan::ComputeShader>(shader_name))
+        {
+            co_return loaded.value();
+        }
+        PROFILE_ZONE("ShaderManager::LoadComputeShaderAsync");
+        const auto new_shader = new GPU::Vulkan::ComputeShader(std::move(code));
+        LOG_FORMAT("Loaded Compute shader '{}'", shader_name);
+        co_return Register(shader_name, new_shader, std::span(&filepath, 1));
+    }
+
+    void ShaderManager::RecreatePipelines(NonOwningPtr<const GPU::Vulkan::RenderPass> RenderPass)
+    {
+        for (const auto &graphics_shader : m_graphicsShaders)
+        {
+            graphics_shader->RecreatePipeline(RenderPass);
+        }
+    }
+
+    void ShaderManager::Shutdown()
+    {
+        AssetCache::UnloadAll(AssetType::Shader);
+        m_namedShaders.clear();
+        m_graphicsShaders.clear();
+    }
+
+    AssetMemory ShaderManager::GetShaderMemory(const std::span<const std::string_view> Filepaths)
+    {
+        AssetMemory memory;
+        for (const auto filepath : Filepaths)
+        {
+            std::error_code error;
+            const auto size = std::filesystem::file_size(filepath, error);
+            memory.cpuBytes += error ? 0 : size;
+        }
+        return memory;
+    }
+
+    template<typename T> std::optional<AssetHandle<T>> ShaderManager::FindLoaded(const std::string &Name)
+    {
+        const auto hash = StringViewHash{}(Name);
+        if (!m_namedShaders.contains(hash))
+        {
+            return {};
+        }
+
+        if (auto shader = AssetCache::Find(m_namedShaders.at(hash).get()).TryCast<T>())
+        {
+            LOG_FORMAT("Returned already loaded shader '{}'", Name)
+            return shader;
+        }
+        LOG_FORMAT("Returned null. Allready loaded shader '{}' is not a {} shader.",
+                   Name,
+                   std::is_same_v<T, GPU::Vulkan::GraphicsShader> ? "graphics" : "compute")
+        return AssetHandle<T>();
+    }
+
+    std::vector<std::tuple<std::string_view, GPU::Vulkan::ShaderType>> ShaderManager::GetGraphicsShaderStages(
+        const std::span<const std::string_view> Filepaths)
+    {
         std::vector<std::tuple<std::string_view, GPU::Vulkan::ShaderType>> shader_stages;
         for (auto &filepath : Filepaths)
         {
@@ -70,58 +186,46 @@ namespace Slipper
             else if (file_ending == "comp")
                 ASSERT(false, "If you want to load Compute Shaders use LoadComputeShader instead!")
         }
-        const auto &new_shader = m_graphicsShaders.emplace_back(new GPU::Vulkan::GraphicsShader(shader_stages));
-        if (shader_stages.size() == 1)
+        return shader_stages;
+    }
+
+    void ShaderManager::LogLoadedShader(
+        const std::string &Name, const std::span<const std::tuple<std::string_view, GPU::Vulkan::ShaderType>> Stages)
+    {
+        if (Stages.size() == 1)
         {
             LOG_FORMAT("Loaded {} shader '{}'",
-                       GPU::Vulkan::ShaderTypeNames[static_cast<int>(std::get<1>(shader_stages[0]))],
-                       shader_name);
+                       GPU::Vulkan::ShaderTypeNames[static_cast<int>(std::get<1>(Stages[0]))],
+                       Name);
         }
         else
         {
-            LOG_FORMAT("Loaded shader '{}' with shader stages: ", shader_name);
-            for (auto &[name, type] : shader_stages)
+            LOG_FORMAT("Loaded shader '{}' with shader stages: ", Name);
+            for (auto &[name, type] : Stages)
             {
                 LOG_FORMAT("\t{}", GPU::Vulkan::ShaderTypeNames[static_cast<int>(type)])
             }
         }
-
-        m_namedShaders.emplace(hash, NonOwningPtr<GPU::Vulkan::Shader>(new_shader)).first->second;
-        return new_shader;
     }
 
-    NonOwningPtr<GPU::Vulkan::ComputeShader> ShaderManager::LoadComputeShader(const std::string_view Filepath)
+    template<typename T>
+    AssetHandle<T> ShaderManager::Register(const std::string &Name,
+                                           T *Shader,
+                                           const std::span<const std::string_view> Filepaths)
     {
-        const auto shader_name = File::remove_file_type_from_name(File::get_file_name_from_path(Filepath));
-        const auto hash = StringViewHash{}(shader_name);
-        if (m_namedShaders.contains(hash))
+        const auto hash = StringViewHash{}(Name);
+        m_namedShaders.emplace(hash, NonOwningPtr<GPU::Vulkan::Shader>(Shader));
+        if constexpr (std::is_same_v<T, GPU::Vulkan::GraphicsShader>)
         {
-            if (auto shader = m_namedShaders.at(hash); shader.TryCast<GPU::Vulkan::ComputeShader>())
-            {
-                LOG_FORMAT("Returned already loaded shader '{}'", shader_name)
-                return shader.TryCast<GPU::Vulkan::ComputeShader>();
-            }
-            else
-            {
-                LOG_FORMAT("Returned null. Allready loaded shader '{}' is not a compute shader.", shader_name)
-                return nullptr;
-            }
+            m_graphicsShaders.emplace_back(Shader);
         }
 
-        auto file_ending = File::get_shader_type_from_spirv_path(Filepath);
-        if (file_ending != "comp")
-            ASSERT(false, "If you want to load Graphics Shaders use LoadGraphicsShader instead!")
-
-        const auto &new_shader = m_computeShaders.emplace_back(new GPU::Vulkan::ComputeShader(Filepath));
-        LOG_FORMAT("Loaded Compute shader '{}'", shader_name);
-        m_namedShaders.emplace(hash, NonOwningPtr<GPU::Vulkan::Shader>(new_shader)).first->second;
-        return new_shader;
-    }
-
-    void ShaderManager::Shutdown()
-    {
-        m_namedShaders.clear();
-        m_graphicsShaders.clear();
-        m_computeShaders.clear();
+        return AssetCache::Register(Name, AssetType::Shader, Shader, GetShaderMemory(Filepaths), [hash, Shader] {
+            m_namedShaders.erase(hash);
+            if constexpr (std::is_same_v<T, GPU::Vulkan::GraphicsShader>)
+            {
+                std::erase(m_graphicsShaders, NonOwningPtr<GPU::Vulkan::GraphicsShader>(Shader));
+            }
+        });
     }
 }  // namespace Slipper
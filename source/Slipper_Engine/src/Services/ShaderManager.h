@@ -1,28 +1,54 @@
 #pragma once
 
+#include "AssetCache.h"
+#include "AssetTask.h"
+
 namespace Slipper
 {
     namespace GPU::Vulkan
     {
         class ComputeShader;
         class GraphicsShader;
+        class RenderPass;
         class Shader;
+        enum class ShaderType;
     }
 
+    // Shaders stay loaded while a handle to them exists, e.g. the one of a material using them
     class ShaderManager
     {
      public:
-        static NonOwningPtr<GPU::Vulkan::Shader> GetShader(const std::string_view &Name);
-        static NonOwningPtr<GPU::Vulkan::GraphicsShader> TryGetGraphicsShader(const std::string_view Name);
-        static NonOwningPtr<GPU::Vulkan::ComputeShader> TryGetComputeShader(const std::string_view Name);
-        static NonOwningPtr<GPU::Vulkan::GraphicsShader> LoadGraphicsShader(
+        static AssetHandle<GPU::Vulkan::Shader> GetShader(const std::string_view &Name);
+        static AssetHandle<GPU::Vulkan::GraphicsShader> TryGetGraphicsShader(const std::string_view Name);
+        static AssetHandle<GPU::Vulkan::ComputeShader> TryGetComputeShader(const std::string_view Name);
+        static AssetHandle<GPU::Vulkan::GraphicsShader> LoadGraphicsShader(
             const std::vector<std::string_view> &Filepaths);
-        static NonOwningPtr<GPU::Vulkan::ComputeShader> LoadComputeShader(const std::string_view Filepaths);
+        static AssetHandle<GPU::Vulkan::ComputeShader> LoadComputeShader(const std::string_view Filepaths);
+        /* Read and reflect the spir-v on a worker and create the shader on the main thread, have to be started on
+         * the main thread. If another load of the shader finished in the meantime its shader is returned instead. */
+        static AssetTask<AssetHandle<GPU::Vulkan::GraphicsShader>> LoadGraphicsShaderAsync(
+            std::vector<std::string> Filepaths);
+        static AssetTask<AssetHandle<GPU::Vulkan::ComputeShader>> LoadComputeShaderAsync(std::string Filepath);
+        // Rebuilds the pipelines of all graphics shaders after the render pass has been recreated
+        static void RecreatePipelines(NonOwningPtr<const GPU::Vulkan::RenderPass> RenderPass);
         static void Shutdown();
 
      private:
-        static inline std::vector<OwningPtr<GPU::Vulkan::GraphicsShader>> m_graphicsShaders;
-        static inline std::vector<OwningPtr<GPU::Vulkan::ComputeShader>> m_computeShaders;
+        // Empty if no shader has the name, an invalid handle if the shader with the name is no T
+        template<typename T> static std::optional<AssetHandle<T>> FindLoaded(const std::string &Name);
+        static std::vector<std::tuple<std::string_view, GPU::Vulkan::ShaderType>> GetGraphicsShaderStages(
+            std::span<const std::string_view> Filepaths);
+        static void LogLoadedShader(const std::string &Name,
+                                    std::span<const std::tuple<std::string_view, GPU::Vulkan::ShaderType>> Stages);
+        // The spir-v is the only part of a shader whose size is known, pipelines live in driver memory
+        static AssetMemory GetShaderMemory(std::span<const std::string_view> Filepaths);
+        template<typename T>
+        static AssetHandle<T> Register(const std::string &Name,
+                                       T *Shader,
+                                       std::span<const std::string_view> Filepaths);
+
+     private:
+        static inline std::vector<NonOwningPtr<GPU::Vulkan::GraphicsShader>> m_graphicsShaders;
         static inline std::map<size_t, NonOwningPtr<GPU::Vulkan::Shader>> m_namedShaders;
     };
 }  // namespace Slipper
@@ -0,0 +1,84 @@
+#include "TextureCache.h"
+
+#include "Path.h"
+#include "VirtualFileSystem.h"
+#include "Vulkan/vk_BlockCompression.h"
+
+namespace Slipper
+{
+namespace
+{
+// Has to be bumped whenever GenerateMips changes its output, chains cooked by older versions are ignored then
+constexpr uint64_t MIP_GENERATOR_VERSION = 1;
+
+// 64 bit FNV-1a of the source file followed by everything that changes the cooked chain
+uint64_t HashCookInput(const std::span<const char> Source,
+                       const vk::Format Format,
+                       const GPU::Vulkan::MipGeneratorSettings &Settings)
+{
+    uint64_t hash = 14695981039346656037ull;
+    const auto append = [&hash](const void *Data, const size_t Size) {
+        for (size_t i = 0; i < Size; ++i) {
+            hash ^= static_cast<const uint8_t *>(Data)[i];
+            hash *= 1099511628211ull;
+        }
+    };
+
+    append(Source.data(), Source.size());
+    append(&MIP_GENERATOR_VERSION, sizeof(MIP_GENERATOR_VERSION));
+    append(&Format, sizeof(Format));
+    append(&Settings.filter, sizeof(Settings.filter));
+    append(&Settings.srgb, sizeof(Settings.srgb));
+    append(&Settings.preserveAlphaCoverage, sizeof(Settings.preserveAlphaCoverage));
+    append(&Settings.alphaTestReference, sizeof(Settings.alphaTestReference));
+    return hash;
+}
+}  // namespace
+
+GPU::Vulkan::KtxImage TextureCache::LoadCooked(const std::string &AbsolutePath, const vk::Format Format)
+{
+    PROFILE_ZONE("TextureCache::LoadCooked");
+
+    const VirtualFile source_file = VirtualFileSystem::Open(AbsolutePath);
+    const std::span<const char> source = source_file.GetChars();
+    GPU::Vulkan::MipGeneratorSettings mip_settings = settings;
+    mip_settings.srgb = GPU::Vulkan::IsSrgbFormat(Format);
+
+    const std::string cooked_path = std::format(
+        "{}/{:016x}.ktx2", GetCacheDirectory(), HashCookInput(source, Format, mip_settings));
+    if (std::filesystem::exists(cooked_path)) {
+        auto image = GPU::Vulkan::LoadKtx2(cooked_path);
+        image.filepath = AbsolutePath;
+        return image;
+    }
+
+    int width, height, channels;
+    stbi_uc *pixels = stbi_load_from_memory(reinterpret_cast<const stbi_uc *>(source.data()),
+                                            static_cast<int>(source.size()),
+                                            &width,
+                                            &height,
+                                            &channels,
+                                            STBI_rgb_alpha);
+    if (!pixels) {
+        throw std::runtime_error("Failed to load texture image!");
+    }
+
+    GPU::Vulkan::KtxImage image;
+    image.format = Format;
+    image.extent = vk::Extent3D(static_cast<uint32_t>(width), static_cast<uint32_t>(height), 1);
+    image.levels = GPU::Vulkan::GenerateMips(pixels, image.extent, mip_settings);
+    image.filepath = AbsolutePath;
+    stbi_image_free(pixels);
+
+    std::filesystem::create_directories(GetCacheDirectory());
+    GPU::Vulkan::SaveKtx2(image, cooked_path);
+
+    LOG_FORMAT("Cooked {} mips of '{}' into {}", image.levels.size(), AbsolutePath, cooked_path)
+    return image;
+}
+
+std::string TextureCache::GetCacheDirectory()
+{
+    return Path::make_engine_relative_path_absolute("./Cache/Textures");
+}
+}  // namespace Slipper
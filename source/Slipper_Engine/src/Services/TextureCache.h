@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Vulkan/vk_Ktx.h"
+#include "Vulkan/vk_MipGenerator.h"
+
+namespace Slipper
+{
+    /* Cooked mip chains of source images. The first load of an image builds its chain on the cpu and stores it as a
+     * KTX2 file named after the hash of the source file and the generator settings, later loads of the same content
+     * only read the chain back. Editing the image or changing the settings gives it a new entry. */
+    class TextureCache
+    {
+     public:
+        // Chain of the image at the absolute path, the image is cooked first if it has no entry yet
+        static GPU::Vulkan::KtxImage LoadCooked(const std::string &AbsolutePath, vk::Format Format);
+
+        static std::string GetCacheDirectory();
+
+     public:
+        // Srgb is taken from the format of every load
+        static inline GPU::Vulkan::MipGeneratorSettings settings;
+    };
+}  // namespace Slipper
@@ -1,61 +1,311 @@
 #include "TextureManager.h"
 
 #include "File.h"
+#include "MaterialManager.h"
 #include "Path.h"
+#include "TextureCache.h"
+#include "ThreadPool.h"
+#include "VirtualFileSystem.h"
 #include "Texture/Texture2D.h"
 
 #include "Texture/DepthBuffer.h"
+#include "Vulkan/vk_Device.h"
+#include "Vulkan/vk_Ktx.h"
+#include "Vulkan/vk_TextureStreamer.h"
 
 namespace Slipper
 {
-NonOwningPtr<Texture2D> TextureManager::Load2D(std::string_view Filepath, bool GenerateMipMaps)
+// Neutral grey so materials look plausible until the real image arrives
+const std::vector<uint8_t> PLACEHOLDER_PIXEL = {128, 128, 128, 255};
+
+void TextureHandle::State::Finish(const TextureLoadState FinalState)
+{
+    std::vector<std::coroutine_handle<>> waiting;
+    {
+        std::scoped_lock lock(mutex);
+        state = FinalState;
+        waiting.swap(continuations);
+    }
+    for (const auto continuation : waiting) {
+        AssetScheduler::Post(continuation);
+    }
+}
+
+bool TextureHandle::await_suspend(const std::coroutine_handle<> Continuation) const
+{
+    if (!m_state) {
+        return false;
+    }
+
+    std::scoped_lock lock(m_state->mutex);
+    if (m_state->state != TextureLoadState::Decoding) {
+        return false;
+    }
+    m_state->continuations.push_back(Continuation);
+    return true;
+}
+
+AssetHandle<Texture2D> TextureHandle::Wait() const
+{
+    ASSERT(AssetScheduler::IsMainThread(), "Texture loads can only be waited for on the main thread!")
+
+    if (!m_state) {
+        return nullptr;
+    }
+
+    while (m_state->state == TextureLoadState::Decoding) {
+        {
+            std::unique_lock lock(TextureManager::m_decodedMutex);
+            TextureManager::m_decodedCondition.wait(lock,
+                                                    [] { return !TextureManager::m_decodedTextures.empty(); });
+        }
+        TextureManager::Update();
+    }
+    return m_state->texture;
+}
+
+AssetHandle<Texture2D> TextureManager::Load2D(std::string_view Filepath, bool GenerateMipMaps)
 {
     const auto texture_name = File::get_file_name_from_path(Filepath);
-    if (m_namedTextures.contains(texture_name)) {
-        if (m_namedTextures.at(texture_name)->GetImageInfo().type != vk::ImageType::e2D) {
-            LOG_FORMAT(
-                "Texture '{}' allready exists with another type. Rename the texture or load "
-                "another one.",
-                texture_name)
-            return nullptr;
+    TextureHandle pending_load;
+    std::shared_ptr<TextureHandle::State> state;
+    {
+        std::scoped_lock lock(m_registryMutex);
+        if (const auto load = m_pendingLoads.find(texture_name); load != m_pendingLoads.end()) {
+            pending_load = load->second;
         }
-        return m_namedTextures.at(texture_name)->As<Texture2D>();
+        else if (m_namedTextures.contains(texture_name)) {
+            if (m_namedTextures.at(texture_name)->GetImageInfo().type != vk::ImageType::e2D) {
+                LOG_FORMAT(
+                    "Texture '{}' allready exists with another type. Rename the texture or load "
+                    "another one.",
+                    texture_name)
+                return nullptr;
+            }
+            return AssetCache::Find(m_namedTextures.at(texture_name)->As<Texture2D>().get());
+        }
+        else {
+            // Claimed in the same lock as the lookup, so a second load of the name waits for this one
+            state = std::make_shared<TextureHandle::State>();
+            state->name = texture_name;
+            m_pendingLoads.emplace(texture_name, TextureHandle(state));
+        }
+    }
+    // The texture is already being decoded, finishing that load is all that is left to do
+    if (pending_load.IsValid()) {
+        return pending_load.Wait();
+    }
+
+    PROFILE_ZONE("TextureManager::Load2D");
+    Texture2D *new_texture;
+    try {
+        new_texture = CreateTexture2D(Decode(Path::make_engine_relative_path_absolute(Filepath), GenerateMipMaps));
+    }
+    catch (...) {
+        {
+            std::scoped_lock lock(m_registryMutex);
+            m_pendingLoads.erase(texture_name);
+        }
+        state->Finish(TextureLoadState::Failed);
+        throw;
+    }
+
+    state->texture = Register(texture_name, new_texture);
+    {
+        std::scoped_lock lock(m_registryMutex);
+        m_pendingLoads.erase(texture_name);
+    }
+    state->Finish(TextureLoadState::Loaded);
+    LOG_FORMAT("Loaded texture '{}' from {}", texture_name, Filepath);
+    return state->texture;
+}
+
+TextureHandle TextureManager::LoadAsync(std::string_view Filepath, const bool GenerateMipMaps)
+{
+    const auto texture_name = File::get_file_name_from_path(Filepath);
+    auto state = std::make_shared<TextureHandle::State>();
+    state->name = texture_name;
+    const TextureHandle handle(state);
+    {
+        std::scoped_lock lock(m_registryMutex);
+        if (const auto load = m_pendingLoads.find(texture_name); load != m_pendingLoads.end()) {
+            return load->second;
+        }
+        if (const auto texture = m_namedTextures.find(texture_name); texture != m_namedTextures.end()) {
+            if (texture->second->GetImageInfo().type != vk::ImageType::e2D) {
+                LOG_FORMAT("Texture '{}' is of other type than Texture2D. Returned an invalid handle", texture_name)
+                return {};
+            }
+            state->texture = AssetCache::Find(texture->second->As<Texture2D>().get());
+            state->state = TextureLoadState::Loaded;
+            return handle;
+        }
+        // Claimed in the same lock as the lookup, so a second load of the name gets this handle
+        m_pendingLoads.emplace(texture_name, handle);
     }
 
-    VkExtent3D tex_dimensions{0, 0, 1};
+    PROFILE_ZONE("TextureManager::LoadAsync");
     std::string absolute_path = Path::make_engine_relative_path_absolute(Filepath);
-    stbi_uc *pixels = nullptr;
+
+    // Every load gets its own placeholder image, it is swapped for the real one once that was uploaded
+    GPU::Vulkan::KtxImage placeholder;
+    placeholder.format = Engine::TARGET_VIEWPORT_TEXTURE_FORMAT;
+    placeholder.extent = vk::Extent3D(1, 1, 1);
+    placeholder.levels.push_back(PLACEHOLDER_PIXEL);
+    placeholder.filepath = absolute_path;
+
+    state->texture = Register(texture_name, new Texture2D(placeholder));
+
+    auto decode = [state, absolute_path = std::move(absolute_path), GenerateMipMaps] {
+        DecodedTexture decoded{state};
+        try {
+            decoded.image = Decode(absolute_path, GenerateMipMaps);
+        }
+        catch (const std::exception &Exception) {
+            decoded.error = Exception.what();
+        }
+
+        {
+            std::scoped_lock lock(m_decodedMutex);
+            m_decodedTextures.push_back(std::move(decoded));
+        }
+        m_decodedCondition.notify_all();
+    };
+    if (ThreadPool::IsAvailable()) {
+        ThreadPool::Get().Submit(std::move(decode));
+    }
+    else {
+        decode();
+    }
+    return handle;
+}
+
+void TextureManager::Update()
+{
+    std::vector<DecodedTexture> decoded_textures;
     {
-        int tex_width, tex_height, tex_channels;
-        pixels = stbi_load(
-            absolute_path.c_str(), &tex_width, &tex_height, &tex_channels, STBI_rgb_alpha);
+        std::scoped_lock lock(m_decodedMutex);
+        decoded_textures.swap(m_decodedTextures);
+    }
+    if (!decoded_textures.empty()) {
+        PROFILE_ZONE("TextureManager::FinishLoads");
+        for (auto &decoded : decoded_textures) {
+            FinishLoad(std::move(decoded));
+        }
+    }
+
+    while (!m_retiredTextures.empty() && m_retiredTextures.front().first <= GPU::Vulkan::FRAME_COUNT) {
+        m_retiredTextures.pop_front();
+    }
+}
+
+GPU::Vulkan::KtxImage TextureManager::Decode(const std::string &AbsolutePath, const bool GenerateMipMaps)
+{
+    PROFILE_ZONE("TextureManager::Decode");
 
-        tex_dimensions.width = tex_width;
-        tex_dimensions.height = tex_height;
+    if (AbsolutePath.ends_with(".ktx2")) {
+        // Blocks the device can not sample are decoded on the cpu
+        auto image = GPU::Vulkan::LoadKtx2(AbsolutePath);
+        GPU::Vulkan::TranscodeIfUnsupported(image);
+        return image;
     }
 
+    // Mip chains are built once on import, later loads only read the cooked chain
+    if (GenerateMipMaps) {
+        return TextureCache::LoadCooked(AbsolutePath, Engine::TARGET_VIEWPORT_TEXTURE_FORMAT);
+    }
+
+    const VirtualFile file = VirtualFileSystem::Open(AbsolutePath);
+    int tex_width, tex_height, tex_channels;
+    stbi_uc *pixels = stbi_load_from_memory(reinterpret_cast<const stbi_uc *>(file.GetData().data()),
+                                            static_cast<int>(file.GetSize()),
+                                            &tex_width,
+                                            &tex_height,
+                                            &tex_channels,
+                                            STBI_rgb_alpha);
     if (!pixels) {
         throw std::runtime_error("Failed to load texture image!");
     }
 
-    const auto image = StbImage(
-        pixels, tex_dimensions, Engine::TARGET_VIEWPORT_TEXTURE_FORMAT, std::move(absolute_path));
+    GPU::Vulkan::KtxImage image;
+    image.format = Engine::TARGET_VIEWPORT_TEXTURE_FORMAT;
+    image.extent = vk::Extent3D(static_cast<uint32_t>(tex_width), static_cast<uint32_t>(tex_height), 1);
+    image.levels.emplace_back(pixels, pixels + static_cast<size_t>(tex_width) * tex_height * 4);
+    image.filepath = AbsolutePath;
+    stbi_image_free(pixels);
+    return image;
+}
 
-    const auto &new_texture =
-        m_textures.emplace_back(new Texture2D(image, GenerateMipMaps))->As<Texture2D>();
-    m_namedTextures.emplace(texture_name, new_texture);
-    LOG_FORMAT("Loaded texture '{}' from {}", texture_name, Filepath);
-    return new_texture;
+Texture2D *TextureManager::CreateTexture2D(GPU::Vulkan::KtxImage &&Image)
+{
+    // Streamed textures start with their low mips only, the rest is uploaded once rendering needs it
+    if (Image.levels.size() > 1 && GPU::Vulkan::TextureStreamer::IsAvailable()) {
+        return GPU::Vulkan::TextureStreamer::Get().CreateTexture2D(std::move(Image));
+    }
+    return new Texture2D(Image);
+}
+
+void TextureManager::FinishLoad(DecodedTexture &&Decoded)
+{
+    TextureHandle::State &state = *Decoded.state;
+    {
+        std::scoped_lock lock(m_registryMutex);
+        m_pendingLoads.erase(state.name);
+    }
+
+    if (!Decoded.image) {
+        LOG_FORMAT("Failed to load texture '{}', keeping its placeholder: {}", state.name, Decoded.error)
+        state.Finish(TextureLoadState::Failed);
+        return;
+    }
+
+    // The texture keeps its identity so materials that bound the placeholder pick up the image without rebinding
+    Texture2D &texture = *state.texture;
+    OwningPtr<Texture> loaded(CreateTexture2D(std::move(Decoded.image.value())));
+    texture.SwapImage(*loaded);
+    if (GPU::Vulkan::TextureStreamer::IsAvailable()) {
+        GPU::Vulkan::TextureStreamer::Get().Transfer(*loaded, texture);
+    }
+    texture.ReregisterBindless();
+    MaterialManager::RefreshUniforms(texture);
+    AssetCache::UpdateMemory(&texture, GetTextureMemory(texture));
+    m_retiredTextures.emplace_back(GPU::Vulkan::FRAME_COUNT + GPU::Vulkan::MAX_FRAMES_IN_FLIGHT, std::move(loaded));
+
+    LOG_FORMAT("Loaded texture '{}' from {}", state.name, texture.filepath);
+    state.Finish(TextureLoadState::Loaded);
 }
 
-NonOwningPtr<Texture2D> TextureManager::Get2D(const std::string &Name)
+AssetHandle<Texture2D> TextureManager::Register(const std::string &Name, Texture2D *Texture)
 {
+    // Gives the texture an index that materials can use instead of a descriptor binding
+    Texture->RegisterBindless();
+
+    {
+        std::scoped_lock lock(m_registryMutex);
+        m_namedTextures.emplace(Name, Texture);
+    }
+    return AssetCache::Register(Name, AssetType::Texture, Texture, GetTextureMemory(*Texture), [Name] {
+        std::scoped_lock lock(m_registryMutex);
+        m_namedTextures.erase(Name);
+    });
+}
+
+AssetMemory TextureManager::GetTextureMemory(const Texture &Texture)
+{
+    // Streamed textures only count the mips that were resident when this was called
+    return {sizeof(Texture2D),
+            GPU::Vulkan::VKDevice::Get().logicalDevice.getImageMemoryRequirements(static_cast<vk::Image>(Texture)).size};
+}
+
+AssetHandle<Texture2D> TextureManager::Get2D(const std::string &Name)
+{
+    std::scoped_lock lock(m_registryMutex);
     if (m_namedTextures.contains(Name)) {
         if (m_namedTextures.at(Name)->GetImageInfo().type != vk::ImageType::e2D) {
             LOG_FORMAT("Texture '{}' is of other type than Texture2D. Returned nullptr", Name)
             return nullptr;
         }
-        return m_namedTextures.at(Name)->As<Texture2D>();
+        return AssetCache::Find(m_namedTextures.at(Name)->As<Texture2D>().get());
     }
     LOG_FORMAT("Texture '{}' does not exist.", Name)
     return nullptr;
@@ -63,8 +313,14 @@ NonOwningPtr<Texture2D> TextureManager::Get2D(const std::string &Name)
 
 void TextureManager::Shutdown()
 {
+    {
+        std::scoped_lock lock(m_decodedMutex);
+        m_decodedTextures.clear();
+    }
+    m_pendingLoads.clear();
+    m_retiredTextures.clear();
+    AssetCache::UnloadAll(AssetType::Texture);
     m_namedTextures.clear();
-    m_textures.clear();
 }
 
 std::map<std::string, NonOwningPtr<Texture>> &TextureManager::GetTextures()
@@ -74,6 +330,7 @@ std::map<std::string, NonOwningPtr<Texture>> &TextureManager::GetTextures()
 
 const std::string &TextureManager::GetTextureName(NonOwningPtr<const Texture> Texture)
 {
+    std::scoped_lock lock(m_registryMutex);
     for (const auto &[name, texture] : m_namedTextures) {
         if (texture.get() == Texture.get()) {
             return name;
@@ -1,5 +1,9 @@
 #pragma once
 
+#include "AssetCache.h"
+#include "AssetTask.h"
+#include "Vulkan/vk_Ktx.h"
+
 namespace Slipper
 {
     namespace GPU::Vulkan
@@ -8,17 +12,131 @@ namespace Slipper
         class Texture2D;
     }  // namespace GPU::Vulkan
 
+    enum class TextureLoadState : uint8_t
+    {
+        Decoding,
+        Loaded,
+        // The texture keeps its placeholder image
+        Failed,
+    };
+
+    /* Texture that is decoded on the worker threads. The texture exists as soon as the load starts with a 1x1
+     * placeholder image, so it can be bound to materials right away, and gets its real image once it was uploaded.
+     * Copies refer to the same load. Coroutines can co_await the handle, they continue on the main thread once the
+     * load finished and get the texture. */
+    class TextureHandle
+    {
+        friend class TextureManager;
+
+        struct State
+        {
+            AssetHandle<GPU::Vulkan::Texture2D> texture;
+            std::string name;
+            std::atomic<TextureLoadState> state = TextureLoadState::Decoding;
+            // Guards leaving the decoding state against coroutines starting to wait for it
+            std::mutex mutex;
+            std::vector<std::coroutine_handle<>> continuations;
+
+            // Sets the final state and hands the waiting coroutines to the AssetScheduler
+            void Finish(TextureLoadState FinalState);
+        };
+
+     public:
+        TextureHandle() = default;
+
+        // Placeholder until the load finished, null if the handle does not refer to a load
+        [[nodiscard]] AssetHandle<GPU::Vulkan::Texture2D> Get() const
+        {
+            return m_state ? m_state->texture : nullptr;
+        }
+
+        [[nodiscard]] TextureLoadState GetState() const
+        {
+            return m_state ? m_state->state.load() : TextureLoadState::Failed;
+        }
+
+        [[nodiscard]] bool IsLoaded() const
+        {
+            return GetState() == TextureLoadState::Loaded;
+        }
+
+        [[nodiscard]] bool IsValid() const
+        {
+            return m_state != nullptr;
+        }
+
+        // Blocks until decoding finished and uploads the texture, has to be called from the main thread
+        AssetHandle<GPU::Vulkan::Texture2D> Wait() const;
+
+        [[nodiscard]] bool await_ready() const
+        {
+            return GetState() != TextureLoadState::Decoding;
+        }
+
+        bool await_suspend(std::coroutine_handle<> Continuation) const;
+
+        // The placeholder if the load failed
+        AssetHandle<GPU::Vulkan::Texture2D> await_resume() const
+        {
+            return Get();
+        }
+
+     private:
+        explicit TextureHandle(std::shared_ptr<State> State) : m_state(std::move(State))
+        {
+        }
+
+     private:
+        std::shared_ptr<State> m_state;
+    };
+
+    /* Loaded textures by name, the AssetCache owns them and unloads them once they are unused. Loading and
+     * uploading has to happen on the main thread, lookups are synchronized and may be done from any thread. */
     class TextureManager
     {
+        friend TextureHandle;
+
+        // Decoded image of an asynchronous load, or the reason it failed
+        struct DecodedTexture
+        {
+            std::shared_ptr<TextureHandle::State> state;
+            std::optional<GPU::Vulkan::KtxImage> image;
+            std::string error;
+        };
+
      public:
-        static NonOwningPtr<GPU::Vulkan::Texture2D> Load2D(std::string_view Filepath, bool GenerateMipMaps);
-        static NonOwningPtr<GPU::Vulkan::Texture2D> Get2D(const std::string &Name);
+        static AssetHandle<GPU::Vulkan::Texture2D> Load2D(std::string_view Filepath, bool GenerateMipMaps);
+        // Decodes the file on the ThreadPool, the upload happens in the first Update after decoding finished
+        static TextureHandle LoadAsync(std::string_view Filepath, bool GenerateMipMaps);
+        static AssetHandle<GPU::Vulkan::Texture2D> Get2D(const std::string &Name);
+        // Uploads the textures that finished decoding, called once per frame after the frame slot is free again
+        static void Update();
         static void Shutdown();
+        // Not synchronized, only use it on the main thread
         static std::map<std::string, NonOwningPtr<GPU::Vulkan::Texture>> &GetTextures();
         static const std::string &GetTextureName(NonOwningPtr<const GPU::Vulkan::Texture> Texture);
 
      private:
-        static inline std::vector<OwningPtr<GPU::Vulkan::Texture>> m_textures;
+        // Reads the file into a chain that is ready for upload, safe to call from worker threads
+        static GPU::Vulkan::KtxImage Decode(const std::string &AbsolutePath, bool GenerateMipMaps);
+        // Streams the chain if it has mips to stream, otherwise uploads it whole
+        static GPU::Vulkan::Texture2D *CreateTexture2D(GPU::Vulkan::KtxImage &&Image);
+        // Gives the texture of the load its decoded image
+        static void FinishLoad(DecodedTexture &&Decoded);
+
+        static AssetHandle<GPU::Vulkan::Texture2D> Register(const std::string &Name, GPU::Vulkan::Texture2D *Texture);
+        static AssetMemory GetTextureMemory(const GPU::Vulkan::Texture &Texture);
+
+     private:
         static inline std::map<std::string, NonOwningPtr<GPU::Vulkan::Texture>> m_namedTextures;
+        static inline std::unordered_map<std::string, TextureHandle> m_pendingLoads;
+        static inline std::mutex m_registryMutex;
+
+        static inline std::vector<DecodedTexture> m_decodedTextures;
+        static inline std::mutex m_decodedMutex;
+        static inline std::condition_variable m_decodedCondition;
+
+        // Placeholder images that were swapped out, kept until no frame in flight can sample them
+        static inline std::deque<std::pair<uint64_t, OwningPtr<GPU::Vulkan::Texture>>> m_retiredTextures;
     };
 }  // namespace Slipper
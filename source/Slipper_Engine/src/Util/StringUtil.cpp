@@ -23,5 +23,38 @@ std::string to_lower(std::string_view String)
         String, output.begin(), [](unsigned char c) { return std::tolower(c); });
     return output;
 }
+
+std::string escape_json(const std::string_view Text)
+{
+    std::string escaped;
+    escaped.reserve(Text.size());
+    for (const char c : Text) {
+        switch (c) {
+            case '"':
+                escaped += "\\\"";
+                break;
+            case '\\':
+                escaped += "\\\\";
+                break;
+            case '\n':
+                escaped += "\\n";
+                break;
+            case '\r':
+                escaped += "\\r";
+                break;
+            case '\t':
+                escaped += "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    escaped += std::format("\\u{:04x}", static_cast<unsigned char>(c));
+                }
+                else {
+                    escaped += c;
+                }
+        }
+    }
+    return escaped;
+}
 }  // namespace String
 }  // namespace Slipper
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdarg>
+#include <cstdint>
 #include <string>
 #include <string_view>
 
@@ -49,5 +50,39 @@ int get_total_length_of_strings(const std::string_view &String, const StringView
 extern void replace_substring(std::string &Str, const std::string &From, const std::string &To);
 
 extern std::string to_lower(std::string_view String);
+
+// Escapes quotes, backslashes and control characters so the text can be placed inside a JSON string
+extern std::string escape_json(std::string_view Text);
+
+/* Case insensitive 64 bit FNV-1a hash. Usable at compile time, so names known to the engine
+ * (e.g. shader bindings) can be resolved without building or lowering strings at runtime. */
+constexpr uint64_t hash_name(const std::string_view String)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (char c : String) {
+        if (c >= 'A' && c <= 'Z') {
+            c = static_cast<char>(c - 'A' + 'a');
+        }
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// Case insensitive comparison matching hash_name, used to confirm a lookup by hash
+constexpr bool equals_name(const std::string_view Left, const std::string_view Right)
+{
+    if (Left.size() != Right.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < Left.size(); ++i) {
+        const char left = Left[i] >= 'A' && Left[i] <= 'Z' ? static_cast<char>(Left[i] - 'A' + 'a') : Left[i];
+        const char right = Right[i] >= 'A' && Right[i] <= 'Z' ? static_cast<char>(Right[i] - 'A' + 'a') : Right[i];
+        if (left != right) {
+            return false;
+        }
+    }
+    return true;
+}
 }  // namespace String
 }  // namespace Slipper
\ No newline at end of file
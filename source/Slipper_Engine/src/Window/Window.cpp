@@ -12,6 +12,7 @@ namespace Slipper
         glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
         glfwWindowHint(GLFW_RESIZABLE, CreateInfo.resizable);
         glfwWindowHint(GLFW_SRGB_CAPABLE, GLFW_TRUE);
+        glfwWindowHint(GLFW_VISIBLE, CreateInfo.visible);
 
         glfwWindow = glfwCreateWindow(m_info.width, m_info.height, m_info.name.c_str(), nullptr, nullptr);
         if (glfwRawMouseMotionSupported())
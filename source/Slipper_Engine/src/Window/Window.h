@@ -19,6 +19,7 @@ namespace Slipper
         uint32_t width;
         uint32_t height;
         bool resizable;
+        bool visible = true;
     };
 
     class Window
@@ -55,6 +55,9 @@
 
 #define BIT(x) (1 << x)
 
+#define CONCAT_INNER(a, b) a##b
+#define CONCAT(a, b) CONCAT_INNER(a, b)
+
 using StringViewHash = std::hash<std::string_view>;
 
 inline void hash_combine(std::size_t &seed)
@@ -3,17 +3,29 @@
 #include <algorithm>
 #include <any>
 #include <array>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
 #include <format>
 #include <fstream>
 #include <functional>
+#include <future>
 #include <iomanip>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <numeric>
 #include <optional>
 #include <ranges>
 #include <set>
+#include <span>
 #include <sstream>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <variant>
@@ -58,5 +70,7 @@
 
 #include "Core/Entity.h"
 
+#include "Core/Profiler.h"
+
 #include "Engine.h"
 #include "Util/StringUtil.h"
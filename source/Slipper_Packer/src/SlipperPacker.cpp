@@ -0,0 +1,34 @@
+#include "Filesystem/PackFile.h"
+
+int main(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        std::cerr << "Usage: SlipperPacker <directory> <pack> [--no-compress]\n";
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        Slipper::PackWriteSettings settings;
+        // Build scripts live next to the content they describe
+        settings.excludedNames = {"CMakeLists.txt"};
+        for (int i = 3; i < argc; ++i)
+        {
+            const std::string_view argument = argv[i];
+            if (argument == "--no-compress")
+                settings.compress = false;
+            else
+                throw std::invalid_argument(std::format("Unknown packer argument '{}'", argument));
+        }
+
+        Slipper::WritePackFile(argv[1], argv[2], settings);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}